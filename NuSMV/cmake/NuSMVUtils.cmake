@@ -506,6 +506,7 @@ macro(nusmv_check_common_headers)
       limits.h
       memory.h
       ndir.h
+      poll.h
       regex.h
       signal.h
       stdbool.h
@@ -523,6 +524,7 @@ macro(nusmv_check_common_headers)
       sys/stat.h
       sys/time.h
       sys/types.h
+      sys/wait.h
       unistd.h
       )
     foreach(_h ${_required_headers})
@@ -534,6 +536,7 @@ endmacro()
 macro(nusmv_check_common_functions)
     set(_required_funcs
       floor
+      fork
       getenv
       getpid
       isatty
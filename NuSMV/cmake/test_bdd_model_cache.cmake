@@ -0,0 +1,67 @@
+# Checks that the on-disk BDD model cache (option -mc) is hit by an
+# unchanged model and missed when the body of a DEFINE or the domain of
+# a variable changes, even if the flattened model prints the same.
+#
+# Usage: cmake -DNUSMV=<NuSMV binary> -DWORK_DIR=<dir> -P <this file>
+
+if(NOT NUSMV OR NOT WORK_DIR)
+  message(FATAL_ERROR "NUSMV and WORK_DIR must be given")
+endif()
+
+set(cache_dir "${WORK_DIR}/cache")
+file(REMOVE_RECURSE "${WORK_DIR}")
+file(MAKE_DIRECTORY "${cache_dir}")
+
+set(model_vars "MODULE main
+VAR
+  x : 0..3;
+  s : {idle, busy, done};
+")
+set(model_define "DEFINE
+  next_x := (x + 1) mod 4;
+")
+set(model_assign "ASSIGN
+  init(x) := 0;
+  next(x) := next_x;
+  init(s) := idle;
+  next(s) := case x = 3 : done; TRUE : busy; esac;
+SPEC AG (x < 4)
+")
+
+file(WRITE "${WORK_DIR}/base.smv"
+  "${model_vars}${model_define}${model_assign}")
+
+string(REPLACE "(x + 1)" "(x + 3)" changed_define "${model_define}")
+file(WRITE "${WORK_DIR}/define.smv"
+  "${model_vars}${changed_define}${model_assign}")
+
+string(REPLACE "{idle, busy, done}" "{busy, idle, done}"
+  changed_vars "${model_vars}")
+file(WRITE "${WORK_DIR}/domain.smv"
+  "${changed_vars}${model_define}${model_assign}")
+
+# runs NuSMV on model and checks that the cache reports action
+function(check_cache model action)
+  execute_process(
+    COMMAND "${NUSMV}" -v 1 -mc "${cache_dir}" "${WORK_DIR}/${model}"
+    RESULT_VARIABLE res
+    OUTPUT_VARIABLE out
+    ERROR_VARIABLE out)
+
+  if(NOT res EQUAL 0)
+    message(FATAL_ERROR "NuSMV failed on ${model}:\n${out}")
+  endif()
+
+  if(NOT out MATCHES "BDD model cache: ${action} ")
+    message(FATAL_ERROR "BDD model of ${model} was not ${action}:\n${out}")
+  endif()
+
+  if(action STREQUAL "stored" AND out MATCHES "BDD model cache: loaded ")
+    message(FATAL_ERROR "stale BDD model loaded for ${model}:\n${out}")
+  endif()
+endfunction()
+
+check_cache(base.smv stored)
+check_cache(base.smv loaded)
+check_cache(define.smv stored)
+check_cache(domain.smv stored)
@@ -118,4 +118,16 @@ int
 Compass_print_add_sigref_format(DDMgr_ptr dd, add_ptr add, FILE* file,
                                 boolean do_indent);
 
+/*!
+  \brief Reads the probabilities of the labels from a prob file
+
+  Parses prob_file (see Compass_write_sigref) and returns the ADD
+  that associates to each input the probability of its label, or 0
+  when the input has no label. Only inputs of legal transitions of
+  fsm are considered. Returns NULL if the file is empty. Returned add
+  is referenced.
+*/
+add_ptr
+Compass_read_prob_add(NuSMVEnv_ptr env, BddFsm_ptr fsm, FILE* prob_file);
+
 #endif /* __NUSMV_ADDONS_CORE_COMPASS_COMPASS_H__ */
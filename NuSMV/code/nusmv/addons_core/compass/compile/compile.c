@@ -43,6 +43,8 @@
 #include "nusmv/core/utils/ErrorMgr.h"
 #include "nusmv/core/node/printers/MasterPrinter.h"
 #include "nusmv/addons_core/compass/compile/ProbAssign.h"
+#include "nusmv/addons_core/compass/parser/prob/ParserProb.h"
+#include "nusmv/core/enc/base/BaseEnc.h"
 
 #include "nusmv/addons_core/compass/compass.h"
 #include "nusmv/addons_core/compass/compassInt.h"
@@ -207,6 +209,36 @@ add_ptr Compass_process_prob_list(BddEnc_ptr enc, NodeList_ptr list, add_ptr tra
     StreamMgr_print_output(streams, "========================================\n");
 #endif
 
-  bdd_free(dd, ncube);
+  bdd_free(dd, cube);
   return res_add;
 }
+
+add_ptr Compass_read_prob_add(NuSMVEnv_ptr env, BddFsm_ptr fsm,
+                              FILE* prob_file)
+{
+  BddEnc_ptr enc = BddFsm_get_bdd_encoding(fsm);
+  DDMgr_ptr dd = BddEnc_get_dd_manager(enc);
+  const TypeChecker_ptr tc = BaseEnc_get_type_checker(BASE_ENC(enc));
+  ParserProb_ptr pl_parser = ParserProb_create(env);
+  NodeList_ptr probs_list;
+  add_ptr res = (add_ptr) NULL;
+
+  ParserProb_parse_from_file(pl_parser, prob_file);
+  probs_list = ParserProb_get_prob_list(pl_parser);
+
+  if (NODE_LIST(NULL) != probs_list) {
+    /* only the labels of legal transitions get a probability */
+    bdd_ptr legal =
+      BddFsm_get_states_inputs_constraints(fsm, BDD_FSM_DIR_BWD);
+
+    Compass_check_prob_list(tc, probs_list);
+    res = Compass_process_prob_list(enc, probs_list, legal);
+
+    bdd_free(dd, legal);
+  }
+
+  /* the list belongs to the parser */
+  ParserProb_destroy(pl_parser);
+
+  return res;
+}
@@ -195,6 +195,12 @@
 */
 #define BMC_INC_INVAR_ALG_ZIGZAG    "zigzag"
 
+/*!
+  \brief IC3 (property directed reachability) invariant algorithm
+
+*/
+#define BMC_INC_INVAR_ALG_IC3       "ic3"
+
 /*!
   \brief \todo Missing synopsis
 
@@ -255,6 +261,7 @@ typedef enum {
   ALG_FALSIFICATION,
   ALG_DUAL,
   ALG_ZIGZAG,
+  ALG_IC3,
 
   ALG_INTERP_SEQ,
   ALG_INTERPOLANTS,
@@ -223,6 +223,19 @@ int Bmc_GenSolveLtlInc(NuSMVEnv_ptr env, Prop_ptr ltlprop,
 int Bmc_GenSolveInvarZigzag(NuSMVEnv_ptr env,
                                    Prop_ptr invarprop, const int max_k);
 
+/*!
+  \brief Solve an INVARSPEC problems with algorithm IC3
+
+  Frames are kept as groups of a single incremental solver and
+  strengthened by inductive generalization, so that the problem can
+  be proved without unrolling the transition relation. Not more then
+  max_k frames are opened: if the problem is not solved by then the
+  function just returns 0. The sat solver must be MiniSat, otherwise
+  an error is printed and 1 is returned
+*/
+int Bmc_GenSolveInvarIc3(NuSMVEnv_ptr env,
+                         Prop_ptr invarprop, const int max_k);
+
 /*!
   \brief Solve an INVARSPEC problems wiht algorithm Dual
 
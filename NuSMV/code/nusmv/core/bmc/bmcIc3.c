@@ -0,0 +1,1422 @@
+/* ---------------------------------------------------------------------------
+
+ This file is part of the ``bmc'' package of NuSMV
+  version 2.  Copyright (C) 2004 by FBK-irst.
+
+  NuSMV version 2 is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public License
+  as published by the Free Software Foundation; either version 2 of
+  the License, or (at your option) any later version.
+
+  NuSMV version 2 is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307
+  USA.
+
+  For more information on NuSMV see <http://nusmv.fbk.eu> or
+  email to <nusmv-users@fbk.eu>.  Please report bugs to
+  <nusmv-users@fbk.eu>.
+
+  To contact the NuSMV development board, email to
+  <nusmv@fbk.eu>.
+
+-----------------------------------------------------------------------------*/
+
+/*!
+  \author Alberto Bombardelli
+  \brief IC3 (property directed reachability) for invariants
+
+  The frames F_1 ... F_top of the algorithm live in a single
+  incremental SAT solver, one group per frame. A lemma is stored in
+  the group of the highest frame it holds in, so F_i is given by the
+  groups i ... top, while F_0 additionally enables the group of the
+  initial states. The transition relation (from time 0 to time 1) and
+  the negated invariant (at time 1) sit in groups of their own, and
+  the states under scrutiny are passed as assumptions, so that every
+  query reuses all the clauses learnt so far. The clause !s of a
+  relative induction query needs a group of its own, which cannot be
+  removed from the solver, so the solver is reloaded with the frames
+  every IC3_MAX_RETIRED_GROUPS queries.
+
+  A state is blocked at frame i when F_(i-1) & !s & T & s' is
+  unsatisfiable: the assumptions in the conflict give a first
+  generalization of s, which is then shrunk by dropping literals as
+  long as the cube stays inductive relative to F_(i-1) and disjoint
+  from the initial states. Lemmas are pushed forward when a new frame
+  is opened, and the invariant holds as soon as a frame becomes empty.
+
+  Counterexamples are rebuilt by a BMC problem of the length found,
+  constrained by the states of the chain of proof obligations.
+
+*/
+
+
+#if HAVE_CONFIG_H
+#  include "nusmv-config.h"
+#endif
+
+#include "nusmv/core/utils/StreamMgr.h"
+#include "nusmv/core/utils/Logger.h"
+#include "nusmv/core/utils/ErrorMgr.h"
+#include "nusmv/core/utils/assoc.h"
+#include "nusmv/core/utils/Olist.h"
+#include "nusmv/core/utils/Slist.h"
+#include "nusmv/core/bmc/bmcBmc.h"
+#include "nusmv/core/bmc/bmcInt.h"
+#include "nusmv/core/bmc/bmcConv.h"
+#include "nusmv/core/bmc/bmcModel.h"
+#include "nusmv/core/bmc/bmcUtils.h"
+#include "nusmv/core/wff/wff.h"
+#include "nusmv/core/wff/w2w/w2w.h"
+
+#include "nusmv/core/enc/enc.h"
+#include "nusmv/core/enc/be/BeEnc.h"
+#include "nusmv/core/be/be.h"
+
+#include "nusmv/core/node/node.h"
+#include "nusmv/core/prop/propPkg.h"
+#include "nusmv/core/prop/propProp.h"
+
+#include "nusmv/core/mc/mc.h" /* for print_invar */
+
+#include "nusmv/core/sat/sat.h" /* for solver and result */
+#include "nusmv/core/sat/SatSolver.h"
+#include "nusmv/core/sat/SatIncSolver.h"
+
+/*---------------------------------------------------------------------------*/
+/* The file is compiled only if there is at least one incremental SAT solver*/
+/*---------------------------------------------------------------------------*/
+#if NUSMV_HAVE_INCREMENTAL_SAT
+
+/*---------------------------------------------------------------------------*/
+/* Constant declarations                                                     */
+/*---------------------------------------------------------------------------*/
+
+/*!
+  \brief Relative induction queries after which the solver is reloaded
+
+  The group of every query leaves a variable and a clause in the
+  solver once destroyed.
+*/
+#define IC3_MAX_RETIRED_GROUPS 10000
+
+/*---------------------------------------------------------------------------*/
+/* Structure declarations                                                    */
+/*---------------------------------------------------------------------------*/
+
+/*!
+  \brief A cube over the state bits of the model
+
+  A literal is the index of the bit plus one, negated when the bit
+  is false. Literals are kept in increasing order of bit.
+*/
+typedef struct Ic3Cube_TAG {
+  int size;
+  int* lits;
+} Ic3Cube;
+
+/*!
+  \brief A proof obligation: a state to be excluded from a frame
+
+  next is the obligation of the successor of the state, towards the
+  violation of the invariant.
+*/
+typedef struct Ic3Obligation_TAG {
+  Ic3Cube* state;
+  int level;
+  struct Ic3Obligation_TAG* next;
+} Ic3Obligation;
+
+/*!
+  \brief The state of an IC3 run
+
+*/
+typedef struct Ic3_TAG {
+  NuSMVEnv_ptr env;
+  BeFsm_ptr be_fsm;
+  BeEnc_ptr be_enc;
+  Be_CnfAlgorithm cnf_alg;
+  SatIncSolver_ptr solver;
+
+  /* state and frozen bits, as untimed BE variables */
+  int bits_num;
+  be_ptr* bits;
+  /* CNF variables of the bits at time 0 and 1 */
+  int* curr_vars;
+  int* next_vars;
+  /* CNF variable -> bit + 1, at time 0 and 1 */
+  hash_ptr curr2bit;
+  hash_ptr next2bit;
+  /* scratch marks over the bits, always left cleared */
+  boolean* marks;
+
+  be_ptr be_bad; /* negated invariant at time 1 */
+
+  SatSolverGroup group_init;  /* initial states */
+  SatSolverGroup group_trans; /* transition relation, time 0 to 1 */
+  SatSolverGroup group_bad;   /* be_bad */
+
+  /* frames 1 ... top, index 0 is unused. frame_lemmas[i] holds the
+     cubes whose blocking clause is in the group frame_groups[i] */
+  SatSolverGroup* frame_groups;
+  Olist_ptr* frame_lemmas;
+  int top;
+  int frames_size;
+
+  long sat_calls;
+  /* groups destroyed since the solver was loaded */
+  int retired_groups;
+} Ic3;
+
+/*---------------------------------------------------------------------------*/
+/* Type declarations                                                         */
+/*---------------------------------------------------------------------------*/
+
+typedef Ic3Cube* Ic3Cube_ptr;
+typedef Ic3Obligation* Ic3Obligation_ptr;
+typedef Ic3* Ic3_ptr;
+
+/*!
+  \brief The outcome of an IC3 run
+
+*/
+typedef enum {
+  IC3_PROVED,
+  IC3_FALSIFIED,
+  IC3_UNKNOWN
+} Ic3Result;
+
+/*---------------------------------------------------------------------------*/
+/* Variable declarations                                                     */
+/*---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*/
+/* Macro declarations                                                        */
+/*---------------------------------------------------------------------------*/
+
+/*!
+  \brief The bit (starting from 0) of a cube literal
+
+*/
+#define IC3_LIT_BIT(lit) (abs(lit) - 1)
+
+/**AutomaticStart*************************************************************/
+
+/*---------------------------------------------------------------------------*/
+/* Static function prototypes                                                */
+/*---------------------------------------------------------------------------*/
+
+static void bmc_ic3_init(Ic3_ptr self, NuSMVEnv_ptr env, BeFsm_ptr be_fsm,
+                         Prop_ptr invarprop, be_ptr be_invar,
+                         SatIncSolver_ptr solver);
+static void bmc_ic3_deinit(Ic3_ptr self);
+
+static void bmc_ic3_load_solver(Ic3_ptr self);
+
+static void bmc_ic3_reload_solver(Ic3_ptr self);
+
+static Ic3Result bmc_ic3_check(Ic3_ptr self, const int max_k,
+                               Olist_ptr cex);
+static boolean bmc_ic3_check_init(Ic3_ptr self, be_ptr be_invar,
+                                  Olist_ptr cex);
+static boolean bmc_ic3_block(Ic3_ptr self, Ic3Cube_ptr state,
+                             Olist_ptr cex);
+static boolean bmc_ic3_propagate(Ic3_ptr self);
+static Ic3Cube_ptr bmc_ic3_generalize(Ic3_ptr self, Ic3Cube_ptr state,
+                                      Ic3Cube_ptr core, const int level);
+static int bmc_ic3_push_lemma(Ic3_ptr self, Ic3Cube_ptr cube,
+                              const int level);
+
+static void bmc_ic3_new_frame(Ic3_ptr self);
+static Olist_ptr bmc_ic3_frame_groups(Ic3_ptr self, const int level);
+static boolean bmc_ic3_solve(Ic3_ptr self, Olist_ptr groups,
+                             Slist_ptr assumptions);
+static boolean bmc_ic3_solve_relative(Ic3_ptr self, Ic3Cube_ptr cube,
+                                      const int level,
+                                      Ic3Cube_ptr* pred, Ic3Cube_ptr* core);
+static boolean bmc_ic3_is_blocked(Ic3_ptr self, Ic3Cube_ptr cube,
+                                  const int level);
+static boolean bmc_ic3_intersects_init(Ic3_ptr self, Ic3Cube_ptr cube);
+
+static Ic3Cube_ptr bmc_ic3_get_state(Ic3_ptr self);
+static Ic3Cube_ptr bmc_ic3_get_core(Ic3_ptr self, Ic3Cube_ptr cube);
+static Slist_ptr bmc_ic3_cube_to_assumptions(Ic3_ptr self, Ic3Cube_ptr cube,
+                                             const int time);
+static void bmc_ic3_add_blocking_clause(Ic3_ptr self, Ic3Cube_ptr cube,
+                                        SatSolverGroup group);
+static be_ptr bmc_ic3_cube_to_be(Ic3_ptr self, Ic3Cube_ptr cube,
+                                 const int time);
+static Trace_ptr bmc_ic3_print_cntexample(Ic3_ptr self, be_ptr be_invar,
+                                          Olist_ptr cex, Prop_ptr invarprop);
+
+static Ic3Cube_ptr bmc_ic3_cube_create(const int size);
+static Ic3Cube_ptr bmc_ic3_cube_copy(Ic3Cube_ptr cube);
+static Ic3Cube_ptr bmc_ic3_cube_restrict(Ic3_ptr self, Ic3Cube_ptr cube);
+static Ic3Cube_ptr bmc_ic3_cube_remove(Ic3Cube_ptr cube, const int index);
+static void bmc_ic3_cube_destroy(Ic3Cube_ptr cube);
+static void bmc_ic3_cube_list_destroy(Olist_ptr cubes);
+
+static int bmc_ic3_get_cnf_var(Ic3_ptr self, be_ptr var, const int time);
+
+/**AutomaticEnd***************************************************************/
+
+/*---------------------------------------------------------------------------*/
+/* Definition of exported functions                                          */
+/*---------------------------------------------------------------------------*/
+
+int Bmc_GenSolveInvarIc3(NuSMVEnv_ptr env, Prop_ptr invarprop, const int max_k)
+{
+  const StreamMgr_ptr streams =
+    STREAM_MGR(NuSMVEnv_get_value(env, ENV_STREAM_MANAGER));
+  const OptsHandler_ptr opts =
+    OPTS_HANDLER(NuSMVEnv_get_value(env, ENV_OPTS_HANDLER));
+
+  BddEnc_ptr bdd_enc = BDD_ENC(NuSMVEnv_get_value(env, ENV_BDD_ENCODER));
+  node_ptr binvarspec;  /* Its booleanization */
+  BeFsm_ptr be_fsm; /* The corresponding be fsm */
+  BeEnc_ptr be_enc;
+  be_ptr be_invar;
+
+  Prop_ptr oldprop = invarprop;
+  Prop_Rewriter_ptr rewriter = NULL;
+
+  SatIncSolver_ptr solver;
+  Ic3 ic3;
+  Ic3Result result;
+  Olist_ptr cex;
+
+  /* outputs the name of the algorithm */
+  if (opt_verbose_level_gt(opts, 2)) {
+    Logger_ptr logger = LOGGER(NuSMVEnv_get_value(env, ENV_LOGGER));
+    Logger_log(logger,
+            "The invariant solving algorithm is IC3\n");
+  }
+  /* checks that a property was selected: */
+  nusmv_assert(invarprop != PROP(NULL));
+
+  if (Prop_get_status(invarprop) != Prop_Unchecked) {
+    return 0;
+  }
+
+  /* the queries rely on assumptions and on their conflicts, which
+     only MiniSat provides */
+  if (strcasecmp(get_sat_solver(opts), "MiniSat") != 0) {
+    StreamMgr_print_error(streams,  "IC3 requires the incremental sat solver "
+                          "'MiniSat', '%s' does not support assumptions.\n",
+                          get_sat_solver(opts));
+    return 1;
+  }
+
+  be_fsm = Prop_compute_ground_be_fsm(env, invarprop);
+  BE_FSM_CHECK_INSTANCE(be_fsm);
+
+  rewriter = Prop_Rewriter_create(env, invarprop,
+                                  WFF_REWRITE_METHOD_DEADLOCK_FREE,
+                                  WFF_REWRITER_REWRITE_INPUT_NEXT,
+                                  FSM_TYPE_BE, bdd_enc);
+  invarprop = Prop_Rewriter_rewrite(rewriter);
+  be_fsm = Prop_get_be_fsm(invarprop);
+
+  be_enc = BeFsm_get_be_encoding(be_fsm);
+
+  /* Booleanizes and NNFs the invariant formula: */
+  binvarspec = Wff2Nnf(env, Compile_detexpr2bexpr(bdd_enc,
+                                           Prop_get_expr_core(invarprop)));
+  be_invar = Bmc_Conv_Bexp2Be(be_enc, binvarspec);
+
+  /* Initialiaze the incremental SAT solver */
+  solver = Sat_CreateIncSolver(env, get_sat_solver(opts));
+  if (solver == SAT_INC_SOLVER(NULL)) {
+    StreamMgr_print_error(streams,  "Incremental sat solver '%s' is not available.\n",
+            get_sat_solver(opts));
+
+    Prop_Rewriter_update_original_property(rewriter);
+    Prop_Rewriter_destroy(rewriter); rewriter = NULL;
+
+    return 1;
+  }
+
+  if (opt_verbose_level_gt(opts, 0)) {
+    Logger_ptr logger = LOGGER(NuSMVEnv_get_value(env, ENV_LOGGER));
+    Logger_log(logger, "\nSolving invariant problem (IC3)\n");
+  }
+
+  bmc_ic3_init(&ic3, env, be_fsm, invarprop, be_invar, solver);
+
+  cex = Olist_create();
+  if (bmc_ic3_check_init(&ic3, be_invar, cex)) {
+    result = IC3_FALSIFIED;
+  }
+  else {
+    result = bmc_ic3_check(&ic3, max_k, cex);
+  }
+
+  if (opt_verbose_level_gt(opts, 0)) {
+    Logger_ptr logger = LOGGER(NuSMVEnv_get_value(env, ENV_LOGGER));
+    int lemmas = 0;
+    int i;
+
+    for (i = 1; i <= ic3.top; ++i) {
+      lemmas += Olist_get_size(ic3.frame_lemmas[i]);
+    }
+    Logger_log(logger, "IC3: %d frames, %d lemmas, %ld SAT calls\n",
+               ic3.top, lemmas, ic3.sat_calls);
+  }
+
+  switch (result) {
+  case IC3_PROVED:
+    StreamMgr_print_output(streams,  "-- ");
+    print_invar(StreamMgr_get_output_ostream(streams),
+                oldprop, (Prop_PrintFmt) get_prop_print_method(opts));
+    StreamMgr_print_output(streams,  "  is true\n");
+    Prop_set_status(invarprop, Prop_True);
+    break;
+
+  case IC3_FALSIFIED:
+    StreamMgr_print_output(streams,  "-- ");
+    print_invar(StreamMgr_get_output_ostream(streams),
+                oldprop, (Prop_PrintFmt) get_prop_print_method(opts));
+    StreamMgr_print_output(streams,  "  is false\n");
+    Prop_set_status(invarprop, Prop_False);
+
+    if (opt_counter_examples(opts)) {
+      Trace_ptr trace = bmc_ic3_print_cntexample(&ic3, be_invar, cex,
+                                                 invarprop);
+      Prop_set_trace(invarprop, Trace_get_id(trace));
+    }
+    break;
+
+  case IC3_UNKNOWN:
+    StreamMgr_print_output(streams,
+            "-- no proof or counterexample found with bound %d", ic3.top);
+    if (opt_verbose_level_gt(opts, 2)) {
+      Logger_ptr logger = LOGGER(NuSMVEnv_get_value(env, ENV_LOGGER));
+      Logger_log(logger, " for ");
+      print_invar(Logger_get_ostream(logger),
+                  oldprop, (Prop_PrintFmt) get_prop_print_method(opts));
+    }
+    StreamMgr_print_output(streams,  "\n");
+    break;
+
+  default: error_unreachable_code();
+  }
+
+  bmc_ic3_cube_list_destroy(cex);
+  bmc_ic3_deinit(&ic3);
+
+  Prop_Rewriter_update_original_property(rewriter);
+  Prop_Rewriter_destroy(rewriter); rewriter = NULL;
+
+  return 0;
+}
+
+/*---------------------------------------------------------------------------*/
+/* Definition of static functions                                            */
+/*---------------------------------------------------------------------------*/
+
+/*!
+  \brief Sets up an IC3 run on the given solver
+
+  The state and frozen bits are those of the boolean FSM of the
+  property, so the cone of influence is taken into account, or those
+  of the master boolean FSM if the property has none. The solver is
+  taken over.
+*/
+
+static void bmc_ic3_init(Ic3_ptr self, NuSMVEnv_ptr env, BeFsm_ptr be_fsm,
+                         Prop_ptr invarprop, be_ptr be_invar,
+                         SatIncSolver_ptr solver)
+{
+  const OptsHandler_ptr opts =
+    OPTS_HANDLER(NuSMVEnv_get_value(env, ENV_OPTS_HANDLER));
+  BeEnc_ptr be_enc = BeFsm_get_be_encoding(be_fsm);
+  Be_Manager_ptr be_mgr = BeEnc_get_be_manager(be_enc);
+  SymbTable_ptr st = BaseEnc_get_symb_table(BASE_ENC(be_enc));
+  BoolEnc_ptr bool_enc =
+    BoolEncClient_get_bool_enc(BOOL_ENC_CLIENT(be_enc));
+  BoolSexpFsm_ptr bsexp_fsm = Prop_get_bool_sexp_fsm(invarprop);
+  NodeList_ptr vars;
+  Olist_ptr bits = Olist_create();
+  ListIter_ptr iter;
+  Oiter oiter;
+  int i;
+
+  self->env = env;
+  self->be_fsm = be_fsm;
+  self->be_enc = be_enc;
+  self->cnf_alg = get_rbc2cnf_algorithm(opts);
+  self->solver = solver;
+  self->sat_calls = 0;
+  self->retired_groups = 0;
+
+  if (BOOL_SEXP_FSM(NULL) == bsexp_fsm) {
+    bsexp_fsm = \
+      BOOL_SEXP_FSM(NuSMVEnv_get_value(env, ENV_BOOL_FSM));
+    BOOL_SEXP_FSM_CHECK_INSTANCE(bsexp_fsm);
+  }
+  vars = SexpFsm_get_vars_list(SEXP_FSM(bsexp_fsm));
+
+  /* collects the bits of the state and frozen variables */
+  NODE_LIST_FOREACH(vars, iter) {
+    node_ptr var = NodeList_get_elem_at(vars, iter);
+
+    if (!SymbTable_is_symbol_state_frozen_var(st, var)) continue;
+
+    if (SymbTable_is_symbol_bool_var(st, var)) {
+      Olist_append(bits, BeEnc_name_to_untimed(be_enc, var));
+    }
+    else {
+      NodeList_ptr var_bits = BoolEnc_get_var_bits(bool_enc, var);
+      ListIter_ptr bits_iter;
+
+      NODE_LIST_FOREACH(var_bits, bits_iter) {
+        node_ptr bit = NodeList_get_elem_at(var_bits, bits_iter);
+        Olist_append(bits, BeEnc_name_to_untimed(be_enc, bit));
+      }
+      NodeList_destroy(var_bits);
+    }
+  }
+
+  self->bits_num = Olist_get_size(bits);
+  self->bits = ALLOC(be_ptr, self->bits_num + 1);
+  self->curr_vars = ALLOC(int, self->bits_num + 1);
+  self->next_vars = ALLOC(int, self->bits_num + 1);
+  self->marks = ALLOC(boolean, self->bits_num + 1);
+  self->curr2bit = new_assoc();
+  self->next2bit = new_assoc();
+
+  i = 0;
+  OLIST_FOREACH(bits, oiter) {
+    self->bits[i] = (be_ptr) Oiter_element(oiter);
+    self->curr_vars[i] = bmc_ic3_get_cnf_var(self, self->bits[i], 0);
+    self->next_vars[i] = bmc_ic3_get_cnf_var(self, self->bits[i], 1);
+    self->marks[i] = false;
+
+    insert_assoc(self->curr2bit, NODE_FROM_INT(self->curr_vars[i]),
+                 NODE_FROM_INT(i + 1));
+    insert_assoc(self->next2bit, NODE_FROM_INT(self->next_vars[i]),
+                 NODE_FROM_INT(i + 1));
+    ++i;
+  }
+  Olist_destroy(bits);
+
+  self->be_bad =
+    Be_Not(be_mgr, BeEnc_untimed_expr_to_timed(be_enc, be_invar, 1));
+
+  self->frames_size = 8;
+  self->frame_groups = ALLOC(SatSolverGroup, self->frames_size);
+  self->frame_lemmas = ALLOC(Olist_ptr, self->frames_size);
+  self->top = 0;
+
+  bmc_ic3_load_solver(self);
+}
+
+/*!
+  \brief Releases the memory owned by an IC3 run
+
+  The solver is destroyed as well.
+*/
+
+static void bmc_ic3_deinit(Ic3_ptr self)
+{
+  int i;
+
+  SatIncSolver_destroy(self->solver);
+
+  for (i = 1; i <= self->top; ++i) {
+    bmc_ic3_cube_list_destroy(self->frame_lemmas[i]);
+  }
+  FREE(self->frame_lemmas);
+  FREE(self->frame_groups);
+
+  free_assoc(self->next2bit);
+  free_assoc(self->curr2bit);
+  FREE(self->marks);
+  FREE(self->next_vars);
+  FREE(self->curr_vars);
+  FREE(self->bits);
+}
+
+/*!
+  \brief Fills the solver with the model and the frames
+
+  The groups of the initial states, of the transition relation, of
+  the bad states and of every frame are created, and the lemmas of
+  every frame are added to its group.
+*/
+
+static void bmc_ic3_load_solver(Ic3_ptr self)
+{
+  int i;
+
+  self->group_init = SatIncSolver_create_group(self->solver);
+  Bmc_Utils_add_be_into_inc_solver_positively(self->solver, self->group_init,
+                                              Bmc_Model_GetInit0(self->be_fsm),
+                                              self->be_enc, self->cnf_alg);
+
+  self->group_trans = SatIncSolver_create_group(self->solver);
+  Bmc_Utils_add_be_into_inc_solver_positively(self->solver, self->group_trans,
+                                              Bmc_Model_GetUnrolling(
+                                                self->be_fsm, 0, 1),
+                                              self->be_enc, self->cnf_alg);
+
+  self->group_bad = SatIncSolver_create_group(self->solver);
+  Bmc_Utils_add_be_into_inc_solver_positively(self->solver, self->group_bad,
+                                              self->be_bad,
+                                              self->be_enc, self->cnf_alg);
+
+  for (i = 1; i <= self->top; ++i) {
+    Oiter iter;
+
+    self->frame_groups[i] = SatIncSolver_create_group(self->solver);
+    OLIST_FOREACH(self->frame_lemmas[i], iter) {
+      bmc_ic3_add_blocking_clause(self, (Ic3Cube_ptr) Oiter_element(iter),
+                                  self->frame_groups[i]);
+    }
+  }
+
+  self->retired_groups = 0;
+}
+
+/*!
+  \brief Replaces the solver with a new one
+
+  The frames are kept, the clauses learnt so far are lost.
+*/
+
+static void bmc_ic3_reload_solver(Ic3_ptr self)
+{
+  const OptsHandler_ptr opts =
+    OPTS_HANDLER(NuSMVEnv_get_value(self->env, ENV_OPTS_HANDLER));
+
+  if (opt_verbose_level_gt(opts, 1)) {
+    Logger_ptr logger = LOGGER(NuSMVEnv_get_value(self->env, ENV_LOGGER));
+    Logger_log(logger, "IC3: reloading the solver after %d queries\n",
+               self->retired_groups);
+  }
+
+  SatIncSolver_destroy(self->solver);
+  self->solver = Sat_CreateIncSolver(self->env, get_sat_solver(opts));
+  SAT_INC_SOLVER_CHECK_INSTANCE(self->solver);
+
+  bmc_ic3_load_solver(self);
+}
+
+/*!
+  \brief Checks for counterexamples of length 0 and 1
+
+  Returns true if one is found, and in that case fills cex with its
+  states but the last one. These are the cases in which the violation
+  does not go through a proof obligation.
+*/
+
+static boolean bmc_ic3_check_init(Ic3_ptr self, be_ptr be_invar,
+                                  Olist_ptr cex)
+{
+  Be_Manager_ptr be_mgr = BeEnc_get_be_manager(self->be_enc);
+  SatSolverGroup group_bad0;
+  Olist_ptr groups;
+  boolean res;
+
+  /* initial states violating the invariant */
+  group_bad0 = SatIncSolver_create_group(self->solver);
+  Bmc_Utils_add_be_into_inc_solver_positively(
+      self->solver, group_bad0,
+      Be_Not(be_mgr, BeEnc_untimed_expr_to_timed(self->be_enc, be_invar, 0)),
+      self->be_enc, self->cnf_alg);
+
+  groups = Olist_create();
+  Olist_append(groups, (void*) self->group_init);
+  Olist_append(groups, (void*) group_bad0);
+  res = bmc_ic3_solve(self, groups, SLIST(NULL));
+  Olist_destroy(groups);
+  SatIncSolver_destroy_group(self->solver, group_bad0);
+
+  if (res) return true;
+
+  /* initial states with a successor violating the invariant */
+  groups = bmc_ic3_frame_groups(self, 0);
+  Olist_append(groups, (void*) self->group_trans);
+  Olist_append(groups, (void*) self->group_bad);
+  res = bmc_ic3_solve(self, groups, SLIST(NULL));
+  Olist_destroy(groups);
+
+  if (res) Olist_append(cex, bmc_ic3_get_state(self));
+
+  return res;
+}
+
+/*!
+  \brief The main loop of IC3
+
+  Frames are opened until either a counterexample is found (its
+  states are appended to cex), a frame becomes empty after the
+  propagation of the lemmas, or max_k frames have been explored.
+*/
+
+static Ic3Result bmc_ic3_check(Ic3_ptr self, const int max_k,
+                               Olist_ptr cex)
+{
+  const OptsHandler_ptr opts =
+    OPTS_HANDLER(NuSMVEnv_get_value(self->env, ENV_OPTS_HANDLER));
+
+  bmc_ic3_new_frame(self);
+
+  while (true) {
+    /* blocks the states of the top frame leading to the bad states */
+    while (true) {
+      Olist_ptr groups = bmc_ic3_frame_groups(self, self->top);
+      boolean found;
+
+      Olist_append(groups, (void*) self->group_trans);
+      Olist_append(groups, (void*) self->group_bad);
+      found = bmc_ic3_solve(self, groups, SLIST(NULL));
+      Olist_destroy(groups);
+
+      if (!found) break;
+
+      if (!bmc_ic3_block(self, bmc_ic3_get_state(self), cex)) {
+        return IC3_FALSIFIED;
+      }
+    }
+
+    if (self->top >= max_k) return IC3_UNKNOWN;
+
+    bmc_ic3_new_frame(self);
+    if (bmc_ic3_propagate(self)) return IC3_PROVED;
+
+    if (opt_verbose_level_gt(opts, 0)) {
+      Logger_ptr logger = LOGGER(NuSMVEnv_get_value(self->env, ENV_LOGGER));
+      int i;
+
+      Logger_log(logger, "IC3: frame %d, lemmas:", self->top);
+      for (i = 1; i <= self->top; ++i) {
+        Logger_log(logger, " %d", Olist_get_size(self->frame_lemmas[i]));
+      }
+      Logger_log(logger, "\n");
+    }
+  }
+
+  error_unreachable_code();
+  return IC3_UNKNOWN;
+}
+
+/*!
+  \brief Blocks a state of the top frame
+
+  Proof obligations are handled lowest frame first. Returns false if
+  the state turns out to be reachable: cex is then filled with the
+  states from an initial one to the given one. The given state is
+  taken over.
+*/
+
+static boolean bmc_ic3_block(Ic3_ptr self, Ic3Cube_ptr state,
+                             Olist_ptr cex)
+{
+  Olist_ptr queue = Olist_create();
+  Olist_ptr obligations = Olist_create(); /* all of them, for disposal */
+  Ic3Obligation_ptr ob;
+  boolean res = true;
+  Oiter iter;
+
+  ob = ALLOC(Ic3Obligation, 1);
+  ob->state = state;
+  ob->level = self->top;
+  ob->next = (Ic3Obligation_ptr) NULL;
+  Olist_append(obligations, ob);
+  Olist_prepend(queue, ob);
+
+  while (!Olist_is_empty(queue)) {
+    Ic3Cube_ptr pred = (Ic3Cube_ptr) NULL;
+    Ic3Cube_ptr core = (Ic3Cube_ptr) NULL;
+
+    /* picks the obligation with the lowest level, the most recent
+       one among them */
+    ob = (Ic3Obligation_ptr) NULL;
+    OLIST_FOREACH(queue, iter) {
+      Ic3Obligation_ptr cand = (Ic3Obligation_ptr) Oiter_element(iter);
+      if (ob == (Ic3Obligation_ptr) NULL || cand->level < ob->level) {
+        ob = cand;
+      }
+    }
+    Olist_remove(queue, ob);
+
+    if (bmc_ic3_is_blocked(self, ob->state, ob->level)) continue;
+
+    if (bmc_ic3_solve_relative(self, ob->state, ob->level - 1,
+                               &pred, &core)) {
+      Ic3Obligation_ptr pred_ob;
+
+      if (ob->level == 1) {
+        /* pred is an initial state: a counterexample */
+        Ic3Obligation_ptr step;
+
+        Olist_append(cex, pred);
+        for (step = ob; step != (Ic3Obligation_ptr) NULL; step = step->next) {
+          Olist_append(cex, bmc_ic3_cube_copy(step->state));
+        }
+        res = false;
+        break;
+      }
+
+      pred_ob = ALLOC(Ic3Obligation, 1);
+      pred_ob->state = pred;
+      pred_ob->level = ob->level - 1;
+      pred_ob->next = ob;
+      Olist_append(obligations, pred_ob);
+
+      Olist_prepend(queue, ob);
+      Olist_prepend(queue, pred_ob);
+    }
+    else {
+      Ic3Cube_ptr lemma = bmc_ic3_generalize(self, ob->state, core,
+                                             ob->level);
+      int level = bmc_ic3_push_lemma(self, lemma, ob->level);
+
+      /* the state may still be reachable in a later frame */
+      if (level < self->top) {
+        ob->level = level + 1;
+        Olist_prepend(queue, ob);
+      }
+    }
+  }
+
+  OLIST_FOREACH(obligations, iter) {
+    ob = (Ic3Obligation_ptr) Oiter_element(iter);
+    bmc_ic3_cube_destroy(ob->state);
+    FREE(ob);
+  }
+  Olist_destroy(obligations);
+  Olist_destroy(queue);
+
+  return res;
+}
+
+/*!
+  \brief Pushes the lemmas forward, from the first to the top frame
+
+  Returns true if a frame became empty, i.e. if it is equal to the
+  next one and thus an inductive invariant.
+*/
+
+static boolean bmc_ic3_propagate(Ic3_ptr self)
+{
+  int i;
+
+  for (i = 1; i < self->top; ++i) {
+    Olist_ptr lemmas = self->frame_lemmas[i];
+    Oiter iter = Olist_first(lemmas);
+
+    while (!Oiter_is_end(iter)) {
+      Ic3Cube_ptr cube = (Ic3Cube_ptr) Oiter_element(iter);
+      Olist_ptr groups = bmc_ic3_frame_groups(self, i);
+      Slist_ptr assumptions = bmc_ic3_cube_to_assumptions(self, cube, 1);
+      boolean res;
+
+      Olist_append(groups, (void*) self->group_trans);
+      res = bmc_ic3_solve(self, groups, assumptions);
+      Slist_destroy(assumptions);
+      Olist_destroy(groups);
+
+      if (res) {
+        iter = Oiter_next(iter);
+      }
+      else {
+        /* the clause already in frame i is now redundant */
+        bmc_ic3_add_blocking_clause(self, cube, self->frame_groups[i + 1]);
+        Olist_append(self->frame_lemmas[i + 1], cube);
+        iter = Olist_delete(lemmas, iter, NULL);
+      }
+    }
+
+    if (Olist_is_empty(lemmas)) return true;
+  }
+
+  return false;
+}
+
+/*!
+  \brief Generalizes a state blocked at the given level
+
+  core is the part of the state responsible for the blocking, and is
+  taken over. The result is a sub-cube of the state which is
+  inductive relative to the frame level - 1 and does not contain
+  initial states.
+*/
+
+static Ic3Cube_ptr bmc_ic3_generalize(Ic3_ptr self, Ic3Cube_ptr state,
+                                      Ic3Cube_ptr core, const int level)
+{
+  Ic3Cube_ptr res = core;
+  int i;
+
+  /* the core may reach the initial states: literals of the state are
+     put back until it does not. The state itself does not. */
+  if (bmc_ic3_intersects_init(self, res)) {
+    for (i = 0; i < res->size; ++i) {
+      self->marks[IC3_LIT_BIT(res->lits[i])] = true;
+    }
+    bmc_ic3_cube_destroy(res);
+
+    res = (Ic3Cube_ptr) NULL;
+    for (i = 0; i < state->size; ++i) {
+      int bit = IC3_LIT_BIT(state->lits[i]);
+
+      if (self->marks[bit]) continue;
+      self->marks[bit] = true;
+
+      res = bmc_ic3_cube_restrict(self, state);
+      if (!bmc_ic3_intersects_init(self, res)) break;
+      bmc_ic3_cube_destroy(res);
+      res = (Ic3Cube_ptr) NULL;
+    }
+
+    for (i = 0; i < state->size; ++i) {
+      self->marks[IC3_LIT_BIT(state->lits[i])] = false;
+    }
+    if (res == (Ic3Cube_ptr) NULL) res = bmc_ic3_cube_copy(state);
+  }
+
+  /* drops the literals one at a time */
+  i = 0;
+  while (i < res->size && res->size > 1) {
+    Ic3Cube_ptr cand = bmc_ic3_cube_remove(res, i);
+    Ic3Cube_ptr cand_core = (Ic3Cube_ptr) NULL;
+
+    if (!bmc_ic3_intersects_init(self, cand) &&
+        !bmc_ic3_solve_relative(self, cand, level - 1,
+                                (Ic3Cube_ptr*) NULL, &cand_core)) {
+      if (!bmc_ic3_intersects_init(self, cand_core)) {
+        bmc_ic3_cube_destroy(cand);
+        cand = cand_core;
+      }
+      else bmc_ic3_cube_destroy(cand_core);
+
+      bmc_ic3_cube_destroy(res);
+      res = cand;
+    }
+    else {
+      bmc_ic3_cube_destroy(cand);
+      ++i;
+    }
+  }
+
+  return res;
+}
+
+/*!
+  \brief Adds a lemma blocked at the given level to the highest
+  frame it can be pushed to
+
+  The cube is taken over. The frame is returned.
+*/
+
+static int bmc_ic3_push_lemma(Ic3_ptr self, Ic3Cube_ptr cube,
+                              const int level)
+{
+  int res = level;
+
+  while (res < self->top &&
+         !bmc_ic3_solve_relative(self, cube, res,
+                                 (Ic3Cube_ptr*) NULL, (Ic3Cube_ptr*) NULL)) {
+    ++res;
+  }
+
+  bmc_ic3_add_blocking_clause(self, cube, self->frame_groups[res]);
+  Olist_append(self->frame_lemmas[res], cube);
+
+  return res;
+}
+
+/*!
+  \brief Opens a new top frame
+
+*/
+
+static void bmc_ic3_new_frame(Ic3_ptr self)
+{
+  ++self->top;
+
+  if (self->top >= self->frames_size) {
+    self->frames_size *= 2;
+    self->frame_groups = REALLOC(SatSolverGroup, self->frame_groups,
+                                 self->frames_size);
+    self->frame_lemmas = REALLOC(Olist_ptr, self->frame_lemmas,
+                                 self->frames_size);
+  }
+
+  self->frame_groups[self->top] = SatIncSolver_create_group(self->solver);
+  self->frame_lemmas[self->top] = Olist_create();
+}
+
+/*!
+  \brief The list of the groups making up the given frame
+
+  Frame 0 is made of the initial states (and of all the lemmas, which
+  do not exclude them). The returned list is owned by the caller.
+*/
+
+static Olist_ptr bmc_ic3_frame_groups(Ic3_ptr self, const int level)
+{
+  Olist_ptr res = Olist_create();
+  int i;
+
+  if (level == 0) Olist_append(res, (void*) self->group_init);
+
+  for (i = (level > 0 ? level : 1); i <= self->top; ++i) {
+    Olist_append(res, (void*) self->frame_groups[i]);
+  }
+
+  return res;
+}
+
+/*!
+  \brief Solves the given groups under the given assumptions
+
+  Returns true if the problem is satisfiable. Errors of the solver
+  are fatal.
+*/
+
+static boolean bmc_ic3_solve(Ic3_ptr self, Olist_ptr groups,
+                             Slist_ptr assumptions)
+{
+  const ErrorMgr_ptr errmgr =
+    ERROR_MGR(NuSMVEnv_get_value(self->env, ENV_ERROR_MANAGER));
+  SatSolverResult satResult;
+  Slist_ptr none = SLIST(NULL);
+
+  if (assumptions == SLIST(NULL)) {
+    /* an empty list, so that the conflict is refreshed anyway */
+    none = Slist_create();
+    assumptions = none;
+  }
+
+  ++self->sat_calls;
+  satResult = SatIncSolver_solve_groups_assume(self->solver, groups,
+                                               assumptions);
+  if (none != SLIST(NULL)) Slist_destroy(none);
+
+  switch (satResult) {
+  case SAT_SOLVER_SATISFIABLE_PROBLEM: return true;
+
+  case SAT_SOLVER_UNSATISFIABLE_PROBLEM: return false;
+
+  case SAT_SOLVER_INTERNAL_ERROR:
+    ErrorMgr_internal_error(errmgr, "Sorry, solver answered with a fatal Internal "
+                   "Failure during problem solving.\n");
+
+  case SAT_SOLVER_TIMEOUT:
+  case SAT_SOLVER_MEMOUT:
+    ErrorMgr_internal_error(errmgr, "Sorry, solver ran out of resources and aborted "
+                   "the execution.\n");
+
+  default:
+    ErrorMgr_internal_error(errmgr, "%s:%d:%s: Unexpected value in satResult (%d)",
+                   __FILE__, __LINE__, __func__, satResult);
+  }
+
+  return false;
+}
+
+/*!
+  \brief Checks whether a cube is inductive relative to a frame
+
+  Solves F_level & !cube & T & cube'. If satisfiable, the predecessor
+  found is returned in pred, otherwise the part of the cube in the
+  conflict is returned in core (both optional, and owned by the
+  caller). !cube lives in a group of its own, which is left in the
+  solver once destroyed: the solver is reloaded after
+  IC3_MAX_RETIRED_GROUPS queries.
+*/
+
+static boolean bmc_ic3_solve_relative(Ic3_ptr self, Ic3Cube_ptr cube,
+                                      const int level,
+                                      Ic3Cube_ptr* pred, Ic3Cube_ptr* core)
+{
+  SatSolverGroup group_cube = SatIncSolver_create_group(self->solver);
+  Olist_ptr groups = bmc_ic3_frame_groups(self, level);
+  Slist_ptr assumptions = bmc_ic3_cube_to_assumptions(self, cube, 1);
+  boolean res;
+
+  bmc_ic3_add_blocking_clause(self, cube, group_cube);
+  Olist_append(groups, (void*) self->group_trans);
+  Olist_append(groups, (void*) group_cube);
+
+  res = bmc_ic3_solve(self, groups, assumptions);
+  if (res && pred != (Ic3Cube_ptr*) NULL) {
+    *pred = bmc_ic3_get_state(self);
+  }
+  if (!res && core != (Ic3Cube_ptr*) NULL) {
+    *core = bmc_ic3_get_core(self, cube);
+  }
+
+  Slist_destroy(assumptions);
+  Olist_destroy(groups);
+  SatIncSolver_destroy_group(self->solver, group_cube);
+
+  if (++self->retired_groups >= IC3_MAX_RETIRED_GROUPS) {
+    bmc_ic3_reload_solver(self);
+  }
+
+  return res;
+}
+
+/*!
+  \brief Checks whether a cube is already excluded from a frame
+
+*/
+
+static boolean bmc_ic3_is_blocked(Ic3_ptr self, Ic3Cube_ptr cube,
+                                  const int level)
+{
+  Olist_ptr groups = bmc_ic3_frame_groups(self, level);
+  Slist_ptr assumptions = bmc_ic3_cube_to_assumptions(self, cube, 0);
+  boolean res;
+
+  res = !bmc_ic3_solve(self, groups, assumptions);
+
+  Slist_destroy(assumptions);
+  Olist_destroy(groups);
+
+  return res;
+}
+
+/*!
+  \brief Checks whether a cube contains initial states
+
+*/
+
+static boolean bmc_ic3_intersects_init(Ic3_ptr self, Ic3Cube_ptr cube)
+{
+  Olist_ptr groups = Olist_create();
+  Slist_ptr assumptions = bmc_ic3_cube_to_assumptions(self, cube, 0);
+  boolean res;
+
+  Olist_append(groups, (void*) self->group_init);
+  res = bmc_ic3_solve(self, groups, assumptions);
+
+  Slist_destroy(assumptions);
+  Olist_destroy(groups);
+
+  return res;
+}
+
+/*!
+  \brief The state at time 0 in the model of the last solving
+
+*/
+
+static Ic3Cube_ptr bmc_ic3_get_state(Ic3_ptr self)
+{
+  Ic3Cube_ptr res = bmc_ic3_cube_create(self->bits_num);
+  Slist_ptr model = SatSolver_get_model(SAT_SOLVER(self->solver));
+  Siter iter;
+  int i;
+
+  /* bits missing in the model are false */
+  for (i = 0; i < self->bits_num; ++i) res->lits[i] = -(i + 1);
+
+  SLIST_FOREACH(model, iter) {
+    int lit = PTR_TO_INT(Siter_element(iter));
+    int bit = NODE_TO_INT(find_assoc(self->curr2bit,
+                                     NODE_FROM_INT(abs(lit))));
+
+    if (bit > 0 && lit > 0) res->lits[bit - 1] = bit;
+  }
+
+  return res;
+}
+
+/*!
+  \brief The part of a cube (assumed at time 1) in the conflict of
+  the last solving
+
+*/
+
+static Ic3Cube_ptr bmc_ic3_get_core(Ic3_ptr self, Ic3Cube_ptr cube)
+{
+  Slist_ptr conflict = SatSolver_get_conflicts(SAT_SOLVER(self->solver));
+  Ic3Cube_ptr res;
+  Siter iter;
+  int i;
+
+  SLIST_FOREACH(conflict, iter) {
+    int lit = PTR_TO_INT(Siter_element(iter));
+    int bit;
+
+    /* group ids */
+    if (lit == 0) continue;
+
+    bit = NODE_TO_INT(find_assoc(self->next2bit, NODE_FROM_INT(abs(lit))));
+    if (bit > 0) self->marks[bit - 1] = true;
+  }
+
+  res = bmc_ic3_cube_restrict(self, cube);
+
+  for (i = 0; i < self->bits_num; ++i) self->marks[i] = false;
+
+  return res;
+}
+
+/*!
+  \brief The CNF literals of a cube at the given time (0 or 1)
+
+  The returned list is owned by the caller.
+*/
+
+static Slist_ptr bmc_ic3_cube_to_assumptions(Ic3_ptr self, Ic3Cube_ptr cube,
+                                             const int time)
+{
+  const int* vars = (time == 0) ? self->curr_vars : self->next_vars;
+  Slist_ptr res = Slist_create();
+  int i;
+
+  for (i = 0; i < cube->size; ++i) {
+    int lit = cube->lits[i];
+    int var = vars[IC3_LIT_BIT(lit)];
+
+    Slist_push(res, PTR_FROM_INT(void*, lit > 0 ? var : -var));
+  }
+
+  return res;
+}
+
+/*!
+  \brief Adds the negation of a cube at time 0 to a group
+
+  The clause is added as is, without any conversion.
+*/
+
+static void bmc_ic3_add_blocking_clause(Ic3_ptr self, Ic3Cube_ptr cube,
+                                        SatSolverGroup group)
+{
+  Be_Manager_ptr be_mgr = BeEnc_get_be_manager(self->be_enc);
+  Be_Cnf_ptr cnf = Be_Cnf_Create(Be_Truth(be_mgr));
+  int* clause = ALLOC(int, cube->size + 1);
+  int i;
+
+  for (i = 0; i < cube->size; ++i) {
+    int lit = cube->lits[i];
+    int var = self->curr_vars[IC3_LIT_BIT(lit)];
+
+    clause[i] = lit > 0 ? -var : var;
+  }
+  clause[cube->size] = 0;
+
+  Slist_push(Be_Cnf_GetClausesList(cnf), clause);
+  SatSolver_add(SAT_SOLVER(self->solver), cnf, group);
+  Be_Cnf_Delete(cnf);
+}
+
+/*!
+  \brief The BE of a cube at the given time
+
+*/
+
+static be_ptr bmc_ic3_cube_to_be(Ic3_ptr self, Ic3Cube_ptr cube,
+                                 const int time)
+{
+  Be_Manager_ptr be_mgr = BeEnc_get_be_manager(self->be_enc);
+  be_ptr res = Be_Truth(be_mgr);
+  int i;
+
+  for (i = 0; i < cube->size; ++i) {
+    int lit = cube->lits[i];
+    be_ptr var = BeEnc_untimed_expr_to_timed(self->be_enc,
+                                             self->bits[IC3_LIT_BIT(lit)],
+                                             time);
+
+    res = Be_And(be_mgr, res, lit > 0 ? var : Be_Not(be_mgr, var));
+  }
+
+  return res;
+}
+
+/*!
+  \brief Builds and prints the trace of a counterexample
+
+  cex holds the states from time 0 to k - 1, the invariant being
+  violated at time k. The path is filled in by a BMC problem of
+  length k constrained by those states.
+*/
+
+static Trace_ptr bmc_ic3_print_cntexample(Ic3_ptr self, be_ptr be_invar,
+                                          Olist_ptr cex, Prop_ptr invarprop)
+{
+  const NuSMVEnv_ptr env = self->env;
+  const ErrorMgr_ptr errmgr =
+    ERROR_MGR(NuSMVEnv_get_value(env, ENV_ERROR_MANAGER));
+  const OptsHandler_ptr opts =
+    OPTS_HANDLER(NuSMVEnv_get_value(env, ENV_OPTS_HANDLER));
+  TraceMgr_ptr tm = TRACE_MGR(NuSMVEnv_get_value(env, ENV_TRACE_MGR));
+  Be_Manager_ptr be_mgr = BeEnc_get_be_manager(self->be_enc);
+  const int k = Olist_get_size(cex);
+  BoolSexpFsm_ptr bsexp_fsm; /* needed for trace language */
+  SatSolver_ptr solver;
+  be_ptr prob;
+  Trace_ptr trace;
+  Oiter iter;
+  int time;
+
+  prob = Be_And(be_mgr, Bmc_Model_GetInit0(self->be_fsm),
+                Be_Not(be_mgr, BeEnc_untimed_expr_to_timed(self->be_enc,
+                                                           be_invar, k)));
+  if (k > 0) {
+    prob = Be_And(be_mgr, prob, Bmc_Model_GetUnrolling(self->be_fsm, 0, k));
+  }
+
+  time = 0;
+  OLIST_FOREACH(cex, iter) {
+    prob = Be_And(be_mgr, prob,
+                  bmc_ic3_cube_to_be(self, (Ic3Cube_ptr) Oiter_element(iter),
+                                     time));
+    ++time;
+  }
+
+  solver = Sat_CreateNonIncSolver(env, get_sat_solver(opts));
+  SAT_SOLVER_CHECK_INSTANCE(solver);
+  Bmc_Utils_add_be_into_non_inc_solver_positively(solver, prob,
+                                                  self->be_enc,
+                                                  self->cnf_alg);
+
+  if (SatSolver_solve_all_groups(solver) != SAT_SOLVER_SATISFIABLE_PROBLEM) {
+    ErrorMgr_internal_error(errmgr, "%s:%d:%s: the IC3 counterexample of "
+                            "length %d cannot be rebuilt",
+                            __FILE__, __LINE__, __func__, k);
+  }
+
+  bsexp_fsm = Prop_get_bool_sexp_fsm(invarprop);
+  if (BOOL_SEXP_FSM(NULL) == bsexp_fsm) {
+    bsexp_fsm = \
+      BOOL_SEXP_FSM(NuSMVEnv_get_value(env, ENV_BOOL_FSM));
+    BOOL_SEXP_FSM_CHECK_INSTANCE(bsexp_fsm);
+  }
+
+  trace = \
+    Bmc_Utils_generate_and_print_cntexample(self->be_enc, tm, solver,
+                                            prob, k, "IC3 Counterexample",
+                             SexpFsm_get_symbols_list(SEXP_FSM(bsexp_fsm)));
+
+  SatSolver_destroy(solver);
+
+  return trace;
+}
+
+/*!
+  \brief Creates a cube with room for size literals
+
+*/
+
+static Ic3Cube_ptr bmc_ic3_cube_create(const int size)
+{
+  Ic3Cube_ptr res = ALLOC(Ic3Cube, 1);
+
+  res->size = size;
+  res->lits = ALLOC(int, size + 1);
+
+  return res;
+}
+
+/*!
+  \brief Copies a cube
+
+*/
+
+static Ic3Cube_ptr bmc_ic3_cube_copy(Ic3Cube_ptr cube)
+{
+  Ic3Cube_ptr res = bmc_ic3_cube_create(cube->size);
+
+  memcpy(res->lits, cube->lits, cube->size * sizeof(int));
+
+  return res;
+}
+
+/*!
+  \brief The literals of a cube whose bits are marked
+
+*/
+
+static Ic3Cube_ptr bmc_ic3_cube_restrict(Ic3_ptr self, Ic3Cube_ptr cube)
+{
+  Ic3Cube_ptr res = bmc_ic3_cube_create(cube->size);
+  int i;
+
+  res->size = 0;
+  for (i = 0; i < cube->size; ++i) {
+    if (self->marks[IC3_LIT_BIT(cube->lits[i])]) {
+      res->lits[res->size++] = cube->lits[i];
+    }
+  }
+
+  return res;
+}
+
+/*!
+  \brief A copy of a cube without the literal at the given index
+
+*/
+
+static Ic3Cube_ptr bmc_ic3_cube_remove(Ic3Cube_ptr cube, const int index)
+{
+  Ic3Cube_ptr res = bmc_ic3_cube_create(cube->size - 1);
+
+  memcpy(res->lits, cube->lits, index * sizeof(int));
+  memcpy(res->lits + index, cube->lits + index + 1,
+         (cube->size - index - 1) * sizeof(int));
+
+  return res;
+}
+
+/*!
+  \brief Destroys a cube
+
+*/
+
+static void bmc_ic3_cube_destroy(Ic3Cube_ptr cube)
+{
+  FREE(cube->lits);
+  FREE(cube);
+}
+
+/*!
+  \brief Destroys a list of cubes, and the cubes
+
+*/
+
+static void bmc_ic3_cube_list_destroy(Olist_ptr cubes)
+{
+  Oiter iter;
+
+  OLIST_FOREACH(cubes, iter) {
+    bmc_ic3_cube_destroy((Ic3Cube_ptr) Oiter_element(iter));
+  }
+  Olist_destroy(cubes);
+}
+
+/*!
+  \brief The CNF variable of an untimed BE variable at the given time
+
+*/
+
+static int bmc_ic3_get_cnf_var(Ic3_ptr self, be_ptr var, const int time)
+{
+  Be_Manager_ptr be_mgr = BeEnc_get_be_manager(self->be_enc);
+  Be_Cnf_ptr cnf;
+  int res;
+
+  cnf = Be_ConvertToCnf(be_mgr,
+                        BeEnc_untimed_expr_to_timed(self->be_enc, var, time),
+                        1, self->cnf_alg);
+  res = Be_Cnf_GetFormulaLiteral(cnf);
+  Be_Cnf_Delete(cnf);
+
+  nusmv_assert(res > 0 && res != INT_MAX);
+  return res;
+}
+
+#endif /* NUSMV_HAVE_INCREMENTAL_SAT */
@@ -490,8 +490,9 @@ static boolean opt_check_bmc_inc_invar_alg(OptsHandler_ptr opts,
   if (OPTS_VALUE_ERROR == res) {
     StreamMgr_print_error(streams, 
             "The available INVAR solving (incremental) algorithms are:\n");
-    StreamMgr_print_error(streams,  "%s %s\n",
-            BMC_INC_INVAR_ALG_DUAL, BMC_INC_INVAR_ALG_ZIGZAG);
+    StreamMgr_print_error(streams,  "%s %s %s\n",
+            BMC_INC_INVAR_ALG_DUAL, BMC_INC_INVAR_ALG_ZIGZAG,
+            BMC_INC_INVAR_ALG_IC3);
     return false;
   }
 
@@ -515,6 +516,9 @@ static void* opt_get_bmc_inc_invar_alg(OptsHandler_ptr opts,
   else if (strcasecmp(BMC_INC_INVAR_ALG_DUAL, val) == 0) {
     return BMC_INC_INVAR_ALG_DUAL;
   }
+  else if (strcasecmp(BMC_INC_INVAR_ALG_IC3, val) == 0) {
+    return BMC_INC_INVAR_ALG_IC3;
+  }
   return OPTS_VALUE_ERROR;
 }
 #endif
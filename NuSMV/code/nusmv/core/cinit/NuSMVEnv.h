@@ -293,6 +293,14 @@ typedef struct NuSMVEnv_TAG*  NuSMVEnv_ptr;
 #define ENV_STAT_PROB_GEN "stat_prob_gen"
 
 #define ENV_STAT_PROB_GEN_BMC "stat_prob_gen_bmc"
+
+#define ENV_STAT_RANDOM_GEN "stat_random_gen"
+
+#define ENV_STAT_INPUT_PROBS "stat_input_probs"
+
+#define ENV_STAT_CHECKPOINT "stat_checkpoint"
+
+#define ENV_STAT_PROFILER "stat_profiler"
 /**AutomaticStart*************************************************************/
 
 /*---------------------------------------------------------------------------*/
@@ -643,6 +643,12 @@ void NuSMVCore_init_cmd_options(NuSMVEnv_ptr env)
                                         "tv_file", TRANS_ORDER_FILE, true,
                                         false, NULL, NULL);
 
+  NuSMVCore_add_env_command_line_option("-mc",
+                                        "stores and reloads the BDD model "
+                                        "in the cache directory \"mc_dir\"",
+                                        "mc_dir", BDD_MODEL_CACHE, true,
+                                        false, NULL, NULL);
+
   NuSMVCore_add_env_command_line_option("-AG",
                                         "enables AG only search",
                                         NULL, AG_ONLY_SEARCH, true,
@@ -151,6 +151,15 @@ void dd_manager_init(DDMgr_ptr self, const NuSMVEnv_ptr env)
                "init_dd_package: Unable to initialize the manager.");
 
   /* members initialization */
+  self->density_index = new_assoc();
+  self->mass_index = new_assoc();
+  self->mass_fun = (DPFNV)NULL;
+  self->mass_arg = NULL;
+  self->weights = (double*)NULL;
+  self->weights_num = 0;
+  self->weights_size = 0;
+  self->weights_gcs = 0;
+  self->weights_reorderings = 0;
 
   /* virtual methods settings */
   OVERRIDE(Object, finalize) = dd_manager_finalize;
@@ -162,6 +171,9 @@ void dd_manager_init(DDMgr_ptr self, const NuSMVEnv_ptr env)
 void dd_manager_deinit(DDMgr_ptr self)
 {
   /* members deinitialization */
+  free_assoc(self->density_index);
+  free_assoc(self->mass_index);
+  FREE(self->weights);
 
   Cudd_Quit(self->dd);
 
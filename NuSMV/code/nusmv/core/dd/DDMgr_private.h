@@ -41,9 +41,11 @@
 
 
 #include "nusmv/core/dd/DDMgr.h"
+#include "nusmv/core/dd/dd.h"
 #include "nusmv/core/utils/EnvObject.h"
 #include "nusmv/core/utils/EnvObject_private.h"
 #include "nusmv/core/utils/utils.h"
+#include "nusmv/core/utils/assoc.h"
 
 
 /*!
@@ -64,7 +66,25 @@ typedef struct DDMgr_TAG
   /* -------------------------------------------------- */
   /*                  Private members                   */
   /* -------------------------------------------------- */
-
+  /* weights of the nodes met by the weighted minterm picking, valid
+     until the next garbage collection or reordering. Both indexes
+     map a node to 1 + its index in weights:
+     density_index: fraction of the assignments satisfying a regular
+                    bdd node
+     mass_index: average leaf weight of an add node, with leaves
+                 weighted by mass_fun */
+  hash_ptr density_index;
+  hash_ptr mass_index;
+  DPFNV mass_fun;
+  void* mass_arg;
+  double* weights;
+  size_t weights_num;
+  size_t weights_size;
+
+  /* garbage collections and reorderings when the weights were
+     computed */
+  int weights_gcs;
+  int weights_reorderings;
 
   /* -------------------------------------------------- */
   /*                  Virtual methods                   */
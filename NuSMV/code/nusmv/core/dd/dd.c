@@ -59,6 +59,7 @@
 #include "nusmv/core/enc/operators.h"
 #include "nusmv/core/parser/symbols.h" /* for FAILURE value */
 #include "nusmv/core/dd/DDMgr_private.h"
+#include "cudd/dddmp.h"
 /*---------------------------------------------------------------------------*/
 /* Variable declarations                                                     */
 /*---------------------------------------------------------------------------*/
@@ -96,6 +97,26 @@
 /*---------------------------------------------------------------------------*/
 static void InvalidType(FILE *file, char *field, char *expected);
 
+static bdd_ptr dd_pick_one_minterm(DDMgr_ptr dd, bdd_ptr fn, bdd_ptr * vars,
+                                   int n, RandomGen_ptr gen,
+                                   boolean uniform);
+
+static double dd_minterm_density(DDMgr_ptr dd, DdNode* node);
+
+static double dd_add_mass(DDMgr_ptr dd, DdNode* node);
+
+static void dd_weights_check_cache(DDMgr_ptr dd);
+
+static void dd_weights_store(DDMgr_ptr dd, hash_ptr index, DdNode* node,
+                             double weight);
+
+static char dd_weighted_coin(RandomGen_ptr gen, double t, double e);
+
+static char* dd_alloc_values(DDMgr_ptr dd);
+
+static bdd_ptr dd_values_to_cube(DDMgr_ptr dd, char* values,
+                                 bdd_ptr * vars, int n, RandomGen_ptr gen);
+
 /*---------------------------------------------------------------------------*/
 /* Definition of exported functions                                          */
 /*---------------------------------------------------------------------------*/
@@ -1688,6 +1709,53 @@ bdd_ptr bdd_pick_one_minterm_rand(DDMgr_ptr dd, bdd_ptr fn, bdd_ptr * vars, int
   }
 }
 
+bdd_ptr bdd_pick_one_minterm_gen(DDMgr_ptr dd, bdd_ptr fn, bdd_ptr * vars,
+                                 int n, RandomGen_ptr gen)
+{
+  return dd_pick_one_minterm(dd, fn, vars, n, gen, false);
+}
+
+bdd_ptr bdd_pick_one_minterm_uniform(DDMgr_ptr dd, bdd_ptr fn,
+                                     bdd_ptr * vars, int n, RandomGen_ptr gen)
+{
+  return dd_pick_one_minterm(dd, fn, vars, n, gen, true);
+}
+
+bdd_ptr add_pick_one_minterm_weighted(DDMgr_ptr dd, add_ptr fn,
+                                      DPFNV weight, void* arg,
+                                      bdd_ptr * vars, int n,
+                                      RandomGen_ptr gen)
+{
+  DdNode* node = (DdNode*)fn;
+  bdd_ptr result;
+  char* values;
+
+  dd_weights_check_cache(dd);
+
+  /* masses depend on the leaf weights */
+  if (dd->mass_fun != weight || dd->mass_arg != arg) {
+    clear_assoc(dd->mass_index);
+    dd->mass_fun = weight;
+    dd->mass_arg = arg;
+  }
+
+  if (0.0 == dd_add_mass(dd, node)) return bdd_false(dd);
+
+  values = dd_alloc_values(dd);
+
+  while (! Cudd_IsConstant(node)) {
+    values[node->index] = dd_weighted_coin(gen,
+                                           dd_add_mass(dd, cuddT(node)),
+                                           dd_add_mass(dd, cuddE(node)));
+    node = values[node->index] ? cuddT(node) : cuddE(node);
+  }
+
+  result = dd_values_to_cube(dd, values, vars, n, gen);
+  FREE(values);
+
+  return result;
+}
+
 int bdd_pick_all_terms(
   DDMgr_ptr dd           /* dd manager */,
   bdd_ptr   pick_from_set  /* minterm from which to pick  all term */,
@@ -1778,6 +1846,24 @@ bdd_ptr bdd_cube_intersection(DDMgr_ptr dd, bdd_ptr a, bdd_ptr b)
   return(result);
 }
 
+boolean bdd_to_cube_array(DDMgr_ptr dd, bdd_ptr cube, int* array)
+{
+  return (1 == Cudd_BddToCubeArray(dd->dd, (DdNode *)cube, array));
+}
+
+bdd_ptr bdd_from_cube_array(DDMgr_ptr dd, int* array)
+{
+  DdNode * result;
+  const NuSMVEnv_ptr env = EnvObject_get_environment(ENV_OBJECT(dd));
+  const ErrorMgr_ptr errmgr =
+    ERROR_MGR(NuSMVEnv_get_value(env, ENV_ERROR_MANAGER));
+
+  result = Cudd_CubeArrayToBdd(dd->dd, array);
+  common_error(errmgr, result, "bdd_from_cube_array: result = NULL");
+  Cudd_Ref(result);
+  return((bdd_ptr)result);
+}
+
 int bdd_get_lowest_index(DDMgr_ptr dd, bdd_ptr a)
 {
   int result;
@@ -2003,6 +2089,48 @@ int bdd_DumpBlifBody(
   return(Cudd_DumpBlifBody(dd->dd, n, f, inames, onames, fp));
 }
 
+int bdd_array_store(
+  DDMgr_ptr dd     /* manager */,
+  int  n            /* number of nodes to be stored */,
+  bdd_ptr* f        /* array of nodes to be stored */,
+  FILE* fp          /* pointer to the store file */)
+{
+  return(Dddmp_cuddBddArrayStore(dd->dd, (char*) NULL, n, (DdNode**) f,
+                                 (char**) NULL, (char**) NULL, (int*) NULL,
+                                 DDDMP_MODE_BINARY, DDDMP_VARIDS,
+                                 (char*) NULL, fp) == DDDMP_SUCCESS);
+}
+
+int bdd_array_load(
+  DDMgr_ptr dd     /* manager */,
+  bdd_ptr** f       /* returned array of loaded nodes */,
+  FILE* fp          /* pointer to the store file */)
+{
+  DdNode** roots = (DdNode**) NULL;
+  boolean ok;
+  int num;
+  int i;
+
+  num = Dddmp_cuddBddArrayLoad(dd->dd, DDDMP_ROOT_MATCHLIST, (char**) NULL,
+                               DDDMP_VAR_MATCHIDS, (char**) NULL,
+                               (int*) NULL, (int*) NULL, DDDMP_MODE_BINARY,
+                               (char*) NULL, fp, &roots);
+
+  ok = (num > 0);
+  for (i = 0; ok && i < num; ++i) ok = ((DdNode*) NULL != roots[i]);
+
+  if (!ok) {
+    for (i = 0; i < num; ++i) {
+      if ((DdNode*) NULL != roots[i]) Cudd_RecursiveDeref(dd->dd, roots[i]);
+    }
+    FREE(roots);
+    return 0;
+  }
+
+  *f = (bdd_ptr*) roots;
+  return num;
+}
+
 bdd_ptr bdd_compose(DDMgr_ptr dd, bdd_ptr f, bdd_ptr g, int v)
 {
   const NuSMVEnv_ptr env = EnvObject_get_environment(ENV_OBJECT(dd));
@@ -2204,3 +2332,226 @@ static void InvalidType(FILE *file, char *field, char *expected)
     fprintf(file, "Illegal type detected. %s expected\n", expected);
 
 } /* end of InvalidType */
+
+/*!
+  \brief Picks one on-set minterm of fn, taking the random choices
+  from gen
+
+  Walks a path from fn to the constant one, and then assigns the
+  variables of vars which are not on the path. If uniform is false a
+  fair coin chooses the branch at each node, as done by
+  Cudd_bddPickOneMinterm. Otherwise the branches are chosen with
+  probability proportional to their number of minterms, so that all
+  the minterms of fn over vars are equally likely.
+
+  \sa bdd_pick_one_minterm_gen, bdd_pick_one_minterm_uniform
+*/
+static bdd_ptr dd_pick_one_minterm(DDMgr_ptr dd, bdd_ptr fn, bdd_ptr * vars,
+                                   int n, RandomGen_ptr gen,
+                                   boolean uniform)
+{
+  DdNode* one = DD_ONE(dd->dd);
+  DdNode* zero = Cudd_Not(one);
+  DdNode* node = (DdNode*)fn;
+  bdd_ptr result;
+  char* values;
+
+  if (bdd_is_false(dd, fn)) {
+    Cudd_Ref(fn);
+    return(fn);
+  }
+
+  if (uniform) dd_weights_check_cache(dd);
+
+  values = dd_alloc_values(dd);
+
+  /* walks a random path to the constant one */
+  while (! Cudd_IsConstant(node)) {
+    DdNode* N = Cudd_Regular(node);
+    DdNode* T = cuddT(N);
+    DdNode* E = cuddE(N);
+
+    if (Cudd_IsComplement(node)) {
+      T = Cudd_Not(T);
+      E = Cudd_Not(E);
+    }
+
+    if (T == zero) values[N->index] = 0;
+    else if (E == zero) values[N->index] = 1;
+    else if (uniform) {
+      values[N->index] = dd_weighted_coin(gen,
+                                          dd_minterm_density(dd, T),
+                                          dd_minterm_density(dd, E));
+    }
+    else values[N->index] = RandomGen_next_bit(gen) ? 1 : 0;
+
+    node = values[N->index] ? T : E;
+  }
+  nusmv_assert(node == one);
+
+  result = dd_values_to_cube(dd, values, vars, n, gen);
+  FREE(values);
+
+  return result;
+}
+
+/*!
+  \brief Returns the fraction of the assignments that satisfy node
+
+  The density does not depend on the set of variables. Densities of
+  the regular nodes are cached in the manager, see
+  dd_weights_check_cache.
+*/
+static double dd_minterm_density(DDMgr_ptr dd, DdNode* node)
+{
+  DdNode* N = Cudd_Regular(node);
+  double res;
+
+  if (Cudd_IsConstant(N)) {
+    res = (N == DD_ONE(dd->dd)) ? 1.0 : 0.0;
+  }
+  else {
+    const int index = NODE_TO_INT(find_assoc(dd->density_index, (node_ptr)N));
+
+    if (0 != index) res = dd->weights[index - 1];
+    else {
+      res = (dd_minterm_density(dd, cuddT(N)) +
+             dd_minterm_density(dd, cuddE(N))) / 2.0;
+      dd_weights_store(dd, dd->density_index, N, res);
+    }
+  }
+
+  return Cudd_IsComplement(node) ? 1.0 - res : res;
+}
+
+/*!
+  \brief Returns the average weight of the leaves of node, over all
+  the assignments
+
+  Leaves are weighted by dd->mass_fun. Masses are cached in the
+  manager, see dd_weights_check_cache.
+*/
+static double dd_add_mass(DDMgr_ptr dd, DdNode* node)
+{
+  double res;
+
+  if (Cudd_IsConstant(node)) {
+    res = dd->mass_fun((node_ptr)cuddV(node), dd->mass_arg);
+    nusmv_assert(res >= 0.0);
+  }
+  else {
+    const int index = NODE_TO_INT(find_assoc(dd->mass_index, (node_ptr)node));
+
+    if (0 != index) res = dd->weights[index - 1];
+    else {
+      res = (dd_add_mass(dd, cuddT(node)) +
+             dd_add_mass(dd, cuddE(node))) / 2.0;
+      dd_weights_store(dd, dd->mass_index, node, res);
+    }
+  }
+
+  return res;
+}
+
+/*!
+  \brief Empties the cached weights if they may be stale
+
+  The weights are bound to the nodes, which may be freed or moved by
+  garbage collections and reorderings.
+*/
+static void dd_weights_check_cache(DDMgr_ptr dd)
+{
+  if (dd->weights_gcs != Cudd_ReadGarbageCollections(dd->dd) ||
+      dd->weights_reorderings != Cudd_ReadReorderings(dd->dd)) {
+    clear_assoc(dd->density_index);
+    clear_assoc(dd->mass_index);
+    dd->weights_num = 0;
+    dd->weights_gcs = Cudd_ReadGarbageCollections(dd->dd);
+    dd->weights_reorderings = Cudd_ReadReorderings(dd->dd);
+  }
+}
+
+/*!
+  \brief Caches the weight of node in the given index
+*/
+static void dd_weights_store(DDMgr_ptr dd, hash_ptr index, DdNode* node,
+                             double weight)
+{
+  if (dd->weights_num == dd->weights_size) {
+    dd->weights_size = (0 == dd->weights_size) ? 1024 : 2 * dd->weights_size;
+    dd->weights = REALLOC(double, dd->weights, dd->weights_size);
+    nusmv_assert((double*)NULL != dd->weights);
+  }
+
+  dd->weights[dd->weights_num] = weight;
+  dd->weights_num++;
+  insert_assoc(index, (node_ptr)node, NODE_FROM_INT(dd->weights_num));
+}
+
+/*!
+  \brief Returns 1 with probability t / (t + e), 0 otherwise
+
+  Both weights may underflow on very deep diagrams, in which case a
+  fair coin is used.
+*/
+static char dd_weighted_coin(RandomGen_ptr gen, double t, double e)
+{
+  if (0.0 == t + e) return RandomGen_next_bit(gen) ? 1 : 0;
+
+  return (RandomGen_next_double(gen) * (t + e) < t) ? 1 : 0;
+}
+
+/*!
+  \brief Allocates the values of the variables of a picked path
+
+  0 and 1 are the values of the variables on the path, 2 (the initial
+  value) marks the variables the path does not depend on. The
+  returned array must be freed by the caller.
+*/
+static char* dd_alloc_values(DDMgr_ptr dd)
+{
+  const NuSMVEnv_ptr env = EnvObject_get_environment(ENV_OBJECT(dd));
+  const ErrorMgr_ptr errmgr =
+    ERROR_MGR(NuSMVEnv_get_value(env, ENV_ERROR_MANAGER));
+  char* values = ALLOC(char, Cudd_ReadSize(dd->dd));
+  int i;
+
+  common_error(errmgr, values, "dd_alloc_values: values = NULL");
+  for (i = 0; i < Cudd_ReadSize(dd->dd); i++) values[i] = 2;
+
+  return values;
+}
+
+/*!
+  \brief Builds the minterm over vars given by values
+
+  The variables not on the picked path get a random value from
+  gen. Returned bdd is referenced.
+*/
+static bdd_ptr dd_values_to_cube(DDMgr_ptr dd, char* values,
+                                 bdd_ptr * vars, int n, RandomGen_ptr gen)
+{
+  const NuSMVEnv_ptr env = EnvObject_get_environment(ENV_OBJECT(dd));
+  const ErrorMgr_ptr errmgr =
+    ERROR_MGR(NuSMVEnv_get_value(env, ENV_ERROR_MANAGER));
+  DdNode* result = DD_ONE(dd->dd);
+  int i;
+
+  Cudd_Ref(result);
+
+  for (i = n - 1; i >= 0; i--) {
+    DdNode* var = (DdNode*)vars[i];
+    const int index = Cudd_NodeReadIndex(var);
+    DdNode* tmp;
+
+    if (2 == values[index]) values[index] = RandomGen_next_bit(gen) ? 1 : 0;
+
+    tmp = Cudd_bddAnd(dd->dd, values[index] ? var : Cudd_Not(var), result);
+    common_error(errmgr, tmp, "dd_values_to_cube: result = NULL");
+    Cudd_Ref(tmp);
+    Cudd_RecursiveDeref(dd->dd, result);
+    result = tmp;
+  }
+
+  return((bdd_ptr)result);
+}
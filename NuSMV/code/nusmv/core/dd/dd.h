@@ -47,6 +47,7 @@
 #include "nusmv/core/utils/utils.h"
 #include "nusmv/core/utils/array.h"
 #include "nusmv/core/utils/avl.h"
+#include "nusmv/core/utils/RandomGen.h"
 #include "nusmv/core/node/node.h"
 #include "cudd/cudd.h"
 #include "nusmv/core/opt/OptsHandler.h"
@@ -108,6 +109,15 @@ typedef add_ptr (*FP_A_DAA)(DDMgr_ptr , add_ptr, add_ptr);
 
 typedef node_ptr (*NPFNNE)(node_ptr, node_ptr, const NuSMVEnv_ptr);
 
+/*!
+  \brief Returns the non-negative weight of an add leaf
+
+  The second argument is passed unchanged by the caller.
+
+  \sa add_pick_one_minterm_weighted
+*/
+typedef double (*DPFNV)(node_ptr, void*);
+
 /*!
   \brief \todo Missing synopsis
 
@@ -1614,6 +1624,54 @@ bdd_ptr  bdd_pick_one_minterm(DDMgr_ptr , bdd_ptr, bdd_ptr *, int);
 */
 bdd_ptr  bdd_pick_one_minterm_rand(DDMgr_ptr , bdd_ptr, bdd_ptr *, int);
 
+/*!
+  \brief Picks one on-set minterm from the given DD using the given
+  generator.
+
+  Same as bdd_pick_one_minterm_rand, but the random choices are taken
+  from gen instead of the generator of CUDD, so that the picked
+  minterm only depends on the state of gen. The minterm is in terms of
+  vars, that must contain the support of fn.
+
+  \sa bdd_pick_one_minterm_rand
+*/
+bdd_ptr  bdd_pick_one_minterm_gen(DDMgr_ptr , bdd_ptr, bdd_ptr *, int,
+                                  RandomGen_ptr);
+
+/*!
+  \brief Picks one on-set minterm of the given DD uniformly at random.
+
+  Like bdd_pick_one_minterm_gen, but at each node the branch is
+  chosen with probability proportional to the number of its
+  minterms, so that every minterm of fn over vars has the same
+  probability to be picked. The fraction of satisfying assignments of
+  every visited node is cached in the manager, and is kept among
+  calls until the next garbage collection or reordering, so repeated
+  picks only cost a walk from the root to the constant.
+
+  \sa bdd_pick_one_minterm_gen
+*/
+bdd_ptr  bdd_pick_one_minterm_uniform(DDMgr_ptr , bdd_ptr, bdd_ptr *, int,
+                                      RandomGen_ptr);
+
+/*!
+  \brief Picks one minterm of the given ADD with probability
+  proportional to its leaf.
+
+  The leaves of fn are mapped to non-negative weights by weight,
+  which is called with arg as second argument, and every minterm over
+  vars is picked with probability proportional to the weight of its
+  leaf. The support of fn must be contained in vars. Returns the false
+  bdd if all the leaves have weight zero. Like
+  bdd_pick_one_minterm_uniform, the average weights of the visited
+  nodes are cached in the manager until the next garbage collection or
+  reordering, or until a different weight function is used.
+
+  \sa bdd_pick_one_minterm_uniform
+*/
+bdd_ptr  add_pick_one_minterm_weighted(DDMgr_ptr , add_ptr, DPFNV, void*,
+                                       bdd_ptr *, int, RandomGen_ptr);
+
 /*!
   \brief Returns the array of All Possible Minterms
 
@@ -1720,6 +1778,29 @@ bdd_ptr  bdd_cube_union(DDMgr_ptr , bdd_ptr, bdd_ptr);
 */
 bdd_ptr  bdd_cube_intersection(DDMgr_ptr , bdd_ptr, bdd_ptr);
 
+/*!
+  \brief Converts a BDD cube into an array of literals.
+
+  Fills array, which must have dd_get_size(dd) entries, with
+  the literals of cube indexed by variable index: 0 for a negative
+  literal, 1 for a positive literal and 2 for a variable not occurring
+  in the cube. Returns false if the BDD is not a cube.
+
+  \sa bdd_from_cube_array
+*/
+boolean  bdd_to_cube_array(DDMgr_ptr , bdd_ptr, int*);
+
+/*!
+  \brief Builds the BDD cube described by an array of literals.
+
+  array must have dd_get_size(dd) entries, with the same
+  meaning as in bdd_to_cube_array. Returns a pointer to the resulting
+  cube; a failure is generated otherwise.
+
+  \sa bdd_to_cube_array
+*/
+bdd_ptr  bdd_from_cube_array(DDMgr_ptr , int*);
+
 /*!
   \brief Returns the index of the lowest variable in the BDD a.
 
@@ -1832,6 +1913,35 @@ int      bdd_DumpBlif(DDMgr_ptr dd, int n, bdd_ptr *f, char **inames, char **ona
 */
 int      bdd_DumpBlifBody(DDMgr_ptr dd, int n, bdd_ptr *f, char **inames, char **onames, FILE *fp);
 
+/*!
+  \brief Stores an array of BDDs in dddmp binary format
+
+  Writes the n BDDs in f on fp by means of the dddmp
+  library. Variables are identified by their index, so the file can
+  be loaded back only by a manager where indices denote the same
+  variables. It returns 1 in case of success; 0 otherwise. The file is
+  not closed.
+
+  \se None
+
+  \sa bdd_array_load
+*/
+int      bdd_array_store(DDMgr_ptr dd, int n, bdd_ptr *f, FILE *fp);
+
+/*!
+  \brief Loads an array of BDDs stored by bdd_array_store
+
+  Reads from fp the BDDs stored by bdd_array_store and returns
+  their number, or 0 in case of error (e.g. malformed file). On
+  success *f is set to a newly allocated array holding the referenced
+  BDDs, which the caller has to free. The file is not closed.
+
+  \se None
+
+  \sa bdd_array_store
+*/
+int      bdd_array_load(DDMgr_ptr dd, bdd_ptr **f, FILE *fp);
+
 /*!
   \brief Determines whether f is less than or equal to g.
 
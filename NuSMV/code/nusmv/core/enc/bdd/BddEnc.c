@@ -362,6 +362,13 @@ static void bdd_enc_range_check(DDMgr_ptr dd, node_ptr node);
 static add_ptr lazy_commit_layer_and_get_add(BddEnc_ptr self,
                                              node_ptr name, int type);
 
+static bdd_ptr bdd_enc_pick_one_minterm_rand(const BddEnc_ptr self,
+                                             bdd_ptr fn,
+                                             array_t* vars,
+                                             int vars_dim,
+                                             RandomGen_ptr gen,
+                                             boolean uniform);
+
 /*---------------------------------------------------------------------------*/
 /* Definition of exported functions                                          */
 /*---------------------------------------------------------------------------*/
@@ -1681,32 +1688,78 @@ boolean BddEnc_pick_all_terms_inputs(const BddEnc_ptr self, bdd_ptr bdd,
   return res == 1;
 }
 
-bdd_ptr BddEnc_pick_one_state_rand(const BddEnc_ptr self, bdd_ptr states)
+bdd_ptr BddEnc_pick_one_state_rand(const BddEnc_ptr self, bdd_ptr states,
+                                   RandomGen_ptr gen)
 {
   BDD_ENC_CHECK_INSTANCE(self);
 
-  return bdd_pick_one_minterm_rand(self->dd, states,
-                                   array_fetch_p(bdd_ptr, self->minterm_state_frozen_vars, 0),
-                                   self->minterm_state_frozen_vars_dim);
+  return bdd_enc_pick_one_minterm_rand(self, states,
+                                       self->minterm_state_frozen_vars,
+                                       self->minterm_state_frozen_vars_dim,
+                                       gen, false);
 }
 
-bdd_ptr BddEnc_pick_one_input_rand(const BddEnc_ptr self, bdd_ptr inputs)
+bdd_ptr BddEnc_pick_one_input_rand(const BddEnc_ptr self, bdd_ptr inputs,
+                                   RandomGen_ptr gen)
 {
   BDD_ENC_CHECK_INSTANCE(self);
 
-  return bdd_pick_one_minterm_rand(self->dd, inputs,
-                                   array_fetch_p(bdd_ptr, self->minterm_input_vars, 0),
-                                   self->minterm_input_vars_dim);
+  return bdd_enc_pick_one_minterm_rand(self, inputs,
+                                       self->minterm_input_vars,
+                                       self->minterm_input_vars_dim,
+                                       gen, false);
 }
 
 bdd_ptr BddEnc_pick_one_input_state_rand(const BddEnc_ptr self,
-                                         bdd_ptr inputs_states)
+                                         bdd_ptr inputs_states,
+                                         RandomGen_ptr gen)
 {
   BDD_ENC_CHECK_INSTANCE(self);
 
-  return bdd_pick_one_minterm_rand(self->dd, inputs_states,
-                                   array_fetch_p(bdd_ptr, self->minterm_state_frozen_input_vars, 0),
-                                   self->minterm_state_frozen_input_vars_dim);
+  return bdd_enc_pick_one_minterm_rand(self, inputs_states,
+                                       self->minterm_state_frozen_input_vars,
+                                       self->minterm_state_frozen_input_vars_dim,
+                                       gen, false);
+}
+
+bdd_ptr BddEnc_pick_one_state_uniform(const BddEnc_ptr self, bdd_ptr states,
+                                      RandomGen_ptr gen)
+{
+  BDD_ENC_CHECK_INSTANCE(self);
+  RANDOM_GEN_CHECK_INSTANCE(gen);
+
+  return bdd_enc_pick_one_minterm_rand(self, states,
+                                       self->minterm_state_frozen_vars,
+                                       self->minterm_state_frozen_vars_dim,
+                                       gen, true);
+}
+
+bdd_ptr BddEnc_pick_one_input_uniform(const BddEnc_ptr self, bdd_ptr inputs,
+                                      RandomGen_ptr gen)
+{
+  BDD_ENC_CHECK_INSTANCE(self);
+  RANDOM_GEN_CHECK_INSTANCE(gen);
+
+  return bdd_enc_pick_one_minterm_rand(self, inputs,
+                                       self->minterm_input_vars,
+                                       self->minterm_input_vars_dim,
+                                       gen, true);
+}
+
+bdd_ptr BddEnc_pick_one_input_weighted(const BddEnc_ptr self, add_ptr weights,
+                                       DPFNV weight, void* arg,
+                                       RandomGen_ptr gen)
+{
+  bdd_ptr* vars_array;
+
+  BDD_ENC_CHECK_INSTANCE(self);
+  RANDOM_GEN_CHECK_INSTANCE(gen);
+
+  vars_array = array_fetch_p(bdd_ptr, self->minterm_input_vars, 0);
+
+  return add_pick_one_minterm_weighted(self->dd, weights, weight, arg,
+                                       vars_array,
+                                       self->minterm_input_vars_dim, gen);
 }
 
 node_ptr BddEnc_get_var_name_from_index(const BddEnc_ptr self, int index)
@@ -6715,6 +6768,35 @@ static void bdd_enc_failure_node_check(DDMgr_ptr dd, node_ptr node)
   Utils_failure_node_check(env, node);
 }
 
+/*!
+  \brief Picks a random minterm of fn over the given variables
+
+  The random choices are taken from gen if not NULL, from the
+  generator of the DD package otherwise. If uniform is true all the
+  minterms are equally likely, and gen cannot be NULL.
+*/
+static bdd_ptr bdd_enc_pick_one_minterm_rand(const BddEnc_ptr self,
+                                             bdd_ptr fn,
+                                             array_t* vars,
+                                             int vars_dim,
+                                             RandomGen_ptr gen,
+                                             boolean uniform)
+{
+  bdd_ptr* vars_array = array_fetch_p(bdd_ptr, vars, 0);
+
+  if ((RandomGen_ptr)NULL == gen) {
+    nusmv_assert(!uniform);
+    return bdd_pick_one_minterm_rand(self->dd, fn, vars_array, vars_dim);
+  }
+
+  if (uniform) {
+    return bdd_pick_one_minterm_uniform(self->dd, fn, vars_array, vars_dim,
+                                        gen);
+  }
+
+  return bdd_pick_one_minterm_gen(self->dd, fn, vars_array, vars_dim, gen);
+}
+
 /*!
   \brief Aux routine for Utils_range_check
 
@@ -871,10 +871,14 @@ BddEnc_pick_all_terms_inputs(const BddEnc_ptr self, bdd_ptr bdd,
 
    Note: states are represented by state and frozen variables.
 
-  \sa bdd_pick_one_minterm_rand
+   The random choices are taken from gen, or from the generator of
+   the DD package if gen is NULL.
+
+  \sa bdd_pick_one_minterm_rand, bdd_pick_one_minterm_gen
 */
 bdd_ptr
-BddEnc_pick_one_state_rand(const BddEnc_ptr self, bdd_ptr states);
+BddEnc_pick_one_state_rand(const BddEnc_ptr self, bdd_ptr states,
+                           RandomGen_ptr gen);
 
 /*!
   \methodof BddEnc
@@ -883,10 +887,14 @@ BddEnc_pick_one_state_rand(const BddEnc_ptr self, bdd_ptr states);
   Extracts a random minterm from a given BDD.
    Returned bdd is referenced
 
-  \sa bdd_pick_one_minterm_rand
+   The random choices are taken from gen, or from the generator of
+   the DD package if gen is NULL.
+
+  \sa bdd_pick_one_minterm_rand, bdd_pick_one_minterm_gen
 */
 bdd_ptr
-BddEnc_pick_one_input_rand(const BddEnc_ptr self, bdd_ptr inputs);
+BddEnc_pick_one_input_rand(const BddEnc_ptr self, bdd_ptr inputs,
+                           RandomGen_ptr gen);
 
 /*!
   \methodof BddEnc
@@ -897,12 +905,61 @@ BddEnc_pick_one_input_rand(const BddEnc_ptr self, bdd_ptr inputs);
 
    Note: input-states are represented by input, state and frozen variables.
 
-  \sa bdd_pick_one_minterm_rand,
+   The random choices are taken from gen, or from the generator of
+   the DD package if gen is NULL.
+
+  \sa bdd_pick_one_minterm_rand, bdd_pick_one_minterm_gen,
                        BddEnc_pick_one_input_rand, BddEnc_pick_one_state_rand
 */
 bdd_ptr
 BddEnc_pick_one_input_state_rand(const BddEnc_ptr self,
-                                 bdd_ptr inputs_states);
+                                 bdd_ptr inputs_states,
+                                 RandomGen_ptr gen);
+
+/*!
+  \methodof BddEnc
+  \brief Extracts a minterm from a given BDD uniformly at random.
+
+  Like BddEnc_pick_one_state_rand, but all the states in states
+  have the same probability to be picked. gen cannot be NULL.
+   Returned bdd is referenced.
+
+  \sa bdd_pick_one_minterm_uniform, BddEnc_pick_one_state_rand
+*/
+bdd_ptr
+BddEnc_pick_one_state_uniform(const BddEnc_ptr self, bdd_ptr states,
+                              RandomGen_ptr gen);
+
+/*!
+  \methodof BddEnc
+  \brief Extracts a minterm from a given BDD uniformly at random.
+
+  Like BddEnc_pick_one_input_rand, but all the inputs in inputs
+  have the same probability to be picked. gen cannot be NULL.
+   Returned bdd is referenced.
+
+  \sa bdd_pick_one_minterm_uniform, BddEnc_pick_one_input_rand
+*/
+bdd_ptr
+BddEnc_pick_one_input_uniform(const BddEnc_ptr self, bdd_ptr inputs,
+                              RandomGen_ptr gen);
+
+/*!
+  \methodof BddEnc
+  \brief Extracts an input from a given ADD, with probability
+  proportional to its leaf.
+
+  The leaves of weights, an ADD over the input variables, are mapped
+  to non-negative weights by weight (called with arg). Returns the
+  false bdd if all the inputs have weight zero. gen cannot be NULL.
+   Returned bdd is referenced.
+
+  \sa add_pick_one_minterm_weighted, BddEnc_pick_one_input_uniform
+*/
+bdd_ptr
+BddEnc_pick_one_input_weighted(const BddEnc_ptr self, add_ptr weights,
+                               DPFNV weight, void* arg,
+                               RandomGen_ptr gen);
 
 /*!
   \methodof BddEnc
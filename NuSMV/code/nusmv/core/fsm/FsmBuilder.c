@@ -57,6 +57,7 @@
 #include "nusmv/core/utils/EnvObject.h"
 #include "nusmv/core/utils/EnvObject_private.h"
 #include "nusmv/core/fsm/bdd/FairnessList.h"
+#include "nusmv/core/fsm/bdd/BddModelCache.h"
 #include "nusmv/core/parser/symbols.h"
 #include "nusmv/core/parser/idlist/ParserIdList.h" /* to parse trans ordering file */
 #include "nusmv/core/compile/compile.h"
@@ -397,6 +398,9 @@ BddFsm_ptr FsmBuilder_create_bdd_fsm_of_vars(const FsmBuilder_ptr self,
   bdd_ptr init_bdd, invar_bdd, input_bdd;
   SymbTable_ptr st = BaseEnc_get_symb_table(BASE_ENC(enc));
   Set_t vars = SexpFsm_get_vars(sexp_fsm);
+  Expr_ptr trans_expr;
+  char* cache_prefix;
+  ClusterList_ptr forward, backward;
 
   FSM_BUILDER_CHECK_INSTANCE(self);
 
@@ -426,10 +430,7 @@ BddFsm_ptr FsmBuilder_create_bdd_fsm_of_vars(const FsmBuilder_ptr self,
   /* ---------------------------------------------------------------------- */
   { /* here the trans is constructed out of the vars fsm, to make
        it ordered wrt the obtained ordered vars set */
-    ClusterList_ptr clusters;
-    ClusterOptions_ptr cluster_options;
     Set_t sorted_vars;
-    Expr_ptr trans_expr;
     Set_Iterator_t iter;
 
     sorted_vars = fsm_builder_order_vars_list(self, enc,
@@ -454,6 +455,29 @@ BddFsm_ptr FsmBuilder_create_bdd_fsm_of_vars(const FsmBuilder_ptr self,
       }
       Set_ReleaseSet(deps);
     }
+  }
+
+  /* the on-disk model cache, if enabled, replaces the construction
+     of the clusters and of init and invariants */
+  cache_prefix = BddModelCache_get_prefix(enc,
+                                          SexpFsm_get_init(sexp_fsm),
+                                          SexpFsm_get_invar(sexp_fsm),
+                                          SexpFsm_get_input(sexp_fsm),
+                                          trans_expr, trans_type);
+
+  if ((char*) NULL != cache_prefix &&
+      BddModelCache_load_model(enc, cache_prefix,
+                               &init_bdd, &invar_bdd, &input_bdd,
+                               &forward, &backward)) {
+    trans = BddTrans_create_partitioned(dd_manager, forward, backward,
+                                        (bdd_ptr) state_vars_cube,
+                                        (bdd_ptr) input_vars_cube,
+                                        (bdd_ptr) next_state_vars_cube,
+                                        trans_type);
+  }
+  else {
+    ClusterList_ptr clusters;
+    ClusterOptions_ptr cluster_options;
 
     /* clusters construction */
     clusters = fsm_builder_clusterize_expr(self, enc, trans_expr);
@@ -469,6 +493,18 @@ BddFsm_ptr FsmBuilder_create_bdd_fsm_of_vars(const FsmBuilder_ptr self,
 
     ClusterList_destroy(clusters);
     ClusterOptions_destroy(cluster_options); /* this is no longer needed */
+
+    /* init */
+    init_bdd = BddEnc_expr_to_bdd(enc, SexpFsm_get_init(sexp_fsm), Nil);
+    /* invar */
+    invar_bdd = BddEnc_expr_to_bdd(enc, SexpFsm_get_invar(sexp_fsm), Nil);
+    /* input */
+    input_bdd = BddEnc_expr_to_bdd(enc, SexpFsm_get_input(sexp_fsm), Nil);
+
+    if ((char*) NULL != cache_prefix) {
+      BddModelCache_store_model(enc, cache_prefix,
+                                init_bdd, invar_bdd, input_bdd, trans);
+    }
   }
 
 
@@ -481,13 +517,6 @@ BddFsm_ptr FsmBuilder_create_bdd_fsm_of_vars(const FsmBuilder_ptr self,
   compassion = fsm_builder_compassion_sexp_to_bdd(self, enc,
                                         SexpFsm_get_compassion(sexp_fsm));
 
-  /* init */
-  init_bdd = BddEnc_expr_to_bdd(enc, SexpFsm_get_init(sexp_fsm), Nil);
-  /* invar */
-  invar_bdd = BddEnc_expr_to_bdd(enc, SexpFsm_get_invar(sexp_fsm), Nil);
-  /* input */
-  input_bdd = BddEnc_expr_to_bdd(enc, SexpFsm_get_input(sexp_fsm), Nil);
-
   bddfsm = BddFsm_create(enc,
                          BDD_STATES(init_bdd),
                          BDD_INVAR_STATES(invar_bdd),
@@ -499,6 +528,12 @@ BddFsm_ptr FsmBuilder_create_bdd_fsm_of_vars(const FsmBuilder_ptr self,
   bdd_free(dd_manager, invar_bdd);
   bdd_free(dd_manager, init_bdd);
 
+  if ((char*) NULL != cache_prefix) {
+    BddModelCache_load_reachable(bddfsm, cache_prefix);
+    BddFsm_set_model_cache(bddfsm, cache_prefix);
+    FREE(cache_prefix);
+  }
+
 #if SHOW_BUG_ABOUT_4870
   fsm_builder_insert_bdd_fsm(self, sexp_fsm,
                              SexpFsm_get_vars(sexp_fsm),
@@ -46,6 +46,7 @@
 #include "nusmv/core/fsm/bdd/bddInt.h"
 #include "nusmv/core/fsm/bdd/BddFsm.h"
 #include "nusmv/core/fsm/bdd/FairnessList.h"
+#include "nusmv/core/fsm/bdd/BddModelCache.h"
 
 #include "nusmv/core/utils/OStream.h"
 #include "nusmv/core/utils/StreamMgr.h"
@@ -90,6 +91,11 @@ static void bdd_fsm_deinit(BddFsm_ptr self);
 
 static void bdd_fsm_compute_reachable_states(BddFsm_ptr self);
 
+static void bdd_fsm_rebuild_reachable_layer(const BddFsm_ptr self,
+                                            int distance);
+
+static void bdd_fsm_keep_all_reachable_frontiers(const BddFsm_ptr self);
+
 static BddStatesInputs
 bdd_fsm_get_legal_state_input(BddFsm_ptr self);
 
@@ -164,6 +170,38 @@ BddFsm_ptr BddFsm_copy(const BddFsm_ptr self)
 }
 
 
+void BddFsm_set_model_cache(BddFsm_ptr self, const char* prefix)
+{
+  BDD_FSM_CHECK_INSTANCE(self);
+
+  if ((char*) NULL != self->model_cache) FREE(self->model_cache);
+  self->model_cache = ((char*) NULL != prefix) ?
+    util_strsav((char*) prefix) : (char*) NULL;
+}
+
+
+bdd_ptr BddFsm_get_cached_formula_states(BddFsm_ptr self, node_ptr key)
+{
+  BDD_FSM_CHECK_INSTANCE(self);
+
+  return BddFsmCache_get_formula_states(self->cache, key);
+}
+
+
+void BddFsm_cache_formula_states(BddFsm_ptr self, node_ptr key,
+                                 bdd_ptr states)
+{
+  const NuSMVEnv_ptr env = EnvObject_get_environment(ENV_OBJECT(self->enc));
+  const OptsHandler_ptr opts =
+    OPTS_HANDLER(NuSMVEnv_get_value(env, ENV_OPTS_HANDLER));
+
+  BDD_FSM_CHECK_INSTANCE(self);
+
+  BddFsmCache_set_formula_states(self->cache, key, states,
+                                 (long) get_ctl_cache_size(opts));
+}
+
+
 void BddFsm_copy_cache(BddFsm_ptr self, const BddFsm_ptr other,
                        boolean keep_family)
 {
@@ -171,7 +209,10 @@ void BddFsm_copy_cache(BddFsm_ptr self, const BddFsm_ptr other,
 
   BddFsmCache_destroy(self->cache);
   if (keep_family) self->cache = BddFsmCache_soft_copy(other->cache);
-  else self->cache = BddFsmCache_hard_copy(other->cache);
+  else {
+    bdd_fsm_keep_all_reachable_frontiers(other);
+    self->cache = BddFsmCache_hard_copy(other->cache);
+  }
 }
 
 
@@ -238,18 +279,53 @@ BddEnc_ptr BddFsm_get_bdd_encoding(const BddFsm_ptr self)
 
 
 boolean BddFsm_get_cached_reachable_states(const BddFsm_ptr self,
-                                           BddStates** layers,
                                            int* size)
 {
   BDD_FSM_CHECK_INSTANCE(self);
 
-  *layers = CACHE_GET(reachable.layers);
   *size = CACHE_GET(reachable.diameter);
 
   return CACHE_GET(reachable.computed);
 }
 
 
+BddStates BddFsm_get_cached_reachable_layer(const BddFsm_ptr self,
+                                            int distance)
+{
+  int step;
+
+  BDD_FSM_CHECK_INSTANCE(self);
+  nusmv_assert(0 <= distance && distance < CACHE_GET(reachable.diameter));
+
+  step = CACHE_GET(reachable.step);
+  if (distance == CACHE_GET(reachable.diameter) - 1) {
+    return CACHE_GET_BDD(reachable.last);
+  }
+  if (step > 1 && 0 == (distance % step)) {
+    return CACHE_GET_BDD(reachable.checkpoints[distance / step]);
+  }
+  if (0 == distance) return CACHE_GET_BDD(reachable.frontiers[0]);
+
+  bdd_fsm_rebuild_reachable_layer(self, distance);
+  return CACHE_GET_BDD(reachable.memo_layer);
+}
+
+
+BddStates BddFsm_get_cached_reachable_frontier(const BddFsm_ptr self,
+                                               int distance)
+{
+  BDD_FSM_CHECK_INSTANCE(self);
+  nusmv_assert(0 <= distance && distance < CACHE_GET(reachable.diameter));
+
+  if (!CACHE_IS_EQUAL(reachable.frontiers[distance], BDD_STATES(NULL))) {
+    return CACHE_GET_BDD(reachable.frontiers[distance]);
+  }
+
+  bdd_fsm_rebuild_reachable_layer(self, distance);
+  return CACHE_GET_BDD(reachable.memo_frontier);
+}
+
+
 void BddFsm_set_reachable_states(const BddFsm_ptr self,
                                  BddStates reachable)
 {
@@ -276,6 +352,18 @@ void BddFsm_update_cached_reachable_states(const BddFsm_ptr self,
 }
 
 
+void BddFsm_update_cached_reachable_frontiers(const BddFsm_ptr self,
+                                              node_ptr frontiers,
+                                              int size,
+                                              boolean completed)
+{
+  BDD_FSM_CHECK_INSTANCE(self);
+
+  BddFsmCache_add_reachable_frontiers(self->cache, frontiers, size,
+                                      completed);
+}
+
+
 boolean BddFsm_reachable_states_computed(BddFsm_ptr self)
 {
   BDD_FSM_CHECK_INSTANCE(self);
@@ -304,7 +392,7 @@ BddStates BddFsm_get_reachable_states(BddFsm_ptr self)
     }
 
     if (CACHE_GET(reachable.diameter) > 0) {
-      res = CACHE_GET(reachable.layers[CACHE_GET(reachable.diameter) - 1]);
+      res = CACHE_GET(reachable.last);
     }
     else {
       res = bdd_false(self->dd);
@@ -336,6 +424,9 @@ void BddFsm_copy_reachable_states(BddFsm_ptr self, BddFsm_ptr other,
     self->cache = new_cache;
   }
 
+  /* dropped frontiers can only be rebuilt with the transition
+     relation of other */
+  bdd_fsm_keep_all_reachable_frontiers(other);
   BddFsmCache_copy_reachables(self->cache, other->cache);
 }
 
@@ -361,20 +452,7 @@ BddStates BddFsm_get_reachable_states_at_distance(BddFsm_ptr self,
     /* checks distance */
     nusmv_assert(distance < diameter);
 
-    res = CACHE_GET_BDD(reachable.layers[distance]);
-    /* Compute the distance-th frontier if we are not looking for the
-       initial state */
-    if (distance >= 1) {
-      bdd_ptr x, neg;
-
-      x = CACHE_GET_BDD(reachable.layers[distance - 1]);
-      neg = bdd_not(self->dd, x);
-
-      bdd_and_accumulate(self->dd, &res, neg);
-
-      bdd_free(self->dd, x);
-      bdd_free(self->dd, neg);
-    }
+    res = BddFsm_get_cached_reachable_frontier(self, distance);
   }
 
   /* checks if assigned: */
@@ -610,6 +688,57 @@ BddFsm_get_constrained_forward_image(const BddFsm_ptr self,
 }
 
 
+BddStates BddFsm_get_concrete_forward_image(const BddFsm_ptr self,
+                                            BddStates state)
+{
+  BddStatesInputs one = bdd_true(self->dd);
+  BddStates res;
+
+  BDD_FSM_CHECK_INSTANCE(self);
+
+  res = BddFsm_get_constrained_concrete_forward_image(self, state, one);
+  bdd_free(self->dd, one);
+
+  return res;
+}
+
+
+BddStates
+BddFsm_get_constrained_concrete_forward_image(const BddFsm_ptr self,
+                                              BddStates state,
+                                              BddStatesInputsNexts constraints)
+{
+  BddStates res;
+  bdd_ptr constr_trans;
+  bdd_ptr tmp;
+
+  BDD_FSM_CHECK_INSTANCE(self);
+
+  /* ------------------------------------------------------------ */
+  /* Apply invariant contraints, each one restricted to state: */
+  constr_trans = bdd_cofactor(self->dd, self->invar_states, state);
+
+  tmp = bdd_cofactor(self->dd, self->invar_inputs, state);
+  bdd_and_accumulate(self->dd, &constr_trans, tmp);
+  bdd_free(self->dd, tmp);
+
+  tmp = bdd_cofactor(self->dd, constraints, state);
+  bdd_and_accumulate(self->dd, &constr_trans, tmp);
+  bdd_free(self->dd, tmp);
+  /* ------------------------------------------------------------ */
+
+  tmp = BddTrans_get_forward_image_state_cube(self->trans, state,
+                                              constr_trans);
+  bdd_free(self->dd, constr_trans);
+
+  res = BDD_STATES( BddEnc_next_state_var_to_state_var(self->enc, tmp) );
+  bdd_free(self->dd, tmp);
+
+  bdd_and_accumulate(self->dd, (bdd_ptr*) &res, self->invar_states);
+  return res;
+}
+
+
 BddStates
 BddFsm_get_sins_constrained_forward_image(const BddFsm_ptr self,
                                           BddStates states,
@@ -971,11 +1100,10 @@ boolean BddFsm_expand_cached_reachable_states(BddFsm_ptr self,
   bdd_ptr reachable_states_bdd;
   bdd_ptr from_lower_bound;   /* the frontier */
   bdd_ptr invars;
-  node_ptr reachable_states_layers;
+  node_ptr reachable_states_frontiers;
 
   int diameter;
   boolean completed;
-  BddStates* layers;
   boolean result;
 
   long start_time;
@@ -995,16 +1123,15 @@ boolean BddFsm_expand_cached_reachable_states(BddFsm_ptr self,
   /* Transform max_seconds in milliseconds */
   limit_time = max_seconds * 1000;
 
-  /* Initialize the layers list */
-  reachable_states_layers = Nil;
+  /* Initialize the frontiers list. Only the frontiers that are not
+     cached yet are collected */
+  reachable_states_frontiers = Nil;
 
   /* Get the cache */
-  completed = BddFsm_get_cached_reachable_states(self, &layers, &diameter);
+  completed = BddFsm_get_cached_reachable_states(self, &diameter);
 
   /* Reload cache if any */
   if (diameter > 0) {
-    int i;
-
     if (completed) {
       return true; /* already ready */
     }
@@ -1012,31 +1139,13 @@ boolean BddFsm_expand_cached_reachable_states(BddFsm_ptr self,
       /* The cached analysis is not complete, so we have to resume the
          last state */
 
-      /* Regen the list */
-      for (i=0; i<diameter; i++) {
-        reachable_states_layers =
-          cons(nodemgr, (node_ptr) bdd_dup(layers[i]), reachable_states_layers);
-      }
-
       /* Last layer contains the last reachable set */
-      reachable_states_bdd = bdd_dup(layers[diameter - 1]);
+      reachable_states_bdd =
+        BddFsm_get_cached_reachable_layer(self, diameter - 1);
 
       /* Get the last frontier */
-      if (diameter > 1) {
-        /* Compute the last frontier*/
-        bdd_ptr tmp;
-
-        tmp = bdd_not(self->dd, layers[diameter - 2]);
-        from_lower_bound = bdd_and(self->dd,
-                                   reachable_states_bdd,
-                                   tmp);
-        bdd_free(self->dd, tmp);
-      }
-      else {
-        /* We computed only the init state, so the frontier is the
-           init itself */
-        from_lower_bound = bdd_dup(layers[0]);
-      }
+      from_lower_bound =
+        BddFsm_get_cached_reachable_frontier(self, diameter - 1);
     }
   }
   else {
@@ -1052,14 +1161,15 @@ boolean BddFsm_expand_cached_reachable_states(BddFsm_ptr self,
     from_lower_bound = bdd_dup(reachable_states_bdd);
 
     if (bdd_isnot_false(self->dd, reachable_states_bdd)) {
-      reachable_states_layers =
-        cons(nodemgr, (node_ptr) bdd_dup(reachable_states_bdd), reachable_states_layers);
+      reachable_states_frontiers =
+        cons(nodemgr, (node_ptr) bdd_dup(reachable_states_bdd),
+             reachable_states_frontiers);
 
       diameter = 1;
     }
     else {
       /* If the initial region is empty then diameter is 0 */
-      reachable_states_layers = Nil;
+      reachable_states_frontiers = Nil;
       diameter = 0;
     }
   }
@@ -1136,9 +1246,10 @@ boolean BddFsm_expand_cached_reachable_states(BddFsm_ptr self,
     /* increment the diameter */
     ++diameter;
 
-    /* Update the reachable list */
-    reachable_states_layers =
-      cons(nodemgr, (node_ptr) bdd_dup(reachable_states_bdd), reachable_states_layers);
+    /* Update the frontiers list */
+    reachable_states_frontiers =
+      cons(nodemgr, (node_ptr) bdd_dup(from_lower_bound),
+           reachable_states_frontiers);
 
   } /* while loop */
 
@@ -1146,32 +1257,38 @@ boolean BddFsm_expand_cached_reachable_states(BddFsm_ptr self,
 
   if (result) {
     /*
-       Cache the computed layers.
-       BddFsm_update_cached_reachables is responsible of the free of the list
-       reachable_states_layers
+       Cache the computed frontiers, but the last empty one.
+       BddFsm_update_cached_reachable_frontiers is responsible of the
+       free of the list reachable_states_frontiers
     */
 
-    if (Nil != reachable_states_layers) {
+    if (Nil != reachable_states_frontiers) {
       node_ptr tmp;
 
-      tmp = reachable_states_layers;
-      reachable_states_layers = cdr(reachable_states_layers);
+      tmp = reachable_states_frontiers;
+      reachable_states_frontiers = cdr(reachable_states_frontiers);
       bdd_free(self->dd, (bdd_ptr) car(tmp));
       free_node(nodemgr, tmp);
       diameter --;
     }
 
-    BddFsm_update_cached_reachable_states(self, reachable_states_layers,
-                                          diameter, true);
+    BddFsm_update_cached_reachable_frontiers(self,
+                                             reachable_states_frontiers,
+                                             diameter, true);
+
+    if ((char*) NULL != self->model_cache) {
+      BddModelCache_store_reachable(self, self->model_cache);
+    }
   }
   else {
     /*
-       Cache the partial computed layers.
-       BddFsm_update_cached_reachables is responsible of the free of the list
-       reachable_states_layers
+       Cache the partial computed frontiers.
+       BddFsm_update_cached_reachable_frontiers is responsible of the
+       free of the list reachable_states_frontiers
     */
-    BddFsm_update_cached_reachable_states(self, reachable_states_layers,
-                                          diameter, false);
+    BddFsm_update_cached_reachable_frontiers(self,
+                                             reachable_states_frontiers,
+                                             diameter, false);
   }
 
   /* Free the last reachable states 'set' */
@@ -1304,6 +1421,10 @@ void BddFsm_apply_synchronous_product_custom_varsets(BddFsm_ptr self,
   /* invars */
   bdd_and_accumulate(self->dd, &(self->invar_states), other->invar_states);
 
+  /* the reachable frontiers are kept by the cache substitution, but
+     the dropped ones cannot be rebuilt with the product trans */
+  bdd_fsm_keep_all_reachable_frontiers(self);
+
   /* trans */
   BddTrans_apply_synchronous_product(self->trans, other->trans);
 
@@ -1345,13 +1466,11 @@ void BddFsm_apply_synchronous_product(BddFsm_ptr self, const BddFsm_ptr other)
 
 boolean BddFsm_compute_reachable(BddFsm_ptr self, int k, int t, int* diameter)
 {
-  BddStates* layers = NULL;
-
   BDD_FSM_CHECK_INSTANCE(self);
 
   BddFsm_expand_cached_reachable_states(self, k, t);
 
-  return BddFsm_get_cached_reachable_states(self, &layers, diameter);
+  return BddFsm_get_cached_reachable_states(self, diameter);
 }
 
 
@@ -1532,6 +1651,7 @@ static void bdd_fsm_init(BddFsm_ptr self,
   self->compassion = compassion;
 
   self->cache = BddFsmCache_create(self->dd);
+  self->model_cache = (char*) NULL;
 
   /* check inits and invars for emptiness */
   bdd_fsm_check_init_state_invar_emptiness(self);
@@ -1559,6 +1679,10 @@ static void bdd_fsm_copy(const BddFsm_ptr self, BddFsm_ptr copy)
   copy->compassion = COMPASSION_LIST( Object_copy(OBJECT(self->compassion)));
 
   copy->cache = BddFsmCache_soft_copy(self->cache);
+
+  /* copies may be changed by synchronous products, their reachable
+     states are not the ones of the cached model */
+  copy->model_cache = (char*) NULL;
 }
 
 /*!
@@ -1577,6 +1701,8 @@ static void bdd_fsm_deinit(BddFsm_ptr self)
   Object_destroy(OBJECT(self->compassion), NULL);
 
   BddFsmCache_destroy(self->cache);
+
+  if ((char*) NULL != self->model_cache) FREE(self->model_cache);
 }
 
 /*!
@@ -1597,6 +1723,97 @@ static void bdd_fsm_compute_reachable_states(BddFsm_ptr self)
   nusmv_assert(res);
 }
 
+/*!
+  \brief Rebuilds the reachable frontier and layer at the given
+  distance
+
+  Starts from the closest kept layer, or from the last
+  rebuilt one, and applies F(i+1) = Img(F(i)) & !R(i) and R(i+1) =
+  R(i) | F(i+1) for the frontiers that were not kept. The result is
+  remembered by the cache.
+
+  \se Changes the internal cache
+*/
+static void bdd_fsm_rebuild_reachable_layer(const BddFsm_ptr self,
+                                            int distance)
+{
+  const int step = CACHE_GET(reachable.step);
+  const int memo = CACHE_GET(reachable.memo_distance);
+  int base;
+  int i;
+  bdd_ptr frontier;
+  bdd_ptr layer;
+
+  if (memo == distance) return;
+
+  /* layers are kept at multiples of step. With step 1 only the
+     frontiers are kept, and layers are rebuilt from the initial
+     states */
+  base = (step > 1) ? distance - (distance % step) : 0;
+
+  if (base <= memo && memo < distance) {
+    i = memo;
+    frontier = CACHE_GET_BDD(reachable.memo_frontier);
+    layer = CACHE_GET_BDD(reachable.memo_layer);
+  }
+  else {
+    i = base;
+    frontier = CACHE_GET_BDD(reachable.frontiers[base]);
+    layer = (step > 1) ?
+      CACHE_GET_BDD(reachable.checkpoints[base / step]) :
+      bdd_dup(frontier);
+  }
+
+  while (i < distance) {
+    bdd_ptr next;
+
+    ++i;
+    if (!CACHE_IS_EQUAL(reachable.frontiers[i], BDD_STATES(NULL))) {
+      next = CACHE_GET_BDD(reachable.frontiers[i]);
+    }
+    else {
+      bdd_ptr neg = bdd_not(self->dd, layer);
+
+      next = BddFsm_get_forward_image(self, BDD_STATES(frontier));
+      bdd_and_accumulate(self->dd, &next, neg);
+      bdd_free(self->dd, neg);
+    }
+
+    bdd_or_accumulate(self->dd, &layer, next);
+    bdd_free(self->dd, frontier);
+    frontier = next;
+  }
+
+  BddFsmCache_set_reachable_memo(self->cache, distance,
+                                 BDD_STATES(frontier), BDD_STATES(layer));
+  bdd_free(self->dd, frontier);
+  bdd_free(self->dd, layer);
+}
+
+/*!
+  \brief Rebuilds and keeps the dropped reachable frontiers
+
+  Needed before the cache is handed to an FSM with a
+  different transition relation, which could not rebuild them.
+
+  \se Changes the internal cache
+*/
+static void bdd_fsm_keep_all_reachable_frontiers(const BddFsm_ptr self)
+{
+  int i;
+
+  if (CACHE_GET(reachable.step) <= 1) return;
+
+  for (i = 0; i < CACHE_GET(reachable.diameter); ++i) {
+    if (CACHE_IS_EQUAL(reachable.frontiers[i], BDD_STATES(NULL))) {
+      BddStates frontier = BddFsm_get_cached_reachable_frontier(self, i);
+      CACHE_SET(reachable.frontiers[i], frontier);
+    }
+  }
+
+  BddFsmCache_drop_reachable_checkpoints(self->cache);
+}
+
 /*!
   \brief Returns the set of states and inputs,
    for which a legal transition can be made.
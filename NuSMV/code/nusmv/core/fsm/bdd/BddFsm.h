@@ -124,6 +124,42 @@ void BddFsm_destroy(BddFsm_ptr self);
 */
 BddFsm_ptr BddFsm_copy(const BddFsm_ptr self);
 
+/*!
+  \methodof BddFsm
+  \brief Sets the on-disk model cache of self
+
+  prefix is the name returned by BddModelCache_get_prefix for the
+  model of self. Once the reachable states of self are completely
+  computed, they are stored in that cache. A copy of prefix is
+  kept. Copies of self do not inherit the model cache.
+
+  \sa BddModelCache_store_reachable
+*/
+void BddFsm_set_model_cache(BddFsm_ptr self, const char* prefix);
+
+/*!
+  \methodof BddFsm
+  \brief Returns the cached states of a formula
+
+  key identifies a formula evaluated over self, see
+  BddFsm_cache_formula_states. Returns NULL if the formula is not
+  cached. Returned bdd is referenced.
+*/
+bdd_ptr BddFsm_get_cached_formula_states(BddFsm_ptr self, node_ptr key);
+
+/*!
+  \methodof BddFsm
+  \brief Caches the states of a formula
+
+  key must be a hash-consed node that identifies the formula
+  and everything its states depend on, but self. The cache lasts as
+  long as self and its copies sharing the same cache family, and is
+  reset by synchronous products. Its size is bounded by the option
+  ctl_cache_size, in BDD nodes.
+*/
+void BddFsm_cache_formula_states(BddFsm_ptr self, node_ptr key,
+                                 bdd_ptr states);
+
 /*!
   \methodof BddFsm
   \brief Copies cached information of 'other' into self
@@ -619,6 +655,41 @@ BddFsm_get_constrained_forward_image(const BddFsm_ptr self,
                                      BddStates states,
                                      BddStatesInputsNexts constraints);
 
+/*!
+  \methodof BddFsm
+  \brief Returns the forward image of a single state
+
+  Same as BddFsm_get_forward_image, but state must be a single
+  concrete state (a conjunction of literals). The clusters of the
+  transition relation are cofactored by state, which is much cheaper
+  than the image of a generic set of states. Useful for simulation.
+
+  Returned bdd is referenced.
+
+  \sa BddFsm_get_constrained_concrete_forward_image
+*/
+BddStates
+BddFsm_get_concrete_forward_image(const BddFsm_ptr self, BddStates state);
+
+/*!
+  \methodof BddFsm
+  \brief Returns the constrained forward image of a single state
+
+  Same as BddFsm_get_constrained_forward_image, but state must be a
+  single concrete state (a conjunction of literals). The clusters of
+  the transition relation, the invariants and the constraints are
+  cofactored by state, which is much cheaper than the image of a
+  generic set of states.
+
+  Returned bdd is referenced.
+
+  \sa BddFsm_get_constrained_forward_image
+*/
+BddStates
+BddFsm_get_constrained_concrete_forward_image(const BddFsm_ptr self,
+                                              BddStates state,
+                                              BddStatesInputsNexts constraints);
+
 /*!
   \methodof BddFsm
   \brief Returns the constrained forward image of a set of states
@@ -1072,20 +1143,77 @@ BddStates BddFsm_states_inputs_to_inputs(const BddFsm_ptr self,
 /*!
   \methodof BddFsm
   \brief Returns the cached reachable states
+
+  Sets size to the number of cached layers, and returns
+  true if the reachable states are completely computed. Layers are
+  accessed with BddFsm_get_cached_reachable_layer and
+  BddFsm_get_cached_reachable_frontier.
 */
 boolean BddFsm_get_cached_reachable_states(const BddFsm_ptr self,
-                                                  BddStates** layers,
                                                   int* size);
 
+/*!
+  \methodof BddFsm
+  \brief Returns the cached states reachable within the given
+  distance
+
+  distance must be lower than the cached size. Only the
+  frontiers are cached, so the layer may be rebuilt. Accessing the
+  layers in increasing order is cheap.
+
+  Returned bdd is referenced.
+
+  \se Changes the internal cache
+
+  \sa BddFsm_get_cached_reachable_frontier
+*/
+BddStates BddFsm_get_cached_reachable_layer(const BddFsm_ptr self,
+                                            int distance);
+
+/*!
+  \methodof BddFsm
+  \brief Returns the cached states reachable at exactly the given
+  distance
+
+  distance must be lower than the cached size. When the
+  option reachable_layers_step is greater than 1, the frontiers that
+  were not kept are rebuilt by image from the previous kept one.
+
+  Returned bdd is referenced.
+
+  \se Changes the internal cache
+
+  \sa BddFsm_get_cached_reachable_layer
+*/
+BddStates BddFsm_get_cached_reachable_frontier(const BddFsm_ptr self,
+                                               int distance);
+
 /*!
   \methodof BddFsm
   \brief Updates the cached reachable states
+
+  layers is reversed, and holds the states reachable
+  within each distance. Only the frontiers are cached. The list is
+  destroyed.
 */
 void BddFsm_update_cached_reachable_states(const BddFsm_ptr self,
                                                   node_ptr layers,
                                                   int size,
                                                   boolean completed);
 
+/*!
+  \methodof BddFsm
+  \brief Appends frontiers to the cached reachable states
+
+  frontiers is reversed, and holds the states at exactly
+  each distance from the cached size to size - 1. The list is
+  destroyed.
+*/
+void BddFsm_update_cached_reachable_frontiers(const BddFsm_ptr self,
+                                              node_ptr frontiers,
+                                              int size,
+                                              boolean completed);
+
 /*!
   \methodof BddFsm
   \brief Sets the whole set of reachable states for this FSM, with
@@ -77,9 +77,28 @@
   }
 
 
+/*!
+  \brief An entry of the formulas cache
+
+  hits counts the uses of the entry, including the computation
+  that created it, last is the clock of the last use
+*/
+typedef struct BddFsmFormulaEntry_TAG
+{
+  bdd_ptr states;
+  int size;
+  int hits;
+  unsigned long last;
+} BddFsmFormulaEntry;
+
 static void bdd_fsm_cache_init(BddFsmCache_ptr self, DDMgr_ptr dd);
 static void bdd_fsm_cache_deinit(BddFsmCache_ptr self);
 static void bdd_fsm_cache_deinit_reachables(BddFsmCache_ptr self);
+static void bdd_fsm_cache_clear_layers(BddFsmCache_ptr self);
+static void bdd_fsm_cache_clear_memo(BddFsmCache_ptr self);
+static int bdd_fsm_cache_checkpoints_num(const BddFsmCache_ptr self);
+static void bdd_fsm_cache_clear_formulas(BddFsmCache_ptr self);
+static boolean bdd_fsm_cache_evict_formula(BddFsmCache_ptr self);
 
 
 /* ---------------------------------------------------------------------- */
@@ -142,6 +161,8 @@ void BddFsmCache_reset_not_reusable_fields_after_product(BddFsmCache_ptr self)
   CACHE_UNREF_BDD(BddStates, deadlock_states);
   CACHE_UNREF_BDD(BddStatesInputs, legal_state_input);
   CACHE_UNREF_BDD(BddStatesInputs, monolithic_trans);
+
+  bdd_fsm_cache_clear_formulas(self);
 }
 
 BddFsmCache_ptr BddFsmCache_soft_copy(const BddFsmCache_ptr self)
@@ -166,6 +187,7 @@ void BddFsmCache_copy_reachables(BddFsmCache_ptr self,
 
   self->reachable.computed = other->reachable.computed;
   self->reachable.diameter = other->reachable.diameter;
+  self->reachable.step = other->reachable.step;
 
   /* This can be done under the assumption that the set of reachable
      states of the copy will never be an under-approximation of the
@@ -177,13 +199,26 @@ void BddFsmCache_copy_reachables(BddFsmCache_ptr self,
 
   count = other->reachable.diameter;
   if (count > 0) {
-    self->reachable.layers = ALLOC(BddStates, count);
+    self->reachable.frontiers = ALLOC(BddStates, count);
     while (count > 0) {
       bdd_ptr tmp;
       count -= 1;
-      tmp = (bdd_ptr) other->reachable.layers[count];
-      self->reachable.layers[count] = BDD_STATES(bdd_dup(tmp));
+      tmp = (bdd_ptr) other->reachable.frontiers[count];
+      self->reachable.frontiers[count] = ((bdd_ptr) NULL != tmp) ?
+        BDD_STATES(bdd_dup(tmp)) : BDD_STATES(NULL);
+    }
+
+    if ((BddStates*) NULL != other->reachable.checkpoints) {
+      count = bdd_fsm_cache_checkpoints_num(other);
+      self->reachable.checkpoints = ALLOC(BddStates, count);
+      while (count > 0) {
+        count -= 1;
+        self->reachable.checkpoints[count] =
+          BDD_STATES(bdd_dup(other->reachable.checkpoints[count]));
+      }
     }
+
+    self->reachable.last = BDD_STATES(bdd_dup(other->reachable.last));
   }
 }
 
@@ -204,42 +239,209 @@ void BddFsmCache_set_reachables(BddFsmCache_ptr self,
                                 const int diameter,
                                 boolean completed)
 {
+  const NuSMVEnv_ptr env = EnvObject_get_environment(ENV_OBJECT(self->dd));
+  const NodeMgr_ptr nodemgr =
+    NODE_MGR(NuSMVEnv_get_value(env, ENV_NODE_MGR));
+  node_ptr frontiers_list = Nil;
+  node_ptr iter;
   int i;
 
   BDD_FSM_CACHE_CHECK_INSTANCE(self);
 
   /* If we have previously saved states free them */
-  if (self->reachable.diameter > 0) {
-        for (i = 0; i < self->reachable.diameter; i++) {
-                bdd_free(self->dd, self->reachable.layers[i]);
-        }
-        FREE(self->reachable.layers);
+  bdd_fsm_cache_clear_layers(self);
+
+  /* the frontier at distance i is the difference between the layers
+     i and i-1. The list is reversed, so is the list of frontiers */
+  iter = layers_list;
+  for (i = diameter-1; i >= 0; --i) {
+    bdd_ptr frontier = bdd_dup((bdd_ptr) car(iter));
+
+    if (i > 0) {
+      bdd_ptr neg = bdd_not(self->dd, (bdd_ptr) car(cdr(iter)));
+      bdd_and_accumulate(self->dd, &frontier, neg);
+      bdd_free(self->dd, neg);
+    }
+
+    frontiers_list = cons(nodemgr, (node_ptr) frontier, frontiers_list);
+    iter = cdr(iter);
+  }
+  frontiers_list = reverse(frontiers_list);
+
+  for (i = 0; i < diameter; ++i) {
+    node_ptr tmp = layers_list;
+
+    bdd_free(self->dd, (bdd_ptr) car(layers_list));
+    layers_list = cdr(layers_list);
+    free_node(nodemgr, tmp);
+  }
+
+  BddFsmCache_add_reachable_frontiers(self, frontiers_list, diameter,
+                                      completed);
+}
+
+void BddFsmCache_add_reachable_frontiers(BddFsmCache_ptr self,
+                                         node_ptr frontiers_list,
+                                         const int diameter,
+                                         boolean completed)
+{
+  const NuSMVEnv_ptr env = EnvObject_get_environment(ENV_OBJECT(self->dd));
+  const NodeMgr_ptr nodemgr =
+    NODE_MGR(NuSMVEnv_get_value(env, ENV_NODE_MGR));
+  const OptsHandler_ptr opts =
+    OPTS_HANDLER(NuSMVEnv_get_value(env, ENV_OPTS_HANDLER));
+  int first;
+  int step;
+  int i;
+
+  BDD_FSM_CACHE_CHECK_INSTANCE(self);
+
+  first = (self->reachable.diameter > 0) ? self->reachable.diameter : 0;
+  nusmv_assert(first <= diameter);
+
+  /* the step is chosen when the first frontier is added */
+  if (0 == first) {
+    self->reachable.step = get_reachable_layers_step(opts);
+    if (self->reachable.step < 1) self->reachable.step = 1;
   }
+  step = self->reachable.step;
 
-  /* Update the cache */
   self->reachable.computed = completed;
   self->reachable.diameter = diameter;
+  if (first == diameter) {
+    nusmv_assert(Nil == frontiers_list);
+    return;
+  }
+
+  self->reachable.frontiers = (0 == first) ?
+    ALLOC(BddStates, diameter) :
+    REALLOC(BddStates, self->reachable.frontiers, diameter);
+  nusmv_assert(self->reachable.frontiers != (BddStates*) NULL);
+
+  if (step > 1) {
+    const int count = bdd_fsm_cache_checkpoints_num(self);
+
+    self->reachable.checkpoints = (0 == first) ?
+      ALLOC(BddStates, count) :
+      REALLOC(BddStates, self->reachable.checkpoints, count);
+    nusmv_assert(self->reachable.checkpoints != (BddStates*) NULL);
+  }
+
+  for (i = diameter-1; i >= first; --i) {
+    node_ptr tmp = frontiers_list;
+
+    self->reachable.frontiers[i] = BDD_STATES(car(frontiers_list));
+    frontiers_list = cdr(frontiers_list);
+    free_node(nodemgr, tmp);
+  }
+  nusmv_assert(Nil == frontiers_list);
 
-  self->reachable.layers = ALLOC(BddStates, diameter);
-  nusmv_assert(self->reachable.layers != (BddStates*) NULL);
+  for (i = first; i < diameter; ++i) {
+    bdd_ptr frontier = (bdd_ptr) self->reachable.frontiers[i];
 
-  {
-    const NuSMVEnv_ptr env = EnvObject_get_environment(ENV_OBJECT(self->dd));
-    const NodeMgr_ptr nodemgr =
-      NODE_MGR(NuSMVEnv_get_value(env, ENV_NODE_MGR));
+    if (0 == i) {
+      self->reachable.last = BDD_STATES(bdd_dup(frontier));
+    }
+    else bdd_or_accumulate(self->dd, &(self->reachable.last), frontier);
+
+    if (0 == (i % step)) {
+      if (step > 1) {
+        self->reachable.checkpoints[i / step] =
+          BDD_STATES(bdd_dup(self->reachable.last));
+      }
+    }
+    else {
+      bdd_free(self->dd, frontier);
+      self->reachable.frontiers[i] = BDD_STATES(NULL);
+    }
+  }
+}
+
+void BddFsmCache_set_reachable_memo(BddFsmCache_ptr self,
+                                    int distance,
+                                    BddStates frontier,
+                                    BddStates layer)
+{
+  BDD_FSM_CACHE_CHECK_INSTANCE(self);
+
+  bdd_fsm_cache_clear_memo(self);
+
+  self->reachable.memo_distance = distance;
+  self->reachable.memo_frontier = BDD_STATES(bdd_dup((bdd_ptr) frontier));
+  self->reachable.memo_layer = BDD_STATES(bdd_dup((bdd_ptr) layer));
+}
+
+void BddFsmCache_drop_reachable_checkpoints(BddFsmCache_ptr self)
+{
+  int i;
+
+  BDD_FSM_CACHE_CHECK_INSTANCE(self);
 
-    for (i = diameter-1; i >= 0; --i) {
-      node_ptr tmp;
-      bdd_ptr  layer;
+  for (i = 0; i < self->reachable.diameter; ++i) {
+    nusmv_assert(BDD_STATES(NULL) != self->reachable.frontiers[i]);
+  }
 
-      layer = BDD_STATES( car(layers_list) );
-      self->reachable.layers[i] = bdd_dup(layer);
-      tmp = layers_list;
-      layers_list = cdr(layers_list);
-      bdd_free(self->dd, layer);
-      free_node(nodemgr, tmp);
+  if ((BddStates*) NULL != self->reachable.checkpoints) {
+    for (i = bdd_fsm_cache_checkpoints_num(self) - 1; i >= 0; --i) {
+      bdd_free(self->dd, (bdd_ptr) self->reachable.checkpoints[i]);
     }
+    FREE(self->reachable.checkpoints);
+    self->reachable.checkpoints = (BddStates*) NULL;
   }
+
+  self->reachable.step = 1;
+}
+
+bdd_ptr BddFsmCache_get_formula_states(BddFsmCache_ptr self, node_ptr key)
+{
+  BddFsmFormulaEntry* entry;
+
+  BDD_FSM_CACHE_CHECK_INSTANCE(self);
+
+  if ((hash_ptr) NULL == self->formulas.table) return (bdd_ptr) NULL;
+
+  entry = (BddFsmFormulaEntry*) find_assoc(self->formulas.table, key);
+  if ((BddFsmFormulaEntry*) NULL == entry) return (bdd_ptr) NULL;
+
+  entry->hits += 1;
+  entry->last = ++(self->formulas.clock);
+  return bdd_dup(entry->states);
+}
+
+void BddFsmCache_set_formula_states(BddFsmCache_ptr self, node_ptr key,
+                                    bdd_ptr states, long budget)
+{
+  BddFsmFormulaEntry* entry;
+  int size;
+
+  BDD_FSM_CACHE_CHECK_INSTANCE(self);
+
+  size = bdd_size(self->dd, states);
+  if (size > budget) return;
+
+  if ((hash_ptr) NULL == self->formulas.table) {
+    self->formulas.table = new_assoc();
+  }
+  else {
+    entry = (BddFsmFormulaEntry*) find_assoc(self->formulas.table, key);
+    if ((BddFsmFormulaEntry*) NULL != entry) return; /* already cached */
+  }
+
+  while (self->formulas.size + size > budget &&
+         bdd_fsm_cache_evict_formula(self)) ;
+
+  entry = ALLOC(BddFsmFormulaEntry, 1);
+  nusmv_assert((BddFsmFormulaEntry*) NULL != entry);
+
+  entry->states = bdd_dup(states);
+  entry->size = size;
+  /* the computation counts as a use, so that a new entry is not
+     evicted before the entries that were used once and are older */
+  entry->hits = 1;
+  entry->last = ++(self->formulas.clock);
+
+  insert_assoc(self->formulas.table, key, (node_ptr) entry);
+  self->formulas.size += size;
 }
 
 /*!
@@ -262,14 +464,24 @@ static void bdd_fsm_cache_init(BddFsmCache_ptr self, DDMgr_ptr dd)
   self->revfair_states_inputs = BDD_STATES_INPUTS(NULL);
 
   self->reachable.computed = false;
-  self->reachable.layers   = (BddStates*) NULL;
   self->reachable.diameter = -1;
+  self->reachable.step = 1;
+  self->reachable.frontiers = (BddStates*) NULL;
+  self->reachable.checkpoints = (BddStates*) NULL;
+  self->reachable.last = BDD_STATES(NULL);
+  self->reachable.memo_distance = -1;
+  self->reachable.memo_frontier = BDD_STATES(NULL);
+  self->reachable.memo_layer = BDD_STATES(NULL);
   self->reachable.reachable_states = (BddStates)NULL;
 
   self->not_successor_states  = BDD_STATES(NULL);
   self->deadlock_states       = BDD_STATES(NULL);
   self->legal_state_input   = BDD_STATES_INPUTS(NULL);
   self->monolithic_trans      = BDD_STATES_INPUTS(NULL);
+
+  self->formulas.table = (hash_ptr) NULL;
+  self->formulas.size = 0;
+  self->formulas.clock = 0;
 }
 
 /*!
@@ -293,6 +505,8 @@ static void bdd_fsm_cache_deinit(BddFsmCache_ptr self)
   CACHE_UNREF_BDD(BddStatesInputs, legal_state_input);
   CACHE_UNREF_BDD(BddStatesInputs, monolithic_trans);
 
+  bdd_fsm_cache_clear_formulas(self);
+
   FREE(self->family_counter);
 }
 
@@ -305,20 +519,129 @@ static void bdd_fsm_cache_deinit_reachables(BddFsmCache_ptr self)
 {
   nusmv_assert(*(self->family_counter) <= 1); /* not shared */
 
-  if (self->reachable.computed) {
+  bdd_fsm_cache_clear_layers(self);
 
-    while (self->reachable.diameter > 0) {
-      bdd_ptr tmp;
-      self->reachable.diameter -= 1;
-      tmp = (bdd_ptr) self->reachable.layers[self->reachable.diameter];
-      bdd_free(self->dd, tmp);
+  if ((bdd_ptr)NULL != self->reachable.reachable_states) {
+    bdd_free(self->dd, self->reachable.reachable_states);
+    self->reachable.reachable_states = (BddStates)NULL;
+  }
+}
+
+/*!
+  \brief Frees the reachable frontiers and the related layers
+
+  Partially computed frontiers are freed as well
+*/
+static void bdd_fsm_cache_clear_layers(BddFsmCache_ptr self)
+{
+  int i;
+
+  bdd_fsm_cache_clear_memo(self);
+
+  if ((BddStates*) NULL != self->reachable.checkpoints) {
+    for (i = bdd_fsm_cache_checkpoints_num(self) - 1; i >= 0; --i) {
+      bdd_free(self->dd, (bdd_ptr) self->reachable.checkpoints[i]);
     }
+    FREE(self->reachable.checkpoints);
+    self->reachable.checkpoints = (BddStates*) NULL;
+  }
 
-    FREE(self->reachable.layers);
-    self->reachable.computed = false;
+  if ((BddStates*) NULL != self->reachable.frontiers) {
+    for (i = self->reachable.diameter - 1; i >= 0; --i) {
+      if (BDD_STATES(NULL) != self->reachable.frontiers[i]) {
+        bdd_free(self->dd, (bdd_ptr) self->reachable.frontiers[i]);
+      }
+    }
+    FREE(self->reachable.frontiers);
+    self->reachable.frontiers = (BddStates*) NULL;
   }
 
-  if ((bdd_ptr)NULL != self->reachable.reachable_states) {
-    bdd_free(self->dd, self->reachable.reachable_states);
+  if (BDD_STATES(NULL) != self->reachable.last) {
+    bdd_free(self->dd, (bdd_ptr) self->reachable.last);
+    self->reachable.last = BDD_STATES(NULL);
   }
+
+  self->reachable.computed = false;
+  self->reachable.diameter = -1;
+  self->reachable.step = 1;
+}
+
+/*!
+  \brief Frees the last rebuilt frontier
+*/
+static void bdd_fsm_cache_clear_memo(BddFsmCache_ptr self)
+{
+  if (BDD_STATES(NULL) != self->reachable.memo_frontier) {
+    bdd_free(self->dd, (bdd_ptr) self->reachable.memo_frontier);
+    bdd_free(self->dd, (bdd_ptr) self->reachable.memo_layer);
+  }
+
+  self->reachable.memo_distance = -1;
+  self->reachable.memo_frontier = BDD_STATES(NULL);
+  self->reachable.memo_layer = BDD_STATES(NULL);
+}
+
+/*!
+  \brief Returns the number of kept layers
+
+  Layers are kept at each distance multiple of the step
+*/
+static int bdd_fsm_cache_checkpoints_num(const BddFsmCache_ptr self)
+{
+  return (self->reachable.diameter + self->reachable.step - 1) /
+    self->reachable.step;
+}
+
+/*!
+  \brief Frees the formulas cache
+*/
+static void bdd_fsm_cache_clear_formulas(BddFsmCache_ptr self)
+{
+  assoc_iter iter;
+  node_ptr key;
+  BddFsmFormulaEntry* entry;
+
+  if ((hash_ptr) NULL == self->formulas.table) return;
+
+  ASSOC_FOREACH(self->formulas.table, iter, &key, &entry) {
+    bdd_free(self->dd, entry->states);
+    FREE(entry);
+  }
+
+  free_assoc(self->formulas.table);
+  self->formulas.table = (hash_ptr) NULL;
+  self->formulas.size = 0;
+}
+
+/*!
+  \brief Evicts an entry from the formulas cache
+
+  The entry with fewest uses is evicted, or the least recently
+  used among them, so that on a tie the oldest entry goes first. Returns false if the cache is empty.
+*/
+static boolean bdd_fsm_cache_evict_formula(BddFsmCache_ptr self)
+{
+  assoc_iter iter;
+  node_ptr key;
+  node_ptr victim_key = Nil;
+  BddFsmFormulaEntry* entry;
+  BddFsmFormulaEntry* victim = (BddFsmFormulaEntry*) NULL;
+
+  ASSOC_FOREACH(self->formulas.table, iter, &key, &entry) {
+    if ((BddFsmFormulaEntry*) NULL == victim ||
+        entry->hits < victim->hits ||
+        (entry->hits == victim->hits && entry->last < victim->last)) {
+      victim = entry;
+      victim_key = key;
+    }
+  }
+
+  if ((BddFsmFormulaEntry*) NULL == victim) return false;
+
+  remove_assoc(self->formulas.table, victim_key);
+  self->formulas.size -= victim->size;
+  bdd_free(self->dd, victim->states);
+  FREE(victim);
+
+  return true;
 }
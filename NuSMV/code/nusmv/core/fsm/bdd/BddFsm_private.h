@@ -60,6 +60,10 @@ typedef struct BddFsm_TAG
   CompassionList_ptr compassion;
 
   BddFsmCache_ptr cache;
+
+  /* name of the on-disk model cache the reachable states are stored
+     into once computed, NULL if none */
+  char* model_cache;
 } BddFsm;
 
 
@@ -0,0 +1,655 @@
+/* ---------------------------------------------------------------------------
+
+
+  This file is part of the ``fsm.bdd'' package of NuSMV version 2.
+  Copyright (C) 2003 by FBK-irst.
+
+  NuSMV version 2 is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  NuSMV version 2 is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA.
+
+  For more information on NuSMV see <http://nusmv.fbk.eu>
+  or email to <nusmv-users@fbk.eu>.
+  Please report bugs to <nusmv-users@fbk.eu>.
+
+  To contact the NuSMV development board, email to <nusmv@fbk.eu>.
+
+-----------------------------------------------------------------------------*/
+
+/*!
+  \author Alberto Bombardelli
+  \brief Implementation of the on-disk cache of BDD models
+
+  See BddModelCache.h for the layout of the cache. Names are FNV-1a
+  hashes of the printed model, so that they do not depend on the
+  addresses of the expressions in the current process.
+
+*/
+
+
+#include "nusmv/core/fsm/bdd/BddModelCache.h"
+#include "nusmv/core/fsm/bdd/BddFsm_private.h"
+#include "nusmv/core/fsm/bdd/bddInt.h"
+#include "nusmv/core/trans/bdd/Cluster.h"
+#include "nusmv/core/trans/bdd/ClusterOptions.h"
+#include "nusmv/core/compile/symb_table/SymbTable.h"
+#include "nusmv/core/compile/symb_table/SymbType.h"
+#include "nusmv/core/node/NodeMgr.h"
+#include "nusmv/core/node/printers/MasterPrinter.h"
+#include "nusmv/core/utils/ErrorMgr.h"
+#include "nusmv/core/utils/Logger.h"
+#include "nusmv/core/opt/opt.h"
+
+#include <stdio.h>
+#include <string.h>
+
+/*---------------------------------------------------------------------------*/
+/* Constant declarations                                                     */
+/*---------------------------------------------------------------------------*/
+
+/*!
+  \brief First line of the .ord files
+*/
+#define BDD_MODEL_CACHE_HEADER "NuSMV-bdd-model-cache-1"
+
+/*!
+  \brief FNV-1a 64 bits offset basis
+*/
+#define BDD_MODEL_CACHE_HASH_BASIS 14695981039346656037ULL
+
+/*!
+  \brief FNV-1a 64 bits prime
+*/
+#define BDD_MODEL_CACHE_HASH_PRIME 1099511628211ULL
+
+/*!
+  \brief Size of the buffers used to print numbers
+*/
+#define BDD_MODEL_CACHE_BUF_SIZE 256
+
+
+/* ---------------------------------------------------------------------- */
+/*                     Static functions prototypes                        */
+/* ---------------------------------------------------------------------- */
+
+static unsigned long long
+bdd_model_cache_hash_string(unsigned long long hash, const char* str);
+
+static unsigned long long
+bdd_model_cache_hash_expr(MasterPrinter_ptr wffprint,
+                          unsigned long long hash, Expr_ptr expr);
+
+static unsigned long long
+bdd_model_cache_hash_file(unsigned long long hash, const char* fname);
+
+static unsigned long long
+bdd_model_cache_hash_symbols(SymbTable_ptr st, MasterPrinter_ptr wffprint,
+                             unsigned long long hash);
+
+static char* bdd_model_cache_var_line(BddEnc_ptr enc,
+                                      MasterPrinter_ptr wffprint, int index);
+
+static FILE* bdd_model_cache_open(const char* prefix, const char* ext,
+                                  const char* mode);
+
+static boolean bdd_model_cache_write_order(BddEnc_ptr enc, FILE* file,
+                                           int forward_num,
+                                           int backward_num);
+
+static boolean bdd_model_cache_check_order(BddEnc_ptr enc, FILE* file,
+                                           int* forward_num,
+                                           int* backward_num);
+
+static boolean bdd_model_cache_get_clusters(ClusterList_ptr clusters,
+                                            bdd_ptr* bdds);
+
+static ClusterList_ptr bdd_model_cache_make_clusters(DDMgr_ptr dd,
+                                                     bdd_ptr* bdds,
+                                                     int num);
+
+static void bdd_model_cache_log(BddEnc_ptr enc, const char* action,
+                                const char* prefix, const char* ext);
+
+
+/* ---------------------------------------------------------------------- */
+/*                          public functions                              */
+/* ---------------------------------------------------------------------- */
+
+char* BddModelCache_get_prefix(BddEnc_ptr enc,
+                               Expr_ptr init, Expr_ptr invar,
+                               Expr_ptr input, Expr_ptr trans,
+                               const TransType trans_type)
+{
+  const NuSMVEnv_ptr env = EnvObject_get_environment(ENV_OBJECT(enc));
+  const OptsHandler_ptr opts =
+    OPTS_HANDLER(NuSMVEnv_get_value(env, ENV_OPTS_HANDLER));
+  const MasterPrinter_ptr wffprint =
+    MASTER_PRINTER(NuSMVEnv_get_value(env, ENV_WFF_PRINTER));
+  const DDMgr_ptr dd = BddEnc_get_dd_manager(enc);
+  unsigned long long hash = BDD_MODEL_CACHE_HASH_BASIS;
+  char buf[BDD_MODEL_CACHE_BUF_SIZE];
+  ClusterOptions_ptr cluster_options;
+  char* dir;
+  char* res;
+  int i;
+
+  if (!opt_bdd_model_cache(opts)) return (char*) NULL;
+  dir = get_bdd_model_cache(opts);
+
+  /* the model */
+  hash = bdd_model_cache_hash_expr(wffprint, hash, init);
+  hash = bdd_model_cache_hash_expr(wffprint, hash, invar);
+  hash = bdd_model_cache_hash_expr(wffprint, hash, input);
+  hash = bdd_model_cache_hash_expr(wffprint, hash, trans);
+
+  /* the expressions above refer to DEFINEs by name, and their
+     encoding depends on the types of the variables */
+  hash = bdd_model_cache_hash_symbols(BaseEnc_get_symb_table(BASE_ENC(enc)),
+                                      wffprint, hash);
+
+  /* the partitioning of the clusters */
+  hash = bdd_model_cache_hash_string(hash, TransType_to_string(trans_type));
+
+  cluster_options = ClusterOptions_create(opts);
+  snprintf(buf, BDD_MODEL_CACHE_BUF_SIZE, "%d %d %d %d %d %d %d %d %d",
+           ClusterOptions_get_threshold(cluster_options),
+           ClusterOptions_is_affinity(cluster_options),
+           ClusterOptions_clusters_appended(cluster_options),
+           ClusterOptions_is_iwls95_preorder(cluster_options),
+           ClusterOptions_get_cluster_size(cluster_options),
+           ClusterOptions_get_w1(cluster_options),
+           ClusterOptions_get_w2(cluster_options),
+           ClusterOptions_get_w3(cluster_options),
+           ClusterOptions_get_w4(cluster_options));
+  ClusterOptions_destroy(cluster_options);
+  hash = bdd_model_cache_hash_string(hash, buf);
+
+  if (opt_trans_order_file(opts)) {
+    hash = bdd_model_cache_hash_file(hash, get_trans_order_file(opts));
+  }
+
+  /* the variable order */
+  for (i = 0; i < dd_get_size(dd); ++i) {
+    char* line = bdd_model_cache_var_line(enc, wffprint, i);
+
+    if ((char*) NULL != line) {
+      hash = bdd_model_cache_hash_string(hash, line);
+      FREE(line);
+    }
+  }
+
+  res = ALLOC(char, strlen(dir) + 2 + 16 + 1);
+  sprintf(res, "%s/%016llx", dir, hash);
+
+  return res;
+}
+
+boolean BddModelCache_load_model(BddEnc_ptr enc, const char* prefix,
+                                 bdd_ptr* init, bdd_ptr* invar,
+                                 bdd_ptr* input,
+                                 ClusterList_ptr* forward,
+                                 ClusterList_ptr* backward)
+{
+  const DDMgr_ptr dd = BddEnc_get_dd_manager(enc);
+  bdd_ptr* bdds = (bdd_ptr*) NULL;
+  int forward_num, backward_num;
+  boolean ok;
+  FILE* file;
+  int num;
+  int i;
+
+  file = bdd_model_cache_open(prefix, ".ord", "r");
+  if ((FILE*) NULL == file) return false;
+
+  ok = bdd_model_cache_check_order(enc, file, &forward_num, &backward_num);
+  fclose(file);
+  if (!ok) return false;
+
+  file = bdd_model_cache_open(prefix, ".fsm", "rb");
+  if ((FILE*) NULL == file) return false;
+
+  num = bdd_array_load(dd, &bdds, file);
+  fclose(file);
+
+  if (num != 3 + forward_num + backward_num) {
+    for (i = 0; i < num; ++i) bdd_free(dd, bdds[i]);
+    FREE(bdds);
+    return false;
+  }
+
+  *init = bdds[0];
+  *invar = bdds[1];
+  *input = bdds[2];
+  *forward = bdd_model_cache_make_clusters(dd, bdds + 3, forward_num);
+  *backward = bdd_model_cache_make_clusters(dd, bdds + 3 + forward_num,
+                                            backward_num);
+  FREE(bdds);
+
+  bdd_model_cache_log(enc, "loaded", prefix, ".fsm");
+  return true;
+}
+
+void BddModelCache_store_model(BddEnc_ptr enc, const char* prefix,
+                               bdd_ptr init, bdd_ptr invar, bdd_ptr input,
+                               BddTrans_ptr trans)
+{
+  const NuSMVEnv_ptr env = EnvObject_get_environment(ENV_OBJECT(enc));
+  const ErrorMgr_ptr errmgr =
+    ERROR_MGR(NuSMVEnv_get_value(env, ENV_ERROR_MANAGER));
+  const DDMgr_ptr dd = BddEnc_get_dd_manager(enc);
+  ClusterList_ptr forward;
+  ClusterList_ptr backward;
+  int forward_num, backward_num;
+  bdd_ptr* bdds;
+  boolean ok;
+  FILE* file;
+  int i;
+
+  backward = BddTrans_get_backward_clusterlist(trans);
+  if (CLUSTER_LIST(NULL) == backward) return;
+  forward = BddTrans_get_clusterlist(trans);
+
+  forward_num = ClusterList_length(forward);
+  backward_num = ClusterList_length(backward);
+
+  bdds = ALLOC(bdd_ptr, 3 + forward_num + backward_num);
+  for (i = 0; i < 3 + forward_num + backward_num; ++i) {
+    bdds[i] = (bdd_ptr) NULL;
+  }
+  bdds[0] = init;
+  bdds[1] = invar;
+  bdds[2] = input;
+
+  ok = bdd_model_cache_get_clusters(forward, bdds + 3) &&
+    bdd_model_cache_get_clusters(backward, bdds + 3 + forward_num);
+
+  /* the order is written last, as it marks the model as complete */
+  if (ok) {
+    file = bdd_model_cache_open(prefix, ".fsm", "wb");
+    ok = ((FILE*) NULL != file);
+    if (ok) {
+      ok = bdd_array_store(dd, 3 + forward_num + backward_num, bdds, file);
+      ok = (0 == fclose(file)) && ok;
+    }
+  }
+
+  if (ok) {
+    file = bdd_model_cache_open(prefix, ".ord", "w");
+    ok = ((FILE*) NULL != file);
+    if (ok) {
+      ok = bdd_model_cache_write_order(enc, file, forward_num, backward_num);
+      ok = (0 == fclose(file)) && ok;
+    }
+  }
+
+  if (ok) bdd_model_cache_log(enc, "stored", prefix, ".fsm");
+  else {
+    ErrorMgr_warning_msg(errmgr, "unable to store the BDD model in \"%s\"\n",
+                         prefix);
+  }
+
+  for (i = 3; i < 3 + forward_num + backward_num; ++i) {
+    if ((bdd_ptr) NULL != bdds[i]) bdd_free(dd, bdds[i]);
+  }
+  FREE(bdds);
+
+  ClusterList_destroy(backward);
+  ClusterList_destroy(forward);
+}
+
+boolean BddModelCache_load_reachable(BddFsm_ptr fsm, const char* prefix)
+{
+  const NuSMVEnv_ptr env = EnvObject_get_environment(ENV_OBJECT(fsm->enc));
+  const NodeMgr_ptr nodemgr =
+    NODE_MGR(NuSMVEnv_get_value(env, ENV_NODE_MGR));
+  bdd_ptr* frontiers = (bdd_ptr*) NULL;
+  node_ptr frontiers_list = Nil;
+  FILE* file;
+  int num;
+  int i;
+
+  file = bdd_model_cache_open(prefix, ".reach", "rb");
+  if ((FILE*) NULL == file) return false;
+
+  num = bdd_array_load(fsm->dd, &frontiers, file);
+  fclose(file);
+  if (0 == num) return false;
+
+  /* the list is expected to start from the outermost frontier */
+  for (i = 0; i < num; ++i) {
+    frontiers_list = cons(nodemgr, (node_ptr) frontiers[i], frontiers_list);
+  }
+  FREE(frontiers);
+
+  BddFsm_update_cached_reachable_frontiers(fsm, frontiers_list, num, true);
+
+  bdd_model_cache_log(fsm->enc, "loaded", prefix, ".reach");
+  return true;
+}
+
+void BddModelCache_store_reachable(BddFsm_ptr fsm, const char* prefix)
+{
+  const NuSMVEnv_ptr env = EnvObject_get_environment(ENV_OBJECT(fsm->enc));
+  const ErrorMgr_ptr errmgr =
+    ERROR_MGR(NuSMVEnv_get_value(env, ENV_ERROR_MANAGER));
+  bdd_ptr* frontiers;
+  int diameter;
+  boolean ok;
+  FILE* file;
+  int i;
+
+  if (!BddFsm_get_cached_reachable_states(fsm, &diameter) ||
+      diameter <= 0) {
+    return;
+  }
+
+  /* dropped frontiers are rebuilt, so that the stored model does not
+     depend on the option reachable_layers_step */
+  frontiers = ALLOC(bdd_ptr, diameter);
+  nusmv_assert((bdd_ptr*) NULL != frontiers);
+  for (i = 0; i < diameter; ++i) {
+    frontiers[i] = (bdd_ptr) BddFsm_get_cached_reachable_frontier(fsm, i);
+  }
+
+  file = bdd_model_cache_open(prefix, ".reach", "wb");
+  ok = ((FILE*) NULL != file);
+  if (ok) {
+    ok = bdd_array_store(fsm->dd, diameter, frontiers, file);
+    ok = (0 == fclose(file)) && ok;
+  }
+
+  for (i = 0; i < diameter; ++i) bdd_free(fsm->dd, frontiers[i]);
+  FREE(frontiers);
+
+  if (ok) bdd_model_cache_log(fsm->enc, "stored", prefix, ".reach");
+  else {
+    ErrorMgr_warning_msg(errmgr, "unable to store the reachable states "
+                         "in \"%s\"\n", prefix);
+  }
+}
+
+
+/* ---------------------------------------------------------------------- */
+/*                         Static functions                               */
+/* ---------------------------------------------------------------------- */
+
+/*!
+  \brief Adds the given string to the hash
+
+  A separator is hashed after the string, so that the hash of a
+  sequence of strings does not depend only on their concatenation.
+*/
+static unsigned long long
+bdd_model_cache_hash_string(unsigned long long hash, const char* str)
+{
+  const unsigned char* c;
+
+  for (c = (const unsigned char*) str; *c != '\0'; ++c) {
+    hash = (hash ^ *c) * BDD_MODEL_CACHE_HASH_PRIME;
+  }
+
+  return (hash ^ '\n') * BDD_MODEL_CACHE_HASH_PRIME;
+}
+
+/*!
+  \brief Adds the printed expression to the hash
+*/
+static unsigned long long
+bdd_model_cache_hash_expr(MasterPrinter_ptr wffprint,
+                          unsigned long long hash, Expr_ptr expr)
+{
+  char* str;
+
+  if (Nil == expr) return bdd_model_cache_hash_string(hash, "");
+
+  str = sprint_node(wffprint, expr);
+  nusmv_assert((char*) NULL != str);
+  hash = bdd_model_cache_hash_string(hash, str);
+  FREE(str);
+
+  return hash;
+}
+
+/*!
+  \brief Adds the DEFINEs and the variables of st to the hash
+
+  Every DEFINE is hashed with its flattened body, every variable
+  with its kind and its declared type, enumerative values in the order
+  of declaration. This makes the key change when the body of a DEFINE
+  or the domain of a variable does, even if the printed model and the
+  names of the bits do not.
+*/
+static unsigned long long
+bdd_model_cache_hash_symbols(SymbTable_ptr st, MasterPrinter_ptr wffprint,
+                             unsigned long long hash)
+{
+  SymbTableIter iter;
+
+  SYMB_TABLE_FOREACH(st, iter, STT_DEFINE | STT_ARRAY_DEFINE) {
+    node_ptr name = SymbTable_iter_get_symbol(st, &iter);
+    node_ptr body = SymbTable_is_symbol_define(st, name)
+      ? SymbTable_get_define_flatten_body(st, name)
+      : SymbTable_get_array_define_flatten_body(st, name);
+
+    hash = bdd_model_cache_hash_expr(wffprint, hash, name);
+    hash = bdd_model_cache_hash_expr(wffprint, hash, body);
+  }
+
+  SYMB_TABLE_FOREACH(st, iter, STT_VAR) {
+    node_ptr name = SymbTable_iter_get_symbol(st, &iter);
+    char* type = SymbType_sprint(SymbTable_get_var_type(st, name), wffprint);
+
+    hash = bdd_model_cache_hash_expr(wffprint, hash, name);
+    hash = bdd_model_cache_hash_string(hash,
+             SymbTable_is_symbol_input_var(st, name) ? "IVAR"
+             : SymbTable_is_symbol_frozen_var(st, name) ? "FROZENVAR"
+             : "VAR");
+    hash = bdd_model_cache_hash_string(hash, type);
+    FREE(type);
+  }
+
+  return hash;
+}
+
+/*!
+  \brief Adds the content of the given file to the hash
+
+  A file that cannot be read is hashed as its name.
+*/
+static unsigned long long
+bdd_model_cache_hash_file(unsigned long long hash, const char* fname)
+{
+  FILE* file = fopen(fname, "r");
+  int c;
+
+  if ((FILE*) NULL == file) return bdd_model_cache_hash_string(hash, fname);
+
+  while (EOF != (c = fgetc(file))) {
+    hash = (hash ^ (unsigned char) c) * BDD_MODEL_CACHE_HASH_PRIME;
+  }
+  fclose(file);
+
+  return (hash ^ '\n') * BDD_MODEL_CACHE_HASH_PRIME;
+}
+
+/*!
+  \brief Returns the line describing the variable at the given index
+
+  The line is made of the index and of the name of the variable, it
+  is NULL if enc has no variable at that index. The returned string
+  must be freed by the caller.
+*/
+static char* bdd_model_cache_var_line(BddEnc_ptr enc,
+                                      MasterPrinter_ptr wffprint, int index)
+{
+  char buf[BDD_MODEL_CACHE_BUF_SIZE];
+  char* name;
+  char* res;
+
+  if (!BddEnc_has_var_at_index(enc, index)) return (char*) NULL;
+
+  name = sprint_node(wffprint, BddEnc_get_var_name_from_index(enc, index));
+  nusmv_assert((char*) NULL != name);
+
+  snprintf(buf, BDD_MODEL_CACHE_BUF_SIZE, "%d ", index);
+  res = ALLOC(char, strlen(buf) + strlen(name) + 1);
+  sprintf(res, "%s%s", buf, name);
+  FREE(name);
+
+  return res;
+}
+
+/*!
+  \brief Opens the cache file prefix.ext
+*/
+static FILE* bdd_model_cache_open(const char* prefix, const char* ext,
+                                  const char* mode)
+{
+  char* fname = ALLOC(char, strlen(prefix) + strlen(ext) + 1);
+  FILE* res;
+
+  sprintf(fname, "%s%s", prefix, ext);
+  res = fopen(fname, mode);
+  FREE(fname);
+
+  return res;
+}
+
+/*!
+  \brief Writes the header and the variable order of a .ord file
+*/
+static boolean bdd_model_cache_write_order(BddEnc_ptr enc, FILE* file,
+                                           int forward_num,
+                                           int backward_num)
+{
+  const NuSMVEnv_ptr env = EnvObject_get_environment(ENV_OBJECT(enc));
+  const MasterPrinter_ptr wffprint =
+    MASTER_PRINTER(NuSMVEnv_get_value(env, ENV_WFF_PRINTER));
+  const DDMgr_ptr dd = BddEnc_get_dd_manager(enc);
+  boolean ok;
+  int i;
+
+  ok = (fprintf(file, "%s %d %d\n", BDD_MODEL_CACHE_HEADER,
+                forward_num, backward_num) > 0);
+
+  for (i = 0; ok && i < dd_get_size(dd); ++i) {
+    char* line = bdd_model_cache_var_line(enc, wffprint, i);
+
+    if ((char*) NULL != line) {
+      ok = (fprintf(file, "%s\n", line) > 0);
+      FREE(line);
+    }
+  }
+
+  return ok;
+}
+
+/*!
+  \brief Reads the header of a .ord file and checks the variable order
+
+  Returns true if the file describes exactly the variable order of
+  enc, in which case the number of forward and backward clusters are
+  returned.
+*/
+static boolean bdd_model_cache_check_order(BddEnc_ptr enc, FILE* file,
+                                           int* forward_num,
+                                           int* backward_num)
+{
+  const NuSMVEnv_ptr env = EnvObject_get_environment(ENV_OBJECT(enc));
+  const MasterPrinter_ptr wffprint =
+    MASTER_PRINTER(NuSMVEnv_get_value(env, ENV_WFF_PRINTER));
+  const DDMgr_ptr dd = BddEnc_get_dd_manager(enc);
+  char header[BDD_MODEL_CACHE_BUF_SIZE];
+  boolean ok;
+  int i;
+
+  ok = (3 == fscanf(file, "%255s %d %d", header, forward_num, backward_num))
+    && (0 == strcmp(header, BDD_MODEL_CACHE_HEADER))
+    && ('\n' == fgetc(file))
+    && (*forward_num >= 0) && (*backward_num >= 0);
+
+  for (i = 0; ok && i < dd_get_size(dd); ++i) {
+    char* line = bdd_model_cache_var_line(enc, wffprint, i);
+
+    if ((char*) NULL != line) {
+      const char* c;
+
+      for (c = line; ok && *c != '\0'; ++c) ok = (*c == fgetc(file));
+      ok = ok && ('\n' == fgetc(file));
+      FREE(line);
+    }
+  }
+
+  return ok && (EOF == fgetc(file));
+}
+
+/*!
+  \brief Returns the referenced transition relations of the clusters
+
+  Returns false if some cluster has no transition relation
+*/
+static boolean bdd_model_cache_get_clusters(ClusterList_ptr clusters,
+                                            bdd_ptr* bdds)
+{
+  ClusterListIterator_ptr iter;
+  int i = 0;
+
+  for (iter = ClusterList_begin(clusters);
+       !ClusterListIterator_is_end(iter);
+       iter = ClusterListIterator_next(iter)) {
+    bdds[i] = Cluster_get_trans(ClusterList_get_cluster(clusters, iter));
+    if ((bdd_ptr) NULL == bdds[i]) return false;
+    ++i;
+  }
+
+  return true;
+}
+
+/*!
+  \brief Builds a cluster list out of the given transition relations
+
+  The references of the given bdds are released.
+*/
+static ClusterList_ptr bdd_model_cache_make_clusters(DDMgr_ptr dd,
+                                                     bdd_ptr* bdds,
+                                                     int num)
+{
+  ClusterList_ptr res = ClusterList_create(dd);
+  int i;
+
+  for (i = 0; i < num; ++i) {
+    Cluster_ptr cluster = Cluster_create(dd);
+
+    Cluster_set_trans(cluster, dd, bdds[i]);
+    bdd_free(dd, bdds[i]);
+    ClusterList_append_cluster(res, cluster);
+  }
+
+  return res;
+}
+
+/*!
+  \brief Logs an operation on the cache file prefix.ext
+*/
+static void bdd_model_cache_log(BddEnc_ptr enc, const char* action,
+                                const char* prefix, const char* ext)
+{
+  const NuSMVEnv_ptr env = EnvObject_get_environment(ENV_OBJECT(enc));
+  const OptsHandler_ptr opts =
+    OPTS_HANDLER(NuSMVEnv_get_value(env, ENV_OPTS_HANDLER));
+
+  if (opt_verbose_level_gt(opts, 0)) {
+    Logger_ptr logger = LOGGER(NuSMVEnv_get_value(env, ENV_LOGGER));
+    Logger_log(logger, "BDD model cache: %s %s%s\n", action, prefix, ext);
+  }
+}
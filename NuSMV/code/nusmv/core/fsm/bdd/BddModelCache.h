@@ -0,0 +1,122 @@
+/* ---------------------------------------------------------------------------
+
+
+  This file is part of the ``fsm.bdd'' package of NuSMV version 2.
+  Copyright (C) 2003 by FBK-irst.
+
+  NuSMV version 2 is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  NuSMV version 2 is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA.
+
+  For more information on NuSMV see <http://nusmv.fbk.eu>
+  or email to <nusmv-users@fbk.eu>.
+  Please report bugs to <nusmv-users@fbk.eu>.
+
+  To contact the NuSMV development board, email to <nusmv@fbk.eu>.
+
+-----------------------------------------------------------------------------*/
+
+/*!
+  \author Alberto Bombardelli
+  \brief On-disk cache of BDD models
+
+  A BDD model is stored in a cache directory under a name which is
+  the hash of the flattened model, of the bodies of its DEFINEs, of the
+  types of its variables, of the partitioning options and of the
+  variable order. Three files are used for every model:
+  - <hash>.ord: the variable order, i.e. the name of the variable
+    of every BDD index, and the number of clusters
+  - <hash>.fsm: init, state invariants, input invariants and the
+    forward and backward transition clusters
+  - <hash>.reach: the frontiers of reachable states, when they have
+    been computed
+  BDDs are stored in dddmp binary format, with variables identified
+  by their index. The .ord file is written last and checked first,
+  so that an interrupted store is never loaded.
+
+*/
+
+
+#ifndef __NUSMV_CORE_FSM_BDD_BDD_MODEL_CACHE_H__
+#define __NUSMV_CORE_FSM_BDD_BDD_MODEL_CACHE_H__
+
+#include "nusmv/core/fsm/bdd/BddFsm.h"
+#include "nusmv/core/enc/bdd/BddEnc.h"
+#include "nusmv/core/trans/bdd/BddTrans.h"
+#include "nusmv/core/trans/bdd/ClusterList.h"
+#include "nusmv/core/trans/trans.h"
+#include "nusmv/core/utils/utils.h"
+
+/*!
+  \brief Returns the cache name of the given model
+
+  The returned name is the path of the cache files without their
+  extension, it is NULL if the cache is disabled (see option
+  bdd_model_cache). The name depends on the given expressions, on
+  the DEFINEs and the variable types of the symbol table of enc, on
+  the partitioning options and on the variable order of enc. The
+  returned string must be freed by the caller.
+*/
+char* BddModelCache_get_prefix(BddEnc_ptr enc,
+                               Expr_ptr init, Expr_ptr invar,
+                               Expr_ptr input, Expr_ptr trans,
+                               const TransType trans_type);
+
+/*!
+  \brief Loads a model from the cache
+
+  Returns true if the model named prefix was found, in which case
+  the referenced init, invar and input BDDs and the forward and
+  backward cluster lists are returned. Nothing is returned on a miss.
+
+  \sa BddModelCache_store_model
+*/
+boolean BddModelCache_load_model(BddEnc_ptr enc, const char* prefix,
+                                 bdd_ptr* init, bdd_ptr* invar,
+                                 bdd_ptr* input,
+                                 ClusterList_ptr* forward,
+                                 ClusterList_ptr* backward);
+
+/*!
+  \brief Stores a model in the cache
+
+  trans must have been built out of cluster lists, otherwise
+  nothing is stored. Failures are reported as warnings.
+
+  \sa BddModelCache_load_model
+*/
+void BddModelCache_store_model(BddEnc_ptr enc, const char* prefix,
+                               bdd_ptr init, bdd_ptr invar, bdd_ptr input,
+                               BddTrans_ptr trans);
+
+/*!
+  \brief Loads the reachable states of a model from the cache
+
+  Returns true if the frontiers of reachable states were found, in
+  which case they become the completed reachable states of fsm.
+
+  \sa BddModelCache_store_reachable
+*/
+boolean BddModelCache_load_reachable(BddFsm_ptr fsm, const char* prefix);
+
+/*!
+  \brief Stores the reachable states of a model in the cache
+
+  Nothing is stored if the reachable states of fsm have not been
+  completely computed. Failures are reported as warnings.
+
+  \sa BddModelCache_load_reachable
+*/
+void BddModelCache_store_reachable(BddFsm_ptr fsm, const char* prefix);
+
+#endif /* __NUSMV_CORE_FSM_BDD_BDD_MODEL_CACHE_H__ */
@@ -41,6 +41,7 @@
 
 #include "nusmv/core/dd/dd.h"
 #include "nusmv/core/opt/opt.h"
+#include "nusmv/core/utils/assoc.h"
 
 /* members are public from within the bdd fsm */
 typedef struct BddFsmCache_TAG 
@@ -61,8 +62,18 @@ typedef struct BddFsmCache_TAG
   struct BddFsmReachable_TAG
   {
     boolean computed;
-    BddStates* layers;   /* array of bdds */
     int diameter;
+    int step;               /* only one frontier out of step is kept */
+    BddStates* frontiers;   /* states at distance i, NULL if not kept */
+    BddStates* checkpoints; /* states within distance i*step (step > 1) */
+    BddStates last;         /* states within distance diameter - 1 */
+
+    /* last frontier rebuilt from a checkpoint, with the states within
+       its distance */
+    int memo_distance;
+    BddStates memo_frontier;
+    BddStates memo_layer;
+
     BddStates reachable_states; /* Used to hold the bdd representing the
                                    whole set of reachable states of the
                                    BddFsm.  These may be computed for
@@ -75,6 +86,15 @@ typedef struct BddFsmCache_TAG
   BddStatesInputs legal_state_input; 
   BddStatesInputs monolithic_trans;
 
+  /* states of already evaluated formulas, within a budget of bdd
+     nodes */
+  struct BddFsmFormulas_TAG
+  {
+    hash_ptr table;      /* key -> entry, NULL until first used */
+    long size;           /* sum of the sizes of the cached bdds */
+    unsigned long clock; /* number of accesses */
+  } formulas;
+
 } BddFsmCache;
 
 /*!
@@ -210,7 +230,9 @@ void BddFsmCache_set_reachable_states(BddFsmCache_ptr self,
   \brief Fills cache structure with reachable states information
 
   Given list layers_list must be reversed, from last
-  layer to the layer corresponding to initial state.  Given list
+  layer to the layer corresponding to initial state. Each layer holds
+  the states reachable within its distance. Only the frontiers are
+  kept, see BddFsmCache_add_reachable_frontiers.  Given list
   layers_list will be destroyed.
 
   \se given list layers_list will be destroyed, cache
@@ -221,6 +243,71 @@ void BddFsmCache_set_reachables(BddFsmCache_ptr self,
                                        const int  diameter,
                                        boolean completed);
 
+/*!
+  \methodof BddFsmCache
+  \brief Appends reachable frontiers to the cache
+
+  Given list frontiers_list must be reversed, and holds the
+  states at exactly distance i, for each i from the cached diameter
+  (0 if nothing is cached) to diameter - 1.
+
+  Only one frontier out of the option reachable_layers_step is kept,
+  together with the states reachable within its distance. The
+  dropped frontiers are rebuilt by the BddFsm when needed. The union
+  of all the frontiers is always kept.
+
+  \se given list frontiers_list will be destroyed, cache
+  changes
+*/
+void BddFsmCache_add_reachable_frontiers(BddFsmCache_ptr self,
+                                         node_ptr frontiers_list,
+                                         const int diameter,
+                                         boolean completed);
+
+/*!
+  \methodof BddFsmCache
+  \brief Remembers the last frontier rebuilt by the BddFsm
+
+  frontier and layer are the states at exactly and within
+  the given distance. They are duplicated.
+*/
+void BddFsmCache_set_reachable_memo(BddFsmCache_ptr self,
+                                    int distance,
+                                    BddStates frontier,
+                                    BddStates layer);
+
+/*!
+  \methodof BddFsmCache
+  \brief Frees the layers kept beside the frontiers
+
+  To be called once every frontier has been rebuilt and
+  stored into the cache. From now on every frontier is kept.
+*/
+void BddFsmCache_drop_reachable_checkpoints(BddFsmCache_ptr self);
+
+/*!
+  \methodof BddFsmCache
+  \brief Returns the cached states of the given formula
+
+  Returns NULL if the formula is not cached. Returned bdd
+  is referenced.
+
+  \se The entry counts one more use
+*/
+bdd_ptr BddFsmCache_get_formula_states(BddFsmCache_ptr self, node_ptr key);
+
+/*!
+  \methodof BddFsmCache
+  \brief Caches the states of the given formula
+
+  states is duplicated. When the sizes of the cached bdds
+  exceed budget, the least used entries are evicted first, and the
+  least recently used among them. Nothing is cached if states alone
+  exceeds budget.
+*/
+void BddFsmCache_set_formula_states(BddFsmCache_ptr self, node_ptr key,
+                                    bdd_ptr states, long budget);
+
 /*!
   \methodof BddFsmCache
   \brief Resets any field in the cache that must be recalculated
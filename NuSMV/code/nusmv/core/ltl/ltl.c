@@ -297,6 +297,14 @@ bdd_ptr Ltl_StructCheckLtlSpec_get_clean_s0(Ltl_StructCheckLtlSpec_ptr self)
   return ltl_clean_bdd(self, self->s0);
 }
 
+BddFsm_ptr Ltl_StructCheckLtlSpec_get_fsm(Ltl_StructCheckLtlSpec_ptr self)
+{
+  LTL_STRUCTCHECKLTLSPEC_CHECK_INSTANCE(self);
+  BDD_FSM_CHECK_INSTANCE(self->fsm);
+
+  return self->fsm;
+}
+
 void Ltl_StructCheckLtlSpec_build(Ltl_StructCheckLtlSpec_ptr self)
 {
   const NuSMVEnv_ptr env = EnvObject_get_environment(ENV_OBJECT(self));
@@ -1072,6 +1080,7 @@ static void ltl_structcheckltlspec_init(Ltl_StructCheckLtlSpec_ptr self,
   self->fsm = BDD_FSM(NULL);
   self->bdd_enc = BDD_ENC(NULL);
   self->dd = (DDMgr_ptr )NULL;
+  self->s0 = (bdd_ptr)NULL;
 
   self->symb_table = SYMB_TABLE(NULL);
   self->tableau_layer = SYMB_LAYER(NULL);
@@ -1134,7 +1143,10 @@ static void ltl_structcheckltlspec_deinit(Ltl_StructCheckLtlSpec_ptr self)
   if (BDD_FSM(NULL) != self->fsm) {
     BddFsm_destroy(self->fsm);
   }
-  bdd_free(self->dd, self->s0);
+  /* s0 is not set if the structure was built but not checked */
+  if ((bdd_ptr)NULL != self->s0) {
+    bdd_free(self->dd, self->s0);
+  }
 
   Prop_Rewriter_destroy(self->rewriter); self->rewriter = NULL;
 }
@@ -235,6 +235,16 @@ bdd_ptr Ltl_StructCheckLtlSpec_get_s0(Ltl_StructCheckLtlSpec_ptr self);
 */
 bdd_ptr Ltl_StructCheckLtlSpec_get_clean_s0(Ltl_StructCheckLtlSpec_ptr self);
 
+/*!
+  \methodof Ltl_StructCheckLtlSpec
+  \brief Get the product of the model and the tableau
+
+  Get the fsm field of an Ltl_StructCheckLtlSpec structure.
+  Assumes the structure being initialized before with
+  Ltl_StructCheckLtlSpec_build. Returned fsm is owned by self.
+*/
+BddFsm_ptr Ltl_StructCheckLtlSpec_get_fsm(Ltl_StructCheckLtlSpec_ptr self);
+
 /*!
   \methodof Ltl_StructCheckLtlSpec
   \brief Initialize the structure by computing the tableau for
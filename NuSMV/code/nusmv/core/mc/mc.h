@@ -59,6 +59,7 @@ typedef struct McCheckInvarOpts_TAG {
   Bdd2bmc_Heuristic bdd2bmc_heuristic;
   int threshold;
   int bmc_length;
+  int workers;
 } McCheckInvarOpts;
 
 void McCheckInvarOpts_init(McCheckInvarOpts* options,
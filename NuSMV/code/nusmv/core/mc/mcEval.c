@@ -69,6 +69,12 @@ typedef bdd_ptr (*BDDPFFBBII)(BddFsm_ptr, bdd_ptr, bdd_ptr, int, int);
 static bdd_ptr eval_ctl_spec_recur(BddFsm_ptr, BddEnc_ptr enc,
                                    node_ptr, node_ptr);
 
+static bdd_ptr eval_ctl_spec_cached(BddFsm_ptr, BddEnc_ptr enc,
+                                    node_ptr, node_ptr);
+
+static bdd_ptr eval_ctl_spec_temporal(BddFsm_ptr, BddEnc_ptr enc,
+                                      node_ptr, node_ptr);
+
 static int eval_compute_recur(BddFsm_ptr, BddEnc_ptr enc,
                               node_ptr, node_ptr);
 
@@ -193,6 +199,71 @@ static bdd_ptr eval_ctl_spec_recur(BddFsm_ptr fsm, BddEnc_ptr enc, node_ptr n,
   case IMPLIES: return(binary_bdd_op(fsm, enc, bdd_or, n, 1, -1, 1, context));
   case IFF:     return(binary_bdd_op(fsm, enc, bdd_xor, n, -1, 1, 1, context));
 
+  case EX: case AX: case EF: case AG: case AF: case EG: case EU: case AU:
+  case EBU: case ABU: case EBF: case ABF: case EBG: case ABG:
+    return(eval_ctl_spec_cached(fsm, enc, n, context));
+
+  default:
+    {
+      bdd_ptr res_bdd = BddEnc_expr_to_bdd(enc, n, context);
+
+      if (res_bdd == NULL) {
+        ErrorMgr_rpterr(errmgr, "eval_ctl_spec: res = NULL after a call to \"eval\".");
+        ErrorMgr_nusmv_exit(errmgr, 1);
+      }
+      return res_bdd;
+    }
+  } /* switch */
+}
+
+/*!
+  \brief Evaluates a temporal formula through the cache of the FSM
+
+  The fixpoints of temporal subformulas repeat across the
+  specifications, so their states are cached by the FSM and shared
+  by all the properties checked on it. The key is the hash-consed
+  pair of context and formula, as properties are hash-consed by the
+  compiler. With the option use_reachable_states the fixpoints are
+  restricted to the reachable states, so a different key is used.
+
+  \sa eval_ctl_spec_temporal
+*/
+static bdd_ptr eval_ctl_spec_cached(BddFsm_ptr fsm, BddEnc_ptr enc,
+                                    node_ptr n, node_ptr context)
+{
+  const NuSMVEnv_ptr env = EnvObject_get_environment(ENV_OBJECT(enc));
+  const NodeMgr_ptr nodemgr =
+    NODE_MGR(NuSMVEnv_get_value(env, ENV_NODE_MGR));
+  const OptsHandler_ptr opts =
+    OPTS_HANDLER(NuSMVEnv_get_value(env, ENV_OPTS_HANDLER));
+  node_ptr key;
+  bdd_ptr res;
+
+  if (get_ctl_cache_size(opts) <= 0) {
+    return eval_ctl_spec_temporal(fsm, enc, n, context);
+  }
+
+  key = find_node(nodemgr, CONTEXT, context, n);
+  if (opt_use_reachable_states(opts)) key = find_node(nodemgr, CONS, key, Nil);
+
+  res = BddFsm_get_cached_formula_states(fsm, key);
+  if ((bdd_ptr) NULL == res) {
+    res = eval_ctl_spec_temporal(fsm, enc, n, context);
+    BddFsm_cache_formula_states(fsm, key, res);
+  }
+
+  return res;
+}
+
+/*!
+  \brief Evaluates a temporal formula
+
+  \sa eval_ctl_spec_recur
+*/
+static bdd_ptr eval_ctl_spec_temporal(BddFsm_ptr fsm, BddEnc_ptr enc,
+                                      node_ptr n, node_ptr context)
+{
+  switch (node_get_type(n)) {
   case EX:      return(unary_mod_bdd_op(fsm, enc, ex, n,  1,  1, context));
   case AX:      return(unary_mod_bdd_op(fsm, enc, ex, n, -1, -1, context));
   case EF:      return(unary_mod_bdd_op(fsm, enc, ef, n,  1,  1, context));
@@ -207,17 +278,10 @@ static bdd_ptr eval_ctl_spec_recur(BddFsm_ptr fsm, BddEnc_ptr enc, node_ptr n,
   case ABF:     return(ternary_mod_bdd_op(fsm, enc, ebg, n, -1, -1, context));
   case EBG:     return(ternary_mod_bdd_op(fsm, enc, ebg, n, 1, 1, context));
   case ABG:     return(ternary_mod_bdd_op(fsm, enc, ebf, n, -1, -1, context));
-  default:
-    {
-      bdd_ptr res_bdd = BddEnc_expr_to_bdd(enc, n, context);
+  default:      error_unreachable_code();
+  }
 
-      if (res_bdd == NULL) {
-        ErrorMgr_rpterr(errmgr, "eval_ctl_spec: res = NULL after a call to \"eval\".");
-        ErrorMgr_nusmv_exit(errmgr, 1);
-      }
-      return res_bdd;
-    }
-  } /* switch */
+  return (bdd_ptr) NULL;
 }
 
 /*!
@@ -175,6 +175,12 @@ static Trace_ptr compute_and_complete_path(BddFsm_ptr fsm,
                                            NodeList_ptr symbols,
                                            Trace_ptr* middle_trace);
 
+static int mc_invar_get_distance(BddFsm_ptr fsm, node_ptr frontiers,
+                                 int cached, bdd_ptr states);
+
+static node_ptr mc_invar_get_frontiers(BddFsm_ptr fsm, node_ptr frontiers,
+                                       int cached, int distance);
+
 static int
 check_invariant_forward_backward_with_break(NuSMVEnv_ptr env,
                                             BddFsm_ptr fsm,
@@ -633,7 +639,7 @@ check_invariant_forward_backward_with_break(NuSMVEnv_ptr env,
   int result, turn;
   bdd_ptr last_reachable_states, last_bad_states;
   int backwardStep, forwardStep;
-  node_ptr forward_reachable_list, backward_reachable_list;
+  node_ptr forward_frontiers, backward_reachable_list;
   bdd_ptr invar_bdd, init_bdd;
   bdd_ptr target_states, bad_frontier, reachable_frontier, tmp;
   Expr_ptr inv_expr = NULL;
@@ -642,7 +648,6 @@ check_invariant_forward_backward_with_break(NuSMVEnv_ptr env,
 
   int diameter;
   boolean completed;
-  BddStates* layers;
 
   bdd_ptr buggy;
   Prop_ptr inputprop = inv_prop;
@@ -680,7 +685,7 @@ check_invariant_forward_backward_with_break(NuSMVEnv_ptr env,
   forwardStep = 0;
 
   /* Initilaize lists */
-  forward_reachable_list = Nil;
+  forward_frontiers = Nil;
   backward_reachable_list = Nil;
 
   /* the invariants for this FSM */
@@ -690,38 +695,23 @@ check_invariant_forward_backward_with_break(NuSMVEnv_ptr env,
   init_bdd = BddFsm_get_init(fsm);
 
   /* Retrive the chached reachable states if any */
-  completed = BddFsm_get_cached_reachable_states(fsm, &layers, &diameter);
+  completed = BddFsm_get_cached_reachable_states(fsm, &diameter);
   if (diameter > 0) {
     /* We have at least one state cached */
 
-    /* Build the list of layers */
-    int i;
-    for (i=0; i< diameter; i++) {
-      forward_reachable_list = cons(nodemgr, (node_ptr) bdd_dup(layers[i]),
-                                    forward_reachable_list);
-    }
-
     /* Update nstep variable, because the possible analysis will not
-       start from the beginning but from the cached size */
+       start from the beginning but from the cached size. The cached
+       frontiers are fetched when needed, the list only holds the
+       ones computed from now on */
     forwardStep = diameter - 1;
 
     /* Reachable states calculated right now is exactly the last layer */
-    last_reachable_states = bdd_dup(layers[diameter - 1]);
+    last_reachable_states = BddFsm_get_cached_reachable_layer(fsm,
+                                                              diameter - 1);
 
-    if (diameter > 1) {
-      /*
-        Compute the last frontier as difference between the last and the
-        second last layer
-      */
-      bdd_ptr neg;
-      neg = bdd_not(dd, layers[diameter - 2]);
-      reachable_frontier = bdd_and(dd, last_reachable_states, neg);
-      bdd_free(dd, neg);
-    }
-    else {
-      /* The initial reachable frontier is the init state itself */
-      reachable_frontier = bdd_dup(last_reachable_states);
-    }
+    /* The last frontier is cached as well */
+    reachable_frontier = BddFsm_get_cached_reachable_frontier(fsm,
+                                                              diameter - 1);
 
     if (opt_verbose_level_gt(opts, 1)) {
       Logger_ptr logger = LOGGER(NuSMVEnv_get_value(env, ENV_LOGGER));
@@ -745,9 +735,9 @@ check_invariant_forward_backward_with_break(NuSMVEnv_ptr env,
     /* The initial reachable frontier is the init state itself */
     reachable_frontier = bdd_dup(last_reachable_states);
 
-    /* Add the initial layer in the layers list */
-    forward_reachable_list = cons(nodemgr, (node_ptr) bdd_dup(last_reachable_states),
-                                  Nil);
+    /* Add the initial frontier in the frontiers list */
+    forward_frontiers = cons(nodemgr, (node_ptr) bdd_dup(reachable_frontier),
+                             Nil);
 
     if (opt_verbose_level_gt(opts, 1)) {
       Logger_ptr logger = LOGGER(NuSMVEnv_get_value(env, ENV_LOGGER));
@@ -785,8 +775,6 @@ check_invariant_forward_backward_with_break(NuSMVEnv_ptr env,
   buggy = bdd_and(dd, last_reachable_states, last_bad_states);
   if (bdd_isnot_false(dd, buggy)) {
     /* There is a bug, so no further analysis is required */
-    int pos, upper, lower, i;
-    boolean state_buggy, previous_state_safe;
     bdd_ptr buggy_first, init_state;
 
     if (opt_verbose_level_gt(opts, 1)) {
@@ -843,50 +831,21 @@ check_invariant_forward_backward_with_break(NuSMVEnv_ptr env,
 
       /* Get the counter example if needed */
       if (opt_counter_examples(opts)) {
+        node_ptr path_frontiers;
+        int pos;
+
         if (opt_verbose_level_gt(opts, 1)) {
           Logger_ptr logger = LOGGER(NuSMVEnv_get_value(env, ENV_LOGGER));
           Logger_log(logger,
-                  "Starting the binary search to fin the shortest counterexample.\n");
+                  "Starting the search to find the shortest counterexample.\n");
         }
 
-        /*
-           Find the first buggy frontier with binary search:
-              INVARIANTS:
-                layers[upper] is always unsafe.
-                layers[lower] is always safe.
-                (layers[0] is safe because otherwise we would be catched by
-                 the previous check)
-         */
-        upper = diameter - 1;
-        lower = 0;
-        do {
-
-          if (2 <= (upper - lower)) {
-            pos = ((upper + lower) / 2);
-          }
-          else {
-            /* adjacency case: bug is in upper */
-            nusmv_assert( 1 == (upper - lower) ) ;
-            pos = upper;
-          }
-
-          bdd_free(dd, target_states);
-          target_states = bdd_and(dd, layers[pos], last_bad_states);
-
-          state_buggy = bdd_isnot_false(dd, target_states);
-
-          tmp = bdd_and(dd, layers[pos-1], last_bad_states);
-          previous_state_safe = bdd_is_false(dd, tmp);
-          bdd_free(dd, tmp);
-
-          if (state_buggy) {
-            upper = pos;
-          }
-          else {
-            lower = pos;
-          }
-        } while(!(state_buggy && previous_state_safe));
-        /* This condition is always reached because a bug must exist */
+        /* Find the first buggy frontier, scanning the cached frontiers
+           one at a time. A bug must exist, and the frontier 0 is safe
+           because otherwise we would be catched by the previous check */
+        pos = mc_invar_get_distance(fsm, forward_frontiers, diameter,
+                                    last_bad_states);
+        nusmv_assert(0 < pos);
 
         if (opt_verbose_level_gt(opts, 1)) {
           Logger_ptr logger = LOGGER(NuSMVEnv_get_value(env, ENV_LOGGER));
@@ -896,23 +855,19 @@ check_invariant_forward_backward_with_break(NuSMVEnv_ptr env,
                   pos);
         }
 
-        /* Reduce the layers list length to pos where the pos-th
-           frontier is the first buggy one */
-        for (i=pos+1; i<diameter; i++) {
-          node_ptr val = car(forward_reachable_list);
-          node_ptr nodetmp;
+        path_frontiers = mc_invar_get_frontiers(fsm, forward_frontiers,
+                                                diameter, pos);
 
-          /* Free the stored bdd (was duplicated in insertion) */
-          bdd_free(dd, (bdd_ptr) val);
-
-          nodetmp = forward_reachable_list;
-          forward_reachable_list = cdr(forward_reachable_list);
-          free_node(nodemgr, nodetmp);
-        }
+        bdd_free(dd, target_states);
+        target_states = bdd_and(dd, (bdd_ptr) car(path_frontiers),
+                                last_bad_states);
 
         /* Generate counter example */
         *output_trace = compute_path_fb(fsm, target_states,
-                                        forward_reachable_list, Nil, symbols);
+                                        path_frontiers, Nil, symbols);
+
+        walk_dd(dd, bdd_free, path_frontiers);
+        free_list(nodemgr, path_frontiers);
       }
 
       /* Update property fields */
@@ -925,8 +880,8 @@ check_invariant_forward_backward_with_break(NuSMVEnv_ptr env,
     bdd_free(dd, init_state);
 
     /* Free the list */
-    walk_dd(dd, bdd_free, forward_reachable_list);
-    free_list(nodemgr, forward_reachable_list);
+    walk_dd(dd, bdd_free, forward_frontiers);
+    free_list(nodemgr, forward_frontiers);
   }
   else {
     if (completed) {
@@ -947,8 +902,8 @@ check_invariant_forward_backward_with_break(NuSMVEnv_ptr env,
       result = 1;
 
       /* Free the list */
-      walk_dd(dd, bdd_free, forward_reachable_list);
-      free_list(nodemgr, forward_reachable_list);
+      walk_dd(dd, bdd_free, forward_frontiers);
+      free_list(nodemgr, forward_frontiers);
     }
     else {
       /* The analysis was not completed and the bug is not in cached
@@ -1016,9 +971,10 @@ check_invariant_forward_backward_with_break(NuSMVEnv_ptr env,
             /* release the negation */
             bdd_free(dd, not_f_prev_reachable);
 
-            /* Append reachable states to the layers list */
-            forward_reachable_list =cons(nodemgr, (node_ptr)bdd_dup(last_reachable_states),
-                                         forward_reachable_list);
+            /* Append the frontier to the frontiers list */
+            forward_frontiers = cons(nodemgr,
+                                     (node_ptr) bdd_dup(reachable_frontier),
+                                     forward_frontiers);
 
             /* Free the targets since they are no more significative
                (the frontier changed) */
@@ -1123,9 +1079,15 @@ check_invariant_forward_backward_with_break(NuSMVEnv_ptr env,
 
           if (forwardStep > 1) {
             /* We have explored some space forward so we will exclude it from
-               BMC search */
-            reachables = BddEnc_bdd_to_expr(bdd_enc,
-                                            (bdd_ptr)car(cdr(forward_reachable_list)));
+               BMC search. This is the previous layer, i.e. the reachable
+               states but the last frontier */
+            bdd_ptr not_frontier = bdd_not(dd, reachable_frontier);
+            bdd_ptr prev_reachable = bdd_and(dd, last_reachable_states,
+                                             not_frontier);
+
+            reachables = BddEnc_bdd_to_expr(bdd_enc, prev_reachable);
+            bdd_free(dd, prev_reachable);
+            bdd_free(dd, not_frontier);
           }
           else {
             /* No space explored, so nothing to exclude */
@@ -1237,11 +1199,18 @@ check_invariant_forward_backward_with_break(NuSMVEnv_ptr env,
                 /* 'trace' is used as the middle fragment, thus we can
                    make no assumptions on it. (i.e. it may or may not
                    be NULL, depending on other fragments. */
+                node_ptr path_frontiers =
+                  mc_invar_get_frontiers(fsm, forward_frontiers, diameter,
+                                         forwardStep);
+
                 *output_trace = complete_bmc_trace_with_bdd(&trace, symbols,
                                                            bdd_enc,
                                                            fsm,
-                                                           forward_reachable_list,
+                                                           path_frontiers,
                                                            backward_reachable_list);
+
+                walk_dd(dd, bdd_free, path_frontiers);
+                free_list(nodemgr, path_frontiers);
               }
 
               Prop_set_status(inv_prop, Prop_False);
@@ -1259,16 +1228,16 @@ check_invariant_forward_backward_with_break(NuSMVEnv_ptr env,
           /* Update cache if possible */
           if (forwardStep > diameter) {
             /* Cache the analysis
-               NOTE: this function frees forward_reachable_list */
-            BddFsm_update_cached_reachable_states(fsm,
-                                                  forward_reachable_list,
-                                                  forwardStep+1,
-                                                  false);
+               NOTE: this function frees forward_frontiers */
+            BddFsm_update_cached_reachable_frontiers(fsm,
+                                                     forward_frontiers,
+                                                     forwardStep+1,
+                                                     false);
           }
           else {
             /* Free the forward list */
-            walk_dd(dd, bdd_free, forward_reachable_list);
-            free_list(nodemgr, forward_reachable_list);
+            walk_dd(dd, bdd_free, forward_frontiers);
+            free_list(nodemgr, forward_frontiers);
           }
 
           /* Free the backward list */
@@ -1302,13 +1271,29 @@ check_invariant_forward_backward_with_break(NuSMVEnv_ptr env,
         /* Set the status */
         Prop_set_status(inv_prop, Prop_False);
 
-        /* Compute the counter example */
+        /* Compute the counter example from the closest target
+           states */
         if (opt_counter_examples(opts)) {
+          int pos = mc_invar_get_distance(fsm, forward_frontiers, diameter,
+                                          target_states);
+          node_ptr path_frontiers;
+          bdd_ptr closest_targets;
+
+          nusmv_assert(0 <= pos);
+          path_frontiers = mc_invar_get_frontiers(fsm, forward_frontiers,
+                                                  diameter, pos);
+          closest_targets = bdd_and(dd, (bdd_ptr) car(path_frontiers),
+                                    target_states);
+
           *output_trace = compute_path_fb(fsm,
-                                         target_states,
-                                         forward_reachable_list,
+                                          closest_targets,
+                                          path_frontiers,
                                           backward_reachable_list,
                                           symbols);
+
+          bdd_free(dd, closest_targets);
+          walk_dd(dd, bdd_free, path_frontiers);
+          free_list(nodemgr, path_frontiers);
         }
 
         /* The property is false */
@@ -1325,28 +1310,28 @@ check_invariant_forward_backward_with_break(NuSMVEnv_ptr env,
         if (bdd_is_false(dd, reachable_frontier)) {
           /* We completed the forward analysis */
           /* Cache the analysis
-             NOTE: this function frees plan_reach_list */
-          BddFsm_update_cached_reachable_states(fsm,
-                                                forward_reachable_list,
-                                                forwardStep+1,
-                                                true);
+             NOTE: this function frees forward_frontiers */
+          BddFsm_update_cached_reachable_frontiers(fsm,
+                                                   forward_frontiers,
+                                                   forwardStep+1,
+                                                   true);
         }
         else {
           /* We did not complete the forward analysis but we have new states*/
           /* Cache the analysis
-             NOTE: this function frees plan_reach_list */
-          BddFsm_update_cached_reachable_states(fsm,
-                                                forward_reachable_list,
-                                                forwardStep+1,
-                                                false);
+             NOTE: this function frees forward_frontiers */
+          BddFsm_update_cached_reachable_frontiers(fsm,
+                                                   forward_frontiers,
+                                                   forwardStep+1,
+                                                   false);
         }
       }
       else {
         /* We have not added any new state */
 
         /* Free the forward list */
-        walk_dd(dd, bdd_free, forward_reachable_list);
-        free_list(nodemgr, forward_reachable_list);
+        walk_dd(dd, bdd_free, forward_frontiers);
+        free_list(nodemgr, forward_frontiers);
       }
     }
   }
@@ -1377,6 +1362,79 @@ void print_invar(OStream_ptr file, Prop_ptr p, Prop_PrintFmt fmt)
   Prop_print(p, file, fmt);
 }
 
+/*!
+  \brief Returns the distance of the closest of the given states
+
+  The first cached frontiers are taken from the cache of fsm,
+  one at a time. The following ones are in frontiers, from the
+  outermost one. Returns -1 if no state is reachable.
+*/
+static int mc_invar_get_distance(BddFsm_ptr fsm, node_ptr frontiers,
+                                 int cached, bdd_ptr states)
+{
+  DDMgr_ptr dd = BddEnc_get_dd_manager(BddFsm_get_bdd_encoding(fsm));
+  node_ptr iter;
+  int res = -1;
+  int i;
+
+  for (i = 0; i < cached; ++i) {
+    bdd_ptr frontier = BddFsm_get_cached_reachable_frontier(fsm, i);
+    boolean found = bdd_intersected(dd, frontier, states);
+
+    bdd_free(dd, frontier);
+    if (found) return i;
+  }
+
+  /* frontiers is reversed, the closest one is found last */
+  i = cached + llength(frontiers) - 1;
+  for (iter = frontiers; Nil != iter; iter = cdr(iter), --i) {
+    if (bdd_intersected(dd, (bdd_ptr) car(iter), states)) res = i;
+  }
+
+  return res;
+}
+
+/*!
+  \brief Returns the frontiers up to the given distance
+
+  The first cached frontiers are taken from the cache of fsm,
+  the following ones from frontiers, that holds them from the
+  outermost one. The returned list is reversed as well, and holds
+  referenced bdds. It must be freed by the caller.
+*/
+static node_ptr mc_invar_get_frontiers(BddFsm_ptr fsm, node_ptr frontiers,
+                                       int cached, int distance)
+{
+  const NuSMVEnv_ptr env =
+    EnvObject_get_environment(ENV_OBJECT(BddFsm_get_bdd_encoding(fsm)));
+  const NodeMgr_ptr nodemgr =
+    NODE_MGR(NuSMVEnv_get_value(env, ENV_NODE_MGR));
+  node_ptr res = Nil;
+  node_ptr tail = Nil;
+  node_ptr iter;
+  int i;
+
+  for (i = 0; i < cached && i <= distance; ++i) {
+    res = cons(nodemgr,
+               (node_ptr) BddFsm_get_cached_reachable_frontier(fsm, i), res);
+  }
+
+  /* collects the wanted frontiers of the list in increasing order */
+  i = cached + llength(frontiers) - 1;
+  for (iter = frontiers; Nil != iter; iter = cdr(iter), --i) {
+    if (i <= distance) {
+      tail = cons(nodemgr, (node_ptr) bdd_dup((bdd_ptr) car(iter)), tail);
+    }
+  }
+
+  for (iter = tail; Nil != iter; iter = cdr(iter)) {
+    res = cons(nodemgr, car(iter), res);
+  }
+  free_list(nodemgr, tail);
+
+  return res;
+}
+
 /*!
   \brief Prints the result of the check if the check was performed,
    does nothing otherwise
@@ -1179,6 +1179,9 @@ int Mc_check_invar(NuSMVEnv_ptr env,
     if (NULL != prop) {
       Prop_verify(prop);
     }
+    else if (1 < options->workers) {
+      PropDb_verify_all_type_parallel(prop_db, Prop_Invar, options->workers);
+    }
     else {
       if (opt_use_coi_size_sorting(opts)) {
         FlatHierarchy_ptr hierarchy =
@@ -1227,6 +1230,7 @@ void McCheckInvarOpts_init(McCheckInvarOpts* self,
 #else
   self->bmc_length = MC_CHECK_INVAR_OPTS_INVALID;
 #endif
+  self->workers = 1;
 }
 
 /*!
@@ -1242,6 +1246,7 @@ void McCheckInvarOpts_init_invalid(McCheckInvarOpts* self)
   self->bdd2bmc_heuristic = MC_CHECK_INVAR_OPTS_INVALID;
   self->threshold = MC_CHECK_INVAR_OPTS_INVALID;
   self->bmc_length = MC_CHECK_INVAR_OPTS_INVALID;
+  self->workers = MC_CHECK_INVAR_OPTS_INVALID;
 }
 
 /*!
@@ -1256,7 +1261,8 @@ boolean McCheckInvarOpts_is_valid(McCheckInvarOpts* self)
     self->strategy != MC_CHECK_INVAR_OPTS_INVALID &&
     self->fb_heuristic != MC_CHECK_INVAR_OPTS_INVALID &&
     self->bdd2bmc_heuristic != MC_CHECK_INVAR_OPTS_INVALID &&
-    self->threshold != MC_CHECK_INVAR_OPTS_INVALID
+    self->threshold != MC_CHECK_INVAR_OPTS_INVALID &&
+    self->workers != MC_CHECK_INVAR_OPTS_INVALID
 #if NUSMV_HAVE_SAT_SOLVER
     && self->bmc_length != MC_CHECK_INVAR_OPTS_INVALID
 #endif
@@ -224,6 +224,13 @@ void NodeMgr_destroy(NodeMgr_ptr self)
   Object_destroy(OBJECT(self), NULL);
 }
 
+size_t NodeMgr_get_memory_used(const NodeMgr_ptr self)
+{
+  NODE_MGR_CHECK_INSTANCE(self);
+
+  return self->memused;
+}
+
 
 #ifdef PROFILE_NODE
 
@@ -296,6 +296,15 @@ NodeMgr_ptr NodeMgr_create(const NuSMVEnv_ptr env);
 */
 void NodeMgr_destroy(NodeMgr_ptr self);
 
+/*!
+  \methodof NodeMgr
+  \brief Returns the memory allocated for the nodes, in bytes
+
+  The memory is allocated in chunks and never released, so the value
+  can only grow.
+*/
+size_t NodeMgr_get_memory_used(const NodeMgr_ptr self);
+
 /*!
   \methodof NodeMgr
   \brief Prints a summary of <tt>node</tt> resources usage
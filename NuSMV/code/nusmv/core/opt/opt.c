@@ -211,6 +211,30 @@ boolean opt_trans_order_file(OptsHandler_ptr opt)
   return (get_trans_order_file(opt) != NULL);
 }
 
+/******************************************************************************/
+/* BDD_MODEL_CACHE */
+void set_bdd_model_cache(OptsHandler_ptr opt, char* str)
+{
+  boolean res = OptsHandler_set_option_value(opt, BDD_MODEL_CACHE, str);
+  nusmv_assert(res);
+}
+
+void reset_bdd_model_cache(OptsHandler_ptr opt)
+{
+  boolean res = OptsHandler_reset_option_value(opt, BDD_MODEL_CACHE);
+  nusmv_assert(res);
+}
+
+char* get_bdd_model_cache(OptsHandler_ptr opt)
+{
+  return OptsHandler_get_string_option_value(opt, BDD_MODEL_CACHE);
+}
+
+boolean opt_bdd_model_cache(OptsHandler_ptr opt)
+{
+  return (get_bdd_model_cache(opt) != NULL);
+}
+
 /******************************************************************************/
 /* OUTPUT_FLATTEN_MODEL */
 
@@ -730,6 +754,58 @@ int get_image_cluster_size(OptsHandler_ptr opt)
   return OptsHandler_get_int_option_value(opt, IMAGE_CLUSTER_SIZE);
 }
 
+/******************************************************************************/
+/* REACHABLE_LAYERS_STEP */
+void set_reachable_layers_step(OptsHandler_ptr opt, int step)
+{
+  boolean res = OptsHandler_set_int_option_value(opt, REACHABLE_LAYERS_STEP,
+                                                 step);
+  nusmv_assert(res);
+}
+void reset_reachable_layers_step(OptsHandler_ptr opt)
+{
+  boolean res = OptsHandler_reset_option_value(opt, REACHABLE_LAYERS_STEP);
+  nusmv_assert(res);
+}
+int get_reachable_layers_step(OptsHandler_ptr opt)
+{
+  return OptsHandler_get_int_option_value(opt, REACHABLE_LAYERS_STEP);
+}
+
+/******************************************************************************/
+/* CTL_CACHE_SIZE */
+void set_ctl_cache_size(OptsHandler_ptr opt, int size)
+{
+  boolean res = OptsHandler_set_int_option_value(opt, CTL_CACHE_SIZE, size);
+  nusmv_assert(res);
+}
+void reset_ctl_cache_size(OptsHandler_ptr opt)
+{
+  boolean res = OptsHandler_reset_option_value(opt, CTL_CACHE_SIZE);
+  nusmv_assert(res);
+}
+int get_ctl_cache_size(OptsHandler_ptr opt)
+{
+  return OptsHandler_get_int_option_value(opt, CTL_CACHE_SIZE);
+}
+
+/******************************************************************************/
+/* STAT_CACHE_SIZE */
+void set_stat_cache_size(OptsHandler_ptr opt, int size)
+{
+  boolean res = OptsHandler_set_int_option_value(opt, STAT_CACHE_SIZE, size);
+  nusmv_assert(res);
+}
+void reset_stat_cache_size(OptsHandler_ptr opt)
+{
+  boolean res = OptsHandler_reset_option_value(opt, STAT_CACHE_SIZE);
+  nusmv_assert(res);
+}
+int get_stat_cache_size(OptsHandler_ptr opt)
+{
+  return OptsHandler_get_int_option_value(opt, STAT_CACHE_SIZE);
+}
+
 /******************************************************************************/
 /* IGNORE_INIT_FILE */
 void set_ignore_init_file(OptsHandler_ptr opt)
@@ -108,6 +108,13 @@
 */
 #define DEFAULT_TRANS_ORDER_FILE (char *)NULL
 
+/*!
+  \brief Default directory of the on-disk BDD model cache
+
+  NULL means that the cache is disabled
+*/
+#define DEFAULT_BDD_MODEL_CACHE (char *)NULL
+
 /*!
   \brief \todo Missing synopsis
 
@@ -153,6 +160,23 @@
 */
 #define DEFAULT_IMAGE_CLUSTER_SIZE 1000
 
+/*!
+  \brief Default distance between the kept reachable frontiers
+
+  1 means that every frontier is kept
+*/
+#define DEFAULT_REACHABLE_LAYERS_STEP 1
+
+/*!
+  \brief Default budget of the CTL subformula cache, in BDD nodes
+*/
+#define DEFAULT_CTL_CACHE_SIZE 1000000
+
+/*!
+  \brief Default budget of each cache of statistical runs, in entries
+*/
+#define DEFAULT_STAT_CACHE_SIZE 100000
+
 /*!
   \brief \todo Missing synopsis
 
@@ -371,6 +395,15 @@ typedef enum {
 */
 #define OUTPUT_FLATTEN_MODEL_FILE "output_flatten_model_file"
 
+/*!
+  \brief Directory of the on-disk BDD model cache
+
+  When set, the BDD FSM (variable order, transition clusters,
+  init, invariants and reachable states) is stored in this directory
+  and reloaded by later runs on the same model.
+*/
+#define BDD_MODEL_CACHE "bdd_model_cache"
+
 /*!
   \brief \todo Missing synopsis
 
@@ -539,6 +572,35 @@ typedef enum {
 */
 #define IMAGE_CLUSTER_SIZE "image_cluster_size"
 
+/*!
+  \brief Distance between the reachable frontiers kept by BDD FSMs
+
+  When greater than 1, only every m-th frontier of the reachable
+  states is kept, together with the states reachable within that
+  distance. The other frontiers are recomputed by image when they are
+  needed, e.g. to build a counterexample.
+*/
+#define REACHABLE_LAYERS_STEP "reachable_layers_step"
+
+/*!
+  \brief Budget of the CTL subformula cache, in BDD nodes
+
+  The states satisfying the temporal subformulas of CTL
+  specifications are cached by each BDD FSM, and reused by the
+  following specifications. 0 disables the cache.
+*/
+#define CTL_CACHE_SIZE "ctl_cache_size"
+
+/*!
+  \brief Budget of each cache of statistical runs, in entries
+
+  Statistical model checking caches per state (or per execution)
+  results, e.g. the BDDs of the sampled states and the verified
+  executions. A cache holding at least this many entries is emptied
+  before the next execution. 0 empties them at every execution.
+*/
+#define STAT_CACHE_SIZE "stat_cache_size"
+
 /*!
   \brief \todo Missing synopsis
 
@@ -1116,6 +1178,27 @@ char *  get_trans_order_file(OptsHandler_ptr);
 */
 boolean opt_trans_order_file(OptsHandler_ptr);
 
+/*!
+  \brief Sets the directory of the on-disk BDD model cache
+*/
+void    set_bdd_model_cache(OptsHandler_ptr, char *);
+
+/*!
+  \brief Disables the on-disk BDD model cache
+*/
+void    reset_bdd_model_cache(OptsHandler_ptr);
+
+/*!
+  \brief Returns the directory of the on-disk BDD model cache, or
+  NULL if the cache is disabled
+*/
+char *  get_bdd_model_cache(OptsHandler_ptr);
+
+/*!
+  \brief Returns true if the on-disk BDD model cache is enabled
+*/
+boolean opt_bdd_model_cache(OptsHandler_ptr);
+
 /*!
   \brief \todo Missing synopsis
 
@@ -1683,6 +1766,52 @@ void reset_image_cluster_size(OptsHandler_ptr);
 */
 int get_image_cluster_size(OptsHandler_ptr);
 
+/*!
+  \brief Sets the distance between the kept reachable frontiers
+*/
+void set_reachable_layers_step(OptsHandler_ptr, int);
+
+/*!
+  \brief Resets the distance between the kept reachable frontiers
+*/
+void reset_reachable_layers_step(OptsHandler_ptr);
+
+/*!
+  \brief Returns the distance between the kept reachable frontiers
+*/
+int get_reachable_layers_step(OptsHandler_ptr);
+
+/*!
+  \brief Sets the budget of the CTL subformula cache
+*/
+void set_ctl_cache_size(OptsHandler_ptr, int);
+
+/*!
+  \brief Resets the budget of the CTL subformula cache
+*/
+void reset_ctl_cache_size(OptsHandler_ptr);
+
+/*!
+  \brief Returns the budget of the CTL subformula cache, in BDD nodes
+*/
+int get_ctl_cache_size(OptsHandler_ptr);
+
+/*!
+  \brief Sets the budget of the caches of statistical runs
+*/
+void set_stat_cache_size(OptsHandler_ptr, int);
+
+/*!
+  \brief Resets the budget of the caches of statistical runs
+*/
+void reset_stat_cache_size(OptsHandler_ptr);
+
+/*!
+  \brief Returns the budget of the caches of statistical runs, in
+  entries
+*/
+int get_stat_cache_size(OptsHandler_ptr);
+
 /*!
   \brief \todo Missing synopsis
 
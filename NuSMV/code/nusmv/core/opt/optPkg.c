@@ -168,6 +168,10 @@ void Opt_Pkg_init(NuSMVEnv_ptr const env)
                                        opt_trans_order_file_trigger, env);
   nusmv_assert(res);
 
+  res = OptsHandler_register_generic_option(opts, BDD_MODEL_CACHE,
+                                            DEFAULT_BDD_MODEL_CACHE, true);
+  nusmv_assert(res);
+
   res = OptsHandler_register_generic_option(opts, OUTPUT_FLATTEN_MODEL_FILE,
                                             (char*)NULL, true);
   nusmv_assert(res);
@@ -351,6 +355,18 @@ void Opt_Pkg_init(NuSMVEnv_ptr const env)
                                         DEFAULT_IMAGE_CLUSTER_SIZE, true);
   nusmv_assert(res);
 
+  res = OptsHandler_register_int_option(opts, REACHABLE_LAYERS_STEP,
+                                        DEFAULT_REACHABLE_LAYERS_STEP, true);
+  nusmv_assert(res);
+
+  res = OptsHandler_register_int_option(opts, CTL_CACHE_SIZE,
+                                        DEFAULT_CTL_CACHE_SIZE, true);
+  nusmv_assert(res);
+
+  res = OptsHandler_register_int_option(opts, STAT_CACHE_SIZE,
+                                        DEFAULT_STAT_CACHE_SIZE, true);
+  nusmv_assert(res);
+
   res = OptsHandler_register_bool_option(opts, IWLS95_PREORDER, false, true);
   nusmv_assert(res);
 
@@ -466,6 +466,25 @@ void PropDb_verify_prop_at_index(const PropDb_ptr self,
 void PropDb_verify_all_type_wrapper(PropDb_ptr const self,
                                     const Prop_Type type);
 
+/*!
+  \methodof PropDb
+  \brief Verifies all properties of a given type with forked workers
+
+  The properties of the given type not yet checked are
+  handed out to at most workers forked processes, starting from the
+  ones with the largest cone of influence. Each worker verifies them
+  in its own copy of the DD manager. Statuses and counterexamples are
+  merged back into the properties and the trace manager of the
+  calling process, which also prints the results as they arrive.
+
+  Only Prop_Ctl, Prop_Ltl and Prop_Invar are supported. When workers
+  is not greater than 1, or workers cannot be forked, this behaves as
+  PropDb_verify_all_type_wrapper.
+*/
+void PropDb_verify_all_type_parallel(PropDb_ptr const self,
+                                     const Prop_Type type,
+                                     const int workers);
+
 /* Miscellaneous **************************************************************/
 
 /*!
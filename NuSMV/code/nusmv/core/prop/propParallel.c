@@ -0,0 +1,984 @@
+/* ---------------------------------------------------------------------------
+
+
+  This file is part of the ``prop'' package of NuSMV version 2.
+  Copyright (C) 2010 by FBK-irst.
+
+  NuSMV version 2 is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  NuSMV version 2 is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA.
+
+  For more information on NuSMV see <http://nusmv.fbk.eu>
+  or email to <nusmv-users@fbk.eu>.
+  Please report bugs to <nusmv-users@fbk.eu>.
+
+  To contact the NuSMV development board, email to <nusmv@fbk.eu>.
+
+-----------------------------------------------------------------------------*/
+
+/*!
+  \author Alberto Bombardelli
+  \brief Parallel verification of the properties of a PropDb
+
+  Properties are handed out, largest cone of influence first, to
+  forked workers. Being a copy of the whole process, every worker
+  owns its DD manager and verifies the properties it receives with
+  Prop_verify, with its output discarded.
+
+  Every worker is connected to the parent by a request pipe, on which
+  it receives the index of the next property, and by a result pipe.
+  The parent polls the result pipes of the busy workers, so that it
+  serves the first worker that completes, and sees the end of the
+  result pipe of a worker that terminated unexpectedly. Counterexamples
+  travel as one cube per step over the DD variables existing at fork
+  time, restricted to the symbols of the master FSM, and are rebuilt
+  by the parent in its own DD manager.
+
+*/
+
+#if HAVE_CONFIG_H
+# include "nusmv-config.h"
+#endif
+
+#include "nusmv/core/prop/PropDb.h"
+#include "nusmv/core/prop/Prop.h"
+#include "nusmv/core/prop/propInt.h"
+
+#include "nusmv/core/utils/ErrorMgr.h"
+#include "nusmv/core/utils/StreamMgr.h"
+#include "nusmv/core/node/NodeMgr.h"
+#include "nusmv/core/enc/enc.h"
+#include "nusmv/core/enc/bdd/BddEnc.h"
+#include "nusmv/core/fsm/sexp/SexpFsm.h"
+#include "nusmv/core/mc/mc.h"
+#include "nusmv/core/trace/pkg_trace.h"
+#include "nusmv/core/trace/Trace.h"
+#include "nusmv/core/trace/TraceMgr.h"
+#include "nusmv/core/wff/ExprMgr.h"
+
+#if NUSMV_HAVE_UNISTD_H
+# include <unistd.h>
+#endif
+
+#if NUSMV_HAVE_SYS_WAIT_H
+# include <sys/wait.h>
+#endif
+
+#if NUSMV_HAVE_SIGNAL_H
+# include <signal.h>
+#endif
+
+#if NUSMV_HAVE_POLL_H
+# include <poll.h>
+#endif
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+
+/*---------------------------------------------------------------------------*/
+/* Constant declarations                                                     */
+/*---------------------------------------------------------------------------*/
+
+/* true iff worker processes can be forked on this platform */
+#define PROP_DB_HAS_WORKERS \
+  (NUSMV_HAVE_FORK && NUSMV_HAVE_UNISTD_H && NUSMV_HAVE_SYS_WAIT_H && \
+   NUSMV_HAVE_SIGNAL_H && NUSMV_HAVE_POLL_H)
+
+/* status sent by a worker when the verification raised an error */
+#define PROP_DB_VERIFY_ERROR -1
+
+#if PROP_DB_HAS_WORKERS
+
+/*---------------------------------------------------------------------------*/
+/* Structure declarations                                                    */
+/*---------------------------------------------------------------------------*/
+
+/*!
+  \brief A forked worker, as seen by the parent process
+
+*/
+typedef struct PropWorker_TAG {
+  int pid;
+
+  /* parent -> worker: index of the property to verify, -1 once the
+     worker is lost */
+  int request_fd;
+  /* worker -> parent: status and counterexample */
+  int result_fd;
+
+  /* property under verification, -1 when idle */
+  int prop;
+} PropWorker;
+
+/*!
+  \brief The state shared by the parent and the workers
+
+  It is filled before forking, so that workers and parent agree on
+  the properties indices, on the symbols indices and on the number
+  of DD variables.
+*/
+typedef struct PropSchedule_TAG {
+  NuSMVEnv_ptr env;
+  Prop_Type type;
+
+  /* properties to verify, largest cone of influence first */
+  Prop_ptr* props;
+  int props_num;
+
+  /* symbols of the master FSM, a counterexample is expressed on */
+  node_ptr* symbols;
+  int symbols_num;
+
+  /* DD variables at fork time */
+  int dd_size;
+
+  PropWorker* workers;
+  int workers_num;
+} PropSchedule;
+
+/*---------------------------------------------------------------------------*/
+/* Static function prototypes                                                */
+/*---------------------------------------------------------------------------*/
+
+static boolean prop_db_verify_parallel(PropDb_ptr self,
+                                       const Prop_Type type,
+                                       const int workers);
+
+static boolean prop_db_schedule_init(PropSchedule* schedule,
+                                     PropDb_ptr self,
+                                     const Prop_Type type);
+
+static void prop_db_schedule_deinit(PropSchedule* schedule);
+
+static int prop_db_start_workers(PropSchedule* schedule, const int workers);
+
+static void prop_db_stop_workers(PropSchedule* schedule);
+
+static void prop_db_worker_loop(PropSchedule* schedule,
+                                const int request_fd,
+                                const int result_fd)
+  NUSMV_FUNCATTR_NORETURN;
+
+static boolean prop_db_send_result(PropSchedule* schedule,
+                                   const Prop_ptr prop,
+                                   const int status,
+                                   const int fd);
+
+static boolean prop_db_send_step(PropSchedule* schedule,
+                                 const Trace_ptr trace,
+                                 const TraceIter step,
+                                 const TraceIteratorType iter_type,
+                                 int* cube,
+                                 const int fd);
+
+static boolean prop_db_request(PropSchedule* schedule, PropWorker* worker,
+                               const int prop);
+
+static boolean prop_db_receive_result(PropSchedule* schedule,
+                                      PropWorker* worker);
+
+static Trace_ptr prop_db_receive_trace(PropSchedule* schedule, const int fd);
+
+static void prop_db_print_result(PropSchedule* schedule,
+                                 const Prop_ptr prop,
+                                 const boolean has_trace);
+
+static boolean prop_db_write_all(const int fd, const void* buf,
+                                 const size_t size);
+
+static boolean prop_db_read_all(const int fd, void* buf, const size_t size);
+
+#endif /* PROP_DB_HAS_WORKERS */
+
+/*---------------------------------------------------------------------------*/
+/* Definition of exported functions                                          */
+/*---------------------------------------------------------------------------*/
+
+void PropDb_verify_all_type_parallel(PropDb_ptr const self,
+                                     const Prop_Type type,
+                                     const int workers)
+{
+  PROP_DB_CHECK_INSTANCE(self);
+  nusmv_assert(Prop_Ctl == type || Prop_Ltl == type || Prop_Invar == type);
+
+#if PROP_DB_HAS_WORKERS
+  if (1 < workers && prop_db_verify_parallel(self, type, workers)) return;
+#else
+  if (1 < workers) {
+    const ErrorMgr_ptr errmgr =
+      ERROR_MGR(NuSMVEnv_get_value(EnvObject_get_environment(ENV_OBJECT(self)),
+                                   ENV_ERROR_MANAGER));
+
+    ErrorMgr_warning_msg(errmgr, "Parallel verification is not supported on "
+                         "this platform: using a single worker\n");
+  }
+#endif
+
+  PropDb_verify_all_type_wrapper(self, type);
+}
+
+/*---------------------------------------------------------------------------*/
+/* Definition of static functions                                            */
+/*---------------------------------------------------------------------------*/
+
+#if PROP_DB_HAS_WORKERS
+
+/*!
+  \brief Verifies the properties of the given type with forked workers
+
+  Returns false if nothing was verified, and the properties must be
+  verified serially. Properties whose worker failed or terminated
+  are left unchecked and an error is reported once all the workers
+  have terminated. SIGPIPE is ignored meanwhile, so that writing to a
+  terminated worker fails instead of killing the process.
+*/
+static boolean prop_db_verify_parallel(PropDb_ptr self,
+                                       const Prop_Type type,
+                                       const int workers)
+{
+  const NuSMVEnv_ptr env = EnvObject_get_environment(ENV_OBJECT(self));
+  const ErrorMgr_ptr errmgr =
+    ERROR_MGR(NuSMVEnv_get_value(env, ENV_ERROR_MANAGER));
+  PropSchedule schedule;
+  void (*saved_sigpipe)(int);
+  struct pollfd* fds;
+  int* busy;
+  int next, pending, failures;
+  int i;
+
+  if (! prop_db_schedule_init(&schedule, self, type)) return false;
+
+  saved_sigpipe = signal(SIGPIPE, SIG_IGN);
+
+  if (0 == prop_db_start_workers(&schedule,
+                                 MIN(workers, schedule.props_num))) {
+    (void)signal(SIGPIPE, saved_sigpipe);
+    prop_db_schedule_deinit(&schedule);
+    return false;
+  }
+
+  fds = ALLOC(struct pollfd, schedule.workers_num);
+  busy = ALLOC(int, schedule.workers_num);
+  nusmv_assert((struct pollfd*)NULL != fds && (int*)NULL != busy);
+
+  next = 0;
+  pending = 0;
+  failures = 0;
+
+  /* every worker starts with the largest properties */
+  for (i = 0; i < schedule.workers_num; i++) {
+    if (prop_db_request(&schedule, &(schedule.workers[i]), next)) {
+      next++;
+      pending++;
+    }
+  }
+
+  while (0 < pending) {
+    int num = 0;
+    int j;
+
+    /* waits for a result, or for the end of the channel of a worker
+       that terminated, from the busy workers */
+    for (i = 0; i < schedule.workers_num; i++) {
+      if (0 <= schedule.workers[i].prop) {
+        fds[num].fd = schedule.workers[i].result_fd;
+        fds[num].events = POLLIN;
+        fds[num].revents = 0;
+        busy[num++] = i;
+      }
+    }
+    nusmv_assert(num == pending);
+
+    if (poll(fds, (nfds_t)num, -1) < 0) {
+      if (EINTR == errno) continue;
+      break;
+    }
+
+    for (j = 0; j < num; j++) {
+      PropWorker* worker = &(schedule.workers[busy[j]]);
+
+      if (0 == fds[j].revents) continue;
+
+      /* a terminated worker leaves its property unchecked */
+      if (! prop_db_receive_result(&schedule, worker)) failures++;
+      worker->prop = -1;
+      pending--;
+
+      if (next < schedule.props_num &&
+          prop_db_request(&schedule, worker, next)) {
+        next++;
+        pending++;
+      }
+    }
+  }
+
+  FREE(busy);
+  FREE(fds);
+
+  prop_db_stop_workers(&schedule);
+  (void)signal(SIGPIPE, saved_sigpipe);
+
+  /* properties lost by terminated workers or never handed out */
+  failures += pending + (schedule.props_num - next);
+
+  prop_db_schedule_deinit(&schedule);
+
+  if (0 < failures) {
+    ErrorMgr_rpterr(errmgr, "%d properties could not be verified by the "
+                    "workers\n", failures);
+  }
+
+  return true;
+}
+
+/*!
+  \brief Fills the schedule with the properties to verify
+
+  Returns false if there is nothing to verify in parallel.
+*/
+static boolean prop_db_schedule_init(PropSchedule* schedule,
+                                     PropDb_ptr self,
+                                     const Prop_Type type)
+{
+  const NuSMVEnv_ptr env = EnvObject_get_environment(ENV_OBJECT(self));
+  const NodeMgr_ptr nodemgr =
+    NODE_MGR(NuSMVEnv_get_value(env, ENV_NODE_MGR));
+  const ErrorMgr_ptr errmgr =
+    ERROR_MGR(NuSMVEnv_get_value(env, ENV_ERROR_MANAGER));
+  FlatHierarchy_ptr hierarchy;
+  NodeList_ptr list;
+  ListIter_ptr iter;
+  int i;
+
+  /* counterexamples are expressed on the symbols of the master FSM */
+  if (! NuSMVEnv_has_value(env, ENV_SEXP_FSM)) {
+    ErrorMgr_warning_msg(errmgr, "Parallel verification needs the flat "
+                         "model to be built: using a single worker\n");
+    return false;
+  }
+
+  schedule->env = env;
+  schedule->type = type;
+  schedule->props = ALLOC(Prop_ptr, PropDb_get_size(self));
+  nusmv_assert((Prop_ptr*)NULL != schedule->props);
+  schedule->props_num = 0;
+
+  /* the list is sorted by increasing cone size */
+  hierarchy = FLAT_HIERARCHY(NuSMVEnv_get_value(env, ENV_FLAT_HIERARCHY));
+  list = PropDb_get_ordered_properties(self, hierarchy);
+  NodeList_reverse(list);
+  NODE_LIST_FOREACH(list, iter) {
+    node_ptr couple = NodeList_get_elem_at(list, iter);
+    Prop_ptr prop = PROP(car(couple));
+
+    if (Prop_get_type(prop) == type &&
+        Prop_get_status(prop) == Prop_Unchecked) {
+      schedule->props[schedule->props_num++] = prop;
+    }
+
+    Set_ReleaseSet((Set_t)cdr(couple));
+    free_node(nodemgr, couple);
+  }
+  NodeList_destroy(list);
+
+  /* a single property is not worth a fork */
+  if (schedule->props_num < 2) {
+    FREE(schedule->props);
+    return false;
+  }
+
+  {
+    SexpFsm_ptr sexp_fsm = SEXP_FSM(NuSMVEnv_get_value(env, ENV_SEXP_FSM));
+    NodeList_ptr symbols = SexpFsm_get_symbols_list(sexp_fsm);
+
+    schedule->symbols_num = NodeList_get_length(symbols);
+    schedule->symbols = ALLOC(node_ptr, schedule->symbols_num);
+    nusmv_assert((node_ptr*)NULL != schedule->symbols);
+
+    i = 0;
+    NODE_LIST_FOREACH(symbols, iter) {
+      schedule->symbols[i++] = NodeList_get_elem_at(symbols, iter);
+    }
+  }
+
+  schedule->dd_size =
+    dd_get_size(DD_MGR(NuSMVEnv_get_value(env, ENV_DD_MGR)));
+  schedule->workers = (PropWorker*)NULL;
+  schedule->workers_num = 0;
+
+  return true;
+}
+
+/*!
+  \brief Releases the schedule
+
+*/
+static void prop_db_schedule_deinit(PropSchedule* schedule)
+{
+  FREE(schedule->props);
+  FREE(schedule->symbols);
+}
+
+/*!
+  \brief Forks the workers
+
+  Returns the number of workers actually started.
+*/
+static int prop_db_start_workers(PropSchedule* schedule, const int workers)
+{
+  const ErrorMgr_ptr errmgr =
+    ERROR_MGR(NuSMVEnv_get_value(schedule->env, ENV_ERROR_MANAGER));
+  int i;
+
+  schedule->workers = ALLOC(PropWorker, workers);
+  nusmv_assert((PropWorker*)NULL != schedule->workers);
+
+  /* avoids the workers to flush again the pending output */
+  fflush(NULL);
+
+  for (i = 0; i < workers; i++) {
+    PropWorker* worker = &(schedule->workers[i]);
+    int request_pipe[2], result_pipe[2];
+    pid_t pid;
+
+    if (0 != pipe(request_pipe)) break;
+    if (0 != pipe(result_pipe)) {
+      close(request_pipe[0]); close(request_pipe[1]);
+      break;
+    }
+
+    pid = fork();
+    if (pid < 0) {
+      close(request_pipe[0]); close(request_pipe[1]);
+      close(result_pipe[0]); close(result_pipe[1]);
+      break;
+    }
+
+    if (0 == pid) {
+      int j;
+
+      /* the worker does not need the channels of its siblings */
+      for (j = 0; j < i; j++) {
+        close(schedule->workers[j].request_fd);
+        close(schedule->workers[j].result_fd);
+      }
+      close(request_pipe[1]);
+      close(result_pipe[0]);
+
+      prop_db_worker_loop(schedule, request_pipe[0], result_pipe[1]);
+    }
+
+    close(request_pipe[0]);
+    close(result_pipe[1]);
+
+    worker->pid = (int)pid;
+    worker->request_fd = request_pipe[1];
+    worker->result_fd = result_pipe[0];
+    worker->prop = -1;
+  }
+
+  if (0 == i) {
+    FREE(schedule->workers);
+    schedule->workers = (PropWorker*)NULL;
+
+    ErrorMgr_warning_msg(errmgr, "Unable to start the verification workers: "
+                         "using a single worker\n");
+    return 0;
+  }
+
+  if (i < workers) {
+    ErrorMgr_warning_msg(errmgr, "Only %d of the %d requested verification "
+                         "workers could be started\n", i, workers);
+  }
+
+  schedule->workers_num = i;
+
+  return i;
+}
+
+/*!
+  \brief Stops all the workers and waits for their termination
+
+*/
+static void prop_db_stop_workers(PropSchedule* schedule)
+{
+  int i;
+
+  for (i = 0; i < schedule->workers_num; i++) {
+    PropWorker* worker = &(schedule->workers[i]);
+    int status;
+
+    /* idle workers terminate when their channel is closed */
+    if (0 <= worker->request_fd) close(worker->request_fd);
+    close(worker->result_fd);
+
+    /* a worker still busy is verifying a lost property */
+    if (0 <= worker->prop) (void)kill((pid_t)worker->pid, SIGKILL);
+    (void)waitpid((pid_t)worker->pid, &status, 0);
+  }
+
+  FREE(schedule->workers);
+  schedule->workers = (PropWorker*)NULL;
+  schedule->workers_num = 0;
+}
+
+/*!
+  \brief Main loop of a worker process
+
+  The output stream is discarded, as results are printed by the
+  parent. The worker terminates when the parent closes the channel.
+*/
+static void prop_db_worker_loop(PropSchedule* schedule,
+                                const int request_fd,
+                                const int result_fd)
+{
+  const NuSMVEnv_ptr env = schedule->env;
+  const ErrorMgr_ptr errmgr =
+    ERROR_MGR(NuSMVEnv_get_value(env, ENV_ERROR_MANAGER));
+  const StreamMgr_ptr streams =
+    STREAM_MGR(NuSMVEnv_get_value(env, ENV_STREAM_MANAGER));
+  FILE* null_stream = fopen("/dev/null", "w");
+  int prop_index;
+
+  if ((FILE*)NULL != null_stream) {
+    /* the stream of the parent must not be closed */
+    (void)StreamMgr_reset_output_stream(streams);
+    StreamMgr_set_output_stream(streams, null_stream);
+  }
+
+  while (prop_db_read_all(request_fd, &prop_index, sizeof(prop_index))) {
+    Prop_ptr prop;
+    int status;
+
+    nusmv_assert(0 <= prop_index && prop_index < schedule->props_num);
+    prop = schedule->props[prop_index];
+
+    CATCH(errmgr) {
+      Prop_verify(prop);
+      status = (int)Prop_get_status(prop);
+    }
+    FAIL(errmgr) {
+      status = PROP_DB_VERIFY_ERROR;
+    }
+
+    if (! prop_db_send_result(schedule, prop, status, result_fd)) break;
+  }
+
+  close(request_fd);
+  close(result_fd);
+
+  /* the worker must not execute the parent cleanup handlers */
+  _exit(0);
+}
+
+/*!
+  \brief Sends the status of prop and its counterexample, if any
+
+  The counterexample is sent as its type, its description, the
+  indices of the symbols of its language, its number of states and,
+  for every state, its loopback flag and the cubes of the inputs
+  leading to it and of the state itself.
+*/
+static boolean prop_db_send_result(PropSchedule* schedule,
+                                   const Prop_ptr prop,
+                                   const int status,
+                                   const int fd)
+{
+  const TraceMgr_ptr tm =
+    TRACE_MGR(NuSMVEnv_get_value(schedule->env, ENV_TRACE_MGR));
+  const DDMgr_ptr dd =
+    DD_MGR(NuSMVEnv_get_value(schedule->env, ENV_DD_MGR));
+  Trace_ptr trace;
+  NodeList_ptr trace_symbols;
+  TraceIter step;
+  int header[5];
+  int* cube;
+  boolean res;
+  int i;
+
+  header[0] = status;
+  header[1] = ((int)Prop_False == status && 0 < Prop_get_trace(prop));
+
+  if (! header[1]) {
+    return prop_db_write_all(fd, header, 2 * sizeof(int));
+  }
+
+  trace = TraceMgr_get_trace_at_index(tm, Prop_get_trace(prop) - 1);
+  trace_symbols = Trace_get_symbols(trace);
+
+  header[2] = (int)Trace_get_type(trace);
+  header[3] = Trace_is_frozen(trace);
+  header[4] = strlen(Trace_get_desc(trace));
+
+  if (! prop_db_write_all(fd, header, sizeof(header)) ||
+      ! prop_db_write_all(fd, Trace_get_desc(trace), header[4])) {
+    return false;
+  }
+
+  /* the language is sent as a mask over the master symbols */
+  {
+    char* mask = ALLOC(char, schedule->symbols_num);
+    nusmv_assert((char*)NULL != mask);
+
+    for (i = 0; i < schedule->symbols_num; i++) {
+      mask[i] = NodeList_belongs_to(trace_symbols, schedule->symbols[i]);
+    }
+
+    res = prop_db_write_all(fd, mask, schedule->symbols_num);
+    FREE(mask);
+    if (! res) return false;
+  }
+
+  header[0] = Trace_get_length(trace) + 1;
+  if (! prop_db_write_all(fd, header, sizeof(int))) return false;
+
+  /* variables added by the verification are not known to the parent */
+  cube = ALLOC(int, dd_get_size(dd));
+  nusmv_assert((int*)NULL != cube);
+
+  res = true;
+  i = 0;
+  TRACE_FOREACH(trace, step) {
+    int loopback = header[3] && Trace_step_is_loopback(trace, step);
+
+    res = prop_db_write_all(fd, &loopback, sizeof(loopback)) &&
+      (0 == i ||
+       prop_db_send_step(schedule, trace, step, TRACE_ITER_I_VARS, cube, fd))
+      && prop_db_send_step(schedule, trace, step, TRACE_ITER_SF_VARS,
+                           cube, fd);
+    if (! res) break;
+
+    i++;
+  }
+
+  FREE(cube);
+
+  return res;
+}
+
+/*!
+  \brief Sends the cube of the assignments of a step
+
+  Only the assignments to the master symbols are considered. cube
+  must have an entry for every variable of the DD manager.
+*/
+static boolean prop_db_send_step(PropSchedule* schedule,
+                                 const Trace_ptr trace,
+                                 const TraceIter step,
+                                 const TraceIteratorType iter_type,
+                                 int* cube,
+                                 const int fd)
+{
+  const BddEnc_ptr enc =
+    BDD_ENC(NuSMVEnv_get_value(schedule->env, ENV_BDD_ENCODER));
+  const ExprMgr_ptr exprs =
+    EXPR_MGR(NuSMVEnv_get_value(schedule->env, ENV_EXPR_MANAGER));
+  const DDMgr_ptr dd = BddEnc_get_dd_manager(enc);
+  const SymbTable_ptr symb_table = Trace_get_symb_table(trace);
+  NodeList_ptr symbols = SexpFsm_get_symbols_list(
+    SEXP_FSM(NuSMVEnv_get_value(schedule->env, ENV_SEXP_FSM)));
+  TraceStepIter iter;
+  node_ptr var, val;
+  bdd_ptr values;
+  bdd_ptr implicant;
+  int length;
+  boolean res;
+
+  values = bdd_true(dd);
+  TRACE_STEP_FOREACH(trace, step, iter_type, iter, var, val) {
+    if (NodeList_belongs_to(symbols, var)) {
+      bdd_ptr tmp =
+        BddEnc_expr_to_bdd(enc, ExprMgr_equal(exprs, var, val, symb_table),
+                           Nil);
+      bdd_and_accumulate(dd, &values, tmp);
+      bdd_free(dd, tmp);
+    }
+  }
+
+  /* values is a cube, unless some assignment is not deterministic */
+  if (bdd_is_false(dd, values)) implicant = bdd_true(dd);
+  else implicant = bdd_largest_cube(dd, values, &length);
+  res = bdd_to_cube_array(dd, implicant, cube);
+  bdd_free(dd, implicant);
+  bdd_free(dd, values);
+
+  return res && prop_db_write_all(fd, cube, schedule->dd_size * sizeof(int));
+}
+
+/*!
+  \brief Hands a property over to an idle worker
+
+*/
+static boolean prop_db_request(PropSchedule* schedule, PropWorker* worker,
+                               const int prop)
+{
+  nusmv_assert(0 > worker->prop);
+
+  if (0 > worker->request_fd ||
+      ! prop_db_write_all(worker->request_fd, &prop, sizeof(prop))) {
+    return false;
+  }
+
+  worker->prop = prop;
+  return true;
+}
+
+/*!
+  \brief Receives the result of a worker
+
+  The status and the counterexample are merged into the property
+  and the trace manager, and the result is printed. Returns false if
+  the property could not be verified.
+*/
+static boolean prop_db_receive_result(PropSchedule* schedule,
+                                      PropWorker* worker)
+{
+  const StreamMgr_ptr streams =
+    STREAM_MGR(NuSMVEnv_get_value(schedule->env, ENV_STREAM_MANAGER));
+  const Prop_ptr prop = schedule->props[worker->prop];
+  Trace_ptr trace = TRACE(NULL);
+  int header[2];
+
+  if (! prop_db_read_all(worker->result_fd, header, sizeof(header))) {
+    StreamMgr_print_error(streams, "Verification worker (pid %d) terminated "
+                          "unexpectedly\n", worker->pid);
+
+    /* no further property is handed over to this worker */
+    close(worker->request_fd);
+    worker->request_fd = -1;
+    return false;
+  }
+
+  if (header[1]) {
+    trace = prop_db_receive_trace(schedule, worker->result_fd);
+
+    if (TRACE(NULL) == trace) {
+      StreamMgr_print_error(streams, "Unable to receive a counterexample "
+                            "from verification worker (pid %d)\n",
+                            worker->pid);
+
+      close(worker->request_fd);
+      worker->request_fd = -1;
+      return false;
+    }
+  }
+
+  if (PROP_DB_VERIFY_ERROR == header[0]) {
+    StreamMgr_print_error(streams, "Verification worker (pid %d) failed "
+                          "on property %d\n", worker->pid,
+                          Prop_get_index(prop));
+    return false;
+  }
+
+  Prop_set_status(prop, (Prop_Status)header[0]);
+
+  if (TRACE(NULL) != trace) {
+    const TraceMgr_ptr tm =
+      TRACE_MGR(NuSMVEnv_get_value(schedule->env, ENV_TRACE_MGR));
+
+    (void)TraceMgr_register_trace(tm, trace);
+    Prop_set_trace(prop, Trace_get_id(trace));
+  }
+
+  prop_db_print_result(schedule, prop, TRACE(NULL) != trace);
+
+  return true;
+}
+
+/*!
+  \brief Receives a counterexample and rebuilds it
+
+  Returns NULL if the channel failed.
+
+  \sa prop_db_send_result
+*/
+static Trace_ptr prop_db_receive_trace(PropSchedule* schedule, const int fd)
+{
+  const NodeMgr_ptr nodemgr =
+    NODE_MGR(NuSMVEnv_get_value(schedule->env, ENV_NODE_MGR));
+  const BddEnc_ptr enc =
+    BDD_ENC(NuSMVEnv_get_value(schedule->env, ENV_BDD_ENCODER));
+  const DDMgr_ptr dd = BddEnc_get_dd_manager(enc);
+  Trace_ptr trace = TRACE(NULL);
+  NodeList_ptr symbols;
+  node_ptr path = Nil;
+  int header[3];
+  int steps;
+  char* desc;
+  char* mask;
+  int* loopbacks;
+  int* cube;
+  boolean res;
+  int i;
+
+  nusmv_assert(dd_get_size(dd) == schedule->dd_size);
+
+  if (! prop_db_read_all(fd, header, sizeof(header))) return TRACE(NULL);
+
+  desc = ALLOC(char, header[2] + 1);
+  mask = ALLOC(char, schedule->symbols_num);
+  nusmv_assert((char*)NULL != desc && (char*)NULL != mask);
+
+  res = prop_db_read_all(fd, desc, header[2]) &&
+    prop_db_read_all(fd, mask, schedule->symbols_num) &&
+    prop_db_read_all(fd, &steps, sizeof(steps));
+  desc[header[2]] = '\0';
+
+  if (! res) {
+    FREE(mask);
+    FREE(desc);
+    return TRACE(NULL);
+  }
+
+  symbols = NodeList_create();
+  for (i = 0; i < schedule->symbols_num; i++) {
+    if (mask[i]) NodeList_append(symbols, schedule->symbols[i]);
+  }
+
+  loopbacks = ALLOC(int, steps);
+  cube = ALLOC(int, schedule->dd_size);
+  nusmv_assert((int*)NULL != loopbacks && (int*)NULL != cube);
+
+  /* path is built backward as S (I S)* */
+  for (i = 0; res && i < steps; i++) {
+    res = prop_db_read_all(fd, &(loopbacks[i]), sizeof(int));
+
+    if (res && 0 < i) {
+      res = prop_db_read_all(fd, cube, schedule->dd_size * sizeof(int));
+      if (res) {
+        path = cons(nodemgr, NODE_PTR(bdd_from_cube_array(dd, cube)), path);
+      }
+    }
+
+    if (res) {
+      res = prop_db_read_all(fd, cube, schedule->dd_size * sizeof(int));
+      if (res) {
+        path = cons(nodemgr, NODE_PTR(bdd_from_cube_array(dd, cube)), path);
+      }
+    }
+  }
+
+  if (res) {
+    path = reverse(path);
+    trace = Mc_create_trace_from_bdd_state_input_list(enc, symbols, desc,
+                                                      (TraceType)header[0],
+                                                      path);
+
+    if (header[1]) {
+      TraceIter step;
+
+      Trace_freeze(trace);
+
+      i = 0;
+      TRACE_FOREACH(trace, step) {
+        if (loopbacks[i]) Trace_step_force_loopback(trace, step);
+        i++;
+      }
+    }
+  }
+
+  walk_dd(dd, bdd_free, path);
+  free_list(nodemgr, path);
+
+  FREE(cube);
+  FREE(loopbacks);
+  NodeList_destroy(symbols);
+  FREE(mask);
+  FREE(desc);
+
+  return trace;
+}
+
+/*!
+  \brief Prints the result of a property verified by a worker
+
+  The output is the one of the serial model checkers.
+*/
+static void prop_db_print_result(PropSchedule* schedule,
+                                 const Prop_ptr prop,
+                                 const boolean has_trace)
+{
+  const StreamMgr_ptr streams =
+    STREAM_MGR(NuSMVEnv_get_value(schedule->env, ENV_STREAM_MANAGER));
+  const OptsHandler_ptr opts =
+    OPTS_HANDLER(NuSMVEnv_get_value(schedule->env, ENV_OPTS_HANDLER));
+  const OStream_ptr out = StreamMgr_get_output_ostream(streams);
+
+  StreamMgr_print_output(streams, "-- ");
+
+  if (Prop_Invar == schedule->type) {
+    print_invar(out, prop, get_prop_print_method(opts));
+    StreamMgr_print_output(streams, " ");
+  }
+  else print_spec(out, prop, get_prop_print_method(opts));
+
+  if (Prop_True == Prop_get_status(prop)) {
+    StreamMgr_print_output(streams, "is true\n");
+  }
+  else {
+    StreamMgr_print_output(streams, "is false\n");
+  }
+
+  if (has_trace) {
+    const TraceMgr_ptr tm =
+      TRACE_MGR(NuSMVEnv_get_value(schedule->env, ENV_TRACE_MGR));
+
+    StreamMgr_print_output(streams,
+              "-- as demonstrated by the following execution sequence\n");
+
+    TraceMgr_execute_plugin(tm, TRACE_OPT(NULL), TRACE_MGR_DEFAULT_PLUGIN,
+                            Prop_get_trace(prop) - 1);
+  }
+}
+
+/*!
+  \brief Writes the whole buffer, returns false on failure
+
+*/
+static boolean prop_db_write_all(const int fd, const void* buf,
+                                 const size_t size)
+{
+  const char* data = (const char*)buf;
+  size_t done = 0;
+
+  while (done < size) {
+    ssize_t res = write(fd, data + done, size - done);
+
+    if (res <= 0) return false;
+    done += (size_t)res;
+  }
+
+  return true;
+}
+
+/*!
+  \brief Reads exactly size bytes, returns false on failure
+
+*/
+static boolean prop_db_read_all(const int fd, void* buf, const size_t size)
+{
+  char* data = (char*)buf;
+  size_t done = 0;
+
+  while (done < size) {
+    ssize_t res = read(fd, data + done, size - done);
+
+    if (res <= 0) return false;
+    done += (size_t)res;
+  }
+
+  return true;
+}
+
+#endif /* PROP_DB_HAS_WORKERS */
@@ -162,6 +162,47 @@ SatIncSolver_solve_without_groups(const SatIncSolver_ptr self,
   return result;
 }
 
+SatSolverResult
+SatIncSolver_solve_groups_assume(const SatIncSolver_ptr self,
+                                 const Olist_ptr groups,
+                                 const Slist_ptr assumptions)
+{
+  SatSolverResult result;
+  NuSMVEnv_ptr env;
+  OptsHandler_ptr opts;
+
+  SAT_INC_SOLVER_CHECK_INSTANCE(self);
+
+  env = ENV_OBJECT(self)->environment;
+  opts = OPTS_HANDLER(NuSMVEnv_get_value(env, ENV_OPTS_HANDLER));
+
+  Slist_destroy(SAT_SOLVER(self)->model); /* destroy the model of
+                                             previous solving */
+  SAT_SOLVER(self)->model = (Slist_ptr)NULL;
+  /* the conflict of previous solving is owned (and released) by the
+     derived class, here it is only forgotten */
+  SAT_SOLVER(self)->conflicts = (Slist_ptr)NULL;
+
+  if (opt_verbose_level_gt(opts, 0)) {
+    Logger_ptr logger = LOGGER(NuSMVEnv_get_value(env, ENV_LOGGER));
+    Logger_log(logger, "Invoking solver '%s'...\n",
+            SatSolver_get_name(SAT_SOLVER(self)));
+  }
+
+  SAT_SOLVER(self)->solvingTime = util_cpu_time();
+  result = self->solve_groups_assume(self, groups, assumptions);
+  SAT_SOLVER(self)->solvingTime = util_cpu_time() - SAT_SOLVER(self)->solvingTime;
+
+  if (opt_verbose_level_gt(opts, 0)) {
+    Logger_ptr logger = LOGGER(NuSMVEnv_get_value(env, ENV_LOGGER));
+    Logger_log(logger, "Solver '%s' returned after %f secs \n",
+            SatSolver_get_name(SAT_SOLVER(self)),
+            SatSolver_get_last_solving_time(SAT_SOLVER(self))/1000.0);
+  }
+
+  return result;
+}
+
 
 /* ---------------------------------------------------------------------- */
 /* Private Methods                                                        */
@@ -253,6 +294,25 @@ sat_inc_solver_solve_without_groups (const SatIncSolver_ptr self,
   return SAT_SOLVER_INTERNAL_ERROR;
 }
 
+/*!
+  \brief Pure virtual function, tries to solve formulas from
+  the groups in the list under a set of assumptions
+
+  It is a pure virtual function and SatIncSolver is an abstract
+  base class. Every derived class must ovewrwrite this function.
+
+  \sa SatIncSolver_solve_groups
+*/
+
+SatSolverResult
+sat_inc_solver_solve_groups_assume (const SatIncSolver_ptr self,
+                                    const Olist_ptr groups,
+                                    const Slist_ptr assumptions)
+{
+  error_unreachable_code(); /* Pure Virtual Member Function */
+  return SAT_SOLVER_INTERNAL_ERROR;
+}
+
 /* ---------------------------------------------------------------------- */
 /* Initializer and De-initializer                                         */
 /* ---------------------------------------------------------------------- */
@@ -282,6 +342,8 @@ void sat_inc_solver_init(SatIncSolver_ptr self,
   OVERRIDE(SatIncSolver, solve_groups) = sat_inc_solver_solve_groups;
   OVERRIDE(SatIncSolver, solve_without_groups)
     = sat_inc_solver_solve_without_groups;
+  OVERRIDE(SatIncSolver, solve_groups_assume)
+    = sat_inc_solver_solve_groups_assume;
 
   /* inits members: */
 }
@@ -169,6 +169,24 @@ VIRTUAL SatSolverResult
 SatIncSolver_solve_without_groups(const SatIncSolver_ptr self,
                                   const Olist_ptr groups);
 
+/*!
+  \methodof SatIncSolver
+  \brief Tries to solve formulas from the groups in the list under
+  the given assumptions.
+
+  Same as SatIncSolver_solve_groups, but the CNF literals in
+  'assumptions' are also assumed to be true. If the problem is
+  unsatisfiable the subset of assumptions responsible for it can be
+  obtained with SatSolver_get_conflicts (literals of group ids show
+  up there as 0).
+
+  \sa SatIncSolver_solve_groups, SatSolver_get_conflicts
+*/
+VIRTUAL SatSolverResult
+SatIncSolver_solve_groups_assume(const SatIncSolver_ptr self,
+                                 const Olist_ptr groups,
+                                 const Slist_ptr assumptions);
+
 /**AutomaticEnd***************************************************************/
 
 #endif /* __NUSMV_CORE_SAT_SAT_INC_SOLVER_H__ */
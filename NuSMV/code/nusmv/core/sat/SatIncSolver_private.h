@@ -85,6 +85,12 @@ typedef struct SatIncSolver_TAG
   VIRTUAL SatSolverResult
   (*solve_without_groups) (const SatIncSolver_ptr self,
                            const Olist_ptr groups);
+
+  /* as solve_groups, but also assumes the given CNF literals */
+  VIRTUAL SatSolverResult
+  (*solve_groups_assume) (const SatIncSolver_ptr self,
+                          const Olist_ptr groups,
+                          const Slist_ptr assumptions);
 } SatIncSolver;
 
 /**AutomaticStart*************************************************************/
@@ -145,6 +151,15 @@ SatSolverResult
 sat_inc_solver_solve_without_groups(const SatIncSolver_ptr self,
                                     const Olist_ptr groups);
 
+/*!
+  \methodof SatIncSolver
+  \todo
+*/
+SatSolverResult
+sat_inc_solver_solve_groups_assume(const SatIncSolver_ptr self,
+                                   const Olist_ptr groups,
+                                   const Slist_ptr assumptions);
+
 /**AutomaticEnd***************************************************************/
 
 #endif /* __NUSMV_CORE_SAT_SAT_INC_SOLVER_PRIVATE_H__ */
@@ -658,6 +658,26 @@ sat_minisat_move_to_permanent_and_destroy_group(const SatIncSolver_ptr solver,
 
 SatSolverResult
 sat_minisat_solve_groups(const SatIncSolver_ptr solver, const Olist_ptr groups)
+{
+  return sat_minisat_solve_groups_assume(solver, groups, (Slist_ptr)NULL);
+}
+
+/*!
+  \brief Tries to solve formulas from the groups in the list under
+  a set of assumptions.
+
+  As sat_minisat_solve_groups, but the given CNF literals are
+  assumed as well (NULL stands for no assumptions). The group ids are
+  assumptions too, thus the conflict obtained with
+  sat_minisat_get_conflicts may contain them (as CNF literal 0).
+
+  \sa sat_minisat_solve_groups, sat_minisat_get_conflicts
+*/
+
+SatSolverResult
+sat_minisat_solve_groups_assume(const SatIncSolver_ptr solver,
+                                const Olist_ptr groups,
+                                const Slist_ptr cnfAssumptions)
 {
   SatMinisat_ptr self = SAT_MINISAT(solver);
   SatSolverGroup permanentGroup;
@@ -669,6 +689,12 @@ sat_minisat_solve_groups(const SatIncSolver_ptr solver, const Olist_ptr groups)
 
   SAT_MINISAT_CHECK_INSTANCE(self);
 
+  if ((Slist_ptr)NULL != cnfAssumptions) {
+    /* destroy the conflict of previous solving */
+    Slist_destroy(self->conflict);
+    self->conflict = (Slist_ptr)NULL;
+  }
+
   permanentGroup = SatSolver_get_permanent_group(SAT_SOLVER(self));
 
   /* if the permanent group is unsatisfiable => return.
@@ -685,6 +711,10 @@ sat_minisat_solve_groups(const SatIncSolver_ptr solver, const Olist_ptr groups)
   numberOfGroups += Stack_get_size(self->minisat_itp_groups);
 #endif
 
+  if ((Slist_ptr)NULL != cnfAssumptions) {
+    numberOfGroups += Slist_get_size(cnfAssumptions);
+  }
+
   assumptions = ALLOC(int, numberOfGroups);
 
   numberOfGroups = 0;
@@ -720,6 +750,18 @@ sat_minisat_solve_groups(const SatIncSolver_ptr solver, const Olist_ptr groups)
   }
 #endif
 
+  if ((Slist_ptr)NULL != cnfAssumptions) {
+    Siter iter;
+
+    SLIST_FOREACH (cnfAssumptions, iter) {
+      int aAss = PTR_TO_INT(Siter_element(iter));
+
+      assumptions[numberOfGroups] =
+        sat_minisat_cnfLiteral2minisatLiteral(self, aAss);
+      ++numberOfGroups;
+    }
+  }
+
   /* try to solver (MiniSat_Solve will invoke internal simplifyDB) */
   minisatResult = MiniSat_Solve_Assume(self->minisatSolver,
                                        numberOfGroups, assumptions);
@@ -1210,6 +1252,8 @@ void sat_minisat_init(SatMinisat_ptr self, const NuSMVEnv_ptr env,
   OVERRIDE(SatIncSolver, solve_groups) = sat_minisat_solve_groups;
   OVERRIDE(SatIncSolver, solve_without_groups)
     = sat_minisat_solve_without_groups;
+  OVERRIDE(SatIncSolver, solve_groups_assume)
+    = sat_minisat_solve_groups_assume;
 
   OVERRIDE(SatSolver, set_random_mode) = sat_minisat_set_random_mode;
   OVERRIDE(SatSolver, set_polarity_mode) = sat_minisat_set_polarity_mode;
@@ -203,6 +203,15 @@ SatSolverResult
 sat_minisat_solve_without_groups(const SatIncSolver_ptr self,
                                  const Olist_ptr groups);
 
+/*!
+  \methodof SatMinisat
+  \todo
+*/
+SatSolverResult
+sat_minisat_solve_groups_assume(const SatIncSolver_ptr self,
+                                const Olist_ptr groups,
+                                const Slist_ptr cnfAssumptions);
+
 /* the assumptions/conflict interface of MiniSat */
 /*!
   \methodof SatMinisat
@@ -175,7 +175,9 @@ node_ptr Simulate_MultipleSteps(NuSMVEnv_ptr env, BddFsm_ptr fsm, bdd_ptr constr
     else {
       next_constraint = bdd_dup(constraint);
     }
-    next_constr_set = BddFsm_get_constrained_forward_image(fsm, current_state_bdd, next_constraint);
+    next_constr_set =
+      BddFsm_get_constrained_concrete_forward_image(fsm, current_state_bdd,
+                                                    next_constraint);
     bdd_free(dd, next_constraint);
 
     bdd_and_accumulate(dd, &next_constr_set, mask);
@@ -845,7 +847,8 @@ static void simulate_choose_next(NuSMVEnv_ptr env, BddFsm_ptr fsm,
     nusmv_assert( (mode == Random) || (mode == Deterministic) );
 
     if (mode == Random) {
-      next_state = BddEnc_pick_one_state_rand(enc, next_state_set);
+      next_state = BddEnc_pick_one_state_rand(enc, next_state_set,
+                                              (RandomGen_ptr)NULL);
 
       if (from_state != (bdd_ptr) NULL) {
         bdd_ptr inputs, masked_inputs;
@@ -854,7 +857,8 @@ static void simulate_choose_next(NuSMVEnv_ptr env, BddFsm_ptr fsm,
         masked_inputs = BddEnc_apply_input_vars_mask_bdd(enc, inputs);
         bdd_free(dd, inputs);
 
-        input = BddEnc_pick_one_input_rand(enc, masked_inputs);
+        input = BddEnc_pick_one_input_rand(enc, masked_inputs,
+                                           (RandomGen_ptr)NULL);
         bdd_free(dd, masked_inputs);
       }
     }
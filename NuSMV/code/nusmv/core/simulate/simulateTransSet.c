@@ -313,21 +313,29 @@ void SimulateTransSet_get_state_input_at(const SimulateTransSet_ptr self,
 }
 
 void SimulateTransSet_get_state_input_rand(const SimulateTransSet_ptr self,
+                                           RandomGen_ptr gen,
                                            bdd_ptr* state, bdd_ptr* input)
 {
   int s;
+  int states_num, inputs_num;
 
   SIMULATE_TRANS_SET_CHECK_INSTANCE(self);
 
   *state = NULL;
   *input = NULL;
 
-  s = utils_random() % SimulateTransSet_get_next_state_num(self);
+  states_num = SimulateTransSet_get_next_state_num(self);
+  s = ((RandomGen_ptr)NULL != gen) ?
+    (int)RandomGen_next_below(gen, (unsigned long)states_num) :
+    utils_random() % states_num;
   *state = SimulateTransSet_get_next_state(self, s);
 
-  if (SimulateTransSet_get_inputs_num_at_state(self, s) > 0) {
+  inputs_num = SimulateTransSet_get_inputs_num_at_state(self, s);
+  if (inputs_num > 0) {
     int i;
-    i = utils_random() % SimulateTransSet_get_inputs_num_at_state(self, s);
+    i = ((RandomGen_ptr)NULL != gen) ?
+      (int)RandomGen_next_below(gen, (unsigned long)inputs_num) :
+      utils_random() % inputs_num;
 
     *input = SimulateTransSet_get_input_at_state(self, s, i);
   }
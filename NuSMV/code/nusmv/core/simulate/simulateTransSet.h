@@ -182,12 +182,14 @@ SimulateTransSet_get_state_input_at(const SimulateTransSet_ptr self,
 
 /*!
   \methodof SimulateTransSet
-  \brief 
+  \brief Picks a random state and input
 
-  
+  The random choices are taken from gen, or from utils_random if gen
+  is NULL.
 */
 void
 SimulateTransSet_get_state_input_rand(const SimulateTransSet_ptr self,
+                                      RandomGen_ptr gen,
                                       bdd_ptr* state, bdd_ptr* input);
 
 /*!
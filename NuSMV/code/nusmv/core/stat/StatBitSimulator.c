@@ -0,0 +1,1133 @@
+/* ---------------------------------------------------------------------------
+
+
+  This file is part of the ``stat'' package of NuSMV version 2.
+  Copyright (C) 2012 by FBK-irst.
+
+  NuSMV version 2 is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  NuSMV version 2 is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA.
+
+  For more information on NuSMV see <http://nusmv.fbk.eu>
+  or email to <nusmv-users@fbk.eu>.
+  Please report bugs to <nusmv-users@fbk.eu>.
+
+  To contact the NuSMV development board, email to <nusmv@fbk.eu>.
+
+-----------------------------------------------------------------------------*/
+
+/*!
+  \author Alberto Bombardelli
+  \brief Implementation of class 'StatBitSimulator'
+
+  A program is a sequence of instructions over an array of words,
+  the registers. The first registers hold the values of the untimed
+  variables of the BE encoding (the slots), followed by a register
+  holding the constant false and by the temporaries. An operand is a
+  register index shifted left by one, whose lowest bit tells whether
+  the register is negated, as the annotation bit of the RBC edges.
+
+*/
+
+#if HAVE_CONFIG_H
+# include "nusmv-config.h"
+#endif
+
+#include "nusmv/core/stat/StatBitSimulator.h"
+#include "nusmv/core/stat/statInt.h"
+
+#include "nusmv/core/utils/EnvObject.h"
+#include "nusmv/core/utils/EnvObject_private.h"
+#include "nusmv/core/utils/assoc.h"
+#include "nusmv/core/utils/array.h"
+#include "nusmv/core/utils/NodeList.h"
+#include "nusmv/core/utils/RandomGen.h"
+#include "nusmv/core/utils/Logger.h"
+#include "nusmv/core/utils/error.h"
+#include "nusmv/core/opt/opt.h"
+
+#include "nusmv/core/be/be.h"
+#include "nusmv/core/rbc/rbc.h"
+#include "nusmv/core/dag/dag.h"
+#include "nusmv/core/enc/be/BeEnc.h"
+#include "nusmv/core/enc/bdd/BddEnc.h"
+#include "nusmv/core/fsm/sexp/SexpFsm.h"
+#include "nusmv/core/compile/symb_table/SymbTable.h"
+#include "nusmv/core/parser/symbols.h"
+
+/*---------------------------------------------------------------------------*/
+/* Constant declarations                                                     */
+/*---------------------------------------------------------------------------*/
+
+/*!
+  \brief Attempts to satisfy the constraints of a step
+
+  Executions that do not satisfy them within this number of random
+  choices are dropped, see StatBitSimulator_simulate
+*/
+#define STAT_BIT_SIMULATOR_MAX_TRIES 64
+
+/*---------------------------------------------------------------------------*/
+/* Structure declarations                                                    */
+/*---------------------------------------------------------------------------*/
+
+/*!
+  \brief The operations of the programs
+
+  The copy stores the value of a definition into its slot.
+*/
+typedef enum StatBitOp_TAG {
+  STAT_BIT_AND,
+  STAT_BIT_IFF,
+  STAT_BIT_ITE,
+  STAT_BIT_COPY
+} StatBitOp;
+
+typedef unsigned long long StatBitWord;
+
+typedef struct StatBitInstr_TAG {
+  StatBitOp op;
+  int dst;
+  int args[3];
+} StatBitInstr;
+
+/*!
+  \brief A compiled program
+
+  randoms are the slots drawn at random before running the code,
+  guards the operands that must evaluate to true.
+*/
+typedef struct StatBitProgram_TAG {
+  StatBitInstr* code;
+  int code_num;
+  int* guards;
+  int guards_num;
+  int* randoms;
+  int randoms_num;
+} StatBitProgram;
+
+/*!
+  \brief The state of the compilation of a program
+
+*/
+typedef struct StatBitCompiler_TAG {
+  /* true for the step program, false for the initial one */
+  boolean step;
+
+  /* kinds of the variables the program computes */
+  BeVarType definable;
+
+  /* definition of every slot, NULL if not defined */
+  Rbc_t** defs;
+  boolean* compiled;
+  boolean* compiling;
+
+  /* vertex -> register + 1, for the model and for the invar */
+  hash_ptr regs[2];
+
+  array_t* code;
+} StatBitCompiler;
+
+typedef struct StatBitSimulator_TAG
+{
+  /* this MUST stay on the top */
+  INHERITS_FROM(EnvObject);
+
+  /* -------------------------------------------------- */
+  /*                  Private members                   */
+  /* -------------------------------------------------- */
+  BeEnc_ptr be_enc;
+  Rbc_Manager_t* rbc_mgr;
+  BddEnc_ptr bdd_enc;
+  DDMgr_ptr dd;
+
+  /* random choices are taken from the generator of the package */
+  RandomGen_ptr gen;
+
+  boolean supported;
+
+  /* index -> slot + 1, and kind and be index of every slot. The next
+     of a current state slot is the slot of its next variable */
+  hash_ptr slots;
+  BeVarType* kinds;
+  int* indices;
+  int* nexts;
+  int slots_num;
+
+  /* current state slots, updated at every step */
+  int* currs;
+  int currs_num;
+
+  /* recorded slots: state and frozen ones first, inputs after */
+  int* records;
+  int records_num;
+  int sf_records_num;
+
+  /* negative and positive bdd literal of every recorded slot */
+  bdd_ptr* lits;
+
+  StatBitProgram init;
+  StatBitProgram step;
+
+  /* the register of the constant false */
+  int zero;
+  StatBitWord* regs;
+  int regs_num;
+
+  /* recorded slots at every time of the last block */
+  StatBitWord* history;
+  int history_size;
+
+  /* state and frozen variables, and input variables of the model */
+  NodeList_ptr sf_vars;
+  NodeList_ptr i_vars;
+
+  /* sexps hash map: state or state & input -> sexp (bdds referenced) */
+  hash_ptr sexps;
+} StatBitSimulator;
+
+/*---------------------------------------------------------------------------*/
+/* Type declarations                                                         */
+/*---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*/
+/* Variable declarations                                                     */
+/*---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*/
+/* Macro declarations                                                        */
+/*---------------------------------------------------------------------------*/
+#define STAT_ENV(self) (ENV_OBJECT(self)->environment)
+
+/*!
+  \brief The operand of the given register, negated if neg
+
+*/
+#define STAT_BIT_OPERAND(reg, neg) (((reg) << 1) | ((neg) ? 1 : 0))
+
+/*!
+  \brief The value of the given operand
+
+*/
+#define STAT_BIT_VALUE(regs, op) \
+  ((regs)[(op) >> 1] ^ (-(StatBitWord)((op) & 1)))
+
+/**AutomaticStart*************************************************************/
+
+/*---------------------------------------------------------------------------*/
+/* Static function prototypes                                                */
+/*---------------------------------------------------------------------------*/
+
+static void stat_bit_simulator_init(StatBitSimulator_ptr self,
+                                    const NuSMVEnv_ptr env,
+                                    const BeFsm_ptr fsm);
+
+static void stat_bit_simulator_deinit(StatBitSimulator_ptr self);
+
+static void stat_bit_simulator_init_slots(StatBitSimulator_ptr self);
+
+static int stat_bit_simulator_get_slot(const StatBitSimulator_ptr self,
+                                       const int index);
+
+static void stat_bit_simulator_compile(StatBitSimulator_ptr self,
+                                       StatBitProgram* prog,
+                                       Rbc_t* model, Rbc_t* invar,
+                                       const boolean step);
+
+static void stat_bit_simulator_conjuncts(StatBitSimulator_ptr self,
+                                         Rbc_t* f, array_t* res);
+
+static boolean stat_bit_simulator_define(StatBitSimulator_ptr self,
+                                         StatBitCompiler* comp,
+                                         Rbc_t* conjunct);
+
+static boolean stat_bit_simulator_define_var(StatBitSimulator_ptr self,
+                                             StatBitCompiler* comp,
+                                             Rbc_t* lit, Rbc_t* f);
+
+static void stat_bit_simulator_compile_def(StatBitSimulator_ptr self,
+                                           StatBitCompiler* comp,
+                                           const int slot);
+
+static int stat_bit_simulator_compile_rbc(StatBitSimulator_ptr self,
+                                          StatBitCompiler* comp,
+                                          Rbc_t* f, const boolean invar);
+
+static StatBitWord stat_bit_simulator_run(StatBitSimulator_ptr self,
+                                          const StatBitProgram* prog,
+                                          const StatBitWord alive);
+
+static void stat_bit_simulator_record(StatBitSimulator_ptr self,
+                                      const int time);
+
+static StatTrace_ptr
+  stat_bit_simulator_get_execution(StatBitSimulator_ptr self,
+                                   const int lane, const int k,
+                                   const boolean lassos);
+
+static bdd_ptr stat_bit_simulator_get_minterm(StatBitSimulator_ptr self,
+                                              const StatBitWord* record,
+                                              const int lane,
+                                              const int from,
+                                              const int to);
+
+static Expr_ptr stat_bit_simulator_get_sexp(StatBitSimulator_ptr self,
+                                            bdd_ptr state, bdd_ptr input);
+
+static Expr_ptr stat_bit_simulator_assign(StatBitSimulator_ptr self,
+                                          bdd_ptr minterm,
+                                          NodeList_ptr vars,
+                                          Expr_ptr res);
+
+static void stat_bit_program_deinit(StatBitProgram* prog);
+
+static assoc_retval stat_bit_simulator_free_key(char* key, char* data,
+                                                char* arg);
+
+/*---------------------------------------------------------------------------*/
+/* Definition of exported functions                                          */
+/*---------------------------------------------------------------------------*/
+
+StatBitSimulator_ptr StatBitSimulator_create(const NuSMVEnv_ptr env,
+                                             const BeFsm_ptr fsm)
+{
+  StatBitSimulator_ptr self = ALLOC(StatBitSimulator, 1);
+  STAT_BIT_SIMULATOR_CHECK_INSTANCE(self);
+
+  stat_bit_simulator_init(self, env, fsm);
+  return self;
+}
+
+void StatBitSimulator_destroy(StatBitSimulator_ptr self)
+{
+  STAT_BIT_SIMULATOR_CHECK_INSTANCE(self);
+
+  stat_bit_simulator_deinit(self);
+  FREE(self);
+}
+
+boolean StatBitSimulator_is_supported(const StatBitSimulator_ptr self)
+{
+  STAT_BIT_SIMULATOR_CHECK_INSTANCE(self);
+
+  return self->supported;
+}
+
+int StatBitSimulator_simulate(StatBitSimulator_ptr self,
+                              const int k,
+                              const boolean lassos,
+                              StatTrace_ptr* execs)
+{
+  StatBitWord alive;
+  int res = 0;
+  int lane;
+  int t;
+
+  STAT_BIT_SIMULATOR_CHECK_INSTANCE(self);
+  nusmv_assert(self->supported);
+  nusmv_assert(0 <= k);
+
+  /* the expressions already returned are hashed, and outlive the
+     cache */
+  if (Stat_is_cache_full(STAT_ENV(self), self->sexps)) {
+    clear_assoc_and_free_entries_arg(self->sexps, stat_bit_simulator_free_key,
+                                     (char*)self->dd);
+  }
+
+  if (self->history_size < (k + 1) * self->records_num) {
+    self->history_size = (k + 1) * self->records_num;
+    self->history = REALLOC(StatBitWord, self->history, self->history_size);
+  }
+
+  alive = stat_bit_simulator_run(self, &self->init, ~(StatBitWord)0);
+  stat_bit_simulator_record(self, 0);
+
+  for (t = 1; t <= k && 0 != alive; t++) {
+    int i;
+
+    alive = stat_bit_simulator_run(self, &self->step, alive);
+
+    for (i = 0; i < self->currs_num; i++) {
+      const int slot = self->currs[i];
+      self->regs[slot] = self->regs[self->nexts[slot]];
+    }
+
+    stat_bit_simulator_record(self, t);
+  }
+
+  for (lane = 0; lane < STAT_BIT_SIMULATOR_PATHS; lane++) {
+    if (0 != ((alive >> lane) & 1)) {
+      execs[res++] =
+        stat_bit_simulator_get_execution(self, lane, k, lassos);
+    }
+  }
+
+  return res;
+}
+
+/*---------------------------------------------------------------------------*/
+/* Definition of static functions                                            */
+/*---------------------------------------------------------------------------*/
+
+/*!
+  \brief The StatBitSimulator class private initializer
+
+  \sa StatBitSimulator_create
+*/
+static void stat_bit_simulator_init(StatBitSimulator_ptr self,
+                                    const NuSMVEnv_ptr env,
+                                    const BeFsm_ptr fsm)
+{
+  const OptsHandler_ptr opts =
+    OPTS_HANDLER(NuSMVEnv_get_value(env, ENV_OPTS_HANDLER));
+  const SexpFsm_ptr sexp_fsm = SEXP_FSM(NuSMVEnv_get_value(env, ENV_SEXP_FSM));
+  const SymbTable_ptr st = SYMB_TABLE(NuSMVEnv_get_value(env, ENV_SYMB_TABLE));
+  const BddFsm_ptr bdd_fsm = BDD_FSM(NuSMVEnv_get_value(env, ENV_BDD_FSM));
+  Be_Manager_ptr be_mgr;
+  ListIter_ptr iter;
+  NodeList_ptr symbols;
+  Rbc_t* invar;
+  int i;
+
+  env_object_init(ENV_OBJECT(self), env);
+
+  self->be_enc = BeFsm_get_be_encoding(fsm);
+  be_mgr = BeEnc_get_be_manager(self->be_enc);
+  self->rbc_mgr = (Rbc_Manager_t*)Be_Manager_GetSpecManager(be_mgr);
+  self->bdd_enc = BddFsm_get_bdd_encoding(bdd_fsm);
+  self->dd = BddEnc_get_dd_manager(self->bdd_enc);
+  self->gen = RANDOM_GEN(NuSMVEnv_get_value(env, ENV_STAT_RANDOM_GEN));
+  self->supported = true;
+  self->history = (StatBitWord*)NULL;
+  self->history_size = 0;
+  self->sf_vars = NodeList_create();
+  self->i_vars = NodeList_create();
+  self->sexps = new_assoc();
+
+  stat_bit_simulator_init_slots(self);
+
+  /* registers: the slots, the constant false, then the temporaries */
+  self->zero = self->slots_num;
+  self->regs_num = self->slots_num + 1;
+
+  invar = (Rbc_t*)Be_Manager_Be2Spec(be_mgr, BeFsm_get_invar(fsm));
+
+  stat_bit_simulator_compile(self, &self->init,
+                             (Rbc_t*)Be_Manager_Be2Spec(be_mgr,
+                                                        BeFsm_get_init(fsm)),
+                             invar, false);
+  stat_bit_simulator_compile(self, &self->step,
+                             (Rbc_t*)Be_Manager_Be2Spec(be_mgr,
+                                                        BeFsm_get_trans(fsm)),
+                             invar, true);
+
+  self->regs = ALLOC(StatBitWord, self->regs_num);
+  for (i = 0; i < self->regs_num; i++) self->regs[i] = 0;
+
+  /* the same variables the simulation traces are built on */
+  symbols = SexpFsm_get_symbols_list(sexp_fsm);
+  NODE_LIST_FOREACH(symbols, iter) {
+    node_ptr var = NodeList_get_elem_at(symbols, iter);
+
+    if (SymbTable_is_symbol_input_var(st, var)) {
+      NodeList_append(self->i_vars, var);
+    }
+    else if (SymbTable_is_symbol_state_var(st, var) ||
+             SymbTable_is_symbol_frozen_var(st, var)) {
+      NodeList_append(self->sf_vars, var);
+    }
+  }
+
+  if (opt_verbose_level_gt(opts, 0)) {
+    const Logger_ptr logger = LOGGER(NuSMVEnv_get_value(env, ENV_LOGGER));
+
+    if (self->supported) {
+      Logger_log(logger, "Bit-parallel simulation: %d + %d instructions, "
+                 "%d registers, %d + %d random slots\n",
+                 self->init.code_num, self->step.code_num, self->regs_num,
+                 self->init.randoms_num, self->step.randoms_num);
+    }
+    else {
+      Logger_log(logger, "Bit-parallel simulation: the model is not "
+                 "supported\n");
+    }
+  }
+}
+
+/*!
+  \brief The StatBitSimulator class private deinitializer
+
+  \sa StatBitSimulator_destroy
+*/
+static void stat_bit_simulator_deinit(StatBitSimulator_ptr self)
+{
+  int i;
+
+  clear_assoc_and_free_entries_arg(self->sexps, stat_bit_simulator_free_key,
+                                   (char*)self->dd);
+  free_assoc(self->sexps); self->sexps = (hash_ptr)NULL;
+
+  NodeList_destroy(self->i_vars); self->i_vars = NODE_LIST(NULL);
+  NodeList_destroy(self->sf_vars); self->sf_vars = NODE_LIST(NULL);
+
+  for (i = 0; i < 2 * self->records_num; i++) {
+    bdd_free(self->dd, self->lits[i]);
+  }
+  FREE(self->lits);
+
+  stat_bit_program_deinit(&self->init);
+  stat_bit_program_deinit(&self->step);
+
+  if ((StatBitWord*)NULL != self->history) FREE(self->history);
+  FREE(self->regs);
+  FREE(self->records);
+  FREE(self->currs);
+  FREE(self->nexts);
+  FREE(self->indices);
+  FREE(self->kinds);
+  free_assoc(self->slots); self->slots = (hash_ptr)NULL;
+
+  self->be_enc = BE_ENC(NULL);
+  self->rbc_mgr = (Rbc_Manager_t*)NULL;
+  self->bdd_enc = BDD_ENC(NULL);
+  self->dd = (DDMgr_ptr)NULL;
+  self->gen = RANDOM_GEN(NULL);
+
+  env_object_deinit(ENV_OBJECT(self));
+}
+
+/*!
+  \brief Assigns a slot to every untimed variable of the encoding
+
+  Also the recorded slots and their bdd literals are set up.
+*/
+static void stat_bit_simulator_init_slots(StatBitSimulator_ptr self)
+{
+  const BeEnc_ptr enc = self->be_enc;
+  int index;
+  int slot;
+  int i;
+
+  self->slots = new_assoc();
+  self->slots_num = 0;
+
+  for (index = BeEnc_get_first_untimed_var_index(enc, BE_VAR_TYPE_ALL);
+       BeEnc_is_var_index_valid(enc, index);
+       index = BeEnc_get_next_var_index(enc, index, BE_VAR_TYPE_ALL)) {
+    insert_assoc(self->slots, NODE_FROM_INT(index),
+                 NODE_FROM_INT(++self->slots_num));
+  }
+
+  self->kinds = ALLOC(BeVarType, self->slots_num);
+  self->indices = ALLOC(int, self->slots_num);
+  self->nexts = ALLOC(int, self->slots_num);
+  self->currs = ALLOC(int, self->slots_num);
+  self->records = ALLOC(int, self->slots_num);
+  self->currs_num = 0;
+  self->records_num = 0;
+
+  slot = 0;
+  for (index = BeEnc_get_first_untimed_var_index(enc, BE_VAR_TYPE_ALL);
+       BeEnc_is_var_index_valid(enc, index);
+       index = BeEnc_get_next_var_index(enc, index, BE_VAR_TYPE_ALL)) {
+    self->indices[slot] = index;
+    self->nexts[slot] = -1;
+
+    if (BeEnc_is_index_untimed_curr(enc, index)) {
+      self->kinds[slot] = BE_VAR_TYPE_CURR;
+    }
+    else if (BeEnc_is_index_untimed_frozen(enc, index)) {
+      self->kinds[slot] = BE_VAR_TYPE_FROZEN;
+    }
+    else if (BeEnc_is_index_untimed_input(enc, index)) {
+      self->kinds[slot] = BE_VAR_TYPE_INPUT;
+    }
+    else {
+      nusmv_assert(BeEnc_is_index_untimed_next(enc, index));
+      self->kinds[slot] = BE_VAR_TYPE_NEXT;
+    }
+
+    slot++;
+  }
+
+  for (slot = 0; slot < self->slots_num; slot++) {
+    if (BE_VAR_TYPE_CURR == self->kinds[slot]) {
+      const be_ptr next =
+        BeEnc_var_curr_to_next(enc, BeEnc_index_to_var(enc,
+                                                       self->indices[slot]));
+
+      self->nexts[slot] =
+        stat_bit_simulator_get_slot(self, BeEnc_var_to_index(enc, next));
+      self->currs[self->currs_num++] = slot;
+    }
+
+    if (BE_VAR_TYPE_CURR == self->kinds[slot] ||
+        BE_VAR_TYPE_FROZEN == self->kinds[slot]) {
+      self->records[self->records_num++] = slot;
+    }
+  }
+
+  self->sf_records_num = self->records_num;
+
+  for (slot = 0; slot < self->slots_num; slot++) {
+    if (BE_VAR_TYPE_INPUT == self->kinds[slot]) {
+      self->records[self->records_num++] = slot;
+    }
+  }
+
+  self->lits = ALLOC(bdd_ptr, 2 * self->records_num);
+  for (i = 0; i < self->records_num; i++) {
+    node_ptr name =
+      BeEnc_index_to_name(enc, self->indices[self->records[i]]);
+    bdd_ptr var = BddEnc_expr_to_bdd(self->bdd_enc, name, Nil);
+
+    self->lits[2 * i] = bdd_not(self->dd, var);
+    self->lits[2 * i + 1] = var;
+  }
+}
+
+/*!
+  \brief Returns the slot of the given untimed index
+
+*/
+static int stat_bit_simulator_get_slot(const StatBitSimulator_ptr self,
+                                       const int index)
+{
+  const int res = NODE_TO_INT(find_assoc(self->slots, NODE_FROM_INT(index)));
+
+  nusmv_assert(0 < res);
+  return res - 1;
+}
+
+/*!
+  \brief Compiles model and invar into prog
+
+  The conjuncts of model that define a variable computed by the
+  program are compiled first, in the order they are needed. The
+  other conjuncts of model and the ones of invar become the guards
+  of the program. In the step program invar is evaluated on the next
+  state. If the model can not be compiled, self is marked as not
+  supported.
+*/
+static void stat_bit_simulator_compile(StatBitSimulator_ptr self,
+                                       StatBitProgram* prog,
+                                       Rbc_t* model, Rbc_t* invar,
+                                       const boolean step)
+{
+  StatBitCompiler comp;
+  array_t* conjuncts = array_alloc(Rbc_t*, 16);
+  array_t* constraints = array_alloc(Rbc_t*, 16);
+  array_t* guards = array_alloc(int, 16);
+  array_t* randoms = array_alloc(int, 16);
+  Rbc_t* conjunct;
+  int slot;
+  int i;
+
+  comp.step = step;
+  comp.definable = step ?
+    (BE_VAR_TYPE_NEXT | BE_VAR_TYPE_INPUT) :
+    (BE_VAR_TYPE_CURR | BE_VAR_TYPE_FROZEN | BE_VAR_TYPE_INPUT);
+  comp.defs = ALLOC(Rbc_t*, self->slots_num);
+  comp.compiled = ALLOC(boolean, self->slots_num);
+  comp.compiling = ALLOC(boolean, self->slots_num);
+  comp.regs[0] = new_assoc();
+  comp.regs[1] = new_assoc();
+  comp.code = array_alloc(StatBitInstr, 64);
+
+  for (slot = 0; slot < self->slots_num; slot++) {
+    comp.defs[slot] = (Rbc_t*)NULL;
+    comp.compiled[slot] = false;
+    comp.compiling[slot] = false;
+  }
+
+  stat_bit_simulator_conjuncts(self, model, conjuncts);
+  arrayForEachItem(Rbc_t*, conjuncts, i, conjunct) {
+    if (! stat_bit_simulator_define(self, &comp, conjunct)) {
+      array_insert_last(Rbc_t*, constraints, conjunct);
+    }
+  }
+
+  /* every computed variable is compiled, also if nobody reads it */
+  for (slot = 0; slot < self->slots_num; slot++) {
+    if (0 != (comp.definable & self->kinds[slot])) {
+      stat_bit_simulator_compile_def(self, &comp, slot);
+
+      if ((Rbc_t*)NULL == comp.defs[slot]) {
+        array_insert_last(int, randoms, slot);
+      }
+    }
+  }
+
+  arrayForEachItem(Rbc_t*, constraints, i, conjunct) {
+    array_insert_last(int, guards,
+                      stat_bit_simulator_compile_rbc(self, &comp, conjunct,
+                                                     false));
+  }
+
+  array_free(conjuncts);
+  conjuncts = array_alloc(Rbc_t*, 16);
+  stat_bit_simulator_conjuncts(self, invar, conjuncts);
+  arrayForEachItem(Rbc_t*, conjuncts, i, conjunct) {
+    array_insert_last(int, guards,
+                      stat_bit_simulator_compile_rbc(self, &comp, conjunct,
+                                                     true));
+  }
+
+  prog->code_num = array_n(comp.code);
+  prog->code = array_data(StatBitInstr, comp.code);
+  prog->guards_num = array_n(guards);
+  prog->guards = array_data(int, guards);
+  prog->randoms_num = array_n(randoms);
+  prog->randoms = array_data(int, randoms);
+
+  array_free(randoms);
+  array_free(guards);
+  array_free(constraints);
+  array_free(conjuncts);
+  array_free(comp.code);
+  free_assoc(comp.regs[1]);
+  free_assoc(comp.regs[0]);
+  FREE(comp.compiling);
+  FREE(comp.compiled);
+  FREE(comp.defs);
+}
+
+/*!
+  \brief Appends to res the conjuncts of f
+
+  Constant true conjuncts are dropped.
+*/
+static void stat_bit_simulator_conjuncts(StatBitSimulator_ptr self,
+                                         Rbc_t* f, array_t* res)
+{
+  if (Rbc_is_and(f) && ! Dag_VertexIsSet(f)) {
+    Dag_Vertex_t* v = Dag_VertexGetRef(f);
+
+    stat_bit_simulator_conjuncts(self, (Rbc_t*)v->outList[0], res);
+    stat_bit_simulator_conjuncts(self, (Rbc_t*)v->outList[1], res);
+  }
+  else if (Rbc_GetOne(self->rbc_mgr) != f) {
+    array_insert_last(Rbc_t*, res, f);
+  }
+}
+
+/*!
+  \brief Takes conjunct as a definition, if possible
+
+  Literals and coimplications with a literal side define their
+  variable, provided it is computed by the program and was not
+  defined yet. Returns true if conjunct was taken.
+*/
+static boolean stat_bit_simulator_define(StatBitSimulator_ptr self,
+                                         StatBitCompiler* comp,
+                                         Rbc_t* conjunct)
+{
+  if (Rbc_is_var(conjunct)) {
+    return stat_bit_simulator_define_var(self, comp, conjunct,
+                                         Rbc_GetOne(self->rbc_mgr));
+  }
+
+  if (Rbc_is_iff(conjunct)) {
+    Dag_Vertex_t* v = Dag_VertexGetRef(conjunct);
+    Rbc_t* left = (Rbc_t*)v->outList[0];
+    Rbc_t* right = (Rbc_t*)v->outList[1];
+
+    /* !(l <-> r) is both l <-> !r and !l <-> r */
+    if (Dag_VertexIsSet(conjunct)) {
+      return
+        stat_bit_simulator_define_var(self, comp, left,
+                                      Rbc_MakeNot(self->rbc_mgr, right)) ||
+        stat_bit_simulator_define_var(self, comp, right,
+                                      Rbc_MakeNot(self->rbc_mgr, left));
+    }
+
+    return stat_bit_simulator_define_var(self, comp, left, right) ||
+      stat_bit_simulator_define_var(self, comp, right, left);
+  }
+
+  return false;
+}
+
+/*!
+  \brief Defines the variable of lit as f, if possible
+
+  A negative literal defines its variable as !f.
+*/
+static boolean stat_bit_simulator_define_var(StatBitSimulator_ptr self,
+                                             StatBitCompiler* comp,
+                                             Rbc_t* lit, Rbc_t* f)
+{
+  int slot;
+
+  if (! Rbc_is_var(lit)) return false;
+
+  slot = stat_bit_simulator_get_slot(self, Rbc_GetVarIndex(lit));
+  if (0 == (comp->definable & self->kinds[slot]) ||
+      (Rbc_t*)NULL != comp->defs[slot]) {
+    return false;
+  }
+
+  comp->defs[slot] = Dag_VertexIsSet(lit) ?
+    Rbc_MakeNot(self->rbc_mgr, f) : f;
+
+  return true;
+}
+
+/*!
+  \brief Emits the code computing the given slot, if not done yet
+
+  Slots without a definition are drawn at random, and need no code.
+  A definition depending on itself makes self not supported.
+*/
+static void stat_bit_simulator_compile_def(StatBitSimulator_ptr self,
+                                           StatBitCompiler* comp,
+                                           const int slot)
+{
+  StatBitInstr instr;
+
+  if (comp->compiled[slot] || (Rbc_t*)NULL == comp->defs[slot]) return;
+
+  if (comp->compiling[slot]) {
+    self->supported = false;
+    return;
+  }
+
+  comp->compiling[slot] = true;
+
+  instr.op = STAT_BIT_COPY;
+  instr.dst = slot;
+  instr.args[0] =
+    stat_bit_simulator_compile_rbc(self, comp, comp->defs[slot], false);
+  instr.args[1] = instr.args[2] = 0;
+  array_insert_last(StatBitInstr, comp->code, instr);
+
+  comp->compiling[slot] = false;
+  comp->compiled[slot] = true;
+}
+
+/*!
+  \brief Emits the code computing f, and returns its operand
+
+  Every vertex is computed once per program. When invar is true, f
+  is a conjunct of the invar: it can depend only on the state and
+  frozen variables, and in the step program it is evaluated on the
+  next state.
+*/
+static int stat_bit_simulator_compile_rbc(StatBitSimulator_ptr self,
+                                          StatBitCompiler* comp,
+                                          Rbc_t* f, const boolean invar)
+{
+  Dag_Vertex_t* v = Dag_VertexGetRef(f);
+  const boolean neg = Dag_VertexIsSet(f) ? true : false;
+  StatBitInstr instr;
+  int reg;
+
+  if (Rbc_is_top(f)) {
+    /* the top vertex is true */
+    return STAT_BIT_OPERAND(self->zero, ! neg);
+  }
+
+  if (Rbc_is_var(f)) {
+    int slot = stat_bit_simulator_get_slot(self, Rbc_GetVarIndex(f));
+    const BeVarType kind = self->kinds[slot];
+
+    if ((invar && BE_VAR_TYPE_CURR != kind && BE_VAR_TYPE_FROZEN != kind) ||
+        (! comp->step && BE_VAR_TYPE_NEXT == kind)) {
+      self->supported = false;
+      return STAT_BIT_OPERAND(self->zero, neg);
+    }
+
+    if (invar && comp->step && BE_VAR_TYPE_CURR == kind) {
+      slot = self->nexts[slot];
+    }
+
+    if (0 != (comp->definable & self->kinds[slot])) {
+      stat_bit_simulator_compile_def(self, comp, slot);
+    }
+
+    return STAT_BIT_OPERAND(slot, neg);
+  }
+
+  reg = NODE_TO_INT(find_assoc(comp->regs[invar ? 1 : 0], (node_ptr)v)) - 1;
+  if (0 <= reg) return STAT_BIT_OPERAND(reg, neg);
+
+  if (Rbc_is_and(f)) instr.op = STAT_BIT_AND;
+  else if (Rbc_is_iff(f)) instr.op = STAT_BIT_IFF;
+  else {
+    nusmv_assert(Rbc_is_ite(f));
+    instr.op = STAT_BIT_ITE;
+  }
+
+  instr.args[0] =
+    stat_bit_simulator_compile_rbc(self, comp, (Rbc_t*)v->outList[0], invar);
+  instr.args[1] =
+    stat_bit_simulator_compile_rbc(self, comp, (Rbc_t*)v->outList[1], invar);
+  instr.args[2] = (STAT_BIT_ITE == instr.op) ?
+    stat_bit_simulator_compile_rbc(self, comp, (Rbc_t*)v->outList[2], invar) :
+    0;
+
+  instr.dst = reg = self->regs_num++;
+  array_insert_last(StatBitInstr, comp->code, instr);
+  insert_assoc(comp->regs[invar ? 1 : 0], (node_ptr)v, NODE_FROM_INT(reg + 1));
+
+  return STAT_BIT_OPERAND(reg, neg);
+}
+
+/*!
+  \brief Runs prog on the lanes in alive
+
+  The random slots of the lanes whose guards do not hold are drawn
+  again, until all the guards hold or the attempts are over. The
+  lanes still pending are dropped from the returned alive lanes.
+  Since the program is deterministic, the lanes already accepted
+  keep their values.
+*/
+static StatBitWord stat_bit_simulator_run(StatBitSimulator_ptr self,
+                                          const StatBitProgram* prog,
+                                          const StatBitWord alive)
+{
+  StatBitWord* const regs = self->regs;
+  StatBitWord pending = alive;
+  int tries;
+
+  for (tries = 0;
+       tries < STAT_BIT_SIMULATOR_MAX_TRIES && 0 != pending;
+       tries++) {
+    StatBitWord accepted = ~(StatBitWord)0;
+    int i;
+
+    for (i = 0; i < prog->randoms_num; i++) {
+      const int slot = prog->randoms[i];
+
+      regs[slot] = (regs[slot] & ~pending) |
+        ((StatBitWord)RandomGen_next(self->gen) & pending);
+    }
+
+    for (i = 0; i < prog->code_num; i++) {
+      const StatBitInstr* instr = prog->code + i;
+      const StatBitWord a = STAT_BIT_VALUE(regs, instr->args[0]);
+
+      switch (instr->op) {
+      case STAT_BIT_AND:
+        regs[instr->dst] = a & STAT_BIT_VALUE(regs, instr->args[1]);
+        break;
+
+      case STAT_BIT_IFF:
+        regs[instr->dst] = ~(a ^ STAT_BIT_VALUE(regs, instr->args[1]));
+        break;
+
+      case STAT_BIT_ITE:
+        regs[instr->dst] = (a & STAT_BIT_VALUE(regs, instr->args[1])) |
+          (~a & STAT_BIT_VALUE(regs, instr->args[2]));
+        break;
+
+      case STAT_BIT_COPY:
+        regs[instr->dst] = a;
+        break;
+
+      default:
+        error_unreachable_code();
+      }
+    }
+
+    for (i = 0; i < prog->guards_num; i++) {
+      accepted &= STAT_BIT_VALUE(regs, prog->guards[i]);
+    }
+
+    pending &= ~accepted;
+  }
+
+  return alive & ~pending;
+}
+
+/*!
+  \brief Stores the recorded slots at the given time
+
+*/
+static void stat_bit_simulator_record(StatBitSimulator_ptr self,
+                                      const int time)
+{
+  StatBitWord* record = self->history + time * self->records_num;
+  int i;
+
+  for (i = 0; i < self->records_num; i++) {
+    record[i] = self->regs[self->records[i]];
+  }
+}
+
+/*!
+  \brief Builds the execution of the given lane
+
+  The input of a state is the one drawn by the step leading to it.
+  If lassos is true the execution stops at its first repeated state.
+*/
+static StatTrace_ptr
+  stat_bit_simulator_get_execution(StatBitSimulator_ptr self,
+                                   const int lane, const int k,
+                                   const boolean lassos)
+{
+  StatTrace_ptr exec = StatTrace_create();
+  int t;
+
+  for (t = 0; t <= k && ! StatTrace_is_generated(exec); t++) {
+    const StatBitWord* record = self->history + t * self->records_num;
+    bdd_ptr state =
+      stat_bit_simulator_get_minterm(self, record, lane,
+                                     0, self->sf_records_num);
+    bdd_ptr input = (0 < t) ?
+      stat_bit_simulator_get_minterm(self, record, lane,
+                                     self->sf_records_num, self->records_num) :
+      (bdd_ptr)NULL;
+
+    StatTrace_add_state(exec, stat_bit_simulator_get_sexp(self, state, input),
+                        lassos);
+
+    bdd_free(self->dd, state);
+    if ((bdd_ptr)NULL != input) bdd_free(self->dd, input);
+  }
+
+  if (! StatTrace_is_generated(exec)) StatTrace_force_loopback(exec, 0);
+
+  return exec;
+}
+
+/*!
+  \brief Returns the minterm of the records in [from, to) of lane
+
+  The returned bdd is referenced.
+*/
+static bdd_ptr stat_bit_simulator_get_minterm(StatBitSimulator_ptr self,
+                                              const StatBitWord* record,
+                                              const int lane,
+                                              const int from,
+                                              const int to)
+{
+  bdd_ptr res = bdd_true(self->dd);
+  int i;
+
+  for (i = from; i < to; i++) {
+    bdd_and_accumulate(self->dd, &res,
+                       self->lits[2 * i + (int)((record[i] >> lane) & 1)]);
+  }
+
+  return res;
+}
+
+/*!
+  \brief Returns the sexp of the given state and input
+
+  input can be NULL, in this case only the state variables occur in
+  the sexp. The sexp is built as the one of StatSimulator, so that
+  the same states are the same expressions, and it is cached by
+  minterm.
+*/
+static Expr_ptr stat_bit_simulator_get_sexp(StatBitSimulator_ptr self,
+                                            bdd_ptr state, bdd_ptr input)
+{
+  const ExprMgr_ptr exprs =
+    EXPR_MGR(NuSMVEnv_get_value(STAT_ENV(self), ENV_EXPR_MANAGER));
+  bdd_ptr key;
+  Expr_ptr res;
+
+  if ((bdd_ptr)NULL == input) key = bdd_dup(state);
+  else key = bdd_and(self->dd, state, input);
+
+  res = find_assoc(self->sexps, (node_ptr)key);
+
+  if (Nil == res) {
+    const StatProfiler_ptr profiler = Stat_get_profiler(STAT_ENV(self));
+
+    if (STAT_PROFILER(NULL) != profiler) {
+      StatProfiler_start(profiler, STAT_STAGE_CONVERSION);
+    }
+
+    res = stat_bit_simulator_assign(self, state, self->sf_vars,
+                                    ExprMgr_true(exprs));
+
+    if ((bdd_ptr)NULL != input) {
+      res = stat_bit_simulator_assign(self, input, self->i_vars, res);
+    }
+
+    if (STAT_PROFILER(NULL) != profiler) {
+      StatProfiler_stop(profiler, STAT_STAGE_CONVERSION);
+    }
+
+    /* the key is kept referenced by the hash */
+    insert_assoc(self->sexps, (node_ptr)key, res);
+  }
+  else {
+    bdd_free(self->dd, key);
+  }
+
+  return res;
+}
+
+/*!
+  \brief Conjoins res with the values of vars in minterm
+
+*/
+static Expr_ptr stat_bit_simulator_assign(StatBitSimulator_ptr self,
+                                          bdd_ptr minterm,
+                                          NodeList_ptr vars,
+                                          Expr_ptr res)
+{
+  const NuSMVEnv_ptr env = STAT_ENV(self);
+  const NodeMgr_ptr nodemgr = NODE_MGR(NuSMVEnv_get_value(env, ENV_NODE_MGR));
+  const ExprMgr_ptr exprs = EXPR_MGR(NuSMVEnv_get_value(env, ENV_EXPR_MANAGER));
+  const SymbTable_ptr st = BaseEnc_get_symb_table(BASE_ENC(self->bdd_enc));
+  node_ptr assigns;
+  node_ptr iter;
+
+  assigns = BddEnc_assign_symbols(self->bdd_enc, minterm, vars, false,
+                                  (bdd_ptr*)NULL);
+
+  for (iter = assigns; Nil != iter; iter = cdr(iter)) {
+    node_ptr assign = car(iter);
+
+    nusmv_assert(EQUAL == node_get_type(assign));
+    res = ExprMgr_and(exprs,
+                      ExprMgr_equal(exprs, car(assign), cdr(assign), st),
+                      res);
+  }
+
+  free_list(nodemgr, assigns);
+
+  return res;
+}
+
+/*!
+  \brief Frees the arrays of prog
+
+*/
+static void stat_bit_program_deinit(StatBitProgram* prog)
+{
+  if ((StatBitInstr*)NULL != prog->code) FREE(prog->code);
+  if ((int*)NULL != prog->guards) FREE(prog->guards);
+  if ((int*)NULL != prog->randoms) FREE(prog->randoms);
+}
+
+/*!
+  \brief Private service
+
+  Used when destroying hash containing bdd_ptr as keys
+*/
+static assoc_retval stat_bit_simulator_free_key(char* key, char* data,
+                                                char* arg)
+{
+  DDMgr_ptr dd = (DDMgr_ptr) arg;
+
+  if ((bdd_ptr)NULL != (bdd_ptr)key) { bdd_free(dd, (bdd_ptr)key); }
+  return ASSOC_DELETE;
+}
+
+/**AutomaticEnd***************************************************************/
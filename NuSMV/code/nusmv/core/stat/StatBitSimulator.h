@@ -0,0 +1,156 @@
+/* ---------------------------------------------------------------------------
+
+
+  This file is part of the ``stat'' package of NuSMV version 2.
+  Copyright (C) 2012 by FBK-irst.
+
+  NuSMV version 2 is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  NuSMV version 2 is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA.
+
+  For more information on NuSMV see <http://nusmv.fbk.eu>
+  or email to <nusmv-users@fbk.eu>.
+  Please report bugs to <nusmv-users@fbk.eu>.
+
+  To contact the NuSMV development board, email to <nusmv@fbk.eu>.
+
+-----------------------------------------------------------------------------*/
+
+/*!
+  \author Alberto Bombardelli
+  \brief Public interface of class 'StatBitSimulator'
+
+  A StatBitSimulator draws STAT_BIT_SIMULATOR_PATHS random
+  executions at once out of the boolean model (the BE fsm). The
+  init, invar and trans of the model are compiled into straight-line
+  programs over machine words, where the i-th bit of every word
+  belongs to the i-th execution, so that one evaluation of the
+  program advances all the executions by one step.
+
+  The conjuncts of the model of the form v <-> f are taken as the
+  definition of the variable v, which is computed from f. All the
+  other conjuncts are constraints. The variables not defined, the
+  inputs first of all, are chosen uniformly at random, and a choice
+  that violates a constraint is drawn again, up to a bounded number
+  of attempts. Executions whose attempts run out are discarded.
+
+  Notice that the executions are not drawn with the distribution of
+  StatSimulator, which picks the successor states uniformly: here
+  the undefined bits are picked uniformly instead. The two coincide
+  when different choices lead to different successors.
+
+  Models whose definitions are cyclic, or whose invar depends on the
+  inputs, are not supported.
+
+*/
+
+
+#ifndef __NUSMV_CORE_STAT_STAT_BIT_SIMULATOR_H__
+#define __NUSMV_CORE_STAT_STAT_BIT_SIMULATOR_H__
+
+#include "nusmv/core/cinit/NuSMVEnv.h"
+#include "nusmv/core/fsm/be/BeFsm.h"
+#include "nusmv/core/stat/StatTrace.h"
+#include "nusmv/core/utils/utils.h"
+
+/*!
+  \brief The number of executions drawn at once
+
+  One for every bit of a machine word.
+*/
+#define STAT_BIT_SIMULATOR_PATHS 64
+
+/*!
+  \struct StatBitSimulator
+  \brief Definition of the public accessor for class StatBitSimulator
+
+*/
+typedef struct StatBitSimulator_TAG*  StatBitSimulator_ptr;
+
+/*!
+  \brief To cast and check instances of class StatBitSimulator
+
+  These macros must be used respectively to cast and to check
+  instances of class StatBitSimulator
+*/
+#define STAT_BIT_SIMULATOR(self) \
+         ((StatBitSimulator_ptr) self)
+
+/*!
+  \brief \todo Missing synopsis
+
+  \todo Missing description
+*/
+#define STAT_BIT_SIMULATOR_CHECK_INSTANCE(self) \
+         (nusmv_assert(STAT_BIT_SIMULATOR(self) != STAT_BIT_SIMULATOR(NULL)))
+
+
+/**AutomaticStart*************************************************************/
+
+/*---------------------------------------------------------------------------*/
+/* Function prototypes                                                       */
+/*---------------------------------------------------------------------------*/
+
+/* Constructors ***************************************************************/
+
+/*!
+  \methodof StatBitSimulator
+  \brief The StatBitSimulator class constructor
+
+  The model fsm is compiled. If it is not supported the simulator
+  can not be used.
+
+  \sa StatBitSimulator_destroy, StatBitSimulator_is_supported
+*/
+StatBitSimulator_ptr StatBitSimulator_create(const NuSMVEnv_ptr env,
+                                             const BeFsm_ptr fsm);
+
+/* Destructors ****************************************************************/
+
+/*!
+  \methodof StatBitSimulator
+  \brief The StatBitSimulator class destructor
+
+  \sa StatBitSimulator_create
+*/
+void StatBitSimulator_destroy(StatBitSimulator_ptr self);
+
+/*!
+  \methodof StatBitSimulator
+  \brief Returns true if the model could be compiled
+
+*/
+boolean StatBitSimulator_is_supported(const StatBitSimulator_ptr self);
+
+/*!
+  \methodof StatBitSimulator
+  \brief Draws a block of executions of k steps
+
+  At most STAT_BIT_SIMULATOR_PATHS executions are stored in execs,
+  and their number is returned: executions that cannot satisfy the
+  constraints of a step within a bounded number of random choices
+  are dropped, and the caller can tell how many from the result. If lassos is true, an execution
+  stops at its first repeated state, which gives its loopback.
+  Otherwise, or if no state repeats, the execution has k + 1 states
+  and loopback 0, as the ones of the BMC problems generator. The
+  states are built as StatSimulator does. The executions are owned
+  by the caller.
+*/
+int StatBitSimulator_simulate(StatBitSimulator_ptr self,
+                              const int k,
+                              const boolean lassos,
+                              StatTrace_ptr* execs);
+
+/**AutomaticEnd***************************************************************/
+
+#endif /* __NUSMV_CORE_STAT_STAT_BIT_SIMULATOR_H__ */
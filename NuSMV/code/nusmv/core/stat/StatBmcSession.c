@@ -0,0 +1,560 @@
+/* ---------------------------------------------------------------------------
+
+
+  This file is part of the ``stat'' package of NuSMV version 2.
+  Copyright (C) 2012 by FBK-irst.
+
+  NuSMV version 2 is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  NuSMV version 2 is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA.
+
+  For more information on NuSMV see <http://nusmv.fbk.eu>
+  or email to <nusmv-users@fbk.eu>.
+  Please report bugs to <nusmv-users@fbk.eu>.
+
+  To contact the NuSMV development board, email to <nusmv@fbk.eu>.
+
+-----------------------------------------------------------------------------*/
+
+/*!
+  \author Alberto Bombardelli
+  \brief Implementation of class 'StatBmcSession'
+
+  An execution s_0 ... s_k violates the property within bound k iff
+  the problem [[M]]_k & [[!prop]]_k (with no loopback) is
+  satisfiable under the assumptions that fix, at each time t, the
+  state variables to their values in s_t and the input variables to
+  the values of the input leading from s_t to s_{t+1}. The problem
+  only depends on the property and on k, so it is converted to CNF
+  and added to the permanent group of the solver once: the
+  assumptions are the only part which changes among the executions.
+
+*/
+
+#include "nusmv/core/stat/StatBmcSession.h"
+#include "nusmv/core/stat/statInt.h"
+
+#include "nusmv/core/utils/EnvObject.h"
+#include "nusmv/core/utils/EnvObject_private.h"
+#include "nusmv/core/utils/assoc.h"
+#include "nusmv/core/utils/Slist.h"
+#include "nusmv/core/utils/ErrorMgr.h"
+
+#include "nusmv/core/be/be.h"
+#include "nusmv/core/bmc/bmcGen.h"
+#include "nusmv/core/bmc/bmcUtils.h"
+#include "nusmv/core/enc/enc.h"
+#include "nusmv/core/enc/be/BeEnc.h"
+#include "nusmv/core/enc/bdd/BddEnc.h"
+#include "nusmv/core/compile/compile.h"
+#include "nusmv/core/prop/Prop.h"
+#include "nusmv/core/prop/Prop_Rewriter.h"
+#include "nusmv/core/sat/sat.h"
+#include "nusmv/core/sat/SatSolver.h"
+#include "nusmv/core/sat/SatIncSolver.h"
+#include "nusmv/core/wff/wff.h"
+#include "nusmv/core/wff/w2w/w2w.h"
+
+/*---------------------------------------------------------------------------*/
+/* Constant declarations                                                     */
+/*---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*/
+/* Structure declarations                                                    */
+/*---------------------------------------------------------------------------*/
+
+/*!
+  \brief A boolean variable of the model
+
+  The untimed index of the variable in the BE encoder and the
+  variable in the BDD encoder. Used to fix the value of the variable
+  in the solver according to the BDD of a sampled state.
+*/
+typedef struct StatBmcSessionBit_TAG
+{
+  int be_index;
+  bdd_ptr var;
+} StatBmcSessionBit;
+
+typedef struct StatBmcSession_TAG
+{
+  /* this MUST stay on the top */
+  INHERITS_FROM(EnvObject);
+
+  /* -------------------------------------------------- */
+  /*                  Private members                   */
+  /* -------------------------------------------------- */
+  /* the property, as passed to the constructor */
+  Prop_ptr prop;
+  int k;
+
+  /* private copy of the property, rewritten for BMC */
+  Prop_ptr bmc_prop;
+  Prop_Rewriter_ptr rewriter;
+
+  BeEnc_ptr be_enc;
+  Be_Manager_ptr be_mgr;
+  BddEnc_ptr bdd_enc;
+  DDMgr_ptr dd;
+
+  /* the solver, containing [[M]]_k & [[!prop]]_k */
+  SatIncSolver_ptr solver;
+
+  /* state (and frozen) variables and input variables */
+  StatBmcSessionBit* state_bits;
+  int state_bits_num;
+  StatBmcSessionBit* input_bits;
+  int input_bits_num;
+
+  /* states hash map: state sexp -> bdd_ptr (referenced) */
+  hash_ptr states;
+} StatBmcSession;
+
+/*---------------------------------------------------------------------------*/
+/* Type declarations                                                         */
+/*---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*/
+/* Variable declarations                                                     */
+/*---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*/
+/* Macro declarations                                                        */
+/*---------------------------------------------------------------------------*/
+#define STAT_ENV(self) (ENV_OBJECT(self)->environment)
+
+/**AutomaticStart*************************************************************/
+
+/*---------------------------------------------------------------------------*/
+/* Static function prototypes                                                */
+/*---------------------------------------------------------------------------*/
+
+static void stat_bmc_session_init(StatBmcSession_ptr self,
+                                  const NuSMVEnv_ptr env,
+                                  const Prop_ptr prop,
+                                  const int k);
+
+static void stat_bmc_session_deinit(StatBmcSession_ptr self);
+
+static void stat_bmc_session_load_problem(StatBmcSession_ptr self);
+
+static int stat_bmc_session_collect_bits(StatBmcSession_ptr self,
+                                         const BeVarType type,
+                                         StatBmcSessionBit** bits);
+
+static void stat_bmc_session_assume(StatBmcSession_ptr self,
+                                    Slist_ptr assumptions,
+                                    const StatBmcSessionBit* bits,
+                                    const int bits_num,
+                                    bdd_ptr state, const int time);
+
+static bdd_ptr stat_bmc_session_get_state_bdd(StatBmcSession_ptr self,
+                                              const Expr_ptr state);
+
+static assoc_retval stat_bmc_session_free_bdd(char* key, char* data,
+                                              char* arg);
+
+/*---------------------------------------------------------------------------*/
+/* Definition of exported functions                                          */
+/*---------------------------------------------------------------------------*/
+
+StatBmcSession_ptr StatBmcSession_create(const NuSMVEnv_ptr env,
+                                         const Prop_ptr prop,
+                                         const int k)
+{
+  StatBmcSession_ptr self = ALLOC(StatBmcSession, 1);
+  STAT_BMC_SESSION_CHECK_INSTANCE(self);
+
+  stat_bmc_session_init(self, env, prop, k);
+
+  return self;
+}
+
+void StatBmcSession_destroy(StatBmcSession_ptr self)
+{
+  STAT_BMC_SESSION_CHECK_INSTANCE(self);
+
+  stat_bmc_session_deinit(self);
+
+  FREE(self);
+}
+
+Prop_ptr StatBmcSession_get_prop(const StatBmcSession_ptr self)
+{
+  STAT_BMC_SESSION_CHECK_INSTANCE(self);
+
+  return self->prop;
+}
+
+int StatBmcSession_get_k(const StatBmcSession_ptr self)
+{
+  STAT_BMC_SESSION_CHECK_INSTANCE(self);
+
+  return self->k;
+}
+
+StatVericationResult StatBmcSession_check(StatBmcSession_ptr self,
+                                          const StatTrace_ptr execution)
+{
+  const ErrorMgr_ptr errmgr =
+    ERROR_MGR(NuSMVEnv_get_value(STAT_ENV(self), ENV_ERROR_MANAGER));
+  NodeList_ptr state_list;
+  ListIter_ptr iter;
+  Slist_ptr assumptions;
+  SatSolverResult sat_res;
+  StatVericationResult retval;
+  int t;
+
+  STAT_BMC_SESSION_CHECK_INSTANCE(self);
+  /* k steps + initial state */
+  nusmv_assert(StatTrace_get_length(execution) == self->k + 1);
+
+  /* the states of the previous executions are not in use anymore */
+  if (Stat_is_cache_full(STAT_ENV(self), self->states)) {
+    clear_assoc_and_free_entries_arg(self->states, stat_bmc_session_free_bdd,
+                                     (char*)self->dd);
+  }
+
+  assumptions = Slist_create();
+
+  state_list = StatTrace_get_sexp_states(execution);
+  t = 0;
+  NODE_LIST_FOREACH(state_list, iter) {
+    bdd_ptr state =
+      stat_bmc_session_get_state_bdd(self,
+                                     NodeList_get_elem_at(state_list, iter));
+
+    /* the input of the t-th state leads to it from state t - 1 */
+    if (t > 0) {
+      stat_bmc_session_assume(self, assumptions, self->input_bits,
+                              self->input_bits_num, state, t - 1);
+    }
+    stat_bmc_session_assume(self, assumptions, self->state_bits,
+                            self->state_bits_num, state, t);
+    t++;
+  }
+
+  sat_res =
+    SatSolver_solve_all_groups_assume(SAT_SOLVER(self->solver), assumptions);
+
+  Slist_destroy(assumptions);
+
+  switch (sat_res) {
+  case SAT_SOLVER_UNSATISFIABLE_PROBLEM:
+    retval = STAT_OK;
+    break;
+
+  case SAT_SOLVER_SATISFIABLE_PROBLEM:
+    retval = STAT_NOT_OK;
+    break;
+
+  case SAT_SOLVER_INTERNAL_ERROR:
+  case SAT_SOLVER_TIMEOUT:
+  case SAT_SOLVER_MEMOUT:
+    retval = STAT_INTERNAL_ERROR;
+    break;
+
+  default:
+    ErrorMgr_internal_error(errmgr,
+                            "StatBmcSession_check: Unexpected value in sat "
+                            "result");
+    retval = STAT_INTERNAL_ERROR;
+  }
+
+  return retval;
+}
+
+/*---------------------------------------------------------------------------*/
+/* Definition of internal functions                                          */
+/*---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*/
+/* Definition of static functions                                            */
+/*---------------------------------------------------------------------------*/
+
+/*!
+  \brief The StatBmcSession class private initializer
+
+  \sa StatBmcSession_create
+*/
+static void stat_bmc_session_init(StatBmcSession_ptr self,
+                                  const NuSMVEnv_ptr env,
+                                  const Prop_ptr prop,
+                                  const int k)
+{
+  env_object_init(ENV_OBJECT(self), env);
+
+  nusmv_assert(Prop_Ltl == Prop_get_type(prop));
+  nusmv_assert(k >= 0);
+
+  self->prop = prop;
+  self->k = k;
+  self->bmc_prop = PROP(NULL);
+  self->rewriter = (Prop_Rewriter_ptr)NULL;
+  self->be_enc = BE_ENC(NULL);
+  self->be_mgr = (Be_Manager_ptr)NULL;
+  self->bdd_enc = BDD_ENC(NuSMVEnv_get_value(env, ENV_BDD_ENCODER));
+  self->dd = BddEnc_get_dd_manager(self->bdd_enc);
+  self->solver = SAT_INC_SOLVER(NULL);
+  self->state_bits = (StatBmcSessionBit*)NULL;
+  self->state_bits_num = 0;
+  self->input_bits = (StatBmcSessionBit*)NULL;
+  self->input_bits_num = 0;
+  self->states = new_assoc();
+
+  stat_bmc_session_load_problem(self);
+
+  self->state_bits_num =
+    stat_bmc_session_collect_bits(self,
+                                  BE_VAR_TYPE_CURR | BE_VAR_TYPE_FROZEN,
+                                  &self->state_bits);
+  self->input_bits_num =
+    stat_bmc_session_collect_bits(self, BE_VAR_TYPE_INPUT,
+                                  &self->input_bits);
+}
+
+/*!
+  \brief The StatBmcSession class private deinitializer
+
+  \sa StatBmcSession_destroy
+*/
+static void stat_bmc_session_deinit(StatBmcSession_ptr self)
+{
+  int i;
+
+  clear_assoc_and_free_entries_arg(self->states, stat_bmc_session_free_bdd,
+                                   (char*)self->dd);
+  free_assoc(self->states); self->states = (hash_ptr)NULL;
+
+  for (i = 0; i < self->state_bits_num; i++) {
+    bdd_free(self->dd, self->state_bits[i].var);
+  }
+  FREE(self->state_bits);
+
+  for (i = 0; i < self->input_bits_num; i++) {
+    bdd_free(self->dd, self->input_bits[i].var);
+  }
+  FREE(self->input_bits);
+
+  SatIncSolver_destroy(self->solver);
+  self->solver = SAT_INC_SOLVER(NULL);
+
+  Prop_Rewriter_update_original_property(self->rewriter);
+  Prop_Rewriter_destroy(self->rewriter);
+  self->rewriter = (Prop_Rewriter_ptr)NULL;
+
+  Prop_destroy(self->bmc_prop);
+  self->bmc_prop = PROP(NULL);
+
+  env_object_deinit(ENV_OBJECT(self));
+}
+
+/*!
+  \brief Builds [[M]]_k & [[!prop]]_k and loads it into the solver
+
+  This is the same problem solved by Bmc_GenSolveLtl with no
+  loopback, built on a private copy of the property so that the
+  status of the original one is not affected.
+*/
+static void stat_bmc_session_load_problem(StatBmcSession_ptr self)
+{
+  const NuSMVEnv_ptr env = STAT_ENV(self);
+  const OptsHandler_ptr opts =
+    OPTS_HANDLER(NuSMVEnv_get_value(env, ENV_OPTS_HANDLER));
+  const ErrorMgr_ptr errmgr =
+    ERROR_MGR(NuSMVEnv_get_value(env, ENV_ERROR_MANAGER));
+  const NodeMgr_ptr nodemgr =
+    NODE_MGR(NuSMVEnv_get_value(env, ENV_NODE_MGR));
+
+  Prop_ptr rewritten;
+  BeFsm_ptr be_fsm;
+  node_ptr bltlspec;
+  be_ptr prob;
+  Be_Cnf_ptr cnf;
+  SatSolverGroup group;
+
+  self->solver = Sat_CreateIncSolver(env, get_sat_solver(opts));
+  if (SAT_INC_SOLVER(NULL) == self->solver) {
+    ErrorMgr_rpterr(errmgr, "Incremental sat solver '%s' is not available.\n",
+                    get_sat_solver(opts));
+  }
+
+  self->bmc_prop = Prop_create_partial(env, Prop_get_expr_core(self->prop),
+                                       Prop_Ltl);
+
+  if (opt_cone_of_influence(opts) == true) {
+    Prop_apply_coi_for_bmc(env, self->bmc_prop);
+  }
+
+  be_fsm = Prop_get_be_fsm(self->bmc_prop);
+  if (be_fsm == (BeFsm_ptr) NULL) {
+    Prop_set_environment_fsms(env, self->bmc_prop);
+    be_fsm = Prop_get_be_fsm(self->bmc_prop);
+    nusmv_assert(be_fsm != (BeFsm_ptr) NULL);
+  }
+
+  self->rewriter = Prop_Rewriter_create(env, self->bmc_prop,
+                                        WFF_REWRITE_METHOD_DEADLOCK_FREE,
+                                        WFF_REWRITER_REWRITE_INPUT_NEXT,
+                                        FSM_TYPE_BE, self->bdd_enc);
+  rewritten = Prop_Rewriter_rewrite(self->rewriter);
+  be_fsm = Prop_get_be_fsm(rewritten);
+
+  /* booleanized, negated and NNFed formula: */
+  bltlspec =
+    Wff2Nnf(env, Wff_make_not(nodemgr,
+                              Compile_detexpr2bexpr(self->bdd_enc,
+                                                    Prop_get_expr_core(rewritten))));
+
+  self->be_enc = BeFsm_get_be_encoding(be_fsm);
+  self->be_mgr = BeEnc_get_be_manager(self->be_enc);
+
+  prob = Bmc_Gen_LtlProblem(be_fsm, bltlspec, self->k,
+                            Bmc_Utils_GetNoLoopback());
+  prob = Bmc_Utils_apply_inlining4inc(self->be_mgr, prob);
+
+  cnf = Be_ConvertToCnf(self->be_mgr, prob, 1, get_rbc2cnf_algorithm(opts));
+
+  group = SatSolver_get_permanent_group(SAT_SOLVER(self->solver));
+  SatSolver_add(SAT_SOLVER(self->solver), cnf, group);
+  SatSolver_set_polarity(SAT_SOLVER(self->solver), cnf, 1, group);
+
+  Be_Cnf_Delete(cnf);
+}
+
+/*!
+  \brief Collects the boolean variables of the given type
+
+  Only the variables that are both in the BE and in the BDD encoders
+  are collected: the others (e.g. the monitor variables introduced by
+  the rewriting) are not constrained by the executions. The returned
+  array must be freed by the caller, and so must the bdds it
+  contains. Returns the number of collected variables.
+*/
+static int stat_bmc_session_collect_bits(StatBmcSession_ptr self,
+                                         const BeVarType type,
+                                         StatBmcSessionBit** bits)
+{
+  const SymbTable_ptr st = BaseEnc_get_symb_table(BASE_ENC(self->bdd_enc));
+  int num, idx;
+
+  num = 0;
+  for (idx = BeEnc_get_first_untimed_var_index(self->be_enc, type);
+       BeEnc_is_var_index_valid(self->be_enc, idx);
+       idx = BeEnc_get_next_var_index(self->be_enc, idx, type)) {
+    num++;
+  }
+
+  *bits = ALLOC(StatBmcSessionBit, num > 0 ? num : 1);
+  nusmv_assert((StatBmcSessionBit*)NULL != *bits);
+
+  num = 0;
+  for (idx = BeEnc_get_first_untimed_var_index(self->be_enc, type);
+       BeEnc_is_var_index_valid(self->be_enc, idx);
+       idx = BeEnc_get_next_var_index(self->be_enc, idx, type)) {
+    node_ptr name = BeEnc_index_to_name(self->be_enc, idx);
+    SymbLayer_ptr layer = SymbTable_variable_get_layer(st, name);
+
+    if (SYMB_LAYER(NULL) != layer &&
+        BaseEnc_layer_occurs(BASE_ENC(self->bdd_enc),
+                             SymbLayer_get_name(layer))) {
+      const int bdd_index =
+        BddEnc_get_var_index_from_name(self->bdd_enc, name);
+
+      (*bits)[num].be_index = idx;
+      (*bits)[num].var = bdd_new_var_with_index(self->dd, bdd_index);
+      num++;
+    }
+  }
+
+  return num;
+}
+
+/*!
+  \brief Adds to assumptions the values of bits in state at time
+
+  A bit whose value is not determined by state is left free. Frozen
+  variables are untimed, thus they are fixed at time 0 only.
+*/
+static void stat_bmc_session_assume(StatBmcSession_ptr self,
+                                    Slist_ptr assumptions,
+                                    const StatBmcSessionBit* bits,
+                                    const int bits_num,
+                                    bdd_ptr state, const int time)
+{
+  int i;
+
+  for (i = 0; i < bits_num; i++) {
+    const int idx = bits[i].be_index;
+    be_ptr timed;
+    int cnf_lit;
+
+    if (time > 0 && BeEnc_is_index_frozen_var(self->be_enc, idx)) continue;
+
+    timed = BeEnc_index_to_timed(self->be_enc, idx, time);
+    cnf_lit = Be_BeIndex2CnfLiteral(self->be_mgr,
+                                    BeEnc_var_to_index(self->be_enc, timed));
+
+    /* the variable does not occur in the problem */
+    if (0 == cnf_lit) continue;
+
+    if (bdd_entailed(self->dd, state, bits[i].var)) {
+      Slist_push(assumptions, PTR_FROM_INT(void*, cnf_lit));
+    }
+    else {
+      bdd_ptr neg = bdd_not(self->dd, bits[i].var);
+
+      if (bdd_entailed(self->dd, state, neg)) {
+        Slist_push(assumptions,
+                   PTR_FROM_INT(void*,
+                                Be_CnfLiteral_Negate(self->be_mgr, cnf_lit)));
+      }
+      bdd_free(self->dd, neg);
+    }
+  }
+}
+
+/*!
+  \brief Returns the bdd of the given state
+
+  The returned bdd is cached and must not be freed.
+*/
+static bdd_ptr stat_bmc_session_get_state_bdd(StatBmcSession_ptr self,
+                                              const Expr_ptr state)
+{
+  bdd_ptr res = (bdd_ptr)find_assoc(self->states, state);
+
+  if ((bdd_ptr)NULL == res) {
+    res = BddEnc_expr_to_bdd(self->bdd_enc, state, Nil);
+    insert_assoc(self->states, state, (node_ptr)res);
+  }
+
+  return res;
+}
+
+/*!
+  \brief Private service
+
+  Used when destroying hash containing bdd_ptr as data
+*/
+static assoc_retval stat_bmc_session_free_bdd(char* key, char* data,
+                                              char* arg)
+{
+  bdd_ptr bdd = (bdd_ptr) data;
+  DDMgr_ptr dd = (DDMgr_ptr) arg;
+
+  if (bdd != (bdd_ptr) NULL) { bdd_free(dd, bdd); }
+  return ASSOC_DELETE;
+}
+
+/**AutomaticEnd***************************************************************/
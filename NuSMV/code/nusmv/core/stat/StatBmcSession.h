@@ -0,0 +1,137 @@
+/* ---------------------------------------------------------------------------
+
+
+  This file is part of the ``stat'' package of NuSMV version 2.
+  Copyright (C) 2012 by FBK-irst.
+
+  NuSMV version 2 is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  NuSMV version 2 is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA.
+
+  For more information on NuSMV see <http://nusmv.fbk.eu>
+  or email to <nusmv-users@fbk.eu>.
+  Please report bugs to <nusmv-users@fbk.eu>.
+
+  To contact the NuSMV development board, email to <nusmv@fbk.eu>.
+
+-----------------------------------------------------------------------------*/
+
+/*!
+  \author Alberto Bombardelli
+  \brief Public interface of class 'StatBmcSession'
+
+  A StatBmcSession verifies the fixed length executions produced by
+  StatProblemsGeneratorBmc with a single incremental SAT solver.
+
+  The unrolling of the model and the tableau of the negated property
+  for bound k (with no loopback) are built, converted to CNF and
+  loaded into the permanent group of the solver once. Each execution
+  is then checked by solving under assumptions: one unit literal for
+  each bit of the state (and input) variables at each step of the
+  execution. Learnt clauses are kept from an execution to the next.
+
+*/
+
+
+
+#ifndef __NUSMV_CORE_STAT_STAT_BMC_SESSION_H__
+#define __NUSMV_CORE_STAT_STAT_BMC_SESSION_H__
+
+#include "nusmv/core/stat/stat.h"
+#include "nusmv/core/stat/StatTrace.h"
+#include "nusmv/core/prop/Prop.h"
+
+/*!
+  \struct StatBmcSession
+  \brief Definition of the public accessor for class StatBmcSession
+
+*/
+typedef struct StatBmcSession_TAG*  StatBmcSession_ptr;
+
+/*!
+  \brief To cast and check instances of class StatBmcSession
+
+  These macros must be used respectively to cast and to check
+  instances of class StatBmcSession
+*/
+#define STAT_BMC_SESSION(self) \
+         ((StatBmcSession_ptr) self)
+
+/*!
+  \brief \todo Missing synopsis
+
+  \todo Missing description
+*/
+#define STAT_BMC_SESSION_CHECK_INSTANCE(self) \
+         (nusmv_assert(STAT_BMC_SESSION(self) != STAT_BMC_SESSION(NULL)))
+
+
+/**AutomaticStart*************************************************************/
+
+/*---------------------------------------------------------------------------*/
+/* Function prototypes                                                       */
+/*---------------------------------------------------------------------------*/
+
+/* Constructors ***************************************************************/
+
+/*!
+  \methodof StatBmcSession
+  \brief The StatBmcSession class constructor
+
+  Builds the problem of prop with bound k and loads it into a new
+  incremental solver. An error is raised if the incremental SAT
+  solver selected by the sat_solver option is not available.
+
+  \sa StatBmcSession_destroy
+*/
+StatBmcSession_ptr StatBmcSession_create(const NuSMVEnv_ptr env,
+                                         const Prop_ptr prop,
+                                         const int k);
+
+/* Destructors ****************************************************************/
+
+/*!
+  \methodof StatBmcSession
+  \brief The StatBmcSession class destructor
+
+  \sa StatBmcSession_create
+*/
+void StatBmcSession_destroy(StatBmcSession_ptr self);
+
+/*!
+  \methodof StatBmcSession
+  \brief Returns the property the session was built for
+
+*/
+Prop_ptr StatBmcSession_get_prop(const StatBmcSession_ptr self);
+
+/*!
+  \methodof StatBmcSession
+  \brief Returns the bound the session was built for
+
+*/
+int StatBmcSession_get_k(const StatBmcSession_ptr self);
+
+/*!
+  \methodof StatBmcSession
+  \brief Verifies the property on the given execution
+
+  The execution must have k + 1 states. Returns STAT_OK iff no
+  counterexample of length k follows the execution.
+*/
+StatVericationResult StatBmcSession_check(StatBmcSession_ptr self,
+                                          const StatTrace_ptr execution);
+
+/**AutomaticEnd***************************************************************/
+
+#endif /* __NUSMV_CORE_STAT_STAT_BMC_SESSION_H__ */
@@ -0,0 +1,817 @@
+/* ---------------------------------------------------------------------------
+
+
+  This file is part of the ``stat'' package of NuSMV version 2.
+  Copyright (C) 2012 by FBK-irst.
+
+  NuSMV version 2 is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  NuSMV version 2 is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA.
+
+  For more information on NuSMV see <http://nusmv.fbk.eu>
+  or email to <nusmv-users@fbk.eu>.
+  Please report bugs to <nusmv-users@fbk.eu>.
+
+  To contact the NuSMV development board, email to <nusmv@fbk.eu>.
+
+-----------------------------------------------------------------------------*/
+
+/*!
+  \author Alberto Bombardelli
+  \brief Implementation of class 'StatCheckpoint'
+
+  The checkpoint is a text file made of whitespace separated tokens:
+  a header, the state of the random generator, and then for every
+  property its text, its estimation and its memoized executions.
+
+  The states of the memoized executions share most of their
+  subexpressions, so expressions are written as DAGs: a node is
+  defined the first time it is written, and referred to by the index
+  of its definition afterwards. Nodes are rebuilt with find_node,
+  so that the keys read back are the same keys the problem
+  generators build.
+
+*/
+
+#if HAVE_CONFIG_H
+# include "nusmv-config.h"
+#endif
+
+#include "nusmv/core/stat/StatCheckpoint.h"
+
+#include "nusmv/core/utils/EnvObject.h"
+#include "nusmv/core/utils/EnvObject_private.h"
+#include "nusmv/core/utils/ErrorMgr.h"
+#include "nusmv/core/utils/Logger.h"
+#include "nusmv/core/utils/RandomGen.h"
+#include "nusmv/core/utils/UStringMgr.h"
+#include "nusmv/core/utils/ustring.h"
+#include "nusmv/core/utils/WordNumberMgr.h"
+#include "nusmv/core/utils/assoc.h"
+#include "nusmv/core/node/NodeMgr.h"
+#include "nusmv/core/parser/symbols.h"
+#include "nusmv/core/opt/opt.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+/*---------------------------------------------------------------------------*/
+/* Constant declarations                                                     */
+/*---------------------------------------------------------------------------*/
+
+#define STAT_CHECKPOINT_MAGIC "StatNuSMV-checkpoint"
+
+/* to be increased whenever the format changes */
+#define STAT_CHECKPOINT_VERSION 1
+
+/* the checkpoint is written to fname + suffix, and then renamed */
+#define STAT_CHECKPOINT_TMP_SUFFIX ".tmp"
+
+/*---------------------------------------------------------------------------*/
+/* Structure declarations                                                    */
+/*---------------------------------------------------------------------------*/
+
+typedef struct StatCheckpoint_TAG
+{
+  /* this MUST stay on the top */
+  INHERITS_FROM(EnvObject);
+
+  /* -------------------------------------------------- */
+  /*                  Private members                   */
+  /* -------------------------------------------------- */
+  char* fname;
+
+  const Prop_ptr* props;
+  StatEstimation_ptr* estimations;
+  StatProblemsGenerator_ptr* generators;
+  int props_num;
+
+  /* time of the last checkpoint, or of the creation */
+  time_t last;
+
+  /* true once a checkpoint could not be written, to warn only once */
+  boolean failed;
+
+  /* file being written or read */
+  FILE* stream;
+
+  /* while writing: node -> 1 + index of its definition */
+  hash_ptr ids;
+  long ids_num;
+
+  /* while reading: the defined nodes, by index of definition */
+  node_ptr* nodes;
+  long nodes_num;
+  long nodes_size;
+} StatCheckpoint;
+
+/*---------------------------------------------------------------------------*/
+/* Type declarations                                                         */
+/*---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*/
+/* Variable declarations                                                     */
+/*---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*/
+/* Macro declarations                                                        */
+/*---------------------------------------------------------------------------*/
+
+
+/**AutomaticStart*************************************************************/
+
+/*---------------------------------------------------------------------------*/
+/* Static function prototypes                                                */
+/*---------------------------------------------------------------------------*/
+
+static void stat_checkpoint_init(StatCheckpoint_ptr self,
+                                 const NuSMVEnv_ptr env,
+                                 const char* fname,
+                                 const Prop_ptr* props,
+                                 StatEstimation_ptr* estimations,
+                                 StatProblemsGenerator_ptr* generators,
+                                 const int props_num);
+
+static void stat_checkpoint_deinit(StatCheckpoint_ptr self);
+
+static void stat_checkpoint_write(StatCheckpoint_ptr self);
+
+static boolean stat_checkpoint_read(StatCheckpoint_ptr self);
+
+static void stat_checkpoint_write_text(StatCheckpoint_ptr self,
+                                       const char* text);
+
+static char* stat_checkpoint_read_text(StatCheckpoint_ptr self);
+
+static void stat_checkpoint_write_memoized(StatCheckpoint_ptr self,
+                                           const StatProblemsGenerator_ptr gen);
+
+static boolean stat_checkpoint_read_memoized(StatCheckpoint_ptr self,
+                                             StatProblemsGenerator_ptr gen);
+
+static boolean stat_checkpoint_is_writable(StatCheckpoint_ptr self,
+                                           node_ptr node);
+
+static void stat_checkpoint_write_node(StatCheckpoint_ptr self,
+                                       node_ptr node);
+
+static boolean stat_checkpoint_read_node(StatCheckpoint_ptr self,
+                                         node_ptr* node);
+
+/*---------------------------------------------------------------------------*/
+/* Definition of exported functions                                          */
+/*---------------------------------------------------------------------------*/
+
+StatCheckpoint_ptr StatCheckpoint_create(const NuSMVEnv_ptr env,
+                                         const char* fname,
+                                         const Prop_ptr* props,
+                                         StatEstimation_ptr* estimations,
+                                         StatProblemsGenerator_ptr* generators,
+                                         const int props_num)
+{
+  StatCheckpoint_ptr self = ALLOC(StatCheckpoint, 1);
+  STAT_CHECKPOINT_CHECK_INSTANCE(self);
+
+  stat_checkpoint_init(self, env, fname, props, estimations, generators,
+                       props_num);
+
+  return self;
+}
+
+void StatCheckpoint_destroy(StatCheckpoint_ptr self)
+{
+  STAT_CHECKPOINT_CHECK_INSTANCE(self);
+
+  stat_checkpoint_deinit(self);
+
+  FREE(self);
+}
+
+boolean StatCheckpoint_resume(StatCheckpoint_ptr self)
+{
+  const NuSMVEnv_ptr env = ENV_OBJECT(self)->environment;
+  const ErrorMgr_ptr errmgr =
+    ERROR_MGR(NuSMVEnv_get_value(env, ENV_ERROR_MANAGER));
+  const OptsHandler_ptr opts =
+    OPTS_HANDLER(NuSMVEnv_get_value(env, ENV_OPTS_HANDLER));
+  boolean res;
+
+  STAT_CHECKPOINT_CHECK_INSTANCE(self);
+
+  self->stream = fopen(self->fname, "r");
+  if ((FILE*)NULL == self->stream) return false;
+
+  res = stat_checkpoint_read(self);
+
+  fclose(self->stream);
+  self->stream = (FILE*)NULL;
+
+  FREE(self->nodes);
+  self->nodes_num = 0;
+  self->nodes_size = 0;
+
+  if (! res) {
+    ErrorMgr_rpterr(errmgr, "Checkpoint \"%s\" is corrupted, or it does not "
+                    "match the properties and the parameters of the run\n",
+                    self->fname);
+  }
+
+  if (opt_verbose_level_gt(opts, 0)) {
+    const Logger_ptr logger = LOGGER(NuSMVEnv_get_value(env, ENV_LOGGER));
+
+    Logger_log(logger, "Statistical model checking: resumed from "
+               "checkpoint \"%s\"\n", self->fname);
+  }
+
+  return true;
+}
+
+void StatCheckpoint_update(StatCheckpoint_ptr self)
+{
+  STAT_CHECKPOINT_CHECK_INSTANCE(self);
+
+  if (difftime(time(NULL), self->last) >= STAT_CHECKPOINT_PERIOD) {
+    StatCheckpoint_save(self);
+  }
+}
+
+void StatCheckpoint_save(StatCheckpoint_ptr self)
+{
+  const NuSMVEnv_ptr env = ENV_OBJECT(self)->environment;
+  const OptsHandler_ptr opts =
+    OPTS_HANDLER(NuSMVEnv_get_value(env, ENV_OPTS_HANDLER));
+  char* tmp_fname;
+  boolean saved = false;
+
+  STAT_CHECKPOINT_CHECK_INSTANCE(self);
+
+  tmp_fname = ALLOC(char, strlen(self->fname) +
+                    strlen(STAT_CHECKPOINT_TMP_SUFFIX) + 1);
+  sprintf(tmp_fname, "%s%s", self->fname, STAT_CHECKPOINT_TMP_SUFFIX);
+
+  self->stream = fopen(tmp_fname, "w");
+  if ((FILE*)NULL != self->stream) {
+    stat_checkpoint_write(self);
+
+    saved = (0 == ferror(self->stream));
+    saved = (0 == fclose(self->stream)) && saved;
+    self->stream = (FILE*)NULL;
+
+    /* the previous checkpoint is replaced only by a complete one */
+    saved = saved && (0 == rename(tmp_fname, self->fname));
+    if (! saved) remove(tmp_fname);
+  }
+
+  if (! saved && ! self->failed) {
+    const ErrorMgr_ptr errmgr =
+      ERROR_MGR(NuSMVEnv_get_value(env, ENV_ERROR_MANAGER));
+
+    ErrorMgr_warning_msg(errmgr, "Unable to write checkpoint \"%s\"\n",
+                         self->fname);
+    self->failed = true;
+  }
+  else if (saved && opt_verbose_level_gt(opts, 1)) {
+    const Logger_ptr logger = LOGGER(NuSMVEnv_get_value(env, ENV_LOGGER));
+
+    Logger_log(logger, "Statistical model checking: checkpoint saved to "
+               "\"%s\"\n", self->fname);
+  }
+
+  self->last = time(NULL);
+
+  FREE(tmp_fname);
+}
+
+void StatCheckpoint_remove(StatCheckpoint_ptr self)
+{
+  STAT_CHECKPOINT_CHECK_INSTANCE(self);
+
+  remove(self->fname);
+}
+
+/*---------------------------------------------------------------------------*/
+/* Definition of internal functions                                          */
+/*---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*/
+/* Definition of static functions                                            */
+/*---------------------------------------------------------------------------*/
+
+/*!
+  \brief The StatCheckpoint class private initializer
+
+  \sa StatCheckpoint_create
+*/
+static void stat_checkpoint_init(StatCheckpoint_ptr self,
+                                 const NuSMVEnv_ptr env,
+                                 const char* fname,
+                                 const Prop_ptr* props,
+                                 StatEstimation_ptr* estimations,
+                                 StatProblemsGenerator_ptr* generators,
+                                 const int props_num)
+{
+  env_object_init(ENV_OBJECT(self), env);
+
+  self->fname = util_strsav((char*)fname);
+  self->props = props;
+  self->estimations = estimations;
+  self->generators = generators;
+  self->props_num = props_num;
+  self->last = time(NULL);
+  self->failed = false;
+  self->stream = (FILE*)NULL;
+  self->ids = (hash_ptr)NULL;
+  self->ids_num = 0;
+  self->nodes = (node_ptr*)NULL;
+  self->nodes_num = 0;
+  self->nodes_size = 0;
+}
+
+/*!
+  \brief The StatCheckpoint class private deinitializer
+
+  \sa StatCheckpoint_destroy
+*/
+static void stat_checkpoint_deinit(StatCheckpoint_ptr self)
+{
+  nusmv_assert((FILE*)NULL == self->stream);
+
+  FREE(self->fname);
+  self->props = (const Prop_ptr*)NULL;
+  self->estimations = (StatEstimation_ptr*)NULL;
+  self->generators = (StatProblemsGenerator_ptr*)NULL;
+
+  env_object_deinit(ENV_OBJECT(self));
+}
+
+/*!
+  \brief Writes the whole checkpoint to the stream
+
+*/
+static void stat_checkpoint_write(StatCheckpoint_ptr self)
+{
+  const NuSMVEnv_ptr env = ENV_OBJECT(self)->environment;
+  FILE* out = self->stream;
+  int i;
+
+  fprintf(out, "%s %d\n", STAT_CHECKPOINT_MAGIC, STAT_CHECKPOINT_VERSION);
+  RandomGen_write(RANDOM_GEN(NuSMVEnv_get_value(env, ENV_STAT_RANDOM_GEN)),
+                  out);
+  fprintf(out, "%d\n", self->props_num);
+
+  self->ids = new_assoc();
+  self->ids_num = 0;
+
+  for (i = 0; i < self->props_num; i++) {
+    char* text = Prop_get_text(self->props[i]);
+
+    fprintf(out, "P");
+    stat_checkpoint_write_text(self, text);
+    fprintf(out, "\n");
+    FREE(text);
+
+    StatEstimation_write(self->estimations[i], out);
+
+    if (STAT_PROBLEMS_GENERATOR(NULL) != self->generators[i]) {
+      stat_checkpoint_write_memoized(self, self->generators[i]);
+    }
+
+    fprintf(out, "E\n");
+  }
+
+  free_assoc(self->ids);
+  self->ids = (hash_ptr)NULL;
+}
+
+/*!
+  \brief Reads the whole checkpoint from the stream
+
+  Returns false if the stream does not contain a checkpoint of the
+  current run.
+*/
+static boolean stat_checkpoint_read(StatCheckpoint_ptr self)
+{
+  const NuSMVEnv_ptr env = ENV_OBJECT(self)->environment;
+  FILE* in = self->stream;
+  char magic[sizeof(STAT_CHECKPOINT_MAGIC)];
+  int version, props_num;
+  int i;
+
+  if (2 != fscanf(in, "%20s %d", magic, &version)) return false;
+  if (0 != strcmp(magic, STAT_CHECKPOINT_MAGIC)) return false;
+  if (STAT_CHECKPOINT_VERSION != version) return false;
+
+  if (! RandomGen_read(RANDOM_GEN(NuSMVEnv_get_value(env,
+                                                     ENV_STAT_RANDOM_GEN)),
+                       in)) {
+    return false;
+  }
+
+  if (1 != fscanf(in, "%d", &props_num)) return false;
+  if (self->props_num != props_num) return false;
+
+  for (i = 0; i < self->props_num; i++) {
+    char* text;
+    char* expected;
+    boolean same;
+    char c;
+
+    if (1 != fscanf(in, " %c", &c) || 'P' != c) return false;
+
+    text = stat_checkpoint_read_text(self);
+    if (NIL(char) == text) return false;
+
+    expected = Prop_get_text(self->props[i]);
+    same = (0 == strcmp(text, expected));
+    FREE(expected);
+    FREE(text);
+
+    if (! same) return false;
+
+    if (! StatEstimation_read(self->estimations[i], in)) return false;
+
+    if (! stat_checkpoint_read_memoized(self, self->generators[i])) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+/*!
+  \brief Writes a string prefixed by its length
+
+*/
+static void stat_checkpoint_write_text(StatCheckpoint_ptr self,
+                                       const char* text)
+{
+  fprintf(self->stream, " %lu:%s", (unsigned long)strlen(text), text);
+}
+
+/*!
+  \brief Reads a string written by stat_checkpoint_write_text
+
+  Returns NULL if no string can be read. The result must be freed by
+  the caller.
+*/
+static char* stat_checkpoint_read_text(StatCheckpoint_ptr self)
+{
+  unsigned long len;
+  char* text;
+
+  if (1 != fscanf(self->stream, " %lu:", &len)) return NIL(char);
+
+  text = ALLOC(char, len + 1);
+  if (len != fread(text, sizeof(char), len, self->stream)) {
+    FREE(text);
+    return NIL(char);
+  }
+  text[len] = '\0';
+
+  return text;
+}
+
+/*!
+  \brief Writes the verified executions of gen
+
+  Every execution is written as M, its result, its loopback, its
+  number of states and its states. Executions whose states cannot be
+  written are skipped: they will just be verified again.
+*/
+static void stat_checkpoint_write_memoized(StatCheckpoint_ptr self,
+                                           const StatProblemsGenerator_ptr gen)
+{
+  hash_ptr memoized = StatProblemsGenerator_get_memoized(gen);
+  assoc_iter aiter;
+  node_ptr key;
+  node_ptr value;
+
+  if ((hash_ptr)NULL == memoized) return;
+
+  ASSOC_FOREACH(memoized, aiter, &key, &value) {
+    const StatVericationResult res = (StatVericationResult)NODE_TO_INT(value);
+    node_ptr states = cdr(key);
+    boolean writable = (STAT_OK == res || STAT_NOT_OK == res);
+    node_ptr iter;
+
+    for (iter = states; writable && Nil != iter; iter = cdr(iter)) {
+      writable = stat_checkpoint_is_writable(self, car(iter));
+    }
+
+    if (! writable) continue;
+
+    fprintf(self->stream, "M %d %d %d", (int)res,
+            PTR_TO_INT(car(key)), llength(states));
+
+    for (iter = states; Nil != iter; iter = cdr(iter)) {
+      stat_checkpoint_write_node(self, car(iter));
+    }
+
+    fprintf(self->stream, "\n");
+  }
+}
+
+/*!
+  \brief Reads the executions written by stat_checkpoint_write_memoized
+
+  The executions are stored in gen, or dropped if gen is NULL. The
+  list ends with E.
+*/
+static boolean stat_checkpoint_read_memoized(StatCheckpoint_ptr self,
+                                             StatProblemsGenerator_ptr gen)
+{
+  const NodeMgr_ptr nodemgr =
+    NODE_MGR(NuSMVEnv_get_value(ENV_OBJECT(self)->environment,
+                                ENV_NODE_MGR));
+  char c;
+
+  while (1 == fscanf(self->stream, " %c", &c) && 'M' == c) {
+    int res, loopback, states_num;
+    node_ptr* states;
+    node_ptr key = Nil;
+    boolean read = true;
+    int i;
+
+    if (3 != fscanf(self->stream, "%d %d %d", &res, &loopback,
+                    &states_num)) {
+      return false;
+    }
+    if ((STAT_OK != res && STAT_NOT_OK != res) || 0 >= states_num) {
+      return false;
+    }
+
+    states = ALLOC(node_ptr, states_num);
+    for (i = 0; read && i < states_num; i++) {
+      read = stat_checkpoint_read_node(self, &(states[i]));
+    }
+
+    if (read) {
+      /* the list is rebuilt from the first state, i.e. the last one
+         written */
+      for (i = states_num - 1; i >= 0; i--) {
+        key = new_node(nodemgr, CONS, states[i], key);
+      }
+      key = new_node(nodemgr, CONS, PTR_FROM_INT(node_ptr, loopback), key);
+
+      /* the key is taken over by gen */
+      if (STAT_PROBLEMS_GENERATOR(NULL) != gen) {
+        StatProblemsGenerator_memoize(gen, key,
+                                      (StatVericationResult)res);
+      }
+      else free_list(nodemgr, key);
+    }
+
+    FREE(states);
+    if (! read) return false;
+  }
+
+  return 'E' == c;
+}
+
+/*!
+  \brief Tells whether node can be written in the checkpoint
+
+*/
+static boolean stat_checkpoint_is_writable(StatCheckpoint_ptr self,
+                                           node_ptr node)
+{
+  if (Nil == node || Nil != find_assoc(self->ids, node)) return true;
+
+  switch (node_get_type(node)) {
+  case ATOM:
+  case NUMBER:
+  case NUMBER_UNSIGNED_WORD:
+  case NUMBER_SIGNED_WORD:
+  case NUMBER_FRAC:
+  case NUMBER_REAL:
+  case NUMBER_EXP:
+    return true;
+
+  case BIT:
+    return stat_checkpoint_is_writable(self, car(node));
+
+  case FAILURE:
+    return false;
+
+  default:
+    return stat_checkpoint_is_writable(self, car(node)) &&
+      stat_checkpoint_is_writable(self, cdr(node));
+  }
+}
+
+/*!
+  \brief Writes node
+
+  A node already written is referred to as @ followed by the index of
+  its definition. Otherwise it is defined, after its children, as:
+  - A type text, for the nodes carrying a string
+  - I type value, for numbers
+  - W type width value, for words
+  - B bit var, for bits
+  - N type car cdr, for all the other nodes
+
+  Nil is written as a dot. node must be writable.
+*/
+static void stat_checkpoint_write_node(StatCheckpoint_ptr self,
+                                       node_ptr node)
+{
+  FILE* out = self->stream;
+  const int id = NODE_TO_INT(find_assoc(self->ids, node));
+
+  if (Nil == node) {
+    fprintf(out, " .");
+    return;
+  }
+
+  if (0 != id) {
+    fprintf(out, " @%d", id - 1);
+    return;
+  }
+
+  switch (node_get_type(node)) {
+  case ATOM:
+  case NUMBER_FRAC:
+  case NUMBER_REAL:
+  case NUMBER_EXP:
+    {
+      const string_ptr text = (string_ptr)car(node);
+
+      fprintf(out, " A%d", node_get_type(node));
+      stat_checkpoint_write_text(self, str_get_text(text));
+    }
+    break;
+
+  case NUMBER:
+    fprintf(out, " I%d %d", node_get_type(node), NODE_TO_INT(car(node)));
+    break;
+
+  case NUMBER_UNSIGNED_WORD:
+  case NUMBER_SIGNED_WORD:
+    {
+      const WordNumber_ptr word = WORD_NUMBER(car(node));
+
+      fprintf(out, " W%d %d %llu", node_get_type(node),
+              WordNumber_get_width(word),
+              (unsigned long long)WordNumber_get_unsigned_value(word));
+    }
+    break;
+
+  case BIT:
+    fprintf(out, " B%d", NODE_TO_INT(cdr(node)));
+    stat_checkpoint_write_node(self, car(node));
+    break;
+
+  default:
+    fprintf(out, " N%d", node_get_type(node));
+    stat_checkpoint_write_node(self, car(node));
+    stat_checkpoint_write_node(self, cdr(node));
+  }
+
+  self->ids_num++;
+  insert_assoc(self->ids, node, NODE_FROM_INT(self->ids_num));
+}
+
+/*!
+  \brief Reads a node written by stat_checkpoint_write_node
+
+  Returns false if no valid node can be read.
+*/
+static boolean stat_checkpoint_read_node(StatCheckpoint_ptr self,
+                                         node_ptr* node)
+{
+  const NuSMVEnv_ptr env = ENV_OBJECT(self)->environment;
+  const NodeMgr_ptr nodemgr = NODE_MGR(NuSMVEnv_get_value(env, ENV_NODE_MGR));
+  FILE* in = self->stream;
+  node_ptr res;
+  int type;
+  char c;
+
+  if (1 != fscanf(in, " %c", &c)) return false;
+
+  switch (c) {
+  case '.':
+    *node = Nil;
+    return true;
+
+  case '@':
+    {
+      long id;
+
+      if (1 != fscanf(in, "%ld", &id)) return false;
+      if (0 > id || self->nodes_num <= id) return false;
+
+      *node = self->nodes[id];
+    }
+    return true;
+
+  case 'A':
+    {
+      const UStringMgr_ptr strings =
+        USTRING_MGR(NuSMVEnv_get_value(env, ENV_STRING_MGR));
+      char* text;
+
+      if (1 != fscanf(in, "%d", &type)) return false;
+      if (ATOM != type && NUMBER_FRAC != type && NUMBER_REAL != type &&
+          NUMBER_EXP != type) {
+        return false;
+      }
+
+      text = stat_checkpoint_read_text(self);
+      if (NIL(char) == text) return false;
+
+      res = find_node(nodemgr, type,
+                      (node_ptr)UStringMgr_find_string(strings, text), Nil);
+      FREE(text);
+    }
+    break;
+
+  case 'I':
+    {
+      int value;
+
+      if (2 != fscanf(in, "%d %d", &type, &value)) return false;
+      if (NUMBER != type) return false;
+
+      res = find_node(nodemgr, type, NODE_FROM_INT(value), Nil);
+    }
+    break;
+
+  case 'W':
+    {
+      const WordNumberMgr_ptr words =
+        WORD_NUMBER_MGR(NuSMVEnv_get_value(env, ENV_WORD_NUMBER_MGR));
+      unsigned long long value;
+      int width;
+
+      if (3 != fscanf(in, "%d %d %llu", &type, &width, &value)) {
+        return false;
+      }
+      if (NUMBER_UNSIGNED_WORD != type && NUMBER_SIGNED_WORD != type) {
+        return false;
+      }
+      if (0 >= width || WordNumberMgr_max_width() < width) return false;
+      if (width < 64 && 0 != (value >> width)) return false;
+
+      res = find_node(nodemgr, type,
+                      (node_ptr)WordNumberMgr_integer_to_word_number(words,
+                                                                     value,
+                                                                     width),
+                      Nil);
+    }
+    break;
+
+  case 'B':
+    {
+      node_ptr var;
+      int bit;
+
+      if (1 != fscanf(in, "%d", &bit)) return false;
+      if (! stat_checkpoint_read_node(self, &var)) return false;
+
+      res = find_node(nodemgr, BIT, var, NODE_FROM_INT(bit));
+    }
+    break;
+
+  case 'N':
+    {
+      node_ptr left, right;
+
+      if (1 != fscanf(in, "%d", &type)) return false;
+      if (NUSMV_CORE_SYMBOL_FIRST >= type ||
+          NUSMV_CORE_SYMBOL_LAST <= type) {
+        return false;
+      }
+
+      if (! stat_checkpoint_read_node(self, &left)) return false;
+      if (! stat_checkpoint_read_node(self, &right)) return false;
+
+      res = find_node(nodemgr, type, left, right);
+    }
+    break;
+
+  default:
+    return false;
+  }
+
+  if (self->nodes_num == self->nodes_size) {
+    self->nodes_size = (0 < self->nodes_size) ? 2 * self->nodes_size : 1024;
+    self->nodes = REALLOC(node_ptr, self->nodes, self->nodes_size);
+  }
+  self->nodes[self->nodes_num++] = res;
+
+  *node = res;
+  return true;
+}
+
+/**AutomaticEnd***************************************************************/
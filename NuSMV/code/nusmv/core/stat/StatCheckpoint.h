@@ -0,0 +1,165 @@
+/* ---------------------------------------------------------------------------
+
+
+  This file is part of the ``stat'' package of NuSMV version 2.
+  Copyright (C) 2012 by FBK-irst.
+
+  NuSMV version 2 is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  NuSMV version 2 is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA.
+
+  For more information on NuSMV see <http://nusmv.fbk.eu>
+  or email to <nusmv-users@fbk.eu>.
+  Please report bugs to <nusmv-users@fbk.eu>.
+
+  To contact the NuSMV development board, email to <nusmv@fbk.eu>.
+
+-----------------------------------------------------------------------------*/
+
+/*!
+  \author Alberto Bombardelli
+  \brief Public interface of class 'StatCheckpoint'
+
+  A StatCheckpoint saves the progress of a statistical run to a file,
+  so that an interrupted run can be resumed later. The progress is
+  made of the state of the random generator of the package, and of
+  the estimation and the memoized executions of every checked
+  property. Since the random generator is saved too, the resumed run
+  draws the same executions, and gives the same results, as an
+  uninterrupted one.
+
+  The checkpoint is written at most once every STAT_CHECKPOINT_PERIOD
+  seconds, to a temporary file that then replaces the previous
+  checkpoint, so that a run interrupted while writing leaves the
+  previous checkpoint intact.
+
+  Checkpoints can only be used when sampling serially: the random
+  generators of the forked workers are not saved.
+
+*/
+
+
+#ifndef __NUSMV_CORE_STAT_STAT_CHECKPOINT_H__
+#define __NUSMV_CORE_STAT_STAT_CHECKPOINT_H__
+
+#include "nusmv/core/stat/statInt.h"
+#include "nusmv/core/stat/StatProblemsGenerator.h"
+#include "nusmv/core/cinit/NuSMVEnv.h"
+#include "nusmv/core/prop/Prop.h"
+#include "nusmv/core/utils/utils.h"
+
+/*!
+  \struct StatCheckpoint
+  \brief Definition of the public accessor for class StatCheckpoint
+
+*/
+typedef struct StatCheckpoint_TAG*  StatCheckpoint_ptr;
+
+/*!
+  \brief To cast and check instances of class StatCheckpoint
+
+  These macros must be used respectively to cast and to check
+  instances of class StatCheckpoint
+*/
+#define STAT_CHECKPOINT(self) \
+         ((StatCheckpoint_ptr) self)
+
+/*!
+  \brief \todo Missing synopsis
+
+  \todo Missing description
+*/
+#define STAT_CHECKPOINT_CHECK_INSTANCE(self) \
+         (nusmv_assert(STAT_CHECKPOINT(self) != STAT_CHECKPOINT(NULL)))
+
+
+/**AutomaticStart*************************************************************/
+
+/*---------------------------------------------------------------------------*/
+/* Function prototypes                                                       */
+/*---------------------------------------------------------------------------*/
+
+/* Constructors ***************************************************************/
+
+/*!
+  \methodof StatCheckpoint
+  \brief The StatCheckpoint class constructor
+
+  The progress of the run of the given properties is saved to
+  fname. estimations[i] is the estimation of props[i], and
+  generators[i] is the problem generator whose memoized executions
+  are saved with it, or NULL. The arrays are not copied, and must
+  outlive self.
+
+  \sa StatCheckpoint_destroy
+*/
+StatCheckpoint_ptr StatCheckpoint_create(const NuSMVEnv_ptr env,
+                                         const char* fname,
+                                         const Prop_ptr* props,
+                                         StatEstimation_ptr* estimations,
+                                         StatProblemsGenerator_ptr* generators,
+                                         const int props_num);
+
+/* Destructors ****************************************************************/
+
+/*!
+  \methodof StatCheckpoint
+  \brief The StatCheckpoint class destructor
+
+  The checkpoint file is left untouched
+
+  \sa StatCheckpoint_create
+*/
+void StatCheckpoint_destroy(StatCheckpoint_ptr self);
+
+/*!
+  \methodof StatCheckpoint
+  \brief Restores the progress saved in the checkpoint file
+
+  Returns false if the file does not exist. An error is raised if the
+  file cannot be read, or if it was written by a run with different
+  properties or parameters. The properties must have been prepared in
+  their problem generators.
+*/
+boolean StatCheckpoint_resume(StatCheckpoint_ptr self);
+
+/*!
+  \methodof StatCheckpoint
+  \brief Saves the progress if the last checkpoint is old enough
+
+  To be called between two executions.
+
+  \sa STAT_CHECKPOINT_PERIOD
+*/
+void StatCheckpoint_update(StatCheckpoint_ptr self);
+
+/*!
+  \methodof StatCheckpoint
+  \brief Saves the progress
+
+  A warning is printed if the file cannot be written, and the run
+  goes on.
+*/
+void StatCheckpoint_save(StatCheckpoint_ptr self);
+
+/*!
+  \methodof StatCheckpoint
+  \brief Removes the checkpoint file
+
+  To be called once the run is over.
+*/
+void StatCheckpoint_remove(StatCheckpoint_ptr self);
+
+/**AutomaticEnd***************************************************************/
+
+#endif /* __NUSMV_CORE_STAT_STAT_CHECKPOINT_H__ */
@@ -0,0 +1,609 @@
+/* ---------------------------------------------------------------------------
+
+
+  This file is part of the ``stat'' package of NuSMV version 2.
+  Copyright (C) 2012 by FBK-irst.
+
+  NuSMV version 2 is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  NuSMV version 2 is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA.
+
+  For more information on NuSMV see <http://nusmv.fbk.eu>
+  or email to <nusmv-users@fbk.eu>.
+  Please report bugs to <nusmv-users@fbk.eu>.
+
+  To contact the NuSMV development board, email to <nusmv@fbk.eu>.
+
+-----------------------------------------------------------------------------*/
+
+/*!
+  \author Alberto Bombardelli
+  \brief Implementation of class 'StatLassoChecker'
+
+  Atomic subformulas (i.e. subformulas without temporal operators)
+  and the states of the lassos are converted to BDDs once, and kept
+  in two caches for the whole life of the checker: the same states
+  are visited by many executions. An atom holds in a state iff the
+  state BDD entails the atom BDD.
+
+  Temporal operators are evaluated backwards on the lasso
+  positions. Fixpoint operators (U, V, F, G) need two backward
+  passes: the first one is exact for the positions whose witness
+  does not cross the loopback, the second one propagates the values
+  of the loop positions.
+
+*/
+
+#include "nusmv/core/stat/StatLassoChecker.h"
+#include "nusmv/core/stat/statInt.h"
+
+#include "nusmv/core/utils/EnvObject.h"
+#include "nusmv/core/utils/EnvObject_private.h"
+#include "nusmv/core/utils/assoc.h"
+#include "nusmv/core/utils/ErrorMgr.h"
+
+#include "nusmv/core/parser/symbols.h"
+#include "nusmv/core/compile/compile.h"
+#include "nusmv/core/enc/bdd/BddEnc.h"
+#include "nusmv/core/fsm/bdd/BddFsm.h"
+#include "nusmv/core/fsm/bdd/FairnessList.h"
+#include "nusmv/core/wff/lr/MasterLogicRecognizer.h"
+
+/*---------------------------------------------------------------------------*/
+/* Constant declarations                                                     */
+/*---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*/
+/* Structure declarations                                                    */
+/*---------------------------------------------------------------------------*/
+
+typedef struct StatLassoChecker_TAG
+{
+  /* this MUST stay on the top */
+  INHERITS_FROM(EnvObject);
+
+  /* -------------------------------------------------- */
+  /*                  Private members                   */
+  /* -------------------------------------------------- */
+  /* flattened property, with defines expanded */
+  Expr_ptr formula;
+
+  /* false if the formula contains unsupported operators */
+  boolean supported;
+
+  /* atoms hash map: Expr_ptr -> bdd_ptr (referenced) */
+  hash_ptr atoms;
+
+  /* states hash map: state sexp -> bdd_ptr (referenced) */
+  hash_ptr states;
+} StatLassoChecker;
+
+/*---------------------------------------------------------------------------*/
+/* Type declarations                                                         */
+/*---------------------------------------------------------------------------*/
+
+/*!
+  \brief Shape of the lasso being evaluated
+
+  Positions go from 0 to length - 1; the successor of the last
+  position is loop_start.
+*/
+typedef struct StatLasso_TAG {
+  int length;
+  int loop_start;
+
+  /* state bdds, owned by the checker cache */
+  bdd_ptr* states;
+} StatLasso;
+
+/*---------------------------------------------------------------------------*/
+/* Variable declarations                                                     */
+/*---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*/
+/* Macro declarations                                                        */
+/*---------------------------------------------------------------------------*/
+#define STAT_ENV(self) (ENV_OBJECT(self)->environment)
+
+/*!
+  \brief Successor of position i on the lasso
+
+*/
+#define LASSO_SUCC(lasso, i) \
+  (((i) + 1 < (lasso)->length) ? (i) + 1 : (lasso)->loop_start)
+
+/**AutomaticStart*************************************************************/
+
+/*---------------------------------------------------------------------------*/
+/* Static function prototypes                                                */
+/*---------------------------------------------------------------------------*/
+
+static void stat_lasso_checker_init(StatLassoChecker_ptr self,
+                                    const NuSMVEnv_ptr env,
+                                    const Prop_ptr prop);
+
+static void stat_lasso_checker_deinit(StatLassoChecker_ptr self);
+
+static boolean
+stat_lasso_checker_is_supported_formula(const StatLassoChecker_ptr self,
+                                        const Expr_ptr formula);
+
+static boolean* stat_lasso_checker_eval(StatLassoChecker_ptr self,
+                                        const StatLasso* lasso,
+                                        const Expr_ptr formula);
+
+static boolean* stat_lasso_checker_eval_atom(StatLassoChecker_ptr self,
+                                             const StatLasso* lasso,
+                                             const Expr_ptr atom);
+
+static void stat_lasso_checker_fixpoint(const StatLasso* lasso,
+                                        const boolean* left,
+                                        const boolean* right,
+                                        const boolean greatest,
+                                        boolean* res);
+
+static boolean stat_lasso_checker_is_fair(StatLassoChecker_ptr self,
+                                          const StatLasso* lasso);
+
+static boolean stat_lasso_checker_loop_hits(const StatLassoChecker_ptr self,
+                                            const StatLasso* lasso,
+                                            bdd_ptr p);
+
+static bdd_ptr stat_lasso_checker_get_state_bdd(StatLassoChecker_ptr self,
+                                                const Expr_ptr state);
+
+static assoc_retval stat_lasso_checker_free_bdd(char* key, char* data,
+                                                char* arg);
+
+/*---------------------------------------------------------------------------*/
+/* Definition of exported functions                                          */
+/*---------------------------------------------------------------------------*/
+
+StatLassoChecker_ptr StatLassoChecker_create(const NuSMVEnv_ptr env,
+                                             const Prop_ptr prop)
+{
+  StatLassoChecker_ptr self = ALLOC(StatLassoChecker, 1);
+  STAT_LASSO_CHECKER_CHECK_INSTANCE(self);
+
+  stat_lasso_checker_init(self, env, prop);
+
+  return self;
+}
+
+void StatLassoChecker_destroy(StatLassoChecker_ptr self)
+{
+  STAT_LASSO_CHECKER_CHECK_INSTANCE(self);
+
+  stat_lasso_checker_deinit(self);
+
+  FREE(self);
+}
+
+boolean StatLassoChecker_is_supported(const StatLassoChecker_ptr self)
+{
+  STAT_LASSO_CHECKER_CHECK_INSTANCE(self);
+
+  return self->supported;
+}
+
+StatVericationResult StatLassoChecker_check(StatLassoChecker_ptr self,
+                                            const StatTrace_ptr execution)
+{
+  StatVericationResult res;
+  StatLasso lasso;
+  NodeList_ptr state_list;
+  ListIter_ptr iter;
+  int i;
+
+  STAT_LASSO_CHECKER_CHECK_INSTANCE(self);
+  nusmv_assert(self->supported);
+  nusmv_assert(StatTrace_is_generated(execution));
+
+  lasso.length = StatTrace_get_length(execution);
+  /* loopback is the 1-based index of the first state of the loop */
+  lasso.loop_start = StatTrace_get_loopback(execution) - 1;
+
+  nusmv_assert(0 < lasso.length);
+  nusmv_assert(0 <= lasso.loop_start && lasso.loop_start < lasso.length);
+
+  /* the states of the previous executions are not in use anymore */
+  if (Stat_is_cache_full(STAT_ENV(self), self->states)) {
+    const BddEnc_ptr enc =
+      BDD_ENC(NuSMVEnv_get_value(STAT_ENV(self), ENV_BDD_ENCODER));
+
+    clear_assoc_and_free_entries_arg(self->states,
+                                     stat_lasso_checker_free_bdd,
+                                     (char*)BddEnc_get_dd_manager(enc));
+  }
+
+  lasso.states = ALLOC(bdd_ptr, lasso.length);
+  nusmv_assert((bdd_ptr*)NULL != lasso.states);
+
+  state_list = StatTrace_get_sexp_states(execution);
+  i = 0;
+  NODE_LIST_FOREACH(state_list, iter) {
+    lasso.states[i] =
+      stat_lasso_checker_get_state_bdd(self,
+                                       NodeList_get_elem_at(state_list, iter));
+    i++;
+  }
+
+  if (! stat_lasso_checker_is_fair(self, &lasso)) {
+    /* no fair path follows this lasso: it does not falsify the property */
+    res = STAT_OK;
+  }
+  else {
+    boolean* values = stat_lasso_checker_eval(self, &lasso, self->formula);
+
+    res = values[0] ? STAT_OK : STAT_NOT_OK;
+    FREE(values);
+  }
+
+  FREE(lasso.states);
+
+  return res;
+}
+
+/*---------------------------------------------------------------------------*/
+/* Definition of internal functions                                          */
+/*---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*/
+/* Definition of static functions                                            */
+/*---------------------------------------------------------------------------*/
+
+/*!
+  \brief The StatLassoChecker class private initializer
+
+  \sa StatLassoChecker_create
+*/
+static void stat_lasso_checker_init(StatLassoChecker_ptr self,
+                                    const NuSMVEnv_ptr env,
+                                    const Prop_ptr prop)
+{
+  const SymbTable_ptr st = SYMB_TABLE(NuSMVEnv_get_value(env, ENV_SYMB_TABLE));
+
+  env_object_init(ENV_OBJECT(self), env);
+
+  nusmv_assert(Prop_Ltl == Prop_get_type(prop));
+
+  self->formula =
+    Compile_FlattenSexpExpandDefine(st, Prop_get_expr_core(prop), Nil);
+  self->atoms = new_assoc();
+  self->states = new_assoc();
+
+  self->supported =
+    stat_lasso_checker_is_supported_formula(self, self->formula);
+}
+
+/*!
+  \brief The StatLassoChecker class private deinitializer
+
+  \sa StatLassoChecker_destroy
+*/
+static void stat_lasso_checker_deinit(StatLassoChecker_ptr self)
+{
+  const BddEnc_ptr enc =
+    BDD_ENC(NuSMVEnv_get_value(STAT_ENV(self), ENV_BDD_ENCODER));
+  const DDMgr_ptr dd = BddEnc_get_dd_manager(enc);
+
+  clear_assoc_and_free_entries_arg(self->atoms, stat_lasso_checker_free_bdd,
+                                   (char*)dd);
+  free_assoc(self->atoms); self->atoms = (hash_ptr)NULL;
+
+  clear_assoc_and_free_entries_arg(self->states, stat_lasso_checker_free_bdd,
+                                   (char*)dd);
+  free_assoc(self->states); self->states = (hash_ptr)NULL;
+
+  self->formula = Nil;
+
+  env_object_deinit(ENV_OBJECT(self));
+}
+
+/*!
+  \brief Checks that only future temporal operators are used
+
+  Subformulas recognized as simple expressions are atoms.
+*/
+static boolean
+stat_lasso_checker_is_supported_formula(const StatLassoChecker_ptr self,
+                                        const Expr_ptr formula)
+{
+  const MasterLogicRecognizer_ptr mlr =
+    MASTER_LOGIC_RECOGNIZER(NuSMVEnv_get_value(STAT_ENV(self),
+                                               ENV_MASTER_LOGIC_RECOGNIZER));
+
+  switch (MasterLogicRecognizer_recognize(mlr, formula, Nil)) {
+  case EXP_SIMPLE:
+    return true;
+
+  case EXP_LTL:
+    break;
+
+  default:
+    return false;
+  }
+
+  switch (node_get_type(formula)) {
+  case NOT:
+  case OP_NEXT:
+  case OP_GLOBAL:
+  case OP_FUTURE:
+    return stat_lasso_checker_is_supported_formula(self, car(formula));
+
+  case AND:
+  case OR:
+  case IMPLIES:
+  case IFF:
+  case XOR:
+  case XNOR:
+  case UNTIL:
+  case RELEASES:
+    return stat_lasso_checker_is_supported_formula(self, car(formula)) &&
+      stat_lasso_checker_is_supported_formula(self, cdr(formula));
+
+  default:
+    /* past operators, temporal operators inside case expressions... */
+    return false;
+  }
+}
+
+/*!
+  \brief Labels all the lasso positions with the value of formula
+
+  The returned array has lasso->length elements and must be freed
+  by the caller.
+*/
+static boolean* stat_lasso_checker_eval(StatLassoChecker_ptr self,
+                                        const StatLasso* lasso,
+                                        const Expr_ptr formula)
+{
+  const MasterLogicRecognizer_ptr mlr =
+    MASTER_LOGIC_RECOGNIZER(NuSMVEnv_get_value(STAT_ENV(self),
+                                               ENV_MASTER_LOGIC_RECOGNIZER));
+  boolean* res;
+  boolean* left;
+  boolean* right;
+  int i;
+
+  if (EXP_SIMPLE == MasterLogicRecognizer_recognize(mlr, formula, Nil)) {
+    return stat_lasso_checker_eval_atom(self, lasso, formula);
+  }
+
+  res = ALLOC(boolean, lasso->length);
+  nusmv_assert((boolean*)NULL != res);
+
+  left = stat_lasso_checker_eval(self, lasso, car(formula));
+  right = (boolean*)NULL;
+
+  switch (node_get_type(formula)) {
+  case NOT:
+    for (i = 0; i < lasso->length; i++) res[i] = ! left[i];
+    break;
+
+  case OP_NEXT:
+    for (i = 0; i < lasso->length; i++) res[i] = left[LASSO_SUCC(lasso, i)];
+    break;
+
+  case OP_FUTURE:
+    /* F f = true U f */
+    stat_lasso_checker_fixpoint(lasso, (boolean*)NULL, left, false, res);
+    break;
+
+  case OP_GLOBAL:
+    /* G f = false V f */
+    stat_lasso_checker_fixpoint(lasso, (boolean*)NULL, left, true, res);
+    break;
+
+  default:
+    right = stat_lasso_checker_eval(self, lasso, cdr(formula));
+
+    switch (node_get_type(formula)) {
+    case AND:
+      for (i = 0; i < lasso->length; i++) res[i] = left[i] && right[i];
+      break;
+    case OR:
+      for (i = 0; i < lasso->length; i++) res[i] = left[i] || right[i];
+      break;
+    case IMPLIES:
+      for (i = 0; i < lasso->length; i++) res[i] = (! left[i]) || right[i];
+      break;
+    case IFF:
+    case XNOR:
+      for (i = 0; i < lasso->length; i++) res[i] = (left[i] == right[i]);
+      break;
+    case XOR:
+      for (i = 0; i < lasso->length; i++) res[i] = (left[i] != right[i]);
+      break;
+    case UNTIL:
+      stat_lasso_checker_fixpoint(lasso, left, right, false, res);
+      break;
+    case RELEASES:
+      stat_lasso_checker_fixpoint(lasso, left, right, true, res);
+      break;
+
+    default:
+      error_unreachable_code_msg("Unsupported operator %d\n",
+                                 node_get_type(formula));
+    }
+  }
+
+  FREE(left);
+  if ((boolean*)NULL != right) FREE(right);
+
+  return res;
+}
+
+/*!
+  \brief Labels the lasso positions with the value of an atom
+
+*/
+static boolean* stat_lasso_checker_eval_atom(StatLassoChecker_ptr self,
+                                             const StatLasso* lasso,
+                                             const Expr_ptr atom)
+{
+  const BddEnc_ptr enc =
+    BDD_ENC(NuSMVEnv_get_value(STAT_ENV(self), ENV_BDD_ENCODER));
+  const DDMgr_ptr dd = BddEnc_get_dd_manager(enc);
+  boolean* res = ALLOC(boolean, lasso->length);
+  bdd_ptr atom_bdd;
+  int i;
+
+  nusmv_assert((boolean*)NULL != res);
+
+  atom_bdd = (bdd_ptr)find_assoc(self->atoms, atom);
+  if ((bdd_ptr)NULL == atom_bdd) {
+    atom_bdd = BddEnc_expr_to_bdd(enc, atom, Nil);
+    insert_assoc(self->atoms, atom, (node_ptr)atom_bdd);
+  }
+
+  for (i = 0; i < lasso->length; i++) {
+    res[i] = bdd_entailed(dd, lasso->states[i], atom_bdd);
+  }
+
+  return res;
+}
+
+/*!
+  \brief Computes left U right or left V right on the lasso
+
+  If greatest is false the least fixpoint of
+  X = right | (left & next(X)) is computed (until), otherwise the
+  greatest fixpoint of X = right & (left | next(X)) (release). A
+  NULL left stands for true in the first case (F) and for false in
+  the second one (G).
+*/
+static void stat_lasso_checker_fixpoint(const StatLasso* lasso,
+                                        const boolean* left,
+                                        const boolean* right,
+                                        const boolean greatest,
+                                        boolean* res)
+{
+  int pass, i;
+
+  for (i = 0; i < lasso->length; i++) res[i] = greatest;
+
+  for (pass = 0; pass < 2; pass++) {
+    for (i = lasso->length - 1; i >= 0; i--) {
+      const boolean l = ((boolean*)NULL != left) ? left[i] : !greatest;
+      const boolean next = res[LASSO_SUCC(lasso, i)];
+
+      if (greatest) res[i] = right[i] && (l || next);
+      else res[i] = right[i] || (l && next);
+    }
+  }
+}
+
+/*!
+  \brief Checks the fairness constraints of the model on the lasso
+
+  A justice constraint must hold in some state of the loop. A
+  compassion constraint (p, q) requires a loop state satisfying q
+  whenever a loop state satisfies p.
+*/
+static boolean stat_lasso_checker_is_fair(StatLassoChecker_ptr self,
+                                          const StatLasso* lasso)
+{
+  const BddFsm_ptr fsm =
+    BDD_FSM(NuSMVEnv_get_value(STAT_ENV(self), ENV_BDD_FSM));
+  const BddEnc_ptr enc =
+    BDD_ENC(NuSMVEnv_get_value(STAT_ENV(self), ENV_BDD_ENCODER));
+  const DDMgr_ptr dd = BddEnc_get_dd_manager(enc);
+  JusticeList_ptr justice = BddFsm_get_justice(fsm);
+  CompassionList_ptr compassion = BddFsm_get_compassion(fsm);
+  FairnessListIterator_ptr iter;
+  boolean fair = true;
+
+  iter = FairnessList_begin(FAIRNESS_LIST(justice));
+  while (fair && ! FairnessListIterator_is_end(iter)) {
+    bdd_ptr p = JusticeList_get_p(justice, iter);
+
+    fair = stat_lasso_checker_loop_hits(self, lasso, p);
+
+    bdd_free(dd, p);
+    iter = FairnessListIterator_next(iter);
+  }
+
+  iter = FairnessList_begin(FAIRNESS_LIST(compassion));
+  while (fair && ! FairnessListIterator_is_end(iter)) {
+    bdd_ptr p = CompassionList_get_p(compassion, iter);
+    bdd_ptr q = CompassionList_get_q(compassion, iter);
+
+    fair = (! stat_lasso_checker_loop_hits(self, lasso, p)) ||
+      stat_lasso_checker_loop_hits(self, lasso, q);
+
+    bdd_free(dd, q);
+    bdd_free(dd, p);
+    iter = FairnessListIterator_next(iter);
+  }
+
+  return fair;
+}
+
+/*!
+  \brief Returns true iff some state of the loop satisfies p
+
+*/
+static boolean stat_lasso_checker_loop_hits(const StatLassoChecker_ptr self,
+                                            const StatLasso* lasso,
+                                            bdd_ptr p)
+{
+  const BddEnc_ptr enc =
+    BDD_ENC(NuSMVEnv_get_value(STAT_ENV(self), ENV_BDD_ENCODER));
+  const DDMgr_ptr dd = BddEnc_get_dd_manager(enc);
+  int i;
+
+  for (i = lasso->loop_start; i < lasso->length; i++) {
+    if (bdd_entailed(dd, lasso->states[i], p)) return true;
+  }
+
+  return false;
+}
+
+/*!
+  \brief Returns the (cached) BDD of a state of an execution
+
+  The returned BDD is owned by the checker
+*/
+static bdd_ptr stat_lasso_checker_get_state_bdd(StatLassoChecker_ptr self,
+                                                const Expr_ptr state)
+{
+  bdd_ptr res = (bdd_ptr)find_assoc(self->states, state);
+
+  if ((bdd_ptr)NULL == res) {
+    const BddEnc_ptr enc =
+      BDD_ENC(NuSMVEnv_get_value(STAT_ENV(self), ENV_BDD_ENCODER));
+
+    res = BddEnc_expr_to_bdd(enc, state, Nil);
+    insert_assoc(self->states, state, (node_ptr)res);
+  }
+
+  return res;
+}
+
+/*!
+  \brief Private service
+
+  Used when destroying hash containing bdd_ptr as data
+*/
+static assoc_retval stat_lasso_checker_free_bdd(char* key, char* data,
+                                                char* arg)
+{
+  bdd_ptr bdd = (bdd_ptr) data;
+  DDMgr_ptr dd = (DDMgr_ptr) arg;
+
+  if (bdd != (bdd_ptr) NULL) { bdd_free(dd, bdd); }
+  return ASSOC_DELETE;
+}
+
+/**AutomaticEnd***************************************************************/
@@ -0,0 +1,130 @@
+/* ---------------------------------------------------------------------------
+
+
+  This file is part of the ``stat'' package of NuSMV version 2.
+  Copyright (C) 2012 by FBK-irst.
+
+  NuSMV version 2 is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  NuSMV version 2 is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA.
+
+  For more information on NuSMV see <http://nusmv.fbk.eu>
+  or email to <nusmv-users@fbk.eu>.
+  Please report bugs to <nusmv-users@fbk.eu>.
+
+  To contact the NuSMV development board, email to <nusmv@fbk.eu>.
+
+-----------------------------------------------------------------------------*/
+
+/*!
+  \author Alberto Bombardelli
+  \brief Public interface of class 'StatLassoChecker'
+
+  A StatLassoChecker evaluates an LTL property directly on the lasso
+  shaped executions produced by the statistical problem generators.
+  The evaluation is a labelling of the lasso positions with the
+  subformulas of the property, which is linear in the length of the
+  lasso times the size of the formula. Neither the symbol table nor
+  the encoders are modified.
+
+  Only future time LTL is supported: properties containing past
+  operators or next() expressions must be verified with the model
+  checker.
+
+*/
+
+
+
+#ifndef __NUSMV_CORE_STAT_STAT_LASSO_CHECKER_H__
+#define __NUSMV_CORE_STAT_STAT_LASSO_CHECKER_H__
+
+#include "nusmv/core/stat/stat.h"
+#include "nusmv/core/stat/StatTrace.h"
+#include "nusmv/core/prop/Prop.h"
+
+/*!
+  \struct StatLassoChecker
+  \brief Definition of the public accessor for class StatLassoChecker
+
+*/
+typedef struct StatLassoChecker_TAG*  StatLassoChecker_ptr;
+
+/*!
+  \brief To cast and check instances of class StatLassoChecker
+
+  These macros must be used respectively to cast and to check
+  instances of class StatLassoChecker
+*/
+#define STAT_LASSO_CHECKER(self) \
+         ((StatLassoChecker_ptr) self)
+
+/*!
+  \brief \todo Missing synopsis
+
+  \todo Missing description
+*/
+#define STAT_LASSO_CHECKER_CHECK_INSTANCE(self) \
+         (nusmv_assert(STAT_LASSO_CHECKER(self) != STAT_LASSO_CHECKER(NULL)))
+
+
+/**AutomaticStart*************************************************************/
+
+/*---------------------------------------------------------------------------*/
+/* Function prototypes                                                       */
+/*---------------------------------------------------------------------------*/
+
+/* Constructors ***************************************************************/
+
+/*!
+  \methodof StatLassoChecker
+  \brief The StatLassoChecker class constructor
+
+  Creates a checker for the given LTL property
+
+  \sa StatLassoChecker_destroy
+*/
+StatLassoChecker_ptr StatLassoChecker_create(const NuSMVEnv_ptr env,
+                                             const Prop_ptr prop);
+
+/* Destructors ****************************************************************/
+
+/*!
+  \methodof StatLassoChecker
+  \brief The StatLassoChecker class destructor
+
+  \sa StatLassoChecker_create
+*/
+void StatLassoChecker_destroy(StatLassoChecker_ptr self);
+
+/*!
+  \methodof StatLassoChecker
+  \brief Returns true iff the property can be evaluated on lassos
+
+*/
+boolean StatLassoChecker_is_supported(const StatLassoChecker_ptr self);
+
+/*!
+  \methodof StatLassoChecker
+  \brief Evaluates the property on the given execution
+
+  The execution must be generated (i.e. it must have a loopback).
+  Returns STAT_OK iff the lasso satisfies the property. As done by
+  the LTL model checker, a lasso that violates the fairness
+  constraints of the model is considered to satisfy the property.
+*/
+StatVericationResult StatLassoChecker_check(StatLassoChecker_ptr self,
+                                            const StatTrace_ptr execution);
+
+/**AutomaticEnd***************************************************************/
+
+#endif /* __NUSMV_CORE_STAT_STAT_LASSO_CHECKER_H__ */
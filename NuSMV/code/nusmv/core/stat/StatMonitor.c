@@ -0,0 +1,643 @@
+/* ---------------------------------------------------------------------------
+
+
+  This file is part of the ``stat'' package of NuSMV version 2.
+  Copyright (C) 2012 by FBK-irst.
+
+  NuSMV version 2 is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  NuSMV version 2 is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA.
+
+  For more information on NuSMV see <http://nusmv.fbk.eu>
+  or email to <nusmv-users@fbk.eu>.
+  Please report bugs to <nusmv-users@fbk.eu>.
+
+  To contact the NuSMV development board, email to <nusmv@fbk.eu>.
+
+-----------------------------------------------------------------------------*/
+
+/*!
+  \author Alberto Bombardelli
+  \brief Implementation of class 'StatMonitor'
+
+  The obligation is a hashed formula built from the subformulas of
+  the property. Progressing it through a state replaces the atoms
+  with their value in the state, X f with f, and unrolls the
+  fixpoint operators once:
+
+    F f   -> f | F f
+    G f   -> f & G f
+    f U g -> g | (f & (f U g))
+    f V g -> g & (f | (f V g))
+
+  Boolean connectives are rebuilt by the expression manager, which
+  simplifies the constants away. Conjunctions and disjunctions are
+  kept in a normal form: they are flattened, their operands are
+  sorted and without duplicates, and f is absorbed by G f in a
+  conjunction and by F f in a disjunction. Without it the unrolling
+  of G F p would be F p & (F p & ... G F p), one operand longer at
+  each step; with it the obligations are drawn from a finite set,
+  and the same obligation is reached again as the same node. The
+  progression of an obligation through a state is cached, since the
+  same states are visited by many executions.
+
+*/
+
+#include "nusmv/core/stat/StatMonitor.h"
+#include "nusmv/core/stat/statInt.h"
+
+#include "nusmv/core/utils/EnvObject.h"
+#include "nusmv/core/utils/EnvObject_private.h"
+#include "nusmv/core/utils/assoc.h"
+#include "nusmv/core/utils/ErrorMgr.h"
+
+#include "nusmv/core/node/NodeMgr.h"
+#include "nusmv/core/parser/symbols.h"
+#include "nusmv/core/compile/compile.h"
+#include "nusmv/core/enc/bdd/BddEnc.h"
+#include "nusmv/core/fsm/bdd/BddFsm.h"
+#include "nusmv/core/fsm/bdd/FairnessList.h"
+#include "nusmv/core/wff/ExprMgr.h"
+#include "nusmv/core/wff/lr/MasterLogicRecognizer.h"
+
+#include <stdlib.h>
+
+/*---------------------------------------------------------------------------*/
+/* Constant declarations                                                     */
+/*---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*/
+/* Structure declarations                                                    */
+/*---------------------------------------------------------------------------*/
+
+typedef struct StatMonitor_TAG
+{
+  /* this MUST stay on the top */
+  INHERITS_FROM(EnvObject);
+
+  /* -------------------------------------------------- */
+  /*                  Private members                   */
+  /* -------------------------------------------------- */
+  /* flattened property, with defines expanded */
+  Expr_ptr formula;
+
+  /* what the rest of the current execution must satisfy */
+  Expr_ptr obligation;
+
+  /* false if the formula contains unsupported operators, or if the
+     model has fairness constraints */
+  boolean supported;
+
+  /* atoms hash map: Expr_ptr -> bdd_ptr (referenced) */
+  hash_ptr atoms;
+
+  /* states hash map: state sexp -> bdd_ptr (referenced) */
+  hash_ptr states;
+
+  /* progressions hash map: (obligation . state) -> obligation */
+  hash_ptr progressions;
+} StatMonitor;
+
+/*---------------------------------------------------------------------------*/
+/* Type declarations                                                         */
+/*---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*/
+/* Variable declarations                                                     */
+/*---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*/
+/* Macro declarations                                                        */
+/*---------------------------------------------------------------------------*/
+#define STAT_ENV(self) (ENV_OBJECT(self)->environment)
+
+/**AutomaticStart*************************************************************/
+
+/*---------------------------------------------------------------------------*/
+/* Static function prototypes                                                */
+/*---------------------------------------------------------------------------*/
+
+static void stat_monitor_init(StatMonitor_ptr self,
+                              const NuSMVEnv_ptr env,
+                              const Prop_ptr prop);
+
+static void stat_monitor_deinit(StatMonitor_ptr self);
+
+static boolean stat_monitor_is_supported_formula(const StatMonitor_ptr self,
+                                                 const Expr_ptr formula);
+
+static boolean stat_monitor_is_fairness_free(const StatMonitor_ptr self);
+
+static Expr_ptr stat_monitor_progress(StatMonitor_ptr self,
+                                      const Expr_ptr formula,
+                                      bdd_ptr state);
+
+static Expr_ptr stat_monitor_normalize(StatMonitor_ptr self,
+                                       const int op,
+                                       const Expr_ptr left,
+                                       const Expr_ptr right);
+
+static int stat_monitor_count_operands(const int op, const Expr_ptr formula);
+
+static void stat_monitor_collect_operands(const int op,
+                                          const Expr_ptr formula,
+                                          Expr_ptr* operands,
+                                          int* num);
+
+static int stat_monitor_compare_operands(const void* e1, const void* e2);
+
+static boolean stat_monitor_eval_atom(StatMonitor_ptr self,
+                                      const Expr_ptr atom,
+                                      bdd_ptr state);
+
+static bdd_ptr stat_monitor_get_state_bdd(StatMonitor_ptr self,
+                                          const Expr_ptr state);
+
+static assoc_retval stat_monitor_free_bdd(char* key, char* data, char* arg);
+
+/*---------------------------------------------------------------------------*/
+/* Definition of exported functions                                          */
+/*---------------------------------------------------------------------------*/
+
+StatMonitor_ptr StatMonitor_create(const NuSMVEnv_ptr env,
+                                   const Prop_ptr prop)
+{
+  StatMonitor_ptr self = ALLOC(StatMonitor, 1);
+  STAT_MONITOR_CHECK_INSTANCE(self);
+
+  stat_monitor_init(self, env, prop);
+
+  return self;
+}
+
+void StatMonitor_destroy(StatMonitor_ptr self)
+{
+  STAT_MONITOR_CHECK_INSTANCE(self);
+
+  stat_monitor_deinit(self);
+
+  FREE(self);
+}
+
+boolean StatMonitor_is_supported(const StatMonitor_ptr self)
+{
+  STAT_MONITOR_CHECK_INSTANCE(self);
+
+  return self->supported;
+}
+
+void StatMonitor_reset(StatMonitor_ptr self)
+{
+  STAT_MONITOR_CHECK_INSTANCE(self);
+
+  self->obligation = self->formula;
+
+  /* a new execution starts: the cached states can be dropped */
+  if (Stat_is_cache_full(STAT_ENV(self), self->states)) {
+    const BddEnc_ptr enc =
+      BDD_ENC(NuSMVEnv_get_value(STAT_ENV(self), ENV_BDD_ENCODER));
+
+    clear_assoc_and_free_entries_arg(self->states, stat_monitor_free_bdd,
+                                     (char*)BddEnc_get_dd_manager(enc));
+  }
+
+  /* keys and obligations are hashed nodes */
+  if (Stat_is_cache_full(STAT_ENV(self), self->progressions)) {
+    clear_assoc(self->progressions);
+  }
+}
+
+StatVericationResult StatMonitor_step(StatMonitor_ptr self,
+                                      const Expr_ptr state)
+{
+  const ExprMgr_ptr exprs =
+    EXPR_MGR(NuSMVEnv_get_value(STAT_ENV(self), ENV_EXPR_MANAGER));
+  const NodeMgr_ptr nodemgr =
+    NODE_MGR(NuSMVEnv_get_value(STAT_ENV(self), ENV_NODE_MGR));
+  node_ptr key;
+  Expr_ptr next;
+
+  STAT_MONITOR_CHECK_INSTANCE(self);
+  nusmv_assert(self->supported);
+
+  /* the verdict was already given */
+  if (ExprMgr_is_true(exprs, self->obligation)) return STAT_OK;
+  if (ExprMgr_is_false(exprs, self->obligation)) return STAT_NOT_OK;
+
+  key = find_node(nodemgr, CONS, self->obligation, state);
+  next = (Expr_ptr)find_assoc(self->progressions, key);
+
+  if (Nil == next) {
+    next = stat_monitor_progress(self, self->obligation,
+                                 stat_monitor_get_state_bdd(self, state));
+    insert_assoc(self->progressions, key, next);
+  }
+
+  self->obligation = next;
+
+  if (ExprMgr_is_true(exprs, next)) return STAT_OK;
+  if (ExprMgr_is_false(exprs, next)) return STAT_NOT_OK;
+  return STAT_NOT_VERIFIED;
+}
+
+/*---------------------------------------------------------------------------*/
+/* Definition of internal functions                                          */
+/*---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*/
+/* Definition of static functions                                            */
+/*---------------------------------------------------------------------------*/
+
+/*!
+  \brief The StatMonitor class private initializer
+
+  \sa StatMonitor_create
+*/
+static void stat_monitor_init(StatMonitor_ptr self,
+                              const NuSMVEnv_ptr env,
+                              const Prop_ptr prop)
+{
+  const SymbTable_ptr st = SYMB_TABLE(NuSMVEnv_get_value(env, ENV_SYMB_TABLE));
+
+  env_object_init(ENV_OBJECT(self), env);
+
+  nusmv_assert(Prop_Ltl == Prop_get_type(prop));
+
+  self->formula =
+    Compile_FlattenSexpExpandDefine(st, Prop_get_expr_core(prop), Nil);
+  self->obligation = self->formula;
+  self->atoms = new_assoc();
+  self->states = new_assoc();
+  self->progressions = new_assoc();
+
+  self->supported = stat_monitor_is_fairness_free(self) &&
+    stat_monitor_is_supported_formula(self, self->formula);
+}
+
+/*!
+  \brief The StatMonitor class private deinitializer
+
+  \sa StatMonitor_destroy
+*/
+static void stat_monitor_deinit(StatMonitor_ptr self)
+{
+  const BddEnc_ptr enc =
+    BDD_ENC(NuSMVEnv_get_value(STAT_ENV(self), ENV_BDD_ENCODER));
+  const DDMgr_ptr dd = BddEnc_get_dd_manager(enc);
+
+  clear_assoc_and_free_entries_arg(self->atoms, stat_monitor_free_bdd,
+                                   (char*)dd);
+  free_assoc(self->atoms); self->atoms = (hash_ptr)NULL;
+
+  clear_assoc_and_free_entries_arg(self->states, stat_monitor_free_bdd,
+                                   (char*)dd);
+  free_assoc(self->states); self->states = (hash_ptr)NULL;
+
+  /* keys and obligations are hashed nodes */
+  free_assoc(self->progressions); self->progressions = (hash_ptr)NULL;
+
+  self->formula = Nil;
+  self->obligation = Nil;
+
+  env_object_deinit(ENV_OBJECT(self));
+}
+
+/*!
+  \brief Checks that only future temporal operators are used
+
+  Subformulas recognized as simple expressions are atoms.
+*/
+static boolean stat_monitor_is_supported_formula(const StatMonitor_ptr self,
+                                                 const Expr_ptr formula)
+{
+  const MasterLogicRecognizer_ptr mlr =
+    MASTER_LOGIC_RECOGNIZER(NuSMVEnv_get_value(STAT_ENV(self),
+                                               ENV_MASTER_LOGIC_RECOGNIZER));
+
+  switch (MasterLogicRecognizer_recognize(mlr, formula, Nil)) {
+  case EXP_SIMPLE:
+    return true;
+
+  case EXP_LTL:
+    break;
+
+  default:
+    return false;
+  }
+
+  switch (node_get_type(formula)) {
+  case NOT:
+  case OP_NEXT:
+  case OP_GLOBAL:
+  case OP_FUTURE:
+    return stat_monitor_is_supported_formula(self, car(formula));
+
+  case AND:
+  case OR:
+  case IMPLIES:
+  case IFF:
+  case XOR:
+  case XNOR:
+  case UNTIL:
+  case RELEASES:
+    return stat_monitor_is_supported_formula(self, car(formula)) &&
+      stat_monitor_is_supported_formula(self, cdr(formula));
+
+  default:
+    /* past operators, temporal operators inside case expressions... */
+    return false;
+  }
+}
+
+/*!
+  \brief Returns true iff the model has no fairness constraints
+
+  With fairness constraints only the fair continuations of a prefix
+  matter, and they can not be told apart while the execution is
+  being generated.
+*/
+static boolean stat_monitor_is_fairness_free(const StatMonitor_ptr self)
+{
+  const BddFsm_ptr fsm =
+    BDD_FSM(NuSMVEnv_get_value(STAT_ENV(self), ENV_BDD_FSM));
+
+  return
+    FairnessList_is_empty(FAIRNESS_LIST(BddFsm_get_justice(fsm))) &&
+    FairnessList_is_empty(FAIRNESS_LIST(BddFsm_get_compassion(fsm)));
+}
+
+/*!
+  \brief Progresses formula through a state
+
+  Returns the obligation that the successors of state must satisfy
+  for the execution to satisfy formula from state.
+*/
+static Expr_ptr stat_monitor_progress(StatMonitor_ptr self,
+                                      const Expr_ptr formula,
+                                      bdd_ptr state)
+{
+  const NuSMVEnv_ptr env = STAT_ENV(self);
+  const ExprMgr_ptr exprs = EXPR_MGR(NuSMVEnv_get_value(env, ENV_EXPR_MANAGER));
+  const MasterLogicRecognizer_ptr mlr =
+    MASTER_LOGIC_RECOGNIZER(NuSMVEnv_get_value(env,
+                                               ENV_MASTER_LOGIC_RECOGNIZER));
+  Expr_ptr left;
+  Expr_ptr right;
+
+  if (ExprMgr_is_true(exprs, formula) || ExprMgr_is_false(exprs, formula)) {
+    return formula;
+  }
+
+  if (EXP_SIMPLE == MasterLogicRecognizer_recognize(mlr, formula, Nil)) {
+    return stat_monitor_eval_atom(self, formula, state) ?
+      ExprMgr_true(exprs) : ExprMgr_false(exprs);
+  }
+
+  switch (node_get_type(formula)) {
+  case OP_NEXT:
+    return car(formula);
+
+  case NOT:
+    return ExprMgr_not(exprs, stat_monitor_progress(self, car(formula), state));
+
+  case OP_FUTURE:
+    return stat_monitor_normalize(self, OR,
+                                  stat_monitor_progress(self, car(formula),
+                                                        state),
+                                  formula);
+
+  case OP_GLOBAL:
+    return stat_monitor_normalize(self, AND,
+                                  stat_monitor_progress(self, car(formula),
+                                                        state),
+                                  formula);
+
+  default:
+    break;
+  }
+
+  left = stat_monitor_progress(self, car(formula), state);
+
+  switch (node_get_type(formula)) {
+  case UNTIL:
+    right = stat_monitor_progress(self, cdr(formula), state);
+    return stat_monitor_normalize(self, OR, right,
+                                  stat_monitor_normalize(self, AND,
+                                                         left, formula));
+
+  case RELEASES:
+    right = stat_monitor_progress(self, cdr(formula), state);
+    return stat_monitor_normalize(self, AND, right,
+                                  stat_monitor_normalize(self, OR,
+                                                         left, formula));
+
+  default:
+    break;
+  }
+
+  right = stat_monitor_progress(self, cdr(formula), state);
+
+  switch (node_get_type(formula)) {
+  case AND: return stat_monitor_normalize(self, AND, left, right);
+  case OR: return stat_monitor_normalize(self, OR, left, right);
+  case IMPLIES: return ExprMgr_implies(exprs, left, right);
+  case IFF: return ExprMgr_iff(exprs, left, right);
+  case XNOR: return ExprMgr_xnor(exprs, left, right);
+  case XOR: return ExprMgr_xor(exprs, left, right);
+
+  default:
+    error_unreachable_code_msg("Unsupported operator %d\n",
+                               node_get_type(formula));
+  }
+
+  return Nil;
+}
+
+/*!
+  \brief Builds the conjunction (op is AND) or the disjunction (op is
+  OR) of two obligations, in normal form
+
+  The operands of left and right are collected through the nested
+  nodes of kind op, sorted by address and deduplicated. An operand f
+  is dropped if G f is also an operand of the conjunction, or F f an
+  operand of the disjunction. Since nodes are hashed, equivalent
+  obligations built along different executions are the same node.
+*/
+static Expr_ptr stat_monitor_normalize(StatMonitor_ptr self,
+                                       const int op,
+                                       const Expr_ptr left,
+                                       const Expr_ptr right)
+{
+  const ExprMgr_ptr exprs =
+    EXPR_MGR(NuSMVEnv_get_value(STAT_ENV(self), ENV_EXPR_MANAGER));
+  const int absorbing = (AND == op) ? OP_GLOBAL : OP_FUTURE;
+  Expr_ptr res;
+  Expr_ptr* operands;
+  int num = 0;
+  int size;
+  int i, j;
+
+  nusmv_assert(AND == op || OR == op);
+
+  /* constants and equal operands are simplified by the manager */
+  res = (AND == op) ?
+    ExprMgr_and(exprs, left, right) : ExprMgr_or(exprs, left, right);
+  if (op != node_get_type(res)) return res;
+
+  size = stat_monitor_count_operands(op, res);
+  operands = ALLOC(Expr_ptr, size);
+  nusmv_assert((Expr_ptr*)NULL != operands);
+
+  stat_monitor_collect_operands(op, res, operands, &num);
+  nusmv_assert(num == size);
+
+  /* duplicates become adjacent */
+  qsort((void*)operands, (size_t)size, sizeof(Expr_ptr),
+        stat_monitor_compare_operands);
+
+  for (i = 1, num = 1; i < size; i++) {
+    if (operands[i] != operands[num - 1]) operands[num++] = operands[i];
+  }
+
+  /* G f implies f, f implies F f */
+  for (i = 0; i < num; i++) {
+    if (Nil == operands[i] || absorbing != node_get_type(operands[i])) {
+      continue;
+    }
+
+    for (j = 0; j < num; j++) {
+      if (car(operands[i]) == operands[j]) operands[j] = Nil;
+    }
+  }
+
+  res = Nil;
+  for (i = num - 1; i >= 0; i--) {
+    if (Nil == operands[i]) continue;
+
+    if (Nil == res) res = operands[i];
+    else {
+      res = (AND == op) ?
+        ExprMgr_and(exprs, operands[i], res) :
+        ExprMgr_or(exprs, operands[i], res);
+    }
+  }
+
+  FREE(operands);
+
+  return res;
+}
+
+/*!
+  \brief Returns the number of operands of the nested nodes of kind op
+  at the top of formula
+
+  \sa stat_monitor_collect_operands
+*/
+static int stat_monitor_count_operands(const int op, const Expr_ptr formula)
+{
+  if (op != node_get_type(formula)) return 1;
+
+  return stat_monitor_count_operands(op, car(formula)) +
+    stat_monitor_count_operands(op, cdr(formula));
+}
+
+/*!
+  \brief Appends to operands the operands of the nested nodes of kind
+  op at the top of formula
+
+  num is the number of operands already stored, and is updated
+*/
+static void stat_monitor_collect_operands(const int op,
+                                          const Expr_ptr formula,
+                                          Expr_ptr* operands,
+                                          int* num)
+{
+  if (op != node_get_type(formula)) {
+    operands[(*num)++] = formula;
+    return;
+  }
+
+  stat_monitor_collect_operands(op, car(formula), operands, num);
+  stat_monitor_collect_operands(op, cdr(formula), operands, num);
+}
+
+/*!
+  \brief Orders the operands of a normalized obligation by address
+
+*/
+static int stat_monitor_compare_operands(const void* e1, const void* e2)
+{
+  const Expr_ptr a = *((const Expr_ptr*)e1);
+  const Expr_ptr b = *((const Expr_ptr*)e2);
+
+  if (a < b) return -1;
+  if (a > b) return 1;
+  return 0;
+}
+
+/*!
+  \brief Returns the value of an atom in a state
+
+*/
+static boolean stat_monitor_eval_atom(StatMonitor_ptr self,
+                                      const Expr_ptr atom,
+                                      bdd_ptr state)
+{
+  const BddEnc_ptr enc =
+    BDD_ENC(NuSMVEnv_get_value(STAT_ENV(self), ENV_BDD_ENCODER));
+  bdd_ptr atom_bdd = (bdd_ptr)find_assoc(self->atoms, atom);
+
+  if ((bdd_ptr)NULL == atom_bdd) {
+    atom_bdd = BddEnc_expr_to_bdd(enc, atom, Nil);
+    insert_assoc(self->atoms, atom, (node_ptr)atom_bdd);
+  }
+
+  return bdd_entailed(BddEnc_get_dd_manager(enc), state, atom_bdd);
+}
+
+/*!
+  \brief Returns the (cached) BDD of a state
+
+  The returned BDD is owned by the monitor
+*/
+static bdd_ptr stat_monitor_get_state_bdd(StatMonitor_ptr self,
+                                          const Expr_ptr state)
+{
+  bdd_ptr res = (bdd_ptr)find_assoc(self->states, state);
+
+  if ((bdd_ptr)NULL == res) {
+    const BddEnc_ptr enc =
+      BDD_ENC(NuSMVEnv_get_value(STAT_ENV(self), ENV_BDD_ENCODER));
+
+    res = BddEnc_expr_to_bdd(enc, state, Nil);
+    insert_assoc(self->states, state, (node_ptr)res);
+  }
+
+  return res;
+}
+
+/*!
+  \brief Private service
+
+  Used when destroying hash containing bdd_ptr as data
+*/
+static assoc_retval stat_monitor_free_bdd(char* key, char* data, char* arg)
+{
+  bdd_ptr bdd = (bdd_ptr) data;
+  DDMgr_ptr dd = (DDMgr_ptr) arg;
+
+  if (bdd != (bdd_ptr) NULL) { bdd_free(dd, bdd); }
+  return ASSOC_DELETE;
+}
+
+/**AutomaticEnd***************************************************************/
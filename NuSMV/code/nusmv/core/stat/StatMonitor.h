@@ -0,0 +1,138 @@
+/* ---------------------------------------------------------------------------
+
+
+  This file is part of the ``stat'' package of NuSMV version 2.
+  Copyright (C) 2012 by FBK-irst.
+
+  NuSMV version 2 is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  NuSMV version 2 is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA.
+
+  For more information on NuSMV see <http://nusmv.fbk.eu>
+  or email to <nusmv-users@fbk.eu>.
+  Please report bugs to <nusmv-users@fbk.eu>.
+
+  To contact the NuSMV development board, email to <nusmv@fbk.eu>.
+
+-----------------------------------------------------------------------------*/
+
+/*!
+  \author Alberto Bombardelli
+  \brief Public interface of class 'StatMonitor'
+
+  A StatMonitor evaluates an LTL property on an execution while it is
+  being generated, one state at a time, by formula progression: after
+  each state the property is rewritten into the obligation that the
+  rest of the execution must satisfy. As soon as the obligation
+  becomes true or false the verdict holds for every continuation of
+  the prefix, and the simulation can be stopped.
+
+  The same fragment of StatLassoChecker is supported. Since a prefix
+  says nothing about the fairness of its continuations, the monitor
+  is not supported on models with fairness constraints.
+
+*/
+
+
+#ifndef __NUSMV_CORE_STAT_STAT_MONITOR_H__
+#define __NUSMV_CORE_STAT_STAT_MONITOR_H__
+
+
+#include "nusmv/core/stat/stat.h"
+#include "nusmv/core/prop/Prop.h"
+
+/*!
+  \struct StatMonitor
+  \brief Definition of the public accessor for class StatMonitor
+
+
+*/
+typedef struct StatMonitor_TAG*  StatMonitor_ptr;
+
+/*!
+  \brief To cast and check instances of class StatMonitor
+
+  These macros must be used respectively to cast and to check
+  instances of class StatMonitor
+*/
+#define STAT_MONITOR(self) \
+         ((StatMonitor_ptr) self)
+
+/*!
+  \brief \todo Missing synopsis
+
+  \todo Missing description
+*/
+#define STAT_MONITOR_CHECK_INSTANCE(self) \
+         (nusmv_assert(STAT_MONITOR(self) != STAT_MONITOR(NULL)))
+
+
+/**AutomaticStart*************************************************************/
+
+/*---------------------------------------------------------------------------*/
+/* Function prototypes                                                       */
+/*---------------------------------------------------------------------------*/
+
+/* Constructors ***************************************************************/
+
+/*!
+  \methodof StatMonitor
+  \brief The StatMonitor class constructor
+
+  Creates a monitor for the given LTL property, ready to observe
+  the initial state of an execution
+
+  \sa StatMonitor_destroy
+*/
+StatMonitor_ptr StatMonitor_create(const NuSMVEnv_ptr env,
+                                   const Prop_ptr prop);
+
+/* Destructors ****************************************************************/
+
+/*!
+  \methodof StatMonitor
+  \brief The StatMonitor class destructor
+
+  \sa StatMonitor_create
+*/
+void StatMonitor_destroy(StatMonitor_ptr self);
+
+/*!
+  \methodof StatMonitor
+  \brief Returns true iff the property can be monitored
+
+*/
+boolean StatMonitor_is_supported(const StatMonitor_ptr self);
+
+/*!
+  \methodof StatMonitor
+  \brief Prepares the monitor for a new execution
+
+*/
+void StatMonitor_reset(StatMonitor_ptr self);
+
+/*!
+  \methodof StatMonitor
+  \brief Observes the next state of the execution
+
+  Returns STAT_OK (resp. STAT_NOT_OK) if every execution starting
+  with the states observed since the last reset satisfies (resp.
+  violates) the property, and STAT_NOT_VERIFIED if the verdict
+  still depends on the next states.
+*/
+StatVericationResult StatMonitor_step(StatMonitor_ptr self,
+                                      const Expr_ptr state);
+
+/**AutomaticEnd***************************************************************/
+
+#endif /* __NUSMV_CORE_STAT_STAT_MONITOR_H__ */
@@ -37,14 +37,11 @@
 #include "nusmv/core/stat/statInt.h"
 
 /* Used to generate the key. */
-#include "nusmv/core/node/normalizers/MasterNormalizer.h"
+#include "nusmv/core/node/NodeMgr.h"
+#include "nusmv/core/parser/symbols.h"
 
 /* Used to perform random simulation */
-#include "nusmv/core/simulate/simulate.h"
-
-/* Trace are required to collect steps from the simulation */
-#include "nusmv/core/trace/Trace.h"
-#include "nusmv/core/trace/pkg_trace.h"
+#include "nusmv/core/stat/StatSimulator.h"
 
 /*---------------------------------------------------------------------------*/
 /* Constant declarations                                                     */
@@ -79,15 +76,25 @@
 static StatTrace_ptr
   stat_problems_generator_simulate(StatProblemsGenerator_ptr self);
 
+static StatTrace_ptr
+  stat_problems_generator_run(StatProblemsGenerator_ptr self,
+                              StatMonitor_ptr monitor,
+                              StatVericationResult* verdict);
+
 static StatVericationResult
   stat_problems_generator_verify_execution(const StatProblemsGenerator_ptr self,
                                            const StatTrace_ptr execution);
 
 static Expr_ptr stat_problems_generator_gen_key(const NuSMVEnv_ptr env,
                                                 const StatTrace_ptr exec);
-
-static Expr_ptr dummy_gen_key(const NuSMVEnv_ptr env,
-                              const StatTrace_ptr exec);
+static hash_ptr stat_problems_generator_new_executions(void);
+static void
+  stat_problems_generator_clear_executions(StatProblemsGenerator_ptr self);
+static int stat_problems_generator_key_neq(const char* key1,
+                                           const char* key2);
+static int stat_problems_generator_key_hash(char* key, int size);
+static assoc_retval stat_problems_generator_free_key(char* key, char* data,
+                                                     char* arg);
 static void deinit_executions(StatProblemsGenerator_ptr self);
 /*---------------------------------------------------------------------------*/
 /* Definition of exported functions                                          */
@@ -118,8 +125,9 @@ void StatProblemsGenerator_prepare_property(StatProblemsGenerator_ptr self,
 
   deinit_executions(self);
   /* We do not call init since it overrides simulate and verify... */
-  self->executions_assoc = new_assoc();
-  self->executions_list = Olist_create();
+  self->executions_assoc = stat_problems_generator_new_executions();
+  self->lookups = 0;
+  self->hits = 0;
 
   self->prop = property;
 }
@@ -141,6 +149,39 @@ StatVericationResult StatProblemsGenerator_verify_step(StatProblemsGenerator_ptr
   return stat_problems_generator_verify_step(self);
 }
 
+StatTrace_ptr StatProblemsGenerator_simulate(StatProblemsGenerator_ptr self)
+{
+  StatProfiler_ptr profiler;
+  StatTrace_ptr execution;
+
+  STAT_PROBLEMS_GENERATOR_CHECK_INSTANCE(self);
+
+  profiler = Stat_get_profiler(STAT_ENV(self));
+
+  if (STAT_PROFILER(NULL) != profiler) {
+    StatProfiler_start(profiler, STAT_STAGE_SIMULATION);
+  }
+
+  execution = self->simulate(self);
+
+  if (STAT_PROFILER(NULL) != profiler) {
+    StatProfiler_stop(profiler, STAT_STAGE_SIMULATION);
+    StatProfiler_add_execution(profiler, StatTrace_get_length(execution));
+  }
+
+  return execution;
+}
+
+StatVericationResult
+  StatProblemsGenerator_verify_execution(StatProblemsGenerator_ptr self,
+                                         const StatTrace_ptr execution)
+{
+  STAT_PROBLEMS_GENERATOR_CHECK_INSTANCE(self);
+  PROP_CHECK_INSTANCE(self->prop);
+
+  return stat_problems_generator_check(self, execution);
+}
+
 StatVerificationMethod
   StatProblemsGenerator_get_verification_method(const StatProblemsGenerator_ptr self)
 {
@@ -156,6 +197,86 @@ void StatProblemsGenerator_set_verification_method(StatProblemsGenerator_ptr sel
 
   self->verification_method = method;
 }
+
+void StatProblemsGenerator_set_memoization(StatProblemsGenerator_ptr self,
+                                           const boolean memoize)
+{
+  STAT_PROBLEMS_GENERATOR_CHECK_INSTANCE(self);
+
+  if (! memoize) stat_problems_generator_clear_executions(self);
+
+  self->memoize = memoize;
+}
+
+boolean
+  StatProblemsGenerator_get_memoization(const StatProblemsGenerator_ptr self)
+{
+  STAT_PROBLEMS_GENERATOR_CHECK_INSTANCE(self);
+
+  return self->memoize;
+}
+
+void StatProblemsGenerator_set_monitoring(StatProblemsGenerator_ptr self,
+                                          const boolean monitoring)
+{
+  STAT_PROBLEMS_GENERATOR_CHECK_INSTANCE(self);
+
+  if (! monitoring && STAT_MONITOR(NULL) != self->monitor) {
+    StatMonitor_destroy(self->monitor);
+    self->monitor = STAT_MONITOR(NULL);
+  }
+
+  self->monitoring = monitoring;
+}
+
+boolean
+  StatProblemsGenerator_get_monitoring(const StatProblemsGenerator_ptr self)
+{
+  STAT_PROBLEMS_GENERATOR_CHECK_INSTANCE(self);
+
+  return self->monitoring;
+}
+
+long StatProblemsGenerator_get_lookups_num(const StatProblemsGenerator_ptr self)
+{
+  STAT_PROBLEMS_GENERATOR_CHECK_INSTANCE(self);
+
+  return self->lookups;
+}
+
+long StatProblemsGenerator_get_hits_num(const StatProblemsGenerator_ptr self)
+{
+  STAT_PROBLEMS_GENERATOR_CHECK_INSTANCE(self);
+
+  return self->hits;
+}
+
+hash_ptr
+  StatProblemsGenerator_get_memoized(const StatProblemsGenerator_ptr self)
+{
+  STAT_PROBLEMS_GENERATOR_CHECK_INSTANCE(self);
+
+  return self->executions_assoc;
+}
+
+void StatProblemsGenerator_memoize(StatProblemsGenerator_ptr self,
+                                   const Expr_ptr key,
+                                   const StatVericationResult res)
+{
+  STAT_PROBLEMS_GENERATOR_CHECK_INSTANCE(self);
+  nusmv_assert(STAT_OK == res || STAT_NOT_OK == res);
+
+  if (self->memoize && Nil == find_assoc(self->executions_assoc, key) &&
+      ! Stat_is_cache_full(STAT_ENV(self), self->executions_assoc)) {
+    insert_assoc(self->executions_assoc, key, NODE_FROM_INT(res));
+  }
+  else {
+    stat_problems_generator_free_key((char*)key, (char*)NULL,
+                                     (char*)NODE_MGR(NuSMVEnv_get_value(
+                                         STAT_ENV(self), ENV_NODE_MGR)));
+  }
+}
+
 /*---------------------------------------------------------------------------*/
 /* Definition of internal functions                                          */
 /*---------------------------------------------------------------------------*/
@@ -166,26 +287,37 @@ void stat_problems_generator_init(StatProblemsGenerator_ptr self,
 
   env_object_init(ENV_OBJECT(self), env);
 
-  self->executions_assoc = new_assoc();
-  self->executions_list = Olist_create();
+  self->executions_assoc = stat_problems_generator_new_executions();
+  self->memoize = true;
+  self->lookups = 0;
+  self->hits = 0;
 
   self->prop = PROP(NULL);
   self->verification_method = STAT_LTL_VERIFICATION;
+  self->lasso_checker = STAT_LASSO_CHECKER(NULL);
+  self->tableau = STAT_TABLEAU(NULL);
+  self->simulator = STAT_SIMULATOR(NULL);
+  self->monitoring = false;
+  self->monitor = STAT_MONITOR(NULL);
   self->counter_var =
     SymbTable_get_fresh_symbol_name(st, STAT_COUNTER_VAR_NAME);
 
   OVERRIDE(StatProblemsGenerator, gen_key) = stat_problems_generator_gen_key;
-  OVERRIDE(StatProblemsGenerator, gen_key) = dummy_gen_key;
   OVERRIDE(StatProblemsGenerator, simulate) = stat_problems_generator_simulate;
   OVERRIDE(StatProblemsGenerator, verify_execution) = stat_problems_generator_verify_execution;
 }
 
 void stat_problems_generator_deinit(StatProblemsGenerator_ptr self)
 {
-  env_object_deinit(ENV_OBJECT(self));
-
   deinit_executions(self);
 
+  if (STAT_SIMULATOR(NULL) != self->simulator) {
+    StatSimulator_destroy(self->simulator);
+    self->simulator = STAT_SIMULATOR(NULL);
+  }
+
+  env_object_deinit(ENV_OBJECT(self));
+
   self->counter_var = Nil;
   self->verification_method = STAT_INVALID_VERIFICATION;
 }
@@ -193,25 +325,112 @@ void stat_problems_generator_deinit(StatProblemsGenerator_ptr self)
 StatVericationResult
   stat_problems_generator_verify_step(const StatProblemsGenerator_ptr self)
 {
-  StatTrace_ptr new_exec = self->simulate(self);
-  Expr_ptr new_exec_key = self->gen_key(STAT_ENV(self), new_exec);
+  const StatProfiler_ptr profiler = Stat_get_profiler(STAT_ENV(self));
+  StatVericationResult res = STAT_NOT_VERIFIED;
+  StatTrace_ptr new_exec;
+
+  if (self->monitoring && STAT_MONITOR(NULL) == self->monitor) {
+    self->monitor = StatMonitor_create(STAT_ENV(self), self->prop);
+  }
+
+  if (STAT_PROFILER(NULL) != profiler) {
+    StatProfiler_start(profiler, STAT_STAGE_SIMULATION);
+  }
+
+  if (self->monitoring && StatMonitor_is_supported(self->monitor)) {
+    new_exec = stat_problems_generator_run(self, self->monitor, &res);
+  }
+  else {
+    new_exec = self->simulate(self);
+  }
+
+  if (STAT_PROFILER(NULL) != profiler) {
+    StatProfiler_stop(profiler, STAT_STAGE_SIMULATION);
+    StatProfiler_add_execution(profiler, StatTrace_get_length(new_exec));
+  }
+
+  /* The verdict is not known before the loopback: the lasso is
+     verified (and memoized) as usual */
+  if (STAT_NOT_VERIFIED == res) {
+    res = stat_problems_generator_check(self, new_exec);
+  }
+
+  /* The execution is not needed anymore */
+  StatTrace_destroy(new_exec);
+
+  return res;
+}
+
+StatVericationResult
+  stat_problems_generator_check(const StatProblemsGenerator_ptr self,
+                                const StatTrace_ptr new_exec)
+{
+  const StatProfiler_ptr profiler = Stat_get_profiler(STAT_ENV(self));
+  Expr_ptr new_exec_key = Nil;
+  StatVericationResult res = STAT_NOT_VERIFIED;
+
+  if (self->memoize) {
+    if (STAT_PROFILER(NULL) != profiler) {
+      StatProfiler_start(profiler, STAT_STAGE_MEMOIZATION);
+    }
+
+    new_exec_key = self->gen_key(STAT_ENV(self), new_exec);
+    res = (StatVericationResult)NODE_TO_INT(find_assoc(self->executions_assoc,
+                                                       new_exec_key));
+    self->lookups++;
+
+    if (STAT_PROFILER(NULL) != profiler) {
+      StatProfiler_stop(profiler, STAT_STAGE_MEMOIZATION);
+      StatProfiler_add_lookup(profiler, STAT_NOT_VERIFIED != res);
+    }
+  }
 
-  StatVericationResult res = self->verify_execution(self, new_exec);
+  /* The same lasso has already been verified */
+  if (STAT_NOT_VERIFIED != res) {
+    self->hits++;
+    stat_problems_generator_free_key((char*)new_exec_key, (char*)NULL,
+                                     (char*)NODE_MGR(NuSMVEnv_get_value(
+                                         STAT_ENV(self), ENV_NODE_MGR)));
+  }
+  else {
+    if (STAT_PROFILER(NULL) != profiler) {
+      StatProfiler_start(profiler, STAT_STAGE_VERIFICATION);
+    }
 
-  /* We assume that it is not possible to verify twice the same execution */
-  nusmv_assert(STAT_NOT_VERIFIED ==
-               (StatVericationResult)find_assoc(self->executions_assoc,
-                                                new_exec_key));
+    res = self->verify_execution(self, new_exec);
 
-  /* Store the result */
-  insert_assoc(self->executions_assoc, new_exec_key, NODE_FROM_INT(res));
+    if (STAT_PROFILER(NULL) != profiler) {
+      StatProfiler_stop(profiler, STAT_STAGE_VERIFICATION);
+    }
 
-  /* Add the execution to the list */
-  Olist_append(self->executions_list, (void*)new_exec);
+    /* Store the result, within the budget. Internal errors are not
+       results of the execution, and are not stored */
+    if (self->memoize && (STAT_OK == res || STAT_NOT_OK == res)) {
+      if (Stat_is_cache_full(STAT_ENV(self), self->executions_assoc)) {
+        stat_problems_generator_clear_executions(self);
+      }
+      insert_assoc(self->executions_assoc, new_exec_key, NODE_FROM_INT(res));
+    }
+    else if (self->memoize) {
+      stat_problems_generator_free_key((char*)new_exec_key, (char*)NULL,
+                                       (char*)NODE_MGR(NuSMVEnv_get_value(
+                                           STAT_ENV(self), ENV_NODE_MGR)));
+    }
+  }
 
   return res;
 }
 
+StatSimulator_ptr
+  stat_problems_generator_get_simulator(const StatProblemsGenerator_ptr self)
+{
+  if (STAT_SIMULATOR(NULL) == self->simulator) {
+    self->simulator = StatSimulator_create(STAT_ENV(self));
+  }
+
+  return self->simulator;
+}
+
 /*---------------------------------------------------------------------------*/
 /* Definition of static functions                                            */
 /*---------------------------------------------------------------------------*/
@@ -224,33 +443,85 @@ static StatVericationResult
   StatVericationResult res = STAT_INTERNAL_ERROR;
   const NuSMVEnv_ptr env = STAT_ENV(self);
   const StreamMgr_ptr streams = STREAM_MGR(NuSMVEnv_get_value(env, ENV_STREAM_MANAGER));
+  const StatProfiler_ptr profiler = Stat_get_profiler(env);
   SymbTable_ptr symb_table = SYMB_TABLE(NuSMVEnv_get_value(env, ENV_SYMB_TABLE));
 
   Prop_ptr to_verify = NULL;
   SymbLayer_ptr layer = NULL;
   int k = StatTrace_get_length(execution);
 
-  FILE * f = StreamMgr_reset_output_stream(streams);
+  FILE * f;
   nusmv_assert(0 < k);
 
+  /* the lasso is evaluated directly when the property allows it,
+     otherwise the model checker is used as with STAT_LTL_VERIFICATION */
+  if (STAT_LASSO_VERIFICATION == self->verification_method) {
+    if (STAT_LASSO_CHECKER(NULL) == self->lasso_checker) {
+      self->lasso_checker = StatLassoChecker_create(env, self->prop);
+    }
+
+    if (StatLassoChecker_is_supported(self->lasso_checker)) {
+      return StatLassoChecker_check(self->lasso_checker, execution);
+    }
+  }
+
+  /* the tableau of the property is built once and shared by all the
+     executions. A problem per execution is built only if the
+     property is not supported by StatTableau */
+  if (STAT_TABLEAU(NULL) == self->tableau) {
+    self->tableau = StatTableau_create(env, self->prop);
+  }
+
+  if (StatTableau_is_supported(self->tableau)) {
+    return StatTableau_check(self->tableau, execution);
+  }
+
+  f = StreamMgr_reset_output_stream(streams);
+
 
   /* case the execution is a single state loop */
   if (1 == k) {
+    if (STAT_PROFILER(NULL) != profiler) {
+      StatProfiler_start(profiler, STAT_STAGE_PROBLEM);
+    }
+
     to_verify =
       StatSexpProblem_gen_single_state_problem(env, execution, self->prop);
   }
   else {
+    if (STAT_PROFILER(NULL) != profiler) {
+      StatProfiler_start(profiler, STAT_STAGE_LAYER);
+    }
+
     /* multiple state verification requires counter var */
     layer =
       StatSexpProblem_prepare_layer(env, symb_table, self->counter_var, k);
 
+    if (STAT_PROFILER(NULL) != profiler) {
+      StatProfiler_stop(profiler, STAT_STAGE_LAYER);
+      StatProfiler_start(profiler, STAT_STAGE_PROBLEM);
+    }
+
     to_verify =
       StatSexpProblem_gen_problem(env, execution, self->counter_var, self->prop);
   }
 
-  if (STAT_LTL_VERIFICATION == self->verification_method) {
+  if (STAT_PROFILER(NULL) != profiler) {
+    StatProfiler_stop(profiler, STAT_STAGE_PROBLEM);
+  }
+
+  if (STAT_LTL_VERIFICATION == self->verification_method ||
+      STAT_LASSO_VERIFICATION == self->verification_method) {
+    if (STAT_PROFILER(NULL) != profiler) {
+      StatProfiler_start(profiler, STAT_STAGE_MODEL_CHECKING);
+    }
+
     Prop_verify(to_verify);
 
+    if (STAT_PROFILER(NULL) != profiler) {
+      StatProfiler_stop(profiler, STAT_STAGE_MODEL_CHECKING);
+    }
+
     switch(Prop_get_status(to_verify)) {
       case Prop_True:
         res = STAT_OK;
@@ -268,6 +539,8 @@ static StatVericationResult
     error_unreachable_code_msg("Not yet implemented!\n");
   }
 
+  Prop_destroy(to_verify);
+
   if (NULL != layer) {
     StatSexpProblem_destroy_layer(env, symb_table, layer);
     layer = NULL;
@@ -281,76 +554,70 @@ static StatVericationResult
 static StatTrace_ptr
   stat_problems_generator_simulate(StatProblemsGenerator_ptr self)
 {
-  /* TODO[AB]: This function prints undesired output, fix it */
-  const NuSMVEnv_ptr env = STAT_ENV(self);
-  const BddEnc_ptr enc = BDD_ENC(NuSMVEnv_get_value(env, ENV_BDD_ENCODER));
-  const TraceMgr_ptr tm =
-    TRACE_MGR(NuSMVEnv_get_value(env, ENV_TRACE_MGR));
-  const MasterNormalizer_ptr master_norm =
-    MASTER_NORMALIZER(NuSMVEnv_get_value(env, ENV_NODE_NORMALIZER));
+  return stat_problems_generator_run(self, STAT_MONITOR(NULL),
+                                     (StatVericationResult*)NULL);
+}
+
+/*!
+  \brief Generates a random execution
 
-  DDMgr_ptr dd = BddEnc_get_dd_manager(enc);
+  The execution is generated until it loops back. If monitor is not
+  NULL it observes every state, and the generation stops as soon as
+  it gives a verdict, which is stored in verdict: in that case the
+  returned execution is just a prefix without loopback. verdict is
+  STAT_NOT_VERIFIED otherwise.
+*/
+static StatTrace_ptr
+  stat_problems_generator_run(StatProblemsGenerator_ptr self,
+                              StatMonitor_ptr monitor,
+                              StatVericationResult* verdict)
+{
+  const StatSimulator_ptr simulator =
+    stat_problems_generator_get_simulator(self);
 
   StatTrace_ptr exec = StatTrace_create();
 
-  if (0 == Simulate_pick_state(env, TRACE_LABEL_INVALID, Random,
-                               0, false, NULL)) {
-    boolean found = false;
-    const int trace_id = TraceMgr_get_current_trace_number(tm);
-    const Trace_ptr curr_trace = TraceMgr_get_trace_at_index(tm, trace_id);
+  /* (0) Pick the initial state */
+  Expr_ptr init_sexp = StatSimulator_pick_init(simulator);
 
-    /* (0) Encode initial state */
-    Expr_ptr init_sexp =
-      TraceUtils_fetch_as_sexp(curr_trace, Trace_first_iter(curr_trace),
-                               TRACE_ITER_SF_VARS);
+  if (STAT_MONITOR(NULL) != monitor) {
+    StatMonitor_reset(monitor);
+    *verdict = STAT_NOT_VERIFIED;
+  }
 
-    init_sexp = MasterNormalizer_normalize_node(master_norm, init_sexp);
+  if (Nil != init_sexp) {
+    boolean found = false;
 
     /* No loopback in the first state */
     StatTrace_add_state(exec, init_sexp, false);
 
+    if (STAT_MONITOR(NULL) != monitor) {
+      *verdict = StatMonitor_step(monitor, init_sexp);
+      found = (STAT_NOT_VERIFIED != *verdict);
+    }
+
     while (! found) {
       Expr_ptr state_sexp = Nil;
-      boolean allow_loopback = true;
 
       /* (1.1) Launch single step simulation */
-      int status = Simulate_simulate(env, false, Random, 1, 0,
-                                     false, false, bdd_true(dd));
+      state_sexp = StatSimulator_step(simulator);
 
-      if (0 != status) {
+      if (Nil == state_sexp) {
         error_unreachable_code_msg("Error handling not yet implemented!!!\n");
       }
 
-      /* (1.2) Collect state sexp */
-      state_sexp =
-        TraceUtils_fetch_as_sexp(curr_trace,
-                                 Trace_last_iter(curr_trace),
-                                 TRACE_ITER_ALL_VARS);
-      state_sexp = MasterNormalizer_normalize_node(master_norm, state_sexp);
-
-      /* (1.3) Add state sexp to StatTrace */
+      /* (1.2) Add state sexp to StatTrace */
       StatTrace_add_state(exec, state_sexp, true);
 
-      /* case we find an already visited state */
-      if (StatTrace_is_generated(exec)) {
-        /* Check if we already verified this execution.
-           If so do not allow loopbacks
-        */
-        Expr_ptr new_key = self->gen_key(env, exec);
-
-        /* we allow the loopback if this execution have not been verified yet */
-        if (Nil != find_assoc(self->executions_assoc, new_key)) {
-          StatTrace_remove_loopback(exec);
-          StatTrace_add_state(exec, state_sexp, false);
-        }
-      }
-
-
       /* If this execution generated the loopback we can exit from the loop */
       if (StatTrace_is_generated(exec)) {
-        nusmv_assert(allow_loopback);
         found = true;
       }
+      /* (1.3) The rest of the execution may be irrelevant */
+      else if (STAT_MONITOR(NULL) != monitor) {
+        *verdict = StatMonitor_step(monitor, state_sexp);
+        found = (STAT_NOT_VERIFIED != *verdict);
+      }
     }
   }
   else {
@@ -361,65 +628,140 @@ static StatTrace_ptr
 }
 
 /*!
-  /brief Generates a key using states
+  \brief Generates the key of a lasso
+
+  The key is the list of the states of the execution, from the last
+  one to the initial one, preceded by the loopback. State expressions
+  are hashed, hence two executions have the same key (see
+  stat_problems_generator_key_neq) iff they visit the same states in
+  the same order and loop back to the same position.
 
-  Note: state order and variable order is important !!!
+  List nodes are not hashed, so that they can be freed together with
+  the table of the executions: the returned key belongs to the caller.
 */
 static Expr_ptr stat_problems_generator_gen_key(const NuSMVEnv_ptr env,
                                                 const StatTrace_ptr exec)
 {
-  ListIter_ptr iter;
+  const NodeMgr_ptr nodemgr =
+    NODE_MGR(NuSMVEnv_get_value(env, ENV_NODE_MGR));
   NodeList_ptr state_list;
-  Expr_ptr retval;
-
-  const MasterNormalizer_ptr master_norm =
-    MASTER_NORMALIZER(NuSMVEnv_get_value(env, ENV_NODE_NORMALIZER));
-  const ExprMgr_ptr exprs = EXPR_MGR(NuSMVEnv_get_value(env, ENV_EXPR_MANAGER));
+  ListIter_ptr iter;
+  node_ptr retval = Nil;
 
   nusmv_assert(StatTrace_is_generated(exec));
 
-  retval = ExprMgr_true(exprs);
-
   state_list = StatTrace_get_sexp_states(exec);
 
   NODE_LIST_FOREACH(state_list, iter) {
-    Expr_ptr state_sexp = NodeList_get_elem_at(state_list, iter);
-
-    retval = ExprMgr_and(exprs, state_sexp, retval);
+    retval = new_node(nodemgr, CONS,
+                      NodeList_get_elem_at(state_list, iter), retval);
   }
 
-  retval =
-    ExprMgr_and(exprs, ExprMgr_number(exprs, StatTrace_get_loopback(exec)), retval);
-  retval = MasterNormalizer_normalize_node(master_norm, retval);
+  return new_node(nodemgr, CONS,
+                  PTR_FROM_INT(node_ptr, StatTrace_get_loopback(exec)),
+                  retval);
+}
 
-  return retval;
+/*!
+  \brief Creates the table of the verified executions
+
+  Keys are compared element by element, see
+  stat_problems_generator_gen_key
+*/
+static hash_ptr stat_problems_generator_new_executions(void)
+{
+  return new_assoc_with_params(stat_problems_generator_key_neq,
+                               stat_problems_generator_key_hash);
 }
 
-static void deinit_executions(StatProblemsGenerator_ptr self)
+/*!
+  \brief Forgets the verified executions, and frees their keys
+
+*/
+static void
+  stat_problems_generator_clear_executions(StatProblemsGenerator_ptr self)
 {
-  Oiter oiter;
+  const NodeMgr_ptr nodemgr =
+    NODE_MGR(NuSMVEnv_get_value(STAT_ENV(self), ENV_NODE_MGR));
+
+  clear_assoc_and_free_entries_arg(self->executions_assoc,
+                                   stat_problems_generator_free_key,
+                                   (char*)nodemgr);
+}
 
-  OLIST_FOREACH(self->executions_list, oiter) {
-    StatTrace_ptr execution = STAT_TRACE(Oiter_element(oiter));
+/*!
+  \brief Returns 0 iff the two execution keys are equal
 
-    StatTrace_destroy(execution);
+*/
+static int stat_problems_generator_key_neq(const char* key1,
+                                           const char* key2)
+{
+  node_ptr iter1 = (node_ptr)key1;
+  node_ptr iter2 = (node_ptr)key2;
+
+  while (Nil != iter1 && Nil != iter2) {
+    if (car(iter1) != car(iter2)) return 1;
+
+    iter1 = cdr(iter1);
+    iter2 = cdr(iter2);
+  }
+
+  return iter1 != iter2;
+}
+
+/*!
+  \brief Hashes an execution key
+
+*/
+static int stat_problems_generator_key_hash(char* key, int size)
+{
+  unsigned long hash = 0;
+  node_ptr iter;
+
+  for (iter = (node_ptr)key; Nil != iter; iter = cdr(iter)) {
+    hash = hash * 31 + (unsigned long)car(iter);
   }
 
-  Olist_destroy(self->executions_list); self->executions_list = NULL;
+  return (int)(hash % size);
+}
+
+/*!
+  \brief Private service
+
+  Frees the list nodes of an execution key
+*/
+static assoc_retval stat_problems_generator_free_key(char* key, char* data,
+                                                     char* arg)
+{
+  free_list(NODE_MGR(arg), (node_ptr)key);
 
-  /* no need to destroy hash_ptr elements since they were destroyed before */
-  free_assoc(self->executions_assoc); self->executions_assoc = NULL;
+  return ASSOC_DELETE;
 }
 
-static Expr_ptr dummy_gen_key(const NuSMVEnv_ptr env,
-                              const StatTrace_ptr exec)
+static void deinit_executions(StatProblemsGenerator_ptr self)
 {
-  static int counter = 0;
-  const ExprMgr_ptr exprs = EXPR_MGR(NuSMVEnv_get_value(env, ENV_EXPR_MANAGER));
+  /* keys are owned by the table and results are integers */
+  if ((hash_ptr)NULL != self->executions_assoc) {
+    stat_problems_generator_clear_executions(self);
+    free_assoc(self->executions_assoc); self->executions_assoc = NULL;
+  }
+
+  /* the lasso checker is bound to the property */
+  if (STAT_LASSO_CHECKER(NULL) != self->lasso_checker) {
+    StatLassoChecker_destroy(self->lasso_checker);
+    self->lasso_checker = STAT_LASSO_CHECKER(NULL);
+  }
 
-  counter++;
+  /* and so is the tableau */
+  if (STAT_TABLEAU(NULL) != self->tableau) {
+    StatTableau_destroy(self->tableau);
+    self->tableau = STAT_TABLEAU(NULL);
+  }
 
-  /* TODO[AB]: using a counter is not a good idea */
-  return ExprMgr_number(exprs, counter);
+  /* and the monitor */
+  if (STAT_MONITOR(NULL) != self->monitor) {
+    StatMonitor_destroy(self->monitor);
+    self->monitor = STAT_MONITOR(NULL);
+  }
 }
 /**AutomaticEnd***************************************************************/
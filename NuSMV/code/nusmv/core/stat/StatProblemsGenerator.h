@@ -42,6 +42,7 @@
 #include "nusmv/core/stat/stat.h"
 #include "nusmv/core/stat/StatTrace.h"
 #include "nusmv/core/utils/Olist.h"
+#include "nusmv/core/utils/assoc.h"
 #include "nusmv/core/prop/Prop.h"
 
 /*!
@@ -63,7 +64,9 @@ typedef enum StatVerificationMethod_TAG {
   STAT_INVALID_VERIFICATION = 0,
   STAT_LTL_VERIFICATION,
   STAT_BMC_VERIFICATION_FIXED_K,
-  STAT_BMC_VERIFICATION_NON_FIXED_K
+  STAT_BMC_VERIFICATION_NON_FIXED_K,
+  STAT_LASSO_VERIFICATION,
+  STAT_BMC_VERIFICATION_INCREMENTAL
 } StatVerificationMethod;
 
 typedef StatVericationResult (*VerifFun)(const StatProblemsGenerator_ptr,
@@ -125,9 +128,131 @@ Prop_ptr StatProblemsGenerator_get_prop(const StatProblemsGenerator_ptr self);
 
 StatVericationResult StatProblemsGenerator_verify_step(StatProblemsGenerator_ptr self);
 
+/*!
+  \methodof StatProblemsGenerator
+  \brief Draws a random execution
+
+  The execution is not verified, and must be destroyed by the
+  caller. StatProblemsGenerator_verify_step is the same as this
+  followed by StatProblemsGenerator_verify_execution.
+*/
+StatTrace_ptr StatProblemsGenerator_simulate(StatProblemsGenerator_ptr self);
+
+/*!
+  \methodof StatProblemsGenerator
+  \brief Verifies the prepared property on the given execution
+
+  The execution may have been drawn by another generator. It is
+  memoized as the ones drawn by StatProblemsGenerator_verify_step.
+*/
+StatVericationResult
+  StatProblemsGenerator_verify_execution(StatProblemsGenerator_ptr self,
+                                         const StatTrace_ptr execution);
+
 void StatProblemsGenerator_set_verification_method(StatProblemsGenerator_ptr self,
                                                    StatVerificationMethod method);
 
 StatVerificationMethod
   StatProblemsGenerator_get_verification_method(const StatProblemsGenerator_ptr self);
+
+/*!
+  \methodof StatProblemsGenerator
+  \brief Enables or disables the memoization of the verified executions
+
+  Memoization is enabled by default, and the results are forgotten
+  whenever stat_cache_size of them are stored. When it is disabled
+  the generator does not store anything per execution, and every
+  generated execution is verified. The results stored so far are
+  discarded.
+
+  \sa StatProblemsGenerator_get_memoization
+*/
+void StatProblemsGenerator_set_memoization(StatProblemsGenerator_ptr self,
+                                           const boolean memoize);
+
+/*!
+  \methodof StatProblemsGenerator
+  \brief Tells whether the verified executions are memoized
+
+  \sa StatProblemsGenerator_set_memoization
+*/
+boolean
+  StatProblemsGenerator_get_memoization(const StatProblemsGenerator_ptr self);
+
+/*!
+  \methodof StatProblemsGenerator
+  \brief Enables or disables the monitoring of the property while the
+  executions are generated
+
+  When enabled, the property is progressed through each generated
+  state, and the generation stops as soon as the verdict does not
+  depend on the rest of the execution. Monitoring is disabled by
+  default, and is only supported by the BDD based generator.
+
+  \sa StatProblemsGenerator_get_monitoring
+*/
+void StatProblemsGenerator_set_monitoring(StatProblemsGenerator_ptr self,
+                                          const boolean monitoring);
+
+/*!
+  \methodof StatProblemsGenerator
+  \brief Tells whether the property is monitored while the executions
+  are generated
+
+  \sa StatProblemsGenerator_set_monitoring
+*/
+boolean
+  StatProblemsGenerator_get_monitoring(const StatProblemsGenerator_ptr self);
+
+/*!
+  \methodof StatProblemsGenerator
+  \brief Returns the number of executions generated for the property
+
+  Every generated execution is looked up among the ones already
+  verified for the same property.
+
+  \sa StatProblemsGenerator_get_hits_num
+*/
+long StatProblemsGenerator_get_lookups_num(const StatProblemsGenerator_ptr self);
+
+/*!
+  \methodof StatProblemsGenerator
+  \brief Returns the number of executions whose result was reused
+
+  These executions were not verified again, since the same lasso had
+  already been verified for the property.
+
+  \sa StatProblemsGenerator_get_lookups_num
+*/
+long StatProblemsGenerator_get_hits_num(const StatProblemsGenerator_ptr self);
+
+/*!
+  \methodof StatProblemsGenerator
+  \brief Returns the executions verified for the prepared property
+
+  The table maps the key of every verified execution to its
+  StatVericationResult. A key is the list of the states of the lasso,
+  from the last one to the first one, consed to the loopback index.
+  The table belongs to self and must not be modified.
+
+  \sa StatProblemsGenerator_memoize
+*/
+hash_ptr
+  StatProblemsGenerator_get_memoized(const StatProblemsGenerator_ptr self);
+
+/*!
+  \methodof StatProblemsGenerator
+  \brief Stores the result of the execution with the given key
+
+  Used to restore the results of a previous run. The key is built
+  with new_node, as by the key generator, and is taken over by self:
+  it is freed if nothing is stored, i.e. if memoization is disabled,
+  the execution is already known or stat_cache_size results are
+  already stored.
+
+  \sa StatProblemsGenerator_get_memoized
+*/
+void StatProblemsGenerator_memoize(StatProblemsGenerator_ptr self,
+                                   const Expr_ptr key,
+                                   const StatVericationResult res);
 #endif /* __NUSMV_CORE_STAT_STAT_PROBLEM_GENERATOR_H__ */
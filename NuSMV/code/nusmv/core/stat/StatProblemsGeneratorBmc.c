@@ -39,11 +39,11 @@
 #include "nusmv/core/stat/statInt.h"
 
 /* Used to perform random simulation */
-#include "nusmv/core/simulate/simulate.h"
-
-/* Trace are required to collect steps from the simulation */
-#include "nusmv/core/trace/Trace.h"
-#include "nusmv/core/trace/pkg_trace.h"
+#include "nusmv/core/stat/StatSimulator.h"
+#include "nusmv/core/stat/StatBitSimulator.h"
+#include "nusmv/core/fsm/be/BeFsm.h"
+#include "nusmv/core/utils/ErrorMgr.h"
+#include "nusmv/core/utils/Logger.h"
 
 /* used for bmc verification */
 #include "nusmv/core/bmc/bmcDump.h"
@@ -78,13 +78,25 @@
 static StatTrace_ptr
   stat_problems_generator_bmc_simulate(StatProblemsGenerator_ptr self);
 
+static StatTrace_ptr
+  stat_problems_generator_bmc_simulate_bits(StatProblemsGeneratorBmc_ptr self);
+
+static void
+  stat_problems_generator_bmc_clear_pool(StatProblemsGeneratorBmc_ptr self);
+
 static StatVericationResult
   stat_problems_generator_bmc_verify_execution(const StatProblemsGenerator_ptr gen,
                                                const StatTrace_ptr execution);
 
-static Expr_ptr dummy_gen_key(const NuSMVEnv_ptr env,
-                              const StatTrace_ptr exec);
-static inline int get_opt_loop(const StatProblemsGeneratorBmc_ptr self);
+static StatVericationResult
+  stat_problems_generator_bmc_verify_incremental(const StatProblemsGeneratorBmc_ptr self,
+                                                 const StatTrace_ptr execution);
+
+static inline boolean
+  stat_problems_generator_bmc_stops_at_loops(const StatProblemsGeneratorBmc_ptr self);
+
+static inline int get_opt_loop(const StatTrace_ptr execution);
+static inline int get_opt_length(const StatTrace_ptr execution);
 static inline int get_opt_k(const StatProblemsGeneratorBmc_ptr self);
 /*---------------------------------------------------------------------------*/
 /* Definition of exported functions                                          */
@@ -115,6 +127,15 @@ int StatProblemsGeneratorBmc_get_k(const StatProblemsGeneratorBmc_ptr self)
   return get_opt_k(self);
 }
 
+void StatProblemsGeneratorBmc_set_bit_simulation(StatProblemsGeneratorBmc_ptr self,
+                                                 const boolean enabled)
+{
+  STAT_PROBLEMS_GENERATOR_CHECK_INSTANCE(self);
+
+  if (! enabled) stat_problems_generator_bmc_clear_pool(self);
+  self->bit_simulation = enabled;
+}
+
 /*---------------------------------------------------------------------------*/
 /* Definition of internal functions                                          */
 /*---------------------------------------------------------------------------*/
@@ -127,6 +148,18 @@ void stat_problems_generator_bmc_init(StatProblemsGeneratorBmc_ptr self,
   StatProblemsGenerator_set_verification_method(STAT_PROBLEMS_GENERATOR(self),
                                                 STAT_BMC_VERIFICATION_FIXED_K);
 
+  self->session = (StatBmcSession_ptr)NULL;
+
+  self->bit_simulation = false;
+  self->bit_simulator = STAT_BIT_SIMULATOR(NULL);
+  self->pool_num = 0;
+  self->pool_k = 0;
+  self->pool_lassos = false;
+
+  /* executions have a fixed length, and their verdict is the one of
+     the bounded problem */
+  STAT_PROBLEMS_GENERATOR(self)->monitoring = false;
+
   /* use fixed simulation */
   OVERRIDE(StatProblemsGenerator, simulate) =
     stat_problems_generator_bmc_simulate;
@@ -134,13 +167,22 @@ void stat_problems_generator_bmc_init(StatProblemsGeneratorBmc_ptr self,
   /* use bmc problem generator */
   OVERRIDE(StatProblemsGenerator, verify_execution) =
     stat_problems_generator_bmc_verify_execution;
-
-  /* this function returns a different value on each execution */
-  OVERRIDE(StatProblemsGenerator, gen_key) = dummy_gen_key;
 }
 
 void stat_problems_generator_bmc_deinit(StatProblemsGeneratorBmc_ptr self)
 {
+  if ((StatBmcSession_ptr)NULL != self->session) {
+    StatBmcSession_destroy(self->session);
+    self->session = (StatBmcSession_ptr)NULL;
+  }
+
+  stat_problems_generator_bmc_clear_pool(self);
+
+  if (STAT_BIT_SIMULATOR(NULL) != self->bit_simulator) {
+    StatBitSimulator_destroy(self->bit_simulator);
+    self->bit_simulator = STAT_BIT_SIMULATOR(NULL);
+  }
+
   stat_problems_generator_deinit(STAT_PROBLEMS_GENERATOR(self));
 }
 
@@ -151,46 +193,59 @@ void stat_problems_generator_bmc_deinit(StatProblemsGeneratorBmc_ptr self)
 static StatTrace_ptr
   stat_problems_generator_bmc_simulate(StatProblemsGenerator_ptr self)
 {
-  const NuSMVEnv_ptr env = EnvObject_get_environment(ENV_OBJECT(self));
-
-  const BddEnc_ptr enc = BDD_ENC(NuSMVEnv_get_value(env, ENV_BDD_ENCODER));
-  const TraceMgr_ptr tm =
-    TRACE_MGR(NuSMVEnv_get_value(env, ENV_TRACE_MGR));
-
-  DDMgr_ptr dd = BddEnc_get_dd_manager(enc);
+  const StatSimulator_ptr simulator =
+    stat_problems_generator_get_simulator(self);
 
   StatProblemsGeneratorBmc_ptr self_bmc = STAT_PROBLEMS_GENERATOR_BMC(self);
-  StatTrace_ptr exec = StatTrace_create();
+  const boolean lassos = stat_problems_generator_bmc_stops_at_loops(self_bmc);
+  StatTrace_ptr exec;
+  Expr_ptr state_sexp;
+
+  if (self_bmc->bit_simulation) {
+    const NuSMVEnv_ptr env = EnvObject_get_environment(ENV_OBJECT(self));
+    const OptsHandler_ptr opts =
+      OPTS_HANDLER(NuSMVEnv_get_value(env, ENV_OPTS_HANDLER));
+
+    exec = stat_problems_generator_bmc_simulate_bits(self_bmc);
+    if (STAT_TRACE(NULL) != exec) return exec;
+
+    if (opt_verbose_level_gt(opts, 0)) {
+      Logger_log(LOGGER(NuSMVEnv_get_value(env, ENV_LOGGER)),
+                 "Statistical model checking: no bit-parallel execution "
+                 "available, drawing one with the BDD simulator\n");
+    }
+  }
+
+  exec = StatTrace_create();
 
   /* pick the initial state */
-  if (0 == Simulate_pick_state(env, TRACE_LABEL_INVALID, Random,
-                               0, false, NULL)) {
-    TraceIter trace_iter;
+  state_sexp = StatSimulator_pick_init(simulator);
+
+  if (Nil != state_sexp) {
+    int i;
 
-    const int trace_id = TraceMgr_get_current_trace_number(tm);
-    const Trace_ptr curr_trace = TraceMgr_get_trace_at_index(tm, trace_id);
+    /* when allowed, the simulation stops at the first repeated state,
+       which closes a lasso */
+    StatTrace_add_state(exec, state_sexp, lassos);
 
     /* launch random simulation of length k */
-    int status = Simulate_simulate(env, false, Random, get_opt_k(self_bmc),
-                                   0, false, false, bdd_true(dd));
+    for (i = 0; i < get_opt_k(self_bmc) && ! StatTrace_is_generated(exec);
+         i++) {
+      state_sexp = StatSimulator_step(simulator);
 
-    if (0 != status) {
-      error_unreachable_code_msg("Error handling not yet implemented!!!\n");
-    }
+      if (Nil == state_sexp) {
+        error_unreachable_code_msg("Error handling not yet implemented!!!\n");
+      }
 
-    TRACE_FOREACH(curr_trace, trace_iter) {
-      Expr_ptr state_sexp = TraceUtils_fetch_as_sexp(curr_trace, trace_iter,
-                                                     TRACE_ITER_ALL_VARS);
-      /* loopback is not allowed:
-         We force it at the end of the states computation
-      */
-      StatTrace_add_state(exec, state_sexp, false);
+      StatTrace_add_state(exec, state_sexp, lassos);
     }
 
-    /* k steps + initial state */
-    nusmv_assert(StatTrace_get_length(exec) == get_opt_k(self_bmc) + 1);
+    if (! StatTrace_is_generated(exec)) {
+      /* k steps + initial state, without loopback */
+      nusmv_assert(StatTrace_get_length(exec) == get_opt_k(self_bmc) + 1);
 
-    StatTrace_force_loopback(exec, get_opt_k(self_bmc));
+      StatTrace_force_loopback(exec, 0);
+    }
 
     nusmv_assert(StatTrace_is_generated(exec));
   }
@@ -201,6 +256,90 @@ static StatTrace_ptr
   return exec;
 }
 
+/*!
+  \brief Returns the next execution drawn by the bit-parallel simulator
+
+  A new block is drawn when the executions of the last one are over.
+  The simulator is built at the first call: if the boolean model is
+  not available or not supported, bit-parallel simulation is
+  disabled.
+
+  Lanes that cannot satisfy the constraints of the model are dropped
+  by the simulator, and keeping the other ones would bias the samples
+  toward the paths satisfying them easily. Hence as soon as a block
+  loses some lane, the block is discarded and bit-parallel simulation
+  is disabled, with a warning. NULL is returned when no execution
+  could be drawn, and the caller falls back to the StatSimulator.
+*/
+static StatTrace_ptr
+  stat_problems_generator_bmc_simulate_bits(StatProblemsGeneratorBmc_ptr self)
+{
+  const NuSMVEnv_ptr env = EnvObject_get_environment(ENV_OBJECT(self));
+  const int k = get_opt_k(self);
+  const boolean lassos = stat_problems_generator_bmc_stops_at_loops(self);
+
+  if (STAT_BIT_SIMULATOR(NULL) == self->bit_simulator) {
+    const ErrorMgr_ptr errmgr =
+      ERROR_MGR(NuSMVEnv_get_value(env, ENV_ERROR_MANAGER));
+
+    if (NuSMVEnv_has_value(env, ENV_BE_FSM)) {
+      self->bit_simulator =
+        StatBitSimulator_create(env,
+                                BE_FSM(NuSMVEnv_get_value(env, ENV_BE_FSM)));
+    }
+
+    if (STAT_BIT_SIMULATOR(NULL) == self->bit_simulator ||
+        ! StatBitSimulator_is_supported(self->bit_simulator)) {
+      ErrorMgr_warning_msg(errmgr, "Bit-parallel simulation is not "
+                           "available for this model, executions are "
+                           "drawn one at a time\n");
+      self->bit_simulation = false;
+      return STAT_TRACE(NULL);
+    }
+  }
+
+  if (self->pool_k != k || self->pool_lassos != lassos) {
+    stat_problems_generator_bmc_clear_pool(self);
+  }
+
+  if (0 == self->pool_num) {
+    self->pool_num =
+      StatBitSimulator_simulate(self->bit_simulator, k, lassos, self->pool);
+    self->pool_k = k;
+    self->pool_lassos = lassos;
+
+    if (STAT_BIT_SIMULATOR_PATHS > self->pool_num) {
+      const ErrorMgr_ptr errmgr =
+        ERROR_MGR(NuSMVEnv_get_value(env, ENV_ERROR_MANAGER));
+
+      ErrorMgr_warning_msg(errmgr, "%d of %d bit-parallel executions could "
+                           "not satisfy the constraints of the model and "
+                           "were dropped. To avoid biasing the samples, "
+                           "executions are drawn one at a time\n",
+                           STAT_BIT_SIMULATOR_PATHS - self->pool_num,
+                           STAT_BIT_SIMULATOR_PATHS);
+      stat_problems_generator_bmc_clear_pool(self);
+      self->bit_simulation = false;
+    }
+  }
+
+  if (0 == self->pool_num) return STAT_TRACE(NULL);
+
+  return self->pool[--self->pool_num];
+}
+
+/*!
+  \brief Destroys the executions drawn and not returned yet
+
+*/
+static void
+  stat_problems_generator_bmc_clear_pool(StatProblemsGeneratorBmc_ptr self)
+{
+  while (0 < self->pool_num) {
+    StatTrace_destroy(self->pool[--self->pool_num]);
+  }
+}
+
 static StatVericationResult
   stat_problems_generator_bmc_verify_execution(const StatProblemsGenerator_ptr gen,
                                                const StatTrace_ptr execution)
@@ -208,27 +347,49 @@ static StatVericationResult
   Prop_ptr gen_prop;
   StatVericationResult retval;
   int res;
-  int relative_loop;
 
   const NuSMVEnv_ptr env = EnvObject_get_environment(ENV_OBJECT(gen));
   const ExprMgr_ptr exprs = EXPR_MGR(NuSMVEnv_get_value(env, ENV_EXPR_MANAGER));
   const NodeMgr_ptr nodemgr = NODE_MGR(NuSMVEnv_get_value(env, ENV_NODE_MGR));
+  const StatProfiler_ptr profiler = Stat_get_profiler(env);
 
   const Prop_ptr prop = StatProblemsGenerator_get_prop(gen);
   const StatProblemsGeneratorBmc_ptr self = STAT_PROBLEMS_GENERATOR_BMC(gen);
 
-  /* k steps + initial state */
-  nusmv_assert(StatTrace_get_length(execution) == get_opt_k(self) + 1);
+  if (STAT_BMC_VERIFICATION_INCREMENTAL == gen->verification_method) {
+    /* k steps + initial state */
+    nusmv_assert(StatTrace_get_length(execution) == get_opt_k(self) + 1);
+
+    return stat_problems_generator_bmc_verify_incremental(self, execution);
+  }
+
+  if (STAT_PROFILER(NULL) != profiler) {
+    StatProfiler_start(profiler, STAT_STAGE_PROBLEM);
+  }
 
   gen_prop = StatSexpProblem_gen_bmc_problem(env, execution, prop);
 
+  if (STAT_PROFILER(NULL) != profiler) {
+    StatProfiler_stop(profiler, STAT_STAGE_PROBLEM);
+  }
+
   nusmv_assert(STAT_BMC_VERIFICATION_FIXED_K == gen->verification_method);
 
   retval = STAT_NOT_VERIFIED;
 
-  /* Call BMC internal functions... */
-  res = Bmc_GenSolveLtl(env, gen_prop, get_opt_k(self), get_opt_loop(self),
-                        true, true, BMC_DUMP_NONE, NULL);
+  if (STAT_PROFILER(NULL) != profiler) {
+    StatProfiler_start(profiler, STAT_STAGE_MODEL_CHECKING);
+  }
+
+  /* Call BMC internal functions, only at the length of the execution:
+     the constraints on its states have no model at shorter lengths */
+  res = Bmc_GenSolveLtl(env, gen_prop, get_opt_length(execution),
+                        get_opt_loop(execution),
+                        false, true, BMC_DUMP_NONE, NULL);
+
+  if (STAT_PROFILER(NULL) != profiler) {
+    StatProfiler_stop(profiler, STAT_STAGE_MODEL_CHECKING);
+  }
 
   if (0 != res) {
     retval = STAT_INTERNAL_ERROR;
@@ -245,16 +406,78 @@ static StatVericationResult
   return retval;
 }
 
-static inline int get_opt_loop(const StatProblemsGeneratorBmc_ptr self)
+/*!
+  \brief Verifies the execution with the incremental solver
+
+  The session is built at the first execution and kept as long as
+  the property and the bound do not change, so the problem is
+  converted and loaded into the solver only once per property.
+*/
+static StatVericationResult
+  stat_problems_generator_bmc_verify_incremental(const StatProblemsGeneratorBmc_ptr self,
+                                                 const StatTrace_ptr execution)
 {
   const NuSMVEnv_ptr env = EnvObject_get_environment(ENV_OBJECT(self));
-  const OptsHandler_ptr opts =
-    OPTS_HANDLER(NuSMVEnv_get_value(env, ENV_OPTS_HANDLER));
+  const Prop_ptr prop =
+    StatProblemsGenerator_get_prop(STAT_PROBLEMS_GENERATOR(self));
+
+  if ((StatBmcSession_ptr)NULL != self->session &&
+      (StatBmcSession_get_prop(self->session) != prop ||
+       StatBmcSession_get_k(self->session) != get_opt_k(self))) {
+    StatBmcSession_destroy(self->session);
+    self->session = (StatBmcSession_ptr)NULL;
+  }
 
-  const char* pb_loop = get_bmc_pb_loop(opts);
+  if ((StatBmcSession_ptr)NULL == self->session) {
+    self->session = StatBmcSession_create(env, prop, get_opt_k(self));
+  }
 
-  return Bmc_Utils_GetNoLoopback();
-  // return Bmc_Utils_ConvertLoopFromString(pb_loop, NULL);
+  return StatBmcSession_check(self->session, execution);
+}
+
+/*!
+  \brief Tells whether the executions stop at their first repeated state
+
+  Only the fixed k verification builds a problem per execution, at
+  its own length. The incremental one needs executions of k steps.
+*/
+static inline boolean
+  stat_problems_generator_bmc_stops_at_loops(const StatProblemsGeneratorBmc_ptr self)
+{
+  return STAT_BMC_VERIFICATION_FIXED_K ==
+    STAT_PROBLEMS_GENERATOR(self)->verification_method;
+}
+
+/*!
+  \brief Returns the loopback of the BMC problem of execution
+
+  The loopback is determined by the execution: a lasso loops back to
+  its repeated state, while an execution that did not repeat any
+  state has no loopback, since its states are all different. The
+  bmc_pb_loop option is thus not used.
+*/
+static inline int get_opt_loop(const StatTrace_ptr execution)
+{
+  const int loopback = StatTrace_get_loopback(execution);
+
+  if (0 == loopback) return Bmc_Utils_GetNoLoopback();
+
+  /* loopbacks of StatTrace start from 1 */
+  return loopback - 1;
+}
+
+/*!
+  \brief Returns the bound of the BMC problem of execution
+
+  A lasso of n states is a path of length n, whose last state is the
+  repeated one. Otherwise the last state is the last one of the
+  execution.
+*/
+static inline int get_opt_length(const StatTrace_ptr execution)
+{
+  const int length = StatTrace_get_length(execution);
+
+  return (0 == StatTrace_get_loopback(execution)) ? length - 1 : length;
 }
 
 static inline int get_opt_k(const StatProblemsGeneratorBmc_ptr self)
@@ -266,17 +489,6 @@ static inline int get_opt_k(const StatProblemsGeneratorBmc_ptr self)
   return get_bmc_pb_length(opts);
 }
 
-static Expr_ptr dummy_gen_key(const NuSMVEnv_ptr env,
-                              const StatTrace_ptr exec)
-{
-  static int counter = 0;
-  const ExprMgr_ptr exprs = EXPR_MGR(NuSMVEnv_get_value(env, ENV_EXPR_MANAGER));
-
-  counter++;
-
-  /* TODO[AB]: using a counter is not a good idea */
-  return ExprMgr_number(exprs, counter);
-}
 /**AutomaticEnd***************************************************************/
 
 
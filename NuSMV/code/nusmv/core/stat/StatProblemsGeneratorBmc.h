@@ -95,4 +95,19 @@ StatProblemsGeneratorBmc_ptr StatProblemsGeneratorBmc_create(const NuSMVEnv_ptr
   \sa StatProblemsGeneratorBmc_create
 */
 void StatProblemsGeneratorBmc_destroy(StatProblemsGeneratorBmc_ptr self);
+
+/*!
+  \methodof StatProblemsGeneratorBmc
+  \brief Enables or disables the bit-parallel simulation
+
+  Disabled by default. When enabled the executions are drawn in
+  blocks by a StatBitSimulator on the boolean model, and one at a
+  time by the StatSimulator when the model is not supported. Notice
+  that the two simulators do not draw the executions with the same
+  distribution.
+
+  \sa StatBitSimulator
+*/
+void StatProblemsGeneratorBmc_set_bit_simulation(StatProblemsGeneratorBmc_ptr self,
+                                                 const boolean enabled);
 #endif /* __NUSMV_CORE_STAT_STAT_PROBLEM_GENERATOR_BMC_H__ */
@@ -45,6 +45,8 @@
 /* Include used types */
 #include "nusmv/core/utils/Olist.h"
 #include "nusmv/core/prop/Prop.h"
+#include "nusmv/core/stat/StatBmcSession.h"
+#include "nusmv/core/stat/StatBitSimulator.h"
 
 /* include public header */
 #include "nusmv/core/stat/StatProblemsGeneratorBmc.h"
@@ -57,6 +59,18 @@ typedef struct StatProblemsGeneratorBmc_TAG
   /* -------------------------------------------------- */
   /*                  Private members                   */
   /* -------------------------------------------------- */
+  /* incremental solver of the current property, NULL if not used */
+  StatBmcSession_ptr session;
+
+  /* bit-parallel simulation: the simulator, NULL if not built yet,
+     and the executions of the last block not returned yet, drawn
+     with length pool_k, stopping at loops if pool_lassos */
+  boolean bit_simulation;
+  StatBitSimulator_ptr bit_simulator;
+  StatTrace_ptr pool[STAT_BIT_SIMULATOR_PATHS];
+  int pool_num;
+  int pool_k;
+  boolean pool_lassos;
 
   /* -------------------------------------------------- */
   /*                  Virtual methods                   */
@@ -45,6 +45,10 @@
 /* Include used types */
 #include "nusmv/core/utils/Olist.h"
 #include "nusmv/core/prop/Prop.h"
+#include "nusmv/core/stat/StatLassoChecker.h"
+#include "nusmv/core/stat/StatTableau.h"
+#include "nusmv/core/stat/StatMonitor.h"
+#include "nusmv/core/stat/StatSimulator.h"
 
 /* include public header */
 #include "nusmv/core/stat/StatProblemsGenerator.h"
@@ -57,10 +61,18 @@ typedef struct StatProblemsGenerator_TAG
   /* -------------------------------------------------- */
   /*                  Private members                   */
   /* -------------------------------------------------- */
-  /* exections hash maps: node_ptr -> StatTrace_ptr */
+  /* verified executions: key -> StatVericationResult. Executions
+     are destroyed once verified, only their keys are kept */
   hash_ptr executions_assoc;
-  /* list containing the executions Olist<StatTrace_ptr> */
-  Olist_ptr executions_list;
+
+  /* if false executions_assoc is not used, and every execution is
+     verified */
+  boolean memoize;
+
+  /* executions generated and found in executions_assoc since the
+     property was prepared */
+  long lookups;
+  long hits;
 
   /* Property to be verified */
   Prop_ptr prop;
@@ -71,6 +83,22 @@ typedef struct StatProblemsGenerator_TAG
   /* technique used to perform the executions verification */
   StatVerificationMethod verification_method;
 
+  /* direct evaluator of prop on the executions, created on demand */
+  StatLassoChecker_ptr lasso_checker;
+
+  /* tableau of prop shared by all the executions, created on demand */
+  StatTableau_ptr tableau;
+
+  /* random executions generator, created on demand */
+  StatSimulator_ptr simulator;
+
+  /* if true prop is monitored while the executions are generated,
+     and the generation stops as soon as the verdict is known */
+  boolean monitoring;
+
+  /* online evaluator of prop, created on demand */
+  StatMonitor_ptr monitor;
+
   /* -------------------------------------------------- */
   /*                  Virtual methods                   */
   /* -------------------------------------------------- */
@@ -95,5 +123,12 @@ void stat_problems_generator_deinit(StatProblemsGenerator_ptr self);
 
 StatVericationResult
   stat_problems_generator_verify_step(const StatProblemsGenerator_ptr self);
+
+StatVericationResult
+  stat_problems_generator_check(const StatProblemsGenerator_ptr self,
+                                const StatTrace_ptr new_exec);
+
+StatSimulator_ptr
+  stat_problems_generator_get_simulator(const StatProblemsGenerator_ptr self);
 #endif /* __NUSMV_CORE_STAT_STAT_PROBLEM_GENERATOR_PRIVATE_H__ */
 
@@ -0,0 +1,414 @@
+/* ---------------------------------------------------------------------------
+
+
+  This file is part of the ``stat'' package of NuSMV version 2.
+  Copyright (C) 2012 by FBK-irst.
+
+  NuSMV version 2 is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  NuSMV version 2 is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA.
+
+  For more information on NuSMV see <http://nusmv.fbk.eu>
+  or email to <nusmv-users@fbk.eu>.
+  Please report bugs to <nusmv-users@fbk.eu>.
+
+  To contact the NuSMV development board, email to <nusmv@fbk.eu>.
+
+-----------------------------------------------------------------------------*/
+
+/*!
+  \author Alberto Bombardelli
+  \brief Implementation of class 'StatProfiler'
+
+  Stage times are CPU times measured by TimerBench, while the
+  throughput is computed on the wall clock, which also accounts for
+  the time spent by the workers.
+
+*/
+
+#if HAVE_CONFIG_H
+# include "nusmv-config.h"
+#endif
+
+#include "nusmv/core/stat/StatProfiler.h"
+#include "nusmv/core/stat/stat.h"
+
+#include "nusmv/core/utils/EnvObject.h"
+#include "nusmv/core/utils/EnvObject_private.h"
+#include "nusmv/core/utils/TimerBench.h"
+#include "nusmv/core/utils/Logger.h"
+#include "nusmv/core/opt/opt.h"
+#include "nusmv/core/node/NodeMgr.h"
+#include "nusmv/core/dd/dd.h"
+
+#if NUSMV_HAVE_SYS_TIME_H
+# include <sys/time.h>
+#else
+# include <time.h>
+#endif
+
+/*---------------------------------------------------------------------------*/
+/* Constant declarations                                                     */
+/*---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*/
+/* Structure declarations                                                    */
+/*---------------------------------------------------------------------------*/
+
+typedef struct StatProfiler_TAG
+{
+  /* this MUST stay on the top */
+  INHERITS_FROM(EnvObject);
+
+  /* -------------------------------------------------- */
+  /*                  Private members                   */
+  /* -------------------------------------------------- */
+  TimerBench_ptr timers[STAT_STAGE_NUM];
+
+  long samples;
+  long executions;
+  long executions_length;
+  long lookups;
+  long hits;
+
+  /* wall clock, in seconds */
+  double start_time;
+  double last_report;
+
+  /* memory of the managers when profiling started */
+  size_t start_node_mem;
+  int start_dd_nodes;
+} StatProfiler;
+
+/*---------------------------------------------------------------------------*/
+/* Type declarations                                                         */
+/*---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*/
+/* Variable declarations                                                     */
+/*---------------------------------------------------------------------------*/
+
+/* names of the stages, as printed in the JSON summary */
+static const char* stat_stage_names[STAT_STAGE_NUM] = {
+  "simulation",
+  "conversion",
+  "memoization",
+  "verification",
+  "layer",
+  "problem",
+  "model_checking"
+};
+
+/* parent of every stage, STAT_STAGE_NUM for top level stages */
+static const StatStage stat_stage_parents[STAT_STAGE_NUM] = {
+  STAT_STAGE_NUM,
+  STAT_STAGE_SIMULATION,
+  STAT_STAGE_NUM,
+  STAT_STAGE_NUM,
+  STAT_STAGE_VERIFICATION,
+  STAT_STAGE_VERIFICATION,
+  STAT_STAGE_VERIFICATION
+};
+
+/*---------------------------------------------------------------------------*/
+/* Macro declarations                                                        */
+/*---------------------------------------------------------------------------*/
+
+
+/**AutomaticStart*************************************************************/
+
+/*---------------------------------------------------------------------------*/
+/* Static function prototypes                                                */
+/*---------------------------------------------------------------------------*/
+
+static void stat_profiler_init(StatProfiler_ptr self,
+                               const NuSMVEnv_ptr env);
+
+static void stat_profiler_deinit(StatProfiler_ptr self);
+
+static double stat_profiler_get_wall_time(void);
+
+static size_t stat_profiler_get_node_mem(const StatProfiler_ptr self);
+
+static int stat_profiler_get_dd_nodes(const StatProfiler_ptr self);
+
+static void stat_profiler_print_stages(const StatProfiler_ptr self,
+                                       FILE* out,
+                                       const StatStage parent,
+                                       const int indent);
+
+/*---------------------------------------------------------------------------*/
+/* Definition of exported functions                                          */
+/*---------------------------------------------------------------------------*/
+
+StatProfiler_ptr StatProfiler_create(const NuSMVEnv_ptr env)
+{
+  StatProfiler_ptr self = ALLOC(StatProfiler, 1);
+  STAT_PROFILER_CHECK_INSTANCE(self);
+
+  stat_profiler_init(self, env);
+  return self;
+}
+
+void StatProfiler_destroy(StatProfiler_ptr self)
+{
+  STAT_PROFILER_CHECK_INSTANCE(self);
+
+  stat_profiler_deinit(self);
+
+  FREE(self);
+}
+
+void StatProfiler_start(StatProfiler_ptr self, const StatStage stage)
+{
+  STAT_PROFILER_CHECK_INSTANCE(self);
+  nusmv_assert(stage < STAT_STAGE_NUM);
+
+  /* an error may have interrupted the stage */
+  if (TimerBench_is_running(self->timers[stage])) {
+    TimerBench_stop(self->timers[stage]);
+  }
+
+  TimerBench_start(self->timers[stage]);
+}
+
+void StatProfiler_stop(StatProfiler_ptr self, const StatStage stage)
+{
+  STAT_PROFILER_CHECK_INSTANCE(self);
+  nusmv_assert(stage < STAT_STAGE_NUM);
+
+  TimerBench_stop(self->timers[stage]);
+}
+
+void StatProfiler_add_execution(StatProfiler_ptr self, const int length)
+{
+  STAT_PROFILER_CHECK_INSTANCE(self);
+
+  self->executions++;
+  self->executions_length += length;
+}
+
+void StatProfiler_add_lookup(StatProfiler_ptr self, const boolean hit)
+{
+  STAT_PROFILER_CHECK_INSTANCE(self);
+
+  self->lookups++;
+  if (hit) self->hits++;
+}
+
+void StatProfiler_add_sample(StatProfiler_ptr self)
+{
+  const NuSMVEnv_ptr env = ENV_OBJECT(self)->environment;
+  const OptsHandler_ptr opts =
+    OPTS_HANDLER(NuSMVEnv_get_value(env, ENV_OPTS_HANDLER));
+  double now;
+
+  STAT_PROFILER_CHECK_INSTANCE(self);
+
+  self->samples++;
+
+  if (!opt_verbose_level_gt(opts, 0)) return;
+
+  now = stat_profiler_get_wall_time();
+  if (now - self->last_report >= STAT_PROFILER_REPORT_PERIOD) {
+    const Logger_ptr logger = LOGGER(NuSMVEnv_get_value(env, ENV_LOGGER));
+    const double elapsed = now - self->start_time;
+
+    Logger_log(logger, "Profiler: %ld samples in %.1fs (%.2f samples/s)",
+               self->samples, elapsed,
+               (elapsed > 0) ? (double) self->samples / elapsed : 0.0);
+    if (0 < self->lookups) {
+      Logger_log(logger, ", memoization hit rate %.2f",
+                 (double) self->hits / (double) self->lookups);
+    }
+    Logger_log(logger, "\n");
+
+    self->last_report = now;
+  }
+}
+
+void StatProfiler_print_json(const StatProfiler_ptr self, FILE* out)
+{
+  const double elapsed = stat_profiler_get_wall_time() - self->start_time;
+  const long samples = (0 < self->samples) ? self->samples : 1;
+  const size_t node_mem = stat_profiler_get_node_mem(self);
+  const int dd_nodes = stat_profiler_get_dd_nodes(self);
+
+  STAT_PROFILER_CHECK_INSTANCE(self);
+
+  fprintf(out, "{\n");
+  fprintf(out, "  \"samples\": %ld,\n", self->samples);
+  fprintf(out, "  \"wall_time_s\": %.3f,\n", elapsed);
+  fprintf(out, "  \"samples_per_s\": %.3f,\n",
+          (elapsed > 0) ? (double) self->samples / elapsed : 0.0);
+  fprintf(out, "  \"executions\": %ld,\n", self->executions);
+  fprintf(out, "  \"avg_execution_length\": %.3f,\n",
+          (0 < self->executions) ?
+          (double) self->executions_length / (double) self->executions : 0.0);
+  fprintf(out, "  \"memoization\": {\n");
+  fprintf(out, "    \"lookups\": %ld,\n", self->lookups);
+  fprintf(out, "    \"hits\": %ld,\n", self->hits);
+  fprintf(out, "    \"hit_rate\": %.3f\n",
+          (0 < self->lookups) ?
+          (double) self->hits / (double) self->lookups : 0.0);
+  fprintf(out, "  },\n");
+  fprintf(out, "  \"stages\": ");
+  stat_profiler_print_stages(self, out, STAT_STAGE_NUM, 2);
+  fprintf(out, ",\n");
+  fprintf(out, "  \"memory\": {\n");
+  fprintf(out, "    \"node_bytes\": %" PRIuPTR ",\n", node_mem);
+  fprintf(out, "    \"node_bytes_per_sample\": %.3f,\n",
+          (double) (node_mem - self->start_node_mem) / (double) samples);
+  fprintf(out, "    \"bdd_nodes\": %d,\n", dd_nodes);
+  fprintf(out, "    \"bdd_nodes_per_sample\": %.3f\n",
+          (double) (dd_nodes - self->start_dd_nodes) / (double) samples);
+  fprintf(out, "  }\n");
+  fprintf(out, "}\n");
+}
+
+/*---------------------------------------------------------------------------*/
+/* Definition of internal functions                                          */
+/*---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*/
+/* Definition of static functions                                            */
+/*---------------------------------------------------------------------------*/
+
+/*!
+  \brief The StatProfiler class private initializer
+
+  \sa StatProfiler_create
+*/
+static void stat_profiler_init(StatProfiler_ptr self,
+                               const NuSMVEnv_ptr env)
+{
+  int i;
+
+  /* base class initialization */
+  env_object_init(ENV_OBJECT(self), env);
+
+  /* members initialization */
+  for (i = 0; i < STAT_STAGE_NUM; ++i) {
+    self->timers[i] = TimerBench_create(stat_stage_names[i]);
+  }
+
+  self->samples = 0;
+  self->executions = 0;
+  self->executions_length = 0;
+  self->lookups = 0;
+  self->hits = 0;
+
+  self->start_time = stat_profiler_get_wall_time();
+  self->last_report = self->start_time;
+
+  self->start_node_mem = stat_profiler_get_node_mem(self);
+  self->start_dd_nodes = stat_profiler_get_dd_nodes(self);
+}
+
+/*!
+  \brief The StatProfiler class private deinitializer
+
+  \sa StatProfiler_destroy
+*/
+static void stat_profiler_deinit(StatProfiler_ptr self)
+{
+  int i;
+
+  /* members deinitialization */
+  for (i = 0; i < STAT_STAGE_NUM; ++i) {
+    TimerBench_destroy(self->timers[i]);
+  }
+
+  /* base class deinitialization */
+  env_object_deinit(ENV_OBJECT(self));
+}
+
+/*!
+  \brief Returns the wall clock in seconds
+
+*/
+static double stat_profiler_get_wall_time(void)
+{
+#if NUSMV_HAVE_SYS_TIME_H
+  struct timeval tv;
+
+  gettimeofday(&tv, NULL);
+  return (double) tv.tv_sec + (double) tv.tv_usec / 1e6;
+#else
+  return (double) time(NULL);
+#endif
+}
+
+/*!
+  \brief Returns the memory used by the node manager
+
+*/
+static size_t stat_profiler_get_node_mem(const StatProfiler_ptr self)
+{
+  const NodeMgr_ptr nodemgr =
+    NODE_MGR(NuSMVEnv_get_value(ENV_OBJECT(self)->environment,
+                                ENV_NODE_MGR));
+
+  return NodeMgr_get_memory_used(nodemgr);
+}
+
+/*!
+  \brief Returns the nodes of the BDD manager, 0 if there is none
+
+*/
+static int stat_profiler_get_dd_nodes(const StatProfiler_ptr self)
+{
+  const NuSMVEnv_ptr env = ENV_OBJECT(self)->environment;
+
+  if (!NuSMVEnv_has_value(env, ENV_DD_MGR)) return 0;
+
+  return get_dd_nodes_allocated(DD_MGR(NuSMVEnv_get_value(env, ENV_DD_MGR)));
+}
+
+/*!
+  \brief Prints the children of parent as a JSON object
+
+  Top level stages are printed when parent is STAT_STAGE_NUM
+*/
+static void stat_profiler_print_stages(const StatProfiler_ptr self,
+                                       FILE* out,
+                                       const StatStage parent,
+                                       const int indent)
+{
+  boolean first = true;
+  int i;
+
+  fprintf(out, "{");
+  for (i = 0; i < STAT_STAGE_NUM; ++i) {
+    if (parent != stat_stage_parents[i]) continue;
+
+    fprintf(out, "%s\n%*s\"%s\": {\n", first ? "" : ",",
+            indent + 2, "", stat_stage_names[i]);
+    fprintf(out, "%*s\"time_ms\": %ld,\n", indent + 4, "",
+            TimerBench_get_time(self->timers[i]));
+    fprintf(out, "%*s\"calls\": %ld", indent + 4, "",
+            TimerBench_get_laps(self->timers[i]));
+
+    /* the stage has sub stages */
+    if (i + 1 < STAT_STAGE_NUM && (StatStage) i == stat_stage_parents[i + 1]) {
+      fprintf(out, ",\n%*s\"stages\": ", indent + 4, "");
+      stat_profiler_print_stages(self, out, (StatStage) i, indent + 4);
+    }
+    fprintf(out, "\n%*s}", indent + 2, "");
+
+    first = false;
+  }
+  fprintf(out, "\n%*s}", indent, "");
+}
+
+/**AutomaticEnd***************************************************************/
@@ -0,0 +1,183 @@
+/* ---------------------------------------------------------------------------
+
+
+  This file is part of the ``stat'' package of NuSMV version 2.
+  Copyright (C) 2012 by FBK-irst.
+
+  NuSMV version 2 is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  NuSMV version 2 is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA.
+
+  For more information on NuSMV see <http://nusmv.fbk.eu>
+  or email to <nusmv-users@fbk.eu>.
+  Please report bugs to <nusmv-users@fbk.eu>.
+
+  To contact the NuSMV development board, email to <nusmv@fbk.eu>.
+
+-----------------------------------------------------------------------------*/
+
+/*!
+  \author Alberto Bombardelli
+  \brief Public interface of class 'StatProfiler'
+
+  A StatProfiler collects where the time of a statistical run goes.
+  The run is split in stages, each one timed (CPU time) and counted
+  with a TimerBench. The top level stages are the simulation of the
+  executions, the lookup of the memoized results and the
+  verification of the executions. Some stages are further split in
+  sub stages, whose time is included in the one of their parent:
+
+  - simulation: conversion of the states into expressions
+  - verification: preparation of the counter layer, construction of
+    the problem, model checking of the problem
+
+  The profiler also counts the samples, the generated executions and
+  their length, the memoized lookups, and measures the growth of the
+  node and BDD managers per sample. With several workers only the
+  samples are counted, since the executions are drawn by the forked
+  processes.
+
+  While profiling, the throughput is logged every
+  STAT_PROFILER_REPORT_PERIOD seconds when verbose. A JSON summary
+  can be printed at the end.
+
+*/
+
+
+#ifndef __NUSMV_CORE_STAT_STAT_PROFILER_H__
+#define __NUSMV_CORE_STAT_STAT_PROFILER_H__
+
+#include "nusmv/core/cinit/NuSMVEnv.h"
+#include "nusmv/core/utils/utils.h"
+
+/*!
+  \struct StatProfiler
+  \brief Definition of the public accessor for class StatProfiler
+
+*/
+typedef struct StatProfiler_TAG*  StatProfiler_ptr;
+
+/*!
+  \brief The profiled stages of a statistical run
+
+  Sub stages follow their parent stage.
+*/
+typedef enum StatStage_TAG {
+  STAT_STAGE_SIMULATION = 0,
+  STAT_STAGE_CONVERSION,
+  STAT_STAGE_MEMOIZATION,
+  STAT_STAGE_VERIFICATION,
+  STAT_STAGE_LAYER,
+  STAT_STAGE_PROBLEM,
+  STAT_STAGE_MODEL_CHECKING,
+  STAT_STAGE_NUM
+} StatStage;
+
+/*!
+  \brief To cast and check instances of class StatProfiler
+
+  These macros must be used respectively to cast and to check
+  instances of class StatProfiler
+*/
+#define STAT_PROFILER(self) \
+         ((StatProfiler_ptr) self)
+
+/*!
+  \brief \todo Missing synopsis
+
+  \todo Missing description
+*/
+#define STAT_PROFILER_CHECK_INSTANCE(self) \
+         (nusmv_assert(STAT_PROFILER(self) != STAT_PROFILER(NULL)))
+
+
+/**AutomaticStart*************************************************************/
+
+/*---------------------------------------------------------------------------*/
+/* Function prototypes                                                       */
+/*---------------------------------------------------------------------------*/
+
+/* Constructors ***************************************************************/
+
+/*!
+  \methodof StatProfiler
+  \brief The StatProfiler class constructor
+
+  The memory of the node and BDD managers of env is measured from
+  now on.
+
+  \sa StatProfiler_destroy
+*/
+StatProfiler_ptr StatProfiler_create(const NuSMVEnv_ptr env);
+
+/* Destructors ****************************************************************/
+
+/*!
+  \methodof StatProfiler
+  \brief The StatProfiler class destructor
+
+  \sa StatProfiler_create
+*/
+void StatProfiler_destroy(StatProfiler_ptr self);
+
+/*!
+  \methodof StatProfiler
+  \brief Enters the given stage
+
+  If the stage was not left, for example because an error occurred,
+  it is left first.
+
+  \sa StatProfiler_stop
+*/
+void StatProfiler_start(StatProfiler_ptr self, const StatStage stage);
+
+/*!
+  \methodof StatProfiler
+  \brief Leaves the given stage
+
+  \sa StatProfiler_start
+*/
+void StatProfiler_stop(StatProfiler_ptr self, const StatStage stage);
+
+/*!
+  \methodof StatProfiler
+  \brief Counts a generated execution of the given length
+
+*/
+void StatProfiler_add_execution(StatProfiler_ptr self, const int length);
+
+/*!
+  \methodof StatProfiler
+  \brief Counts a lookup among the memoized results
+
+*/
+void StatProfiler_add_lookup(StatProfiler_ptr self, const boolean hit);
+
+/*!
+  \methodof StatProfiler
+  \brief Counts a sample
+
+  The throughput is logged if the last report is old enough.
+*/
+void StatProfiler_add_sample(StatProfiler_ptr self);
+
+/*!
+  \methodof StatProfiler
+  \brief Prints a JSON summary of the run to out
+
+*/
+void StatProfiler_print_json(const StatProfiler_ptr self, FILE* out);
+
+/**AutomaticEnd***************************************************************/
+
+#endif /* __NUSMV_CORE_STAT_STAT_PROFILER_H__ */
@@ -0,0 +1,599 @@
+/* ---------------------------------------------------------------------------
+
+
+  This file is part of the ``stat'' package of NuSMV version 2.
+  Copyright (C) 2012 by FBK-irst.
+
+  NuSMV version 2 is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  NuSMV version 2 is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA.
+
+  For more information on NuSMV see <http://nusmv.fbk.eu>
+  or email to <nusmv-users@fbk.eu>.
+  Please report bugs to <nusmv-users@fbk.eu>.
+
+  To contact the NuSMV development board, email to <nusmv@fbk.eu>.
+
+-----------------------------------------------------------------------------*/
+
+/*!
+  \author Alberto Bombardelli
+  \brief Implementation of class 'StatSampler'
+
+  Workers are forked processes connected to the parent through two
+  pipes: the parent writes on the first one the number of samples it
+  wants, the worker answers on the second one with one byte per
+  sample. Every worker always has one pending request, so that all
+  the workers keep sampling while the parent consumes the results
+  of one of them. SIGPIPE is ignored while the workers are running,
+  so that a worker terminating unexpectedly is reported as an error.
+
+*/
+
+#if HAVE_CONFIG_H
+# include "nusmv-config.h"
+#endif
+
+#include "nusmv/core/stat/StatSampler.h"
+#include "nusmv/core/stat/statInt.h"
+
+#include "nusmv/core/utils/EnvObject.h"
+#include "nusmv/core/utils/EnvObject_private.h"
+#include "nusmv/core/utils/ErrorMgr.h"
+#include "nusmv/core/utils/RandomGen.h"
+
+#if NUSMV_HAVE_UNISTD_H
+# include <unistd.h>
+#endif
+
+#if NUSMV_HAVE_SYS_WAIT_H
+# include <sys/wait.h>
+#endif
+
+#if NUSMV_HAVE_SIGNAL_H
+# include <signal.h>
+#endif
+
+#include <stdio.h>
+#include <errno.h>
+
+/*---------------------------------------------------------------------------*/
+/* Constant declarations                                                     */
+/*---------------------------------------------------------------------------*/
+
+/* true iff worker processes can be forked on this platform */
+#define STAT_SAMPLER_HAS_WORKERS \
+  (NUSMV_HAVE_FORK && NUSMV_HAVE_UNISTD_H && NUSMV_HAVE_SYS_WAIT_H && \
+   NUSMV_HAVE_SIGNAL_H)
+
+/* number of samples requested to a worker at once */
+#define STAT_SAMPLER_BATCH_SIZE 64
+
+/* byte sent by a worker when a sample could not be computed */
+#define STAT_SAMPLER_SAMPLE_ERROR 2
+
+/*---------------------------------------------------------------------------*/
+/* Structure declarations                                                    */
+/*---------------------------------------------------------------------------*/
+
+/*!
+  \brief A forked worker, as seen by the parent process
+
+*/
+typedef struct StatWorker_TAG {
+  int pid;
+
+  /* parent -> worker: number of requested samples */
+  int request_fd;
+  /* worker -> parent: one byte per sample */
+  int result_fd;
+
+  /* results received and not yet consumed */
+  char buffer[STAT_SAMPLER_BATCH_SIZE];
+  int next;
+  int available;
+} StatWorker;
+
+typedef struct StatSampler_TAG
+{
+  /* this MUST stay on the top */
+  INHERITS_FROM(EnvObject);
+
+  /* -------------------------------------------------- */
+  /*                  Private members                   */
+  /* -------------------------------------------------- */
+  Prop_ptr prop;
+  StatRandomVariable Z;
+
+  /* workers (NULL when sampling serially) */
+  StatWorker* workers;
+  int workers_num;
+
+#if STAT_SAMPLER_HAS_WORKERS
+  /* SIGPIPE handler to be restored when the workers are stopped */
+  void (*saved_sigpipe)(int);
+#endif
+
+  /* worker whose results are currently consumed */
+  int current_worker;
+
+  /* number of samples returned so far */
+  long samples;
+} StatSampler;
+
+/*---------------------------------------------------------------------------*/
+/* Type declarations                                                         */
+/*---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*/
+/* Variable declarations                                                     */
+/*---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*/
+/* Macro declarations                                                        */
+/*---------------------------------------------------------------------------*/
+
+
+/**AutomaticStart*************************************************************/
+
+/*---------------------------------------------------------------------------*/
+/* Static function prototypes                                                */
+/*---------------------------------------------------------------------------*/
+
+static void stat_sampler_init(StatSampler_ptr self,
+                              const NuSMVEnv_ptr env,
+                              const Prop_ptr prop,
+                              const StatRandomVariable Z);
+
+static void stat_sampler_deinit(StatSampler_ptr self);
+
+#if STAT_SAMPLER_HAS_WORKERS
+static int stat_sampler_start_workers(StatSampler_ptr self,
+                                      const int workers);
+
+static void stat_sampler_stop_workers(StatSampler_ptr self);
+
+static void stat_sampler_worker_loop(StatSampler_ptr self,
+                                     const int index,
+                                     const int request_fd,
+                                     const int result_fd)
+  NUSMV_FUNCATTR_NORETURN;
+
+static void stat_sampler_request(StatSampler_ptr self, StatWorker* worker);
+
+static void stat_sampler_receive(StatSampler_ptr self, StatWorker* worker);
+
+static boolean stat_sampler_write_all(const int fd, const void* buf,
+                                      const size_t size);
+
+static boolean stat_sampler_read_all(const int fd, void* buf,
+                                     const size_t size);
+#endif
+
+/*---------------------------------------------------------------------------*/
+/* Definition of exported functions                                          */
+/*---------------------------------------------------------------------------*/
+
+StatSampler_ptr StatSampler_create(const NuSMVEnv_ptr env,
+                                   const Prop_ptr prop,
+                                   const StatRandomVariable Z,
+                                   const int workers)
+{
+  StatSampler_ptr self = ALLOC(StatSampler, 1);
+  STAT_SAMPLER_CHECK_INSTANCE(self);
+
+  stat_sampler_init(self, env, prop, Z);
+
+#if STAT_SAMPLER_HAS_WORKERS
+  if (1 < workers) {
+    self->workers_num = stat_sampler_start_workers(self, workers);
+  }
+#else
+  if (1 < workers) {
+    const ErrorMgr_ptr errmgr =
+      ERROR_MGR(NuSMVEnv_get_value(env, ENV_ERROR_MANAGER));
+
+    ErrorMgr_warning_msg(errmgr, "Parallel sampling is not supported on this "
+                         "platform: using a single worker\n");
+  }
+#endif
+
+  return self;
+}
+
+void StatSampler_destroy(StatSampler_ptr self)
+{
+  STAT_SAMPLER_CHECK_INSTANCE(self);
+
+  stat_sampler_deinit(self);
+
+  FREE(self);
+}
+
+boolean StatSampler_get_sample(StatSampler_ptr self)
+{
+  StatProfiler_ptr profiler;
+  boolean retval;
+
+  STAT_SAMPLER_CHECK_INSTANCE(self);
+
+#if STAT_SAMPLER_HAS_WORKERS
+  if ((StatWorker*)NULL != self->workers) {
+    StatWorker* worker = &(self->workers[self->current_worker]);
+    char sample;
+
+    if (worker->next == worker->available) {
+      stat_sampler_receive(self, worker);
+    }
+
+    sample = worker->buffer[worker->next];
+    worker->next++;
+
+    if (STAT_SAMPLER_SAMPLE_ERROR == sample) {
+      const ErrorMgr_ptr errmgr =
+        ERROR_MGR(NuSMVEnv_get_value(ENV_OBJECT(self)->environment,
+                                     ENV_ERROR_MANAGER));
+
+      ErrorMgr_rpterr(errmgr, "Statistical worker %d (pid %d) failed\n",
+                      self->current_worker, worker->pid);
+    }
+
+    /* the batch is over: move to the next worker */
+    if (worker->next == worker->available) {
+      self->current_worker = (self->current_worker + 1) % self->workers_num;
+    }
+
+    retval = (1 == sample);
+  }
+  else
+#endif
+  {
+    retval = self->Z(ENV_OBJECT(self)->environment, self->prop);
+  }
+
+  self->samples++;
+
+  profiler = Stat_get_profiler(ENV_OBJECT(self)->environment);
+  if (STAT_PROFILER(NULL) != profiler) StatProfiler_add_sample(profiler);
+
+  return retval;
+}
+
+int StatSampler_get_workers_num(const StatSampler_ptr self)
+{
+  STAT_SAMPLER_CHECK_INSTANCE(self);
+
+  return self->workers_num;
+}
+
+long StatSampler_get_samples_num(const StatSampler_ptr self)
+{
+  STAT_SAMPLER_CHECK_INSTANCE(self);
+
+  return self->samples;
+}
+
+/*---------------------------------------------------------------------------*/
+/* Definition of internal functions                                          */
+/*---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*/
+/* Definition of static functions                                            */
+/*---------------------------------------------------------------------------*/
+
+/*!
+  \brief The StatSampler class private initializer
+
+  \sa StatSampler_create
+*/
+static void stat_sampler_init(StatSampler_ptr self,
+                              const NuSMVEnv_ptr env,
+                              const Prop_ptr prop,
+                              const StatRandomVariable Z)
+{
+  env_object_init(ENV_OBJECT(self), env);
+
+  self->prop = prop;
+  self->Z = Z;
+  self->workers = (StatWorker*)NULL;
+  self->workers_num = 1;
+#if STAT_SAMPLER_HAS_WORKERS
+  self->saved_sigpipe = SIG_DFL;
+#endif
+  self->current_worker = 0;
+  self->samples = 0;
+}
+
+/*!
+  \brief The StatSampler class private deinitializer
+
+  \sa StatSampler_destroy
+*/
+static void stat_sampler_deinit(StatSampler_ptr self)
+{
+#if STAT_SAMPLER_HAS_WORKERS
+  if ((StatWorker*)NULL != self->workers) {
+    stat_sampler_stop_workers(self);
+  }
+#endif
+
+  self->prop = PROP(NULL);
+  self->Z = NULL;
+
+  env_object_deinit(ENV_OBJECT(self));
+}
+
+#if STAT_SAMPLER_HAS_WORKERS
+
+/*!
+  \brief Forks the workers
+
+  Returns the number of workers actually started. If no worker
+  can be started, 1 is returned and sampling is performed serially.
+*/
+static int stat_sampler_start_workers(StatSampler_ptr self,
+                                      const int workers)
+{
+  const NuSMVEnv_ptr env = ENV_OBJECT(self)->environment;
+  const ErrorMgr_ptr errmgr =
+    ERROR_MGR(NuSMVEnv_get_value(env, ENV_ERROR_MANAGER));
+  int i;
+
+  self->workers = ALLOC(StatWorker, workers);
+  nusmv_assert((StatWorker*)NULL != self->workers);
+
+  /* a terminated worker must make the requests fail, not kill the
+     parent */
+  self->saved_sigpipe = signal(SIGPIPE, SIG_IGN);
+
+  /* avoids the workers to flush again the pending output */
+  fflush(NULL);
+
+  for (i = 0; i < workers; i++) {
+    StatWorker* worker = &(self->workers[i]);
+    int request_pipe[2], result_pipe[2];
+    pid_t pid;
+
+    if (0 != pipe(request_pipe)) break;
+    if (0 != pipe(result_pipe)) {
+      close(request_pipe[0]); close(request_pipe[1]);
+      break;
+    }
+
+    pid = fork();
+    if (pid < 0) {
+      close(request_pipe[0]); close(request_pipe[1]);
+      close(result_pipe[0]); close(result_pipe[1]);
+      break;
+    }
+
+    if (0 == pid) {
+      int j;
+
+      /* the worker does not need the channels of its siblings */
+      for (j = 0; j < i; j++) {
+        close(self->workers[j].request_fd);
+        close(self->workers[j].result_fd);
+      }
+      close(request_pipe[1]);
+      close(result_pipe[0]);
+
+      stat_sampler_worker_loop(self, i, request_pipe[0], result_pipe[1]);
+    }
+
+    close(request_pipe[0]);
+    close(result_pipe[1]);
+
+    worker->pid = (int)pid;
+    worker->request_fd = request_pipe[1];
+    worker->result_fd = result_pipe[0];
+    worker->next = 0;
+    worker->available = 0;
+  }
+
+  if (i < workers) {
+    ErrorMgr_warning_msg(errmgr, "Only %d of the %d requested statistical "
+                         "workers could be started\n", i, workers);
+  }
+
+  /* the streams of the started workers must not be used again */
+  {
+    const RandomGen_ptr gen =
+      RANDOM_GEN(NuSMVEnv_get_value(env, ENV_STAT_RANDOM_GEN));
+    int j;
+
+    for (j = 0; j <= i; j++) RandomGen_jump(gen);
+  }
+
+  if (0 == i) {
+    FREE(self->workers);
+    self->workers = (StatWorker*)NULL;
+    (void)signal(SIGPIPE, self->saved_sigpipe);
+    return 1;
+  }
+
+  self->workers_num = i;
+
+  /* every worker starts sampling immediately */
+  for (i = 0; i < self->workers_num; i++) {
+    stat_sampler_request(self, &(self->workers[i]));
+  }
+
+  return self->workers_num;
+}
+
+/*!
+  \brief Stops all the workers and waits for their termination
+
+*/
+static void stat_sampler_stop_workers(StatSampler_ptr self)
+{
+  int i;
+
+  for (i = 0; i < self->workers_num; i++) {
+    StatWorker* worker = &(self->workers[i]);
+    int status;
+
+    close(worker->request_fd);
+    close(worker->result_fd);
+
+    /* pending batches are not needed anymore */
+    (void)kill((pid_t)worker->pid, SIGKILL);
+    (void)waitpid((pid_t)worker->pid, &status, 0);
+  }
+
+  FREE(self->workers);
+  self->workers = (StatWorker*)NULL;
+  self->workers_num = 1;
+
+  (void)signal(SIGPIPE, self->saved_sigpipe);
+}
+
+/*!
+  \brief Main loop of a worker process
+
+  The worker with the given index moves the random generator of the
+  package index + 1 streams ahead, so that it produces a sequence of
+  samples independent from the ones of the other workers and of the
+  parent, which only depends on the seed. It terminates when a non
+  positive request is received or when the parent closes the
+  channel.
+*/
+static void stat_sampler_worker_loop(StatSampler_ptr self,
+                                     const int index,
+                                     const int request_fd,
+                                     const int result_fd)
+{
+  const NuSMVEnv_ptr env = ENV_OBJECT(self)->environment;
+  const ErrorMgr_ptr errmgr =
+    ERROR_MGR(NuSMVEnv_get_value(env, ENV_ERROR_MANAGER));
+  const RandomGen_ptr gen =
+    RANDOM_GEN(NuSMVEnv_get_value(env, ENV_STAT_RANDOM_GEN));
+  char buffer[STAT_SAMPLER_BATCH_SIZE];
+  int requested;
+  int j;
+
+  for (j = 0; j <= index; j++) RandomGen_jump(gen);
+
+  while (stat_sampler_read_all(request_fd, &requested, sizeof(requested)) &&
+         0 < requested) {
+    int i;
+
+    nusmv_assert(requested <= STAT_SAMPLER_BATCH_SIZE);
+
+    for (i = 0; i < requested; i++) {
+      CATCH(errmgr) {
+        buffer[i] = self->Z(env, self->prop) ? 1 : 0;
+      }
+      FAIL(errmgr) {
+        buffer[i] = STAT_SAMPLER_SAMPLE_ERROR;
+      }
+    }
+
+    if (! stat_sampler_write_all(result_fd, buffer, requested)) break;
+  }
+
+  close(request_fd);
+  close(result_fd);
+
+  /* the worker must not execute the parent cleanup handlers */
+  _exit(0);
+}
+
+/*!
+  \brief Asks a new batch of samples to the given worker
+
+*/
+static void stat_sampler_request(StatSampler_ptr self, StatWorker* worker)
+{
+  const int requested = STAT_SAMPLER_BATCH_SIZE;
+
+  if (! stat_sampler_write_all(worker->request_fd, &requested,
+                               sizeof(requested))) {
+    const ErrorMgr_ptr errmgr =
+      ERROR_MGR(NuSMVEnv_get_value(ENV_OBJECT(self)->environment,
+                                   ENV_ERROR_MANAGER));
+
+    ErrorMgr_rpterr(errmgr, "Unable to contact statistical worker (pid %d)\n",
+                    worker->pid);
+  }
+}
+
+/*!
+  \brief Waits for the pending batch of the given worker
+
+  A new batch is requested as soon as the previous one is received
+*/
+static void stat_sampler_receive(StatSampler_ptr self, StatWorker* worker)
+{
+  if (! stat_sampler_read_all(worker->result_fd, worker->buffer,
+                              STAT_SAMPLER_BATCH_SIZE)) {
+    const ErrorMgr_ptr errmgr =
+      ERROR_MGR(NuSMVEnv_get_value(ENV_OBJECT(self)->environment,
+                                   ENV_ERROR_MANAGER));
+
+    ErrorMgr_rpterr(errmgr, "Statistical worker (pid %d) terminated "
+                    "unexpectedly\n", worker->pid);
+  }
+
+  worker->next = 0;
+  worker->available = STAT_SAMPLER_BATCH_SIZE;
+
+  stat_sampler_request(self, worker);
+}
+
+/*!
+  \brief Writes the whole buffer, returns false on failure
+
+*/
+static boolean stat_sampler_write_all(const int fd, const void* buf,
+                                      const size_t size)
+{
+  const char* data = (const char*)buf;
+  size_t done = 0;
+
+  while (done < size) {
+    ssize_t res = write(fd, data + done, size - done);
+
+    if (res < 0 && EINTR == errno) continue;
+    if (res <= 0) return false;
+    done += (size_t)res;
+  }
+
+  return true;
+}
+
+/*!
+  \brief Reads exactly size bytes, returns false on failure
+
+*/
+static boolean stat_sampler_read_all(const int fd, void* buf,
+                                     const size_t size)
+{
+  char* data = (char*)buf;
+  size_t done = 0;
+
+  while (done < size) {
+    ssize_t res = read(fd, data + done, size - done);
+
+    if (res < 0 && EINTR == errno) continue;
+    if (res <= 0) return false;
+    done += (size_t)res;
+  }
+
+  return true;
+}
+
+#endif /* STAT_SAMPLER_HAS_WORKERS */
+
+/**AutomaticEnd***************************************************************/
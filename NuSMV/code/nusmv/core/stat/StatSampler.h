@@ -0,0 +1,149 @@
+/* ---------------------------------------------------------------------------
+
+
+  This file is part of the ``stat'' package of NuSMV version 2.
+  Copyright (C) 2012 by FBK-irst.
+
+  NuSMV version 2 is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  NuSMV version 2 is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA.
+
+  For more information on NuSMV see <http://nusmv.fbk.eu>
+  or email to <nusmv-users@fbk.eu>.
+  Please report bugs to <nusmv-users@fbk.eu>.
+
+  To contact the NuSMV development board, email to <nusmv@fbk.eu>.
+
+-----------------------------------------------------------------------------*/
+
+/*!
+  \author Alberto Bombardelli
+  \brief Public interface of class 'StatSampler'
+
+  A StatSampler is the source of the Bernoulli samples consumed by the
+  statistical algorithms. With a single worker the samples are drawn
+  in the current process. With N > 1 workers, N processes are forked,
+  each owning a private copy of the environment (problem generators,
+  BDD and SAT managers), and their results are merged into a single
+  stream of samples.
+
+  Samples are consumed in a fixed round-robin order over the
+  workers, independently of their values: the stream seen by the
+  caller is a sequence of independent identically distributed
+  samples, so the guarantees of the algorithms consuming it are
+  preserved.
+
+*/
+
+
+
+#ifndef __NUSMV_CORE_STAT_STAT_SAMPLER_H__
+#define __NUSMV_CORE_STAT_STAT_SAMPLER_H__
+
+#include "nusmv/core/cinit/NuSMVEnv.h"
+#include "nusmv/core/prop/Prop.h"
+#include "nusmv/core/utils/utils.h"
+
+/*!
+  \struct StatSampler
+  \brief Definition of the public accessor for class StatSampler
+
+*/
+typedef struct StatSampler_TAG*  StatSampler_ptr;
+
+/*!
+  \brief Bernoulli random variable sampled by a StatSampler
+
+  Returns true iff a single random execution satisfies the property
+*/
+typedef boolean (*StatRandomVariable)(const NuSMVEnv_ptr, const Prop_ptr);
+
+/*!
+  \brief To cast and check instances of class StatSampler
+
+  These macros must be used respectively to cast and to check
+  instances of class StatSampler
+*/
+#define STAT_SAMPLER(self) \
+         ((StatSampler_ptr) self)
+
+/*!
+  \brief \todo Missing synopsis
+
+  \todo Missing description
+*/
+#define STAT_SAMPLER_CHECK_INSTANCE(self) \
+         (nusmv_assert(STAT_SAMPLER(self) != STAT_SAMPLER(NULL)))
+
+
+/**AutomaticStart*************************************************************/
+
+/*---------------------------------------------------------------------------*/
+/* Function prototypes                                                       */
+/*---------------------------------------------------------------------------*/
+
+/* Constructors ***************************************************************/
+
+/*!
+  \methodof StatSampler
+  \brief The StatSampler class constructor
+
+  Creates a sampler of Z over prop. If workers is greater than one
+  and the platform supports it, workers processes are forked
+  immediately. Otherwise samples are drawn serially.
+
+  \sa StatSampler_destroy
+*/
+StatSampler_ptr StatSampler_create(const NuSMVEnv_ptr env,
+                                   const Prop_ptr prop,
+                                   const StatRandomVariable Z,
+                                   const int workers);
+
+/* Destructors ****************************************************************/
+
+/*!
+  \methodof StatSampler
+  \brief The StatSampler class destructor
+
+  Stops and waits all the forked workers. Samples already produced
+  by the workers but not yet consumed are discarded.
+
+  \sa StatSampler_create
+*/
+void StatSampler_destroy(StatSampler_ptr self);
+
+/*!
+  \methodof StatSampler
+  \brief Returns the next sample of the stream
+
+  An error is raised if a worker fails
+*/
+boolean StatSampler_get_sample(StatSampler_ptr self);
+
+/*!
+  \methodof StatSampler
+  \brief Returns the number of workers actually used
+
+*/
+int StatSampler_get_workers_num(const StatSampler_ptr self);
+
+/*!
+  \methodof StatSampler
+  \brief Returns the number of samples consumed so far
+
+*/
+long StatSampler_get_samples_num(const StatSampler_ptr self);
+
+/**AutomaticEnd***************************************************************/
+
+#endif /* __NUSMV_CORE_STAT_STAT_SAMPLER_H__ */
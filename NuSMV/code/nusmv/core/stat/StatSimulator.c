@@ -0,0 +1,896 @@
+/* ---------------------------------------------------------------------------
+
+
+  This file is part of the ``stat'' package of NuSMV version 2.
+  Copyright (C) 2012 by FBK-irst.
+
+  NuSMV version 2 is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  NuSMV version 2 is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA.
+
+  For more information on NuSMV see <http://nusmv.fbk.eu>
+  or email to <nusmv-users@fbk.eu>.
+  Please report bugs to <nusmv-users@fbk.eu>.
+
+  To contact the NuSMV development board, email to <nusmv@fbk.eu>.
+
+-----------------------------------------------------------------------------*/
+
+/*!
+  \author Alberto Bombardelli
+  \brief Implementation of class 'StatSimulator'
+
+*/
+
+#include "nusmv/core/stat/StatSimulator.h"
+#include "nusmv/core/stat/statInt.h"
+
+#include "nusmv/core/utils/EnvObject.h"
+#include "nusmv/core/utils/EnvObject_private.h"
+#include "nusmv/core/utils/assoc.h"
+#include "nusmv/core/utils/NodeList.h"
+#include "nusmv/core/utils/RandomGen.h"
+#include "nusmv/core/utils/ErrorMgr.h"
+#include "nusmv/core/utils/UStringMgr.h"
+#include "nusmv/core/utils/error.h"
+
+#include "nusmv/core/enc/bdd/BddEnc.h"
+#include "nusmv/core/fsm/bdd/BddFsm.h"
+#include "nusmv/core/fsm/sexp/SexpFsm.h"
+#include "nusmv/core/compile/symb_table/SymbTable.h"
+#include "nusmv/core/parser/symbols.h"
+
+#include <math.h>
+
+/*---------------------------------------------------------------------------*/
+/* Constant declarations                                                     */
+/*---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*/
+/* Structure declarations                                                    */
+/*---------------------------------------------------------------------------*/
+
+typedef struct StatSimulator_TAG
+{
+  /* this MUST stay on the top */
+  INHERITS_FROM(EnvObject);
+
+  /* -------------------------------------------------- */
+  /*                  Private members                   */
+  /* -------------------------------------------------- */
+  BddFsm_ptr fsm;
+  BddEnc_ptr enc;
+  DDMgr_ptr dd;
+
+  /* random choices are taken from the generator of the package */
+  RandomGen_ptr gen;
+
+  /* masked initial states, computed on demand */
+  bdd_ptr init;
+
+  /* the last chosen state (referenced), NULL if no execution started */
+  bdd_ptr current;
+
+  /* state and frozen variables, and input variables of the model */
+  NodeList_ptr sf_vars;
+  NodeList_ptr i_vars;
+
+  /* images hash map: state -> masked forward image (referenced) */
+  hash_ptr images;
+
+  /* probabilities of the inputs, NULL if the successors are chosen
+     uniformly. Owned by the package */
+  add_ptr input_probs;
+
+  /* inputs hash map: state -> masked inputs having a successor, and
+     weights hash map: state -> input_probs restricted to them (all
+     referenced). Used only with input_probs */
+  hash_ptr inputs;
+  hash_ptr weights;
+
+  /* sexps hash map: state or state & input -> sexp (bdds referenced) */
+  hash_ptr sexps;
+
+  /* nested level sets (referenced), NULL if no level was set */
+  bdd_ptr* levels;
+  int levels_num;
+
+  /* counts hash map: state -> number of successors at each level
+     (levels_num + 1 doubles). Used only with levels */
+  hash_ptr counts;
+} StatSimulator;
+
+/*---------------------------------------------------------------------------*/
+/* Type declarations                                                         */
+/*---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*/
+/* Variable declarations                                                     */
+/*---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*/
+/* Macro declarations                                                        */
+/*---------------------------------------------------------------------------*/
+#define STAT_ENV(self) (ENV_OBJECT(self)->environment)
+
+/**AutomaticStart*************************************************************/
+
+/*---------------------------------------------------------------------------*/
+/* Static function prototypes                                                */
+/*---------------------------------------------------------------------------*/
+
+static void stat_simulator_init(StatSimulator_ptr self,
+                                const NuSMVEnv_ptr env);
+
+static void stat_simulator_deinit(StatSimulator_ptr self);
+
+static bdd_ptr stat_simulator_get_image(StatSimulator_ptr self,
+                                        bdd_ptr state);
+
+static void stat_simulator_pick_weighted(StatSimulator_ptr self,
+                                         bdd_ptr* state, bdd_ptr* input);
+
+static bdd_ptr stat_simulator_get_inputs(StatSimulator_ptr self,
+                                         bdd_ptr state);
+
+static bdd_ptr stat_simulator_pick_input(StatSimulator_ptr self,
+                                         bdd_ptr state);
+
+static const double* stat_simulator_get_counts(StatSimulator_ptr self,
+                                               bdd_ptr state);
+
+static bdd_ptr stat_simulator_get_level_set(StatSimulator_ptr self,
+                                            bdd_ptr image, int level);
+
+static void stat_simulator_clear_levels(StatSimulator_ptr self);
+static void stat_simulator_trim_caches(StatSimulator_ptr self);
+
+static double stat_simulator_leaf_weight(node_ptr leaf, void* arg);
+
+static Expr_ptr stat_simulator_get_sexp(StatSimulator_ptr self,
+                                        bdd_ptr state, bdd_ptr input);
+
+static Expr_ptr stat_simulator_assign(StatSimulator_ptr self,
+                                      bdd_ptr minterm, NodeList_ptr vars,
+                                      Expr_ptr res);
+
+static void stat_simulator_set_current(StatSimulator_ptr self,
+                                       bdd_ptr state);
+
+static assoc_retval stat_simulator_free_image(char* key, char* data,
+                                              char* arg);
+
+static assoc_retval stat_simulator_free_key(char* key, char* data,
+                                            char* arg);
+
+static assoc_retval stat_simulator_free_counts(char* key, char* data,
+                                               char* arg);
+
+/*---------------------------------------------------------------------------*/
+/* Definition of exported functions                                          */
+/*---------------------------------------------------------------------------*/
+
+StatSimulator_ptr StatSimulator_create(const NuSMVEnv_ptr env)
+{
+  StatSimulator_ptr self = ALLOC(StatSimulator, 1);
+  STAT_SIMULATOR_CHECK_INSTANCE(self);
+
+  stat_simulator_init(self, env);
+
+  return self;
+}
+
+void StatSimulator_destroy(StatSimulator_ptr self)
+{
+  STAT_SIMULATOR_CHECK_INSTANCE(self);
+
+  stat_simulator_deinit(self);
+
+  FREE(self);
+}
+
+Expr_ptr StatSimulator_pick_init(StatSimulator_ptr self)
+{
+  bdd_ptr state;
+  Expr_ptr res;
+
+  STAT_SIMULATOR_CHECK_INSTANCE(self);
+
+  if ((bdd_ptr)NULL == self->init) {
+    bdd_ptr init = BddFsm_get_init(self->fsm);
+    bdd_ptr invar = BddFsm_get_state_constraints(self->fsm);
+
+    bdd_and_accumulate(self->dd, &init, invar);
+    self->init = BddEnc_apply_state_frozen_vars_mask_bdd(self->enc, init);
+
+    bdd_free(self->dd, invar);
+    bdd_free(self->dd, init);
+  }
+
+  stat_simulator_set_current(self, (bdd_ptr)NULL);
+  stat_simulator_trim_caches(self);
+
+  if (bdd_is_false(self->dd, self->init)) return Nil;
+
+  state = BddEnc_pick_one_state_uniform(self->enc, self->init, self->gen);
+  res = stat_simulator_get_sexp(self, state, (bdd_ptr)NULL);
+
+  stat_simulator_set_current(self, state);
+  bdd_free(self->dd, state);
+
+  return res;
+}
+
+Expr_ptr StatSimulator_step(StatSimulator_ptr self)
+{
+  bdd_ptr image;
+  bdd_ptr state;
+  bdd_ptr input;
+  Expr_ptr res;
+
+  STAT_SIMULATOR_CHECK_INSTANCE(self);
+  nusmv_assert((bdd_ptr)NULL != self->current);
+
+  image = stat_simulator_get_image(self, self->current);
+  if (bdd_is_false(self->dd, image)) return Nil;
+
+  if ((add_ptr)NULL != self->input_probs) {
+    stat_simulator_pick_weighted(self, &state, &input);
+  }
+  else {
+    state = BddEnc_pick_one_state_uniform(self->enc, image, self->gen);
+    input = stat_simulator_pick_input(self, state);
+  }
+
+  res = stat_simulator_get_sexp(self, state, input);
+
+  stat_simulator_set_current(self, state);
+  bdd_free(self->dd, input);
+  bdd_free(self->dd, state);
+
+  return res;
+}
+
+bdd_ptr StatSimulator_get_state(const StatSimulator_ptr self)
+{
+  STAT_SIMULATOR_CHECK_INSTANCE(self);
+  nusmv_assert((bdd_ptr)NULL != self->current);
+
+  return bdd_dup(self->current);
+}
+
+void StatSimulator_restart(StatSimulator_ptr self, bdd_ptr state)
+{
+  STAT_SIMULATOR_CHECK_INSTANCE(self);
+
+  stat_simulator_trim_caches(self);
+  stat_simulator_set_current(self, state);
+}
+
+void StatSimulator_set_levels(StatSimulator_ptr self,
+                              bdd_ptr* levels, const int levels_num)
+{
+  int i;
+
+  STAT_SIMULATOR_CHECK_INSTANCE(self);
+  nusmv_assert(0 < levels_num);
+
+  stat_simulator_clear_levels(self);
+
+  self->levels = ALLOC(bdd_ptr, levels_num);
+  for (i = 0; i < levels_num; i++) {
+    self->levels[i] = bdd_dup(levels[i]);
+  }
+  self->levels_num = levels_num;
+}
+
+int StatSimulator_get_level(const StatSimulator_ptr self)
+{
+  int res = 0;
+
+  STAT_SIMULATOR_CHECK_INSTANCE(self);
+  nusmv_assert((bdd_ptr*)NULL != self->levels);
+  nusmv_assert((bdd_ptr)NULL != self->current);
+
+  /* level sets are nested */
+  while (res < self->levels_num &&
+         bdd_entailed(self->dd, self->current, self->levels[res])) {
+    res++;
+  }
+
+  return res;
+}
+
+const double* StatSimulator_get_successor_levels(StatSimulator_ptr self)
+{
+  STAT_SIMULATOR_CHECK_INSTANCE(self);
+  nusmv_assert((bdd_ptr*)NULL != self->levels);
+  nusmv_assert((bdd_ptr)NULL != self->current);
+
+  return stat_simulator_get_counts(self, self->current);
+}
+
+Expr_ptr StatSimulator_step_tilted(StatSimulator_ptr self,
+                                   const double theta, double* ratio)
+{
+  const double* counts;
+  bdd_ptr image;
+  bdd_ptr state;
+  bdd_ptr input;
+  bdd_ptr set;
+  Expr_ptr res;
+  double total, shift, mass, coin;
+  int level, j;
+
+  STAT_SIMULATOR_CHECK_INSTANCE(self);
+  nusmv_assert((bdd_ptr*)NULL != self->levels);
+  nusmv_assert((bdd_ptr)NULL != self->current);
+  nusmv_assert((add_ptr)NULL == self->input_probs);
+
+  image = stat_simulator_get_image(self, self->current);
+  if (bdd_is_false(self->dd, image)) return Nil;
+
+  counts = stat_simulator_get_counts(self, self->current);
+
+  /* the weights exp(theta * j) are scaled by the largest one */
+  total = 0.0;
+  shift = -HUGE_VAL;
+  for (j = 0; j <= self->levels_num; j++) {
+    if (0 < counts[j]) {
+      total += counts[j];
+      if (shift < theta * j) shift = theta * j;
+    }
+  }
+
+  mass = 0.0;
+  for (j = 0; j <= self->levels_num; j++) {
+    if (0 < counts[j]) mass += counts[j] * exp(theta * j - shift);
+  }
+
+  /* the level of the successor ... */
+  coin = RandomGen_next_double(self->gen) * mass;
+  level = -1;
+  for (j = 0; j <= self->levels_num; j++) {
+    if (0 < counts[j]) {
+      level = j;
+      coin -= counts[j] * exp(theta * j - shift);
+      if (coin < 0) break;
+    }
+  }
+  nusmv_assert(0 <= level);
+
+  /* ... and then the successor, uniformly among the ones at that level */
+  set = stat_simulator_get_level_set(self, image, level);
+  state = BddEnc_pick_one_state_uniform(self->enc, set, self->gen);
+  bdd_free(self->dd, set);
+
+  /* uniform probability of the successor over its tilted probability */
+  *ratio = mass / (total * exp(theta * level - shift));
+
+  input = stat_simulator_pick_input(self, state);
+  res = stat_simulator_get_sexp(self, state, input);
+
+  stat_simulator_set_current(self, state);
+  bdd_free(self->dd, input);
+  bdd_free(self->dd, state);
+
+  return res;
+}
+
+/*---------------------------------------------------------------------------*/
+/* Definition of internal functions                                          */
+/*---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*/
+/* Definition of static functions                                            */
+/*---------------------------------------------------------------------------*/
+
+/*!
+  \brief The StatSimulator class private initializer
+
+  \sa StatSimulator_create
+*/
+static void stat_simulator_init(StatSimulator_ptr self,
+                                const NuSMVEnv_ptr env)
+{
+  const SexpFsm_ptr sexp_fsm = SEXP_FSM(NuSMVEnv_get_value(env, ENV_SEXP_FSM));
+  const SymbTable_ptr st = SYMB_TABLE(NuSMVEnv_get_value(env, ENV_SYMB_TABLE));
+  ListIter_ptr iter;
+  NodeList_ptr symbols;
+
+  env_object_init(ENV_OBJECT(self), env);
+
+  self->fsm = BDD_FSM(NuSMVEnv_get_value(env, ENV_BDD_FSM));
+  self->enc = BddFsm_get_bdd_encoding(self->fsm);
+  self->dd = BddEnc_get_dd_manager(self->enc);
+  self->gen = RANDOM_GEN(NuSMVEnv_get_value(env, ENV_STAT_RANDOM_GEN));
+  self->init = (bdd_ptr)NULL;
+  self->current = (bdd_ptr)NULL;
+  self->sf_vars = NodeList_create();
+  self->i_vars = NodeList_create();
+  self->images = new_assoc();
+  self->sexps = new_assoc();
+  self->inputs = new_assoc();
+  self->weights = new_assoc();
+  self->levels = (bdd_ptr*)NULL;
+  self->levels_num = 0;
+  self->counts = new_assoc();
+
+  self->input_probs = NuSMVEnv_has_value(env, ENV_STAT_INPUT_PROBS) ?
+    (add_ptr)NuSMVEnv_get_value(env, ENV_STAT_INPUT_PROBS) : (add_ptr)NULL;
+
+  /* the same variables the simulation traces are built on */
+  symbols = SexpFsm_get_symbols_list(sexp_fsm);
+  NODE_LIST_FOREACH(symbols, iter) {
+    node_ptr var = NodeList_get_elem_at(symbols, iter);
+
+    if (SymbTable_is_symbol_input_var(st, var)) {
+      NodeList_append(self->i_vars, var);
+    }
+    else if (SymbTable_is_symbol_state_var(st, var) ||
+             SymbTable_is_symbol_frozen_var(st, var)) {
+      NodeList_append(self->sf_vars, var);
+    }
+  }
+}
+
+/*!
+  \brief The StatSimulator class private deinitializer
+
+  \sa StatSimulator_destroy
+*/
+static void stat_simulator_deinit(StatSimulator_ptr self)
+{
+  stat_simulator_set_current(self, (bdd_ptr)NULL);
+
+  if ((bdd_ptr)NULL != self->init) {
+    bdd_free(self->dd, self->init);
+    self->init = (bdd_ptr)NULL;
+  }
+
+  stat_simulator_clear_levels(self);
+  free_assoc(self->counts); self->counts = (hash_ptr)NULL;
+
+  clear_assoc_and_free_entries_arg(self->images, stat_simulator_free_image,
+                                   (char*)self->dd);
+  free_assoc(self->images); self->images = (hash_ptr)NULL;
+
+  clear_assoc_and_free_entries_arg(self->inputs, stat_simulator_free_image,
+                                   (char*)self->dd);
+  free_assoc(self->inputs); self->inputs = (hash_ptr)NULL;
+
+  clear_assoc_and_free_entries_arg(self->weights, stat_simulator_free_image,
+                                   (char*)self->dd);
+  free_assoc(self->weights); self->weights = (hash_ptr)NULL;
+  self->input_probs = (add_ptr)NULL;
+
+  clear_assoc_and_free_entries_arg(self->sexps, stat_simulator_free_key,
+                                   (char*)self->dd);
+  free_assoc(self->sexps); self->sexps = (hash_ptr)NULL;
+
+  NodeList_destroy(self->i_vars); self->i_vars = NODE_LIST(NULL);
+  NodeList_destroy(self->sf_vars); self->sf_vars = NODE_LIST(NULL);
+
+  self->fsm = BDD_FSM(NULL);
+  self->enc = BDD_ENC(NULL);
+  self->dd = (DDMgr_ptr)NULL;
+  self->gen = RANDOM_GEN(NULL);
+
+  env_object_deinit(ENV_OBJECT(self));
+}
+
+/*!
+  \brief Returns the successors of the given state
+
+  The returned bdd is masked on the state and frozen variables. It is
+  cached and must not be freed.
+*/
+static bdd_ptr stat_simulator_get_image(StatSimulator_ptr self,
+                                        bdd_ptr state)
+{
+  bdd_ptr res = (bdd_ptr)find_assoc(self->images, (node_ptr)state);
+
+  if ((bdd_ptr)NULL == res) {
+    bdd_ptr image = BddFsm_get_concrete_forward_image(self->fsm, state);
+
+    res = BddEnc_apply_state_frozen_vars_mask_bdd(self->enc, image);
+    bdd_free(self->dd, image);
+
+    insert_assoc(self->images, (node_ptr)bdd_dup(state), (node_ptr)res);
+  }
+
+  return res;
+}
+
+/*!
+  \brief Chooses the next input according to the input probabilities,
+  and then a successor through it
+
+  The input is drawn among the ones having a successor from the
+  current state, with probability proportional to input_probs. If
+  none of them has a positive probability it is drawn uniformly. The
+  successor is drawn uniformly among the ones reached through the
+  input. Returned bdds are referenced.
+*/
+static void stat_simulator_pick_weighted(StatSimulator_ptr self,
+                                         bdd_ptr* state, bdd_ptr* input)
+{
+  bdd_ptr inputs = stat_simulator_get_inputs(self, self->current);
+  add_ptr weights = (add_ptr)find_assoc(self->weights,
+                                        (node_ptr)self->current);
+
+  *input = BddEnc_pick_one_input_weighted(self->enc, weights,
+                                          stat_simulator_leaf_weight,
+                                          (void*)self, self->gen);
+
+  if (bdd_is_false(self->dd, *input)) {
+    bdd_free(self->dd, *input);
+    *input = BddEnc_pick_one_input_uniform(self->enc, inputs, self->gen);
+  }
+
+  {
+    bdd_ptr si = bdd_and(self->dd, self->current, *input);
+    bdd_ptr image = BddFsm_get_forward_image_states_inputs(self->fsm, si);
+    bdd_ptr masked = BddEnc_apply_state_frozen_vars_mask_bdd(self->enc,
+                                                             image);
+
+    *state = BddEnc_pick_one_state_uniform(self->enc, masked, self->gen);
+
+    bdd_free(self->dd, masked);
+    bdd_free(self->dd, image);
+    bdd_free(self->dd, si);
+  }
+}
+
+/*!
+  \brief Returns the inputs having a successor from the given state
+
+  The returned bdd is masked on the input variables. It is cached, as
+  is its restriction of input_probs, and must not be freed.
+*/
+static bdd_ptr stat_simulator_get_inputs(StatSimulator_ptr self,
+                                         bdd_ptr state)
+{
+  bdd_ptr res = (bdd_ptr)find_assoc(self->inputs, (node_ptr)state);
+
+  if ((bdd_ptr)NULL == res) {
+    bdd_ptr legal =
+      BddFsm_get_states_inputs_constraints(self->fsm, BDD_FSM_DIR_BWD);
+    bdd_ptr si = bdd_and(self->dd, legal, state);
+    bdd_ptr inputs = BddFsm_states_inputs_to_inputs(self->fsm, si);
+    add_ptr mask;
+    add_ptr zero;
+
+    res = BddEnc_apply_input_vars_mask_bdd(self->enc, inputs);
+    insert_assoc(self->inputs, (node_ptr)bdd_dup(state), (node_ptr)res);
+
+    mask = bdd_to_01_add(self->dd, res);
+    zero = add_zero(self->dd);
+    insert_assoc(self->weights, (node_ptr)bdd_dup(state),
+                 (node_ptr)add_ifthenelse(self->dd, mask, self->input_probs,
+                                          zero));
+
+    add_free(self->dd, zero);
+    add_free(self->dd, mask);
+    bdd_free(self->dd, inputs);
+    bdd_free(self->dd, si);
+    bdd_free(self->dd, legal);
+  }
+
+  return res;
+}
+
+/*!
+  \brief Picks uniformly an input leading from the current state to
+  state
+
+  The returned bdd is referenced.
+*/
+static bdd_ptr stat_simulator_pick_input(StatSimulator_ptr self,
+                                         bdd_ptr state)
+{
+  bdd_ptr inputs =
+    BddFsm_states_to_states_get_inputs(self->fsm, self->current, state);
+  bdd_ptr masked_inputs = BddEnc_apply_input_vars_mask_bdd(self->enc, inputs);
+  bdd_ptr res = BddEnc_pick_one_input_uniform(self->enc, masked_inputs,
+                                              self->gen);
+
+  bdd_free(self->dd, masked_inputs);
+  bdd_free(self->dd, inputs);
+
+  return res;
+}
+
+/*!
+  \brief Returns the number of successors of state at each level
+
+  Element j of the returned array is the number of successors
+  having level j, for j from 0 to levels_num. The array is cached
+  and must not be freed.
+*/
+static const double* stat_simulator_get_counts(StatSimulator_ptr self,
+                                               bdd_ptr state)
+{
+  double* res = (double*)find_assoc(self->counts, (node_ptr)state);
+
+  if ((double*)NULL == res) {
+    bdd_ptr image = stat_simulator_get_image(self, state);
+    bdd_ptr set = bdd_dup(image);
+    double above = BddEnc_count_states_of_bdd(self->enc, set);
+    int j;
+
+    res = ALLOC(double, self->levels_num + 1);
+
+    for (j = 0; j < self->levels_num; j++) {
+      double count;
+
+      bdd_and_accumulate(self->dd, &set, self->levels[j]);
+      count = BddEnc_count_states_of_bdd(self->enc, set);
+
+      res[j] = above - count;
+      above = count;
+    }
+    res[self->levels_num] = above;
+    bdd_free(self->dd, set);
+
+    insert_assoc(self->counts, (node_ptr)bdd_dup(state), (node_ptr)res);
+  }
+
+  return res;
+}
+
+/*!
+  \brief Returns the states of image having exactly the given level
+
+  The returned bdd is referenced.
+*/
+static bdd_ptr stat_simulator_get_level_set(StatSimulator_ptr self,
+                                            bdd_ptr image, int level)
+{
+  bdd_ptr res = bdd_dup(image);
+
+  if (0 < level) bdd_and_accumulate(self->dd, &res, self->levels[level - 1]);
+
+  if (level < self->levels_num) {
+    bdd_ptr above = bdd_not(self->dd, self->levels[level]);
+
+    bdd_and_accumulate(self->dd, &res, above);
+    bdd_free(self->dd, above);
+  }
+
+  return res;
+}
+
+/*!
+  \brief Forgets the level sets and the counts computed on them
+
+*/
+static void stat_simulator_clear_levels(StatSimulator_ptr self)
+{
+  int i;
+
+  clear_assoc_and_free_entries_arg(self->counts, stat_simulator_free_counts,
+                                   (char*)self->dd);
+
+  if ((bdd_ptr*)NULL != self->levels) {
+    for (i = 0; i < self->levels_num; i++) {
+      bdd_free(self->dd, self->levels[i]);
+    }
+    FREE(self->levels);
+    self->levels = (bdd_ptr*)NULL;
+  }
+  self->levels_num = 0;
+}
+
+/*!
+  \brief Empties the caches exceeding their budget
+
+  Called when an execution starts, as the cached values are used
+  only within a step. The expressions already returned are hashed,
+  and outlive the cache.
+*/
+static void stat_simulator_trim_caches(StatSimulator_ptr self)
+{
+  const NuSMVEnv_ptr env = STAT_ENV(self);
+
+  if (Stat_is_cache_full(env, self->images)) {
+    clear_assoc_and_free_entries_arg(self->images, stat_simulator_free_image,
+                                     (char*)self->dd);
+  }
+
+  /* inputs and weights have the same keys */
+  if (Stat_is_cache_full(env, self->inputs)) {
+    clear_assoc_and_free_entries_arg(self->inputs, stat_simulator_free_image,
+                                     (char*)self->dd);
+    clear_assoc_and_free_entries_arg(self->weights, stat_simulator_free_image,
+                                     (char*)self->dd);
+  }
+
+  if (Stat_is_cache_full(env, self->sexps)) {
+    clear_assoc_and_free_entries_arg(self->sexps, stat_simulator_free_key,
+                                     (char*)self->dd);
+  }
+
+  if (Stat_is_cache_full(env, self->counts)) {
+    clear_assoc_and_free_entries_arg(self->counts, stat_simulator_free_counts,
+                                     (char*)self->dd);
+  }
+}
+
+/*!
+  \brief Returns the weight of a leaf of input_probs
+
+  Leaves must be integer or real constants.
+*/
+static double stat_simulator_leaf_weight(node_ptr leaf, void* arg)
+{
+  const StatSimulator_ptr self = STAT_SIMULATOR(arg);
+  const ErrorMgr_ptr errmgr =
+    ERROR_MGR(NuSMVEnv_get_value(STAT_ENV(self), ENV_ERROR_MANAGER));
+
+  switch (node_get_type(leaf)) {
+  case NUMBER:
+    return (double)node_get_int(leaf);
+
+  case NUMBER_REAL:
+    return strtod(UStringMgr_get_string_text((string_ptr)car(leaf)),
+                  (char**)NULL);
+
+  default:
+    ErrorMgr_rpterr(errmgr, "Input probabilities must be numeric constants\n");
+  }
+
+  error_unreachable_code();
+  return 0.0;
+}
+
+/*!
+  \brief Returns the sexp of the given state and input
+
+  input can be NULL, in this case only the state variables occur in
+  the sexp. The sexp is built as TraceUtils_fetch_as_sexp does, and
+  it is cached by minterm.
+*/
+static Expr_ptr stat_simulator_get_sexp(StatSimulator_ptr self,
+                                        bdd_ptr state, bdd_ptr input)
+{
+  const ExprMgr_ptr exprs =
+    EXPR_MGR(NuSMVEnv_get_value(STAT_ENV(self), ENV_EXPR_MANAGER));
+  bdd_ptr key;
+  Expr_ptr res;
+
+  if ((bdd_ptr)NULL == input) key = bdd_dup(state);
+  else key = bdd_and(self->dd, state, input);
+
+  res = find_assoc(self->sexps, (node_ptr)key);
+
+  if (Nil == res) {
+    const StatProfiler_ptr profiler = Stat_get_profiler(STAT_ENV(self));
+
+    if (STAT_PROFILER(NULL) != profiler) {
+      StatProfiler_start(profiler, STAT_STAGE_CONVERSION);
+    }
+
+    res = stat_simulator_assign(self, state, self->sf_vars,
+                                ExprMgr_true(exprs));
+
+    if ((bdd_ptr)NULL != input) {
+      res = stat_simulator_assign(self, input, self->i_vars, res);
+    }
+
+    if (STAT_PROFILER(NULL) != profiler) {
+      StatProfiler_stop(profiler, STAT_STAGE_CONVERSION);
+    }
+
+    /* the key is kept referenced by the hash */
+    insert_assoc(self->sexps, (node_ptr)key, res);
+  }
+  else {
+    bdd_free(self->dd, key);
+  }
+
+  return res;
+}
+
+/*!
+  \brief Conjoins res with the values of vars in minterm
+
+*/
+static Expr_ptr stat_simulator_assign(StatSimulator_ptr self,
+                                      bdd_ptr minterm, NodeList_ptr vars,
+                                      Expr_ptr res)
+{
+  const NuSMVEnv_ptr env = STAT_ENV(self);
+  const NodeMgr_ptr nodemgr = NODE_MGR(NuSMVEnv_get_value(env, ENV_NODE_MGR));
+  const ExprMgr_ptr exprs = EXPR_MGR(NuSMVEnv_get_value(env, ENV_EXPR_MANAGER));
+  const SymbTable_ptr st = BaseEnc_get_symb_table(BASE_ENC(self->enc));
+  node_ptr assigns;
+  node_ptr iter;
+
+  assigns = BddEnc_assign_symbols(self->enc, minterm, vars, false,
+                                  (bdd_ptr*)NULL);
+
+  for (iter = assigns; Nil != iter; iter = cdr(iter)) {
+    node_ptr assign = car(iter);
+
+    nusmv_assert(EQUAL == node_get_type(assign));
+    res = ExprMgr_and(exprs,
+                      ExprMgr_equal(exprs, car(assign), cdr(assign), st),
+                      res);
+  }
+
+  free_list(nodemgr, assigns);
+
+  return res;
+}
+
+/*!
+  \brief Sets the current state
+
+  state is duplicated, and can be NULL
+*/
+static void stat_simulator_set_current(StatSimulator_ptr self,
+                                       bdd_ptr state)
+{
+  if ((bdd_ptr)NULL != self->current) bdd_free(self->dd, self->current);
+
+  self->current = ((bdd_ptr)NULL != state) ?
+    bdd_dup(state) : (bdd_ptr)NULL;
+}
+
+/*!
+  \brief Private service
+
+  Used when destroying hash containing bdd_ptr as keys and data
+*/
+static assoc_retval stat_simulator_free_image(char* key, char* data,
+                                              char* arg)
+{
+  DDMgr_ptr dd = (DDMgr_ptr) arg;
+
+  if ((bdd_ptr)NULL != (bdd_ptr)key) { bdd_free(dd, (bdd_ptr)key); }
+  if ((bdd_ptr)NULL != (bdd_ptr)data) { bdd_free(dd, (bdd_ptr)data); }
+  return ASSOC_DELETE;
+}
+
+/*!
+  \brief Private service
+
+  Used when destroying hash containing bdd_ptr as keys
+*/
+static assoc_retval stat_simulator_free_key(char* key, char* data,
+                                            char* arg)
+{
+  DDMgr_ptr dd = (DDMgr_ptr) arg;
+
+  if ((bdd_ptr)NULL != (bdd_ptr)key) { bdd_free(dd, (bdd_ptr)key); }
+  return ASSOC_DELETE;
+}
+
+/*!
+  \brief Private service
+
+  Used when destroying hash containing bdd_ptr as keys and arrays as
+  data
+*/
+static assoc_retval stat_simulator_free_counts(char* key, char* data,
+                                               char* arg)
+{
+  DDMgr_ptr dd = (DDMgr_ptr) arg;
+
+  if ((bdd_ptr)NULL != (bdd_ptr)key) { bdd_free(dd, (bdd_ptr)key); }
+  if ((double*)NULL != (double*)data) { FREE(data); }
+  return ASSOC_DELETE;
+}
+
+/**AutomaticEnd***************************************************************/
@@ -0,0 +1,196 @@
+/* ---------------------------------------------------------------------------
+
+
+  This file is part of the ``stat'' package of NuSMV version 2.
+  Copyright (C) 2012 by FBK-irst.
+
+  NuSMV version 2 is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  NuSMV version 2 is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA.
+
+  For more information on NuSMV see <http://nusmv.fbk.eu>
+  or email to <nusmv-users@fbk.eu>.
+  Please report bugs to <nusmv-users@fbk.eu>.
+
+  To contact the NuSMV development board, email to <nusmv@fbk.eu>.
+
+-----------------------------------------------------------------------------*/
+
+/*!
+  \author Alberto Bombardelli
+  \brief Public interface of class 'StatSimulator'
+
+  A StatSimulator draws the random executions of the model used by
+  the statistical problem generators. Unlike the simulate package, it
+  neither builds nor registers traces and prints nothing: each step
+  is a forward image of the current state, a random choice of a
+  successor (and of an input leading to it) and the translation of
+  the chosen state into the sexp stored in the StatTrace.
+
+  States are BDD minterms, thus they are canonical: the images and
+  the sexps of the visited states are cached, so each distinct state
+  of the model is processed once.
+
+*/
+
+
+
+#ifndef __NUSMV_CORE_STAT_STAT_SIMULATOR_H__
+#define __NUSMV_CORE_STAT_STAT_SIMULATOR_H__
+
+#include "nusmv/core/cinit/NuSMVEnv.h"
+#include "nusmv/core/utils/utils.h"
+#include "nusmv/core/wff/ExprMgr.h"
+#include "nusmv/core/dd/dd.h"
+
+/*!
+  \struct StatSimulator
+  \brief Definition of the public accessor for class StatSimulator
+
+*/
+typedef struct StatSimulator_TAG*  StatSimulator_ptr;
+
+/*!
+  \brief To cast and check instances of class StatSimulator
+
+  These macros must be used respectively to cast and to check
+  instances of class StatSimulator
+*/
+#define STAT_SIMULATOR(self) \
+         ((StatSimulator_ptr) self)
+
+/*!
+  \brief \todo Missing synopsis
+
+  \todo Missing description
+*/
+#define STAT_SIMULATOR_CHECK_INSTANCE(self) \
+         (nusmv_assert(STAT_SIMULATOR(self) != STAT_SIMULATOR(NULL)))
+
+
+/**AutomaticStart*************************************************************/
+
+/*---------------------------------------------------------------------------*/
+/* Function prototypes                                                       */
+/*---------------------------------------------------------------------------*/
+
+/* Constructors ***************************************************************/
+
+/*!
+  \methodof StatSimulator
+  \brief The StatSimulator class constructor
+
+  Creates a simulator of the BDD fsm of the environment
+
+  \sa StatSimulator_destroy
+*/
+StatSimulator_ptr StatSimulator_create(const NuSMVEnv_ptr env);
+
+/* Destructors ****************************************************************/
+
+/*!
+  \methodof StatSimulator
+  \brief The StatSimulator class destructor
+
+  \sa StatSimulator_create
+*/
+void StatSimulator_destroy(StatSimulator_ptr self);
+
+/*!
+  \methodof StatSimulator
+  \brief Starts a new execution from a random initial state
+
+  Returns the sexp of the chosen state (state and frozen variables),
+  or Nil if the set of initial states is empty.
+*/
+Expr_ptr StatSimulator_pick_init(StatSimulator_ptr self);
+
+/*!
+  \methodof StatSimulator
+  \brief Extends the current execution with a random step
+
+  Returns the sexp of the chosen state and of the input leading to
+  it (state, frozen and input variables), or Nil if the current
+  state has no successors. An execution must have been started with
+  StatSimulator_pick_init.
+*/
+Expr_ptr StatSimulator_step(StatSimulator_ptr self);
+
+/*!
+  \methodof StatSimulator
+  \brief Returns the current state of the execution
+
+  The returned bdd is referenced. An execution must have been
+  started.
+*/
+bdd_ptr StatSimulator_get_state(const StatSimulator_ptr self);
+
+/*!
+  \methodof StatSimulator
+  \brief Continues an execution from the given state
+
+  state must be a state returned by StatSimulator_get_state. It is
+  duplicated.
+*/
+void StatSimulator_restart(StatSimulator_ptr self, bdd_ptr state);
+
+/*!
+  \methodof StatSimulator
+  \brief Sets the level sets used by the tilted simulation
+
+  levels must be nested: levels[i + 1] is contained in levels[i].
+  The level of a state is the number of level sets containing it.
+  The bdds are duplicated.
+*/
+void StatSimulator_set_levels(StatSimulator_ptr self,
+                              bdd_ptr* levels, const int levels_num);
+
+/*!
+  \methodof StatSimulator
+  \brief Returns the level of the current state
+
+  \sa StatSimulator_set_levels
+*/
+int StatSimulator_get_level(const StatSimulator_ptr self);
+
+/*!
+  \methodof StatSimulator
+  \brief Returns how many successors of the current state have each
+  level
+
+  Element j of the returned array, for j from 0 to the number of
+  level sets, is the number of successors of level j. The array is
+  owned by the simulator, and stays valid until the level sets
+  change.
+
+  \sa StatSimulator_set_levels
+*/
+const double* StatSimulator_get_successor_levels(StatSimulator_ptr self);
+
+/*!
+  \methodof StatSimulator
+  \brief Extends the current execution with a biased random step
+
+  The successor is drawn with probability proportional to
+  exp(theta * level) instead of uniformly, and ratio is set to the
+  probability it has in StatSimulator_step over the one it has been
+  drawn with (the likelihood ratio of the step). Level sets must have
+  been set, and no input probability can be used. Returns as
+  StatSimulator_step.
+*/
+Expr_ptr StatSimulator_step_tilted(StatSimulator_ptr self,
+                                   const double theta, double* ratio);
+
+/**AutomaticEnd***************************************************************/
+
+#endif /* __NUSMV_CORE_STAT_STAT_SIMULATOR_H__ */
@@ -0,0 +1,522 @@
+/* ---------------------------------------------------------------------------
+
+
+  This file is part of the ``stat'' package of NuSMV version 2.
+  Copyright (C) 2012 by FBK-irst.
+
+  NuSMV version 2 is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  NuSMV version 2 is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA.
+
+  For more information on NuSMV see <http://nusmv.fbk.eu>
+  or email to <nusmv-users@fbk.eu>.
+  Please report bugs to <nusmv-users@fbk.eu>.
+
+  To contact the NuSMV development board, email to <nusmv@fbk.eu>.
+
+-----------------------------------------------------------------------------*/
+
+/*!
+  \author Alberto Bombardelli
+  \brief Implementation of class 'StatTableau'
+
+  The product M x T of the model and the tableau of the negated
+  property is built once. An execution s_0 ... s_{k-1} with loopback
+  l violates the property iff M x T has a fair path whose projection
+  on the model follows the lasso. Such a path is searched with the
+  Emerson-Lei algorithm, where each set of states is split on the
+  lasso positions: position i only contains the states of M x T
+  whose model part is s_i, and the predecessors of position i are
+  searched in position succ(i) only.
+
+*/
+
+#include "nusmv/core/stat/StatTableau.h"
+#include "nusmv/core/stat/statInt.h"
+
+#include "nusmv/core/utils/EnvObject.h"
+#include "nusmv/core/utils/EnvObject_private.h"
+#include "nusmv/core/utils/assoc.h"
+#include "nusmv/core/utils/ErrorMgr.h"
+#include "nusmv/core/utils/error.h" /* for CATCH(errmgr) */
+
+#include "nusmv/core/parser/symbols.h"
+#include "nusmv/core/ltl/ltl.h"
+#include "nusmv/core/enc/bdd/BddEnc.h"
+#include "nusmv/core/fsm/bdd/BddFsm.h"
+#include "nusmv/core/fsm/bdd/FairnessList.h"
+#include "nusmv/core/wff/wffRewrite.h"
+
+/*---------------------------------------------------------------------------*/
+/* Constant declarations                                                     */
+/*---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*/
+/* Structure declarations                                                    */
+/*---------------------------------------------------------------------------*/
+
+typedef struct StatTableau_TAG
+{
+  /* this MUST stay on the top */
+  INHERITS_FROM(EnvObject);
+
+  /* -------------------------------------------------- */
+  /*                  Private members                   */
+  /* -------------------------------------------------- */
+  /* owner of the tableau layer and of the product fsm, NULL if the
+     property is not supported */
+  Ltl_StructCheckLtlSpec_ptr ltl;
+
+  /* product of the model and the tableau, owned by ltl */
+  BddFsm_ptr fsm;
+  BddEnc_ptr enc;
+  DDMgr_ptr dd;
+
+  /* initial states of the product */
+  bdd_ptr init;
+
+  /* justice constraints of the product (at least one) */
+  bdd_ptr* justice;
+  int justice_num;
+
+  /* states hash map: state sexp -> bdd_ptr (referenced) */
+  hash_ptr states;
+} StatTableau;
+
+/*---------------------------------------------------------------------------*/
+/* Type declarations                                                         */
+/*---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*/
+/* Variable declarations                                                     */
+/*---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*/
+/* Macro declarations                                                        */
+/*---------------------------------------------------------------------------*/
+#define STAT_ENV(self) (ENV_OBJECT(self)->environment)
+
+/*!
+  \brief Successor of position i on a lasso of length k and loopback l
+
+*/
+#define LASSO_SUCC(k, l, i) \
+  (((i) + 1 < (k)) ? (i) + 1 : (l))
+
+/**AutomaticStart*************************************************************/
+
+/*---------------------------------------------------------------------------*/
+/* Static function prototypes                                                */
+/*---------------------------------------------------------------------------*/
+
+static void stat_tableau_init(StatTableau_ptr self,
+                              const NuSMVEnv_ptr env,
+                              const Prop_ptr prop);
+
+static void stat_tableau_deinit(StatTableau_ptr self);
+
+static boolean stat_tableau_build(StatTableau_ptr self, const Prop_ptr prop);
+
+static void stat_tableau_fair_loop(StatTableau_ptr self,
+                                   bdd_ptr* positions,
+                                   const int k, const int l,
+                                   bdd_ptr* res);
+
+static bdd_ptr stat_tableau_pre(StatTableau_ptr self,
+                                bdd_ptr position, bdd_ptr next);
+
+static bdd_ptr stat_tableau_get_state_bdd(StatTableau_ptr self,
+                                          const Expr_ptr state);
+
+static assoc_retval stat_tableau_free_bdd(char* key, char* data, char* arg);
+
+/*---------------------------------------------------------------------------*/
+/* Definition of exported functions                                          */
+/*---------------------------------------------------------------------------*/
+
+StatTableau_ptr StatTableau_create(const NuSMVEnv_ptr env,
+                                   const Prop_ptr prop)
+{
+  StatTableau_ptr self = ALLOC(StatTableau, 1);
+  STAT_TABLEAU_CHECK_INSTANCE(self);
+
+  stat_tableau_init(self, env, prop);
+
+  return self;
+}
+
+void StatTableau_destroy(StatTableau_ptr self)
+{
+  STAT_TABLEAU_CHECK_INSTANCE(self);
+
+  stat_tableau_deinit(self);
+
+  FREE(self);
+}
+
+boolean StatTableau_is_supported(const StatTableau_ptr self)
+{
+  STAT_TABLEAU_CHECK_INSTANCE(self);
+
+  return (Ltl_StructCheckLtlSpec_ptr)NULL != self->ltl;
+}
+
+StatVericationResult StatTableau_check(StatTableau_ptr self,
+                                       const StatTrace_ptr execution)
+{
+  NodeList_ptr state_list;
+  ListIter_ptr iter;
+  bdd_ptr* positions;
+  bdd_ptr* paths;
+  bdd_ptr witness;
+  int k, l, i;
+
+  STAT_TABLEAU_CHECK_INSTANCE(self);
+  nusmv_assert(StatTableau_is_supported(self));
+  nusmv_assert(StatTrace_is_generated(execution));
+
+  k = StatTrace_get_length(execution);
+  /* loopback is the 1-based index of the first state of the loop */
+  l = StatTrace_get_loopback(execution) - 1;
+  nusmv_assert(0 <= l && l < k);
+
+  /* the states of the previous executions are not in use anymore */
+  if (Stat_is_cache_full(STAT_ENV(self), self->states)) {
+    clear_assoc_and_free_entries_arg(self->states, stat_tableau_free_bdd,
+                                     (char*)self->dd);
+  }
+
+  positions = ALLOC(bdd_ptr, k);
+  paths = ALLOC(bdd_ptr, k);
+  nusmv_assert((bdd_ptr*)NULL != positions && (bdd_ptr*)NULL != paths);
+
+  state_list = StatTrace_get_sexp_states(execution);
+  i = 0;
+  NODE_LIST_FOREACH(state_list, iter) {
+    positions[i] =
+      stat_tableau_get_state_bdd(self, NodeList_get_elem_at(state_list, iter));
+    paths[i] = (bdd_ptr)NULL;
+    i++;
+  }
+
+  /* (1) states of the loop from which a fair path follows the loop */
+  stat_tableau_fair_loop(self, positions, k, l, paths);
+
+  /* (2) states of the stem from which the fair loop is reached */
+  for (i = l - 1; i >= 0; i--) {
+    paths[i] = stat_tableau_pre(self, positions[i], paths[i + 1]);
+  }
+
+  /* (3) a witness exists iff an initial state is in the first position */
+  witness = bdd_and(self->dd, paths[0], self->init);
+
+  for (i = 0; i < k; i++) bdd_free(self->dd, paths[i]);
+  FREE(paths);
+  FREE(positions);
+
+  {
+    const boolean violated = bdd_isnot_false(self->dd, witness);
+
+    bdd_free(self->dd, witness);
+    return violated ? STAT_NOT_OK : STAT_OK;
+  }
+}
+
+/*---------------------------------------------------------------------------*/
+/* Definition of internal functions                                          */
+/*---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*/
+/* Definition of static functions                                            */
+/*---------------------------------------------------------------------------*/
+
+/*!
+  \brief The StatTableau class private initializer
+
+  \sa StatTableau_create
+*/
+static void stat_tableau_init(StatTableau_ptr self,
+                              const NuSMVEnv_ptr env,
+                              const Prop_ptr prop)
+{
+  env_object_init(ENV_OBJECT(self), env);
+
+  self->ltl = (Ltl_StructCheckLtlSpec_ptr)NULL;
+  self->fsm = BDD_FSM(NULL);
+  self->enc = BDD_ENC(NULL);
+  self->dd = (DDMgr_ptr)NULL;
+  self->init = (bdd_ptr)NULL;
+  self->justice = (bdd_ptr*)NULL;
+  self->justice_num = 0;
+  self->states = new_assoc();
+
+  nusmv_assert(Prop_Ltl == Prop_get_type(prop));
+
+  if (stat_tableau_build(self, prop)) {
+    JusticeList_ptr justice = BddFsm_get_justice(self->fsm);
+    FairnessListIterator_ptr fiter;
+    int j;
+
+    self->init = BddFsm_get_init(self->fsm);
+
+    self->justice_num = 0;
+    fiter = FairnessList_begin(FAIRNESS_LIST(justice));
+    while (! FairnessListIterator_is_end(fiter)) {
+      self->justice_num++;
+      fiter = FairnessListIterator_next(fiter);
+    }
+
+    /* with no justice constraints every loop is fair */
+    if (0 == self->justice_num) {
+      self->justice = ALLOC(bdd_ptr, 1);
+      nusmv_assert((bdd_ptr*)NULL != self->justice);
+
+      self->justice[0] = bdd_true(self->dd);
+      self->justice_num = 1;
+    }
+    else {
+      self->justice = ALLOC(bdd_ptr, self->justice_num);
+      nusmv_assert((bdd_ptr*)NULL != self->justice);
+
+      j = 0;
+      fiter = FairnessList_begin(FAIRNESS_LIST(justice));
+      while (! FairnessListIterator_is_end(fiter)) {
+        self->justice[j++] = JusticeList_get_p(justice, fiter);
+        fiter = FairnessListIterator_next(fiter);
+      }
+    }
+  }
+}
+
+/*!
+  \brief The StatTableau class private deinitializer
+
+  \sa StatTableau_destroy
+*/
+static void stat_tableau_deinit(StatTableau_ptr self)
+{
+  if ((Ltl_StructCheckLtlSpec_ptr)NULL != self->ltl) {
+    int j;
+
+    clear_assoc_and_free_entries_arg(self->states, stat_tableau_free_bdd,
+                                     (char*)self->dd);
+
+    for (j = 0; j < self->justice_num; j++) {
+      bdd_free(self->dd, self->justice[j]);
+    }
+    FREE(self->justice);
+    bdd_free(self->dd, self->init);
+
+    /* this removes the tableau layer as well */
+    Ltl_StructCheckLtlSpec_destroy(self->ltl);
+    self->ltl = (Ltl_StructCheckLtlSpec_ptr)NULL;
+  }
+
+  free_assoc(self->states); self->states = (hash_ptr)NULL;
+
+  self->fsm = BDD_FSM(NULL);
+  self->enc = BDD_ENC(NULL);
+  self->dd = (DDMgr_ptr)NULL;
+
+  env_object_deinit(ENV_OBJECT(self));
+}
+
+/*!
+  \brief Builds the product of the model and the tableau
+
+  Returns false if the property is not supported. Errors raised
+  during the construction are not propagated: in that case false
+  is returned as well, and the model checker will report them.
+*/
+static boolean stat_tableau_build(StatTableau_ptr self, const Prop_ptr prop)
+{
+  const NuSMVEnv_ptr env = STAT_ENV(self);
+  const ErrorMgr_ptr errmgr =
+    ERROR_MGR(NuSMVEnv_get_value(env, ENV_ERROR_MANAGER));
+  const SymbTable_ptr st = SYMB_TABLE(NuSMVEnv_get_value(env, ENV_SYMB_TABLE));
+  Expr_ptr spec = Prop_get_expr_core(prop);
+  node_ptr context = Nil;
+  Ltl_StructCheckLtlSpec_ptr ltl;
+  boolean built = false;
+
+  if (CONTEXT == node_get_type(spec)) {
+    context = car(spec);
+    spec = cdr(spec);
+  }
+
+  /* the rewriting would introduce a layer per property */
+  if (Wff_Rewrite_is_rewriting_needed(st, spec, context)) return false;
+
+  ltl = Ltl_StructCheckLtlSpec_create(env, prop);
+  Ltl_StructCheckLtlSpec_set_do_rewriting(ltl, false);
+
+  CATCH(errmgr) {
+    Ltl_StructCheckLtlSpec_build(ltl);
+    built = true;
+  }
+  FAIL(errmgr) {
+    built = false;
+  }
+
+  if (built) {
+    BddFsm_ptr fsm = Ltl_StructCheckLtlSpec_get_fsm(ltl);
+
+    /* strong fairness would require the full fair states algorithm */
+    if (! FairnessList_is_empty(FAIRNESS_LIST(BddFsm_get_compassion(fsm)))) {
+      built = false;
+    }
+    else {
+      self->ltl = ltl;
+      self->fsm = fsm;
+      self->enc = BddFsm_get_bdd_encoding(fsm);
+      self->dd = BddEnc_get_dd_manager(self->enc);
+    }
+  }
+
+  if (! built) Ltl_StructCheckLtlSpec_destroy(ltl);
+
+  return built;
+}
+
+/*!
+  \brief Computes the fair states of the loop of a lasso
+
+  positions[i] is the set of states of the product whose model part
+  is the i-th state of the lasso. res[l] ... res[k-1] are set to the
+  states of the respective positions from which a path following the
+  loop and visiting all the justice constraints infinitely often
+  starts. The computed bdds are referenced.
+*/
+static void stat_tableau_fair_loop(StatTableau_ptr self,
+                                   bdd_ptr* positions,
+                                   const int k, const int l,
+                                   bdd_ptr* res)
+{
+  bdd_ptr* until = ALLOC(bdd_ptr, k);
+  boolean changed;
+  int i, j;
+
+  nusmv_assert((bdd_ptr*)NULL != until);
+
+  for (i = l; i < k; i++) res[i] = bdd_dup(positions[i]);
+
+  /* Z := nu Z. positions & AND_j EX E[Z U (Z & J_j)] */
+  do {
+    changed = false;
+
+    for (j = 0; j < self->justice_num; j++) {
+      boolean until_changed;
+
+      /* E[Z U (Z & J_j)] */
+      for (i = l; i < k; i++) {
+        until[i] = bdd_and(self->dd, res[i], self->justice[j]);
+      }
+
+      do {
+        until_changed = false;
+
+        for (i = k - 1; i >= l; i--) {
+          bdd_ptr pre =
+            stat_tableau_pre(self, res[i], until[LASSO_SUCC(k, l, i)]);
+
+          if (bdd_entailed(self->dd, pre, until[i])) {
+            bdd_free(self->dd, pre);
+          }
+          else {
+            bdd_or_accumulate(self->dd, &(until[i]), pre);
+            bdd_free(self->dd, pre);
+            until_changed = true;
+          }
+        }
+      } while (until_changed);
+
+      /* Z & EX E[Z U (Z & J_j)] */
+      for (i = k - 1; i >= l; i--) {
+        bdd_ptr pre =
+          stat_tableau_pre(self, res[i], until[LASSO_SUCC(k, l, i)]);
+
+        if (pre != res[i]) changed = true;
+        bdd_free(self->dd, res[i]);
+        res[i] = pre;
+      }
+
+      for (i = l; i < k; i++) bdd_free(self->dd, until[i]);
+    }
+  } while (changed);
+
+  FREE(until);
+}
+
+/*!
+  \brief States of position having a successor in next
+
+  The returned bdd is referenced
+*/
+static bdd_ptr stat_tableau_pre(StatTableau_ptr self,
+                                bdd_ptr position, bdd_ptr next)
+{
+  bdd_ptr res;
+
+  if (bdd_is_false(self->dd, next)) return bdd_dup(next);
+
+  res = BddFsm_get_backward_image(self->fsm, next);
+  bdd_and_accumulate(self->dd, &res, position);
+
+  return res;
+}
+
+/*!
+  \brief Returns the (cached) set of product states of an execution
+  state
+
+  Input variables are abstracted away. The returned BDD is owned by
+  the tableau.
+*/
+static bdd_ptr stat_tableau_get_state_bdd(StatTableau_ptr self,
+                                          const Expr_ptr state)
+{
+  bdd_ptr res = (bdd_ptr)find_assoc(self->states, state);
+
+  if ((bdd_ptr)NULL == res) {
+    BddVarSet_ptr inputs = BddEnc_get_input_vars_cube(self->enc);
+    bdd_ptr invar = BddFsm_get_state_constraints(self->fsm);
+    bdd_ptr state_bdd = BddEnc_expr_to_bdd(self->enc, state, Nil);
+
+    res = bdd_forsome(self->dd, state_bdd, inputs);
+    bdd_and_accumulate(self->dd, &res, invar);
+
+    bdd_free(self->dd, state_bdd);
+    bdd_free(self->dd, invar);
+    bdd_free(self->dd, (bdd_ptr)inputs);
+
+    insert_assoc(self->states, state, (node_ptr)res);
+  }
+
+  return res;
+}
+
+/*!
+  \brief Private service
+
+  Used when destroying hash containing bdd_ptr as data
+*/
+static assoc_retval stat_tableau_free_bdd(char* key, char* data, char* arg)
+{
+  bdd_ptr bdd = (bdd_ptr) data;
+  DDMgr_ptr dd = (DDMgr_ptr) arg;
+
+  if (bdd != (bdd_ptr) NULL) { bdd_free(dd, bdd); }
+  return ASSOC_DELETE;
+}
+
+/**AutomaticEnd***************************************************************/
@@ -0,0 +1,138 @@
+/* ---------------------------------------------------------------------------
+
+
+  This file is part of the ``stat'' package of NuSMV version 2.
+  Copyright (C) 2012 by FBK-irst.
+
+  NuSMV version 2 is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  NuSMV version 2 is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA.
+
+  For more information on NuSMV see <http://nusmv.fbk.eu>
+  or email to <nusmv-users@fbk.eu>.
+  Please report bugs to <nusmv-users@fbk.eu>.
+
+  To contact the NuSMV development board, email to <nusmv@fbk.eu>.
+
+-----------------------------------------------------------------------------*/
+
+/*!
+  \author Alberto Bombardelli
+  \brief Public interface of class 'StatTableau'
+
+  A StatTableau model checks the executions produced by the
+  statistical problem generators against an LTL property, building
+  the tableau of the negated property only once.
+
+  The tableau is built with ltl2smv and encoded when the StatTableau
+  is created, and kept in the symbol table and in the encoders until
+  it is destroyed. Each execution is then checked by searching a fair
+  path of the product of the model and the tableau which follows the
+  lasso: the fixpoints are computed on one BDD per lasso position,
+  with no per execution layer, property or tableau.
+
+  Properties that require input rewriting (i.e. that contain input
+  variables or next() expressions) and models with compassion
+  constraints are not supported.
+
+*/
+
+
+
+#ifndef __NUSMV_CORE_STAT_STAT_TABLEAU_H__
+#define __NUSMV_CORE_STAT_STAT_TABLEAU_H__
+
+#include "nusmv/core/stat/stat.h"
+#include "nusmv/core/stat/StatTrace.h"
+#include "nusmv/core/prop/Prop.h"
+
+/*!
+  \struct StatTableau
+  \brief Definition of the public accessor for class StatTableau
+
+*/
+typedef struct StatTableau_TAG*  StatTableau_ptr;
+
+/*!
+  \brief To cast and check instances of class StatTableau
+
+  These macros must be used respectively to cast and to check
+  instances of class StatTableau
+*/
+#define STAT_TABLEAU(self) \
+         ((StatTableau_ptr) self)
+
+/*!
+  \brief \todo Missing synopsis
+
+  \todo Missing description
+*/
+#define STAT_TABLEAU_CHECK_INSTANCE(self) \
+         (nusmv_assert(STAT_TABLEAU(self) != STAT_TABLEAU(NULL)))
+
+
+/**AutomaticStart*************************************************************/
+
+/*---------------------------------------------------------------------------*/
+/* Function prototypes                                                       */
+/*---------------------------------------------------------------------------*/
+
+/* Constructors ***************************************************************/
+
+/*!
+  \methodof StatTableau
+  \brief The StatTableau class constructor
+
+  Creates the tableau of the given LTL property, if supported.
+
+  \sa StatTableau_destroy
+*/
+StatTableau_ptr StatTableau_create(const NuSMVEnv_ptr env,
+                                   const Prop_ptr prop);
+
+/* Destructors ****************************************************************/
+
+/*!
+  \methodof StatTableau
+  \brief The StatTableau class destructor
+
+  Removes the tableau layer from the encoders and from the symbol
+  table.
+
+  \sa StatTableau_create
+*/
+void StatTableau_destroy(StatTableau_ptr self);
+
+/*!
+  \methodof StatTableau
+  \brief Returns true iff the tableau has been built
+
+  If false is returned the executions must be verified with the
+  model checker.
+*/
+boolean StatTableau_is_supported(const StatTableau_ptr self);
+
+/*!
+  \methodof StatTableau
+  \brief Verifies the property on the given execution
+
+  The execution must be generated (i.e. it must have a
+  loopback). Returns STAT_OK iff no fair path of the model following
+  the lasso violates the property.
+*/
+StatVericationResult StatTableau_check(StatTableau_ptr self,
+                                       const StatTrace_ptr execution);
+
+/**AutomaticEnd***************************************************************/
+
+#endif /* __NUSMV_CORE_STAT_STAT_TABLEAU_H__ */
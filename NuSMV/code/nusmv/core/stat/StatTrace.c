@@ -80,6 +80,28 @@ void StatTrace_destroy(StatTrace_ptr self)
   STAT_TRACE_CHECK_INSTANCE(self);
 
   stat_trace_deinit(self);
+
+  FREE(self);
+}
+
+StatTrace_ptr StatTrace_copy(const StatTrace_ptr self)
+{
+  StatTrace_ptr res;
+  ListIter_ptr iter;
+
+  STAT_TRACE_CHECK_INSTANCE(self);
+
+  res = StatTrace_create();
+
+  NODE_LIST_FOREACH(self->sexp_state_list, iter) {
+    StatTrace_add_state(res, NodeList_get_elem_at(self->sexp_state_list, iter),
+                        false);
+  }
+
+  res->loopback = self->loopback;
+  res->generated = self->generated;
+
+  return res;
 }
 
 boolean StatTrace_has_state(const StatTrace_ptr self,
@@ -96,6 +96,14 @@ StatTrace_ptr StatTrace_create(void);
 */
 void StatTrace_destroy(StatTrace_ptr self);
 
+/*!
+  \methodof StatTrace
+  \brief Returns a copy of StatTrace
+
+  State sexps are shared with self.
+*/
+StatTrace_ptr StatTrace_copy(const StatTrace_ptr self);
+
 /*!
   \methodof StatTrace
   \brief Returns true iff the state sexp is inside StatTrace
@@ -141,6 +149,8 @@ int StatTrace_get_loopback(const StatTrace_ptr self);
   \brief Force loopback
 
   set self->loopback = loopback and set generated as true.
+  Loopbacks start from 1: loopback 0 marks a bounded execution that
+  does not loop.
 */
 void StatTrace_force_loopback(StatTrace_ptr self,
                               const int loopback);
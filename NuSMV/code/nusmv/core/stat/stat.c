@@ -40,16 +40,21 @@
 
 #include "nusmv/core/parser/symbols.h"
 #include "nusmv/core/stat/stat.h"
+#include "nusmv/core/stat/statInt.h"
 #include "nusmv/core/utils/StreamMgr.h"
 #include "nusmv/core/utils/ErrorMgr.h"
+#include "nusmv/core/utils/Logger.h"
 #include "nusmv/core/utils/error.h" /* for CATCH(errmgr) */
+#include "nusmv/core/opt/opt.h"
 #include "nusmv/core/stat/StatProblemsGenerator.h"
+#include "nusmv/core/stat/StatSampler.h"
+#include "nusmv/core/stat/StatCheckpoint.h"
 
 #include <math.h>
+#include <string.h>
 /*---------------------------------------------------------------------------*/
 /* Type declarations                                                         */
 /*---------------------------------------------------------------------------*/
-typedef boolean (*RandomVariable)(const NuSMVEnv_ptr, const Prop_ptr);
 /*---------------------------------------------------------------------------*/
 /* Variable declarations                                                     */
 /*---------------------------------------------------------------------------*/
@@ -73,127 +78,513 @@ static boolean verify_single_simulation_ltl(const NuSMVEnv_ptr env,
 static boolean verify_single_simulation_bmc(const NuSMVEnv_ptr env,
                                             const Prop_ptr ltl_prop);
 /* Statistical algorithm functions */
-static double Stat_approximate(const NuSMVEnv_ptr env,
-                               const Prop_ptr prop_problem,
-                               const double epsilon,
-                               const double delta,
-                               const RandomVariable Z);
-
-static double Stat_stopping_rule_alg(const NuSMVEnv_ptr env,
-                                     const Prop_ptr prob_prop,
+static double stat_check_approximate(const NuSMVEnv_ptr env,
+                                     const Prop_ptr prop,
+                                     const StatEstimator estimator,
                                      const double epsilon,
                                      const double delta,
-                                     const RandomVariable Z);
+                                     const int workers,
+                                     const StatRandomVariable Z,
+                                     const char* env_stat_prob_gen);
+
+static boolean stat_check_sprt(const NuSMVEnv_ptr env,
+                               const Prop_ptr prop,
+                               const double theta,
+                               const double width,
+                               const double alpha,
+                               const double beta,
+                               const int workers,
+                               const StatRandomVariable Z,
+                               const char* env_stat_prob_gen);
+
+static boolean Stat_sprt(const NuSMVEnv_ptr env,
+                         const StatSampler_ptr sampler,
+                         const Prop_ptr prop,
+                         const char* env_stat_prob_gen,
+                         const double p0,
+                         const double p1,
+                         const double alpha,
+                         const double beta);
+
+static void stat_sample(const NuSMVEnv_ptr env,
+                        const StatSampler_ptr sampler,
+                        const Prop_ptr prop,
+                        const char* env_stat_prob_gen,
+                        StatEstimation_ptr estimation);
+
+static void stat_check_shared(const NuSMVEnv_ptr env,
+                              const Prop_ptr* props,
+                              const int props_num,
+                              StatEstimation_ptr* estimations);
+
+static void stat_print_memoization_stats(const NuSMVEnv_ptr env,
+                                         const Prop_ptr prop);
 
 /*---------------------------------------------------------------------------*/
 /* Definition of exported functions                                          */
 /*---------------------------------------------------------------------------*/
 int Stat_check_ltlspec(const NuSMVEnv_ptr env,
                        const Prop_ptr prop,
+                       const StatEstimator estimator,
                        const double error_level,
                        const double confidence_level,
+                       const int workers,
                        double *res)
 {
-  *res = Stat_approximate(env, prop, error_level, confidence_level,
-                          &verify_single_simulation_ltl);
+  *res = stat_check_approximate(env, prop, estimator,
+                                error_level, confidence_level,
+                                workers, &verify_single_simulation_ltl,
+                                ENV_STAT_PROB_GEN);
 
   return 0;
 }
 
 int Stat_check_ltlspec_bmc(const NuSMVEnv_ptr env,
                            const Prop_ptr prop,
+                           const StatEstimator estimator,
                            const double error_level,
                            const double confidence_level,
+                           const int workers,
                            double *res)
 {
-  *res = Stat_approximate(env, prop, error_level, confidence_level,
-                          &verify_single_simulation_bmc);
+  *res = stat_check_approximate(env, prop, estimator,
+                                error_level, confidence_level,
+                                workers, &verify_single_simulation_bmc,
+                                ENV_STAT_PROB_GEN_BMC);
 
   return 0;
 }
+
+int Stat_test_ltlspec(const NuSMVEnv_ptr env,
+                      const Prop_ptr prop,
+                      const double theta,
+                      const double width,
+                      const double alpha,
+                      const double beta,
+                      const int workers,
+                      boolean *res)
+{
+  *res = stat_check_sprt(env, prop, theta, width, alpha, beta,
+                         workers, &verify_single_simulation_ltl,
+                         ENV_STAT_PROB_GEN);
+
+  return 0;
+}
+
+int Stat_check_ltlspecs(const NuSMVEnv_ptr env,
+                        const Prop_ptr* props,
+                        const int props_num,
+                        const StatEstimator estimator,
+                        const double error_level,
+                        const double confidence_level,
+                        double* res)
+{
+  StatEstimation_ptr* estimations = ALLOC(StatEstimation_ptr, props_num);
+  int i;
+
+  for (i = 0; i < props_num; i++) {
+    estimations[i] =
+      StatEstimation_create(estimator, error_level, confidence_level);
+  }
+
+  stat_check_shared(env, props, props_num, estimations);
+
+  for (i = 0; i < props_num; i++) {
+    res[i] = StatEstimation_get_result(estimations[i]);
+    StatEstimation_destroy(estimations[i]);
+  }
+  FREE(estimations);
+
+  return 0;
+}
+
+int Stat_test_ltlspecs(const NuSMVEnv_ptr env,
+                       const Prop_ptr* props,
+                       const int props_num,
+                       const double theta,
+                       const double width,
+                       const double alpha,
+                       const double beta,
+                       boolean* res)
+{
+  StatEstimation_ptr* estimations = ALLOC(StatEstimation_ptr, props_num);
+  int i;
+
+  /* the indifference region must be a non empty subset of [0, 1] */
+  nusmv_assert(0 < width);
+  nusmv_assert(0 <= theta - width && theta + width <= 1);
+
+  for (i = 0; i < props_num; i++) {
+    estimations[i] = StatEstimation_create_test(theta + width, theta - width,
+                                                alpha, beta);
+  }
+
+  stat_check_shared(env, props, props_num, estimations);
+
+  for (i = 0; i < props_num; i++) {
+    res[i] = (1.0 == StatEstimation_get_result(estimations[i]));
+    StatEstimation_destroy(estimations[i]);
+  }
+  FREE(estimations);
+
+  return 0;
+}
+StatEstimator Stat_estimator_from_string(const char* name)
+{
+  if (strcmp(name, "dklr") == 0) return STAT_ESTIMATOR_DKLR;
+  if (strcmp(name, "okamoto") == 0) return STAT_ESTIMATOR_OKAMOTO;
+  if (strcmp(name, "bayes") == 0) return STAT_ESTIMATOR_BAYES;
+
+  return STAT_ESTIMATOR_INVALID;
+}
+
+const char* Stat_estimator_to_string(const StatEstimator estimator)
+{
+  switch (estimator) {
+  case STAT_ESTIMATOR_DKLR: return "dklr";
+  case STAT_ESTIMATOR_OKAMOTO: return "okamoto";
+  case STAT_ESTIMATOR_BAYES: return "bayes";
+
+  default:
+    error_unreachable_code();
+  }
+
+  return NIL(char);
+}
+
 /*---------------------------------------------------------------------------*/
 /* Static function declaration                                               */
 /*---------------------------------------------------------------------------*/
-static double Stat_approximate(const NuSMVEnv_ptr env,
-                               const Prop_ptr prop_problem,
-                               const double epsilon,
-                               const double delta,
-                               const RandomVariable Z)
+
+/*!
+  \brief Runs the given estimator on a fresh sampler of Z
+
+  Z draws its executions with the problem generator
+  env_stat_prob_gen. The sampler (and its workers) is destroyed also
+  when an error occurs. In that case the error is propagated to the
+  caller.
+*/
+static double stat_check_approximate(const NuSMVEnv_ptr env,
+                                     const Prop_ptr prop,
+                                     const StatEstimator estimator,
+                                     const double epsilon,
+                                     const double delta,
+                                     const int workers,
+                                     const StatRandomVariable Z,
+                                     const char* env_stat_prob_gen)
 {
-  double upsilon, upsilon2, mu_hat_Z;
-  double rho_hat_Z;
+  const ErrorMgr_ptr errmgr =
+    ERROR_MGR(NuSMVEnv_get_value(env, ENV_ERROR_MANAGER));
+  StatSampler_ptr sampler = StatSampler_create(env, prop, Z, workers);
+  StatEstimation_ptr estimation =
+    StatEstimation_create(estimator, epsilon, delta);
+  double retval = 0.0;
+  boolean failed = false;
+
+  CATCH(errmgr) {
+    stat_sample(env, sampler, prop, env_stat_prob_gen, estimation);
+    retval = StatEstimation_get_result(estimation);
+  }
+  FAIL(errmgr) {
+    failed = true;
+  }
 
-  int N, alt, cnt;
-  int i, successes;
+  StatEstimation_destroy(estimation);
+  StatSampler_destroy(sampler);
 
-  upsilon = 4 * (M_E - 2) * log(2 / delta) / pow(epsilon, 2);
-  upsilon2 = 2 * (1 + sqrt(epsilon)) * (1 + 2*sqrt(epsilon)) *
-             ((1 + log(1.5)) / log(2 / delta)) * upsilon;
+  if (failed) ErrorMgr_nusmv_exit(errmgr, 1);
 
-  /* phase 1 */
-  mu_hat_Z = Stat_stopping_rule_alg(env, prop_problem,
-                                    min(0.5, sqrt(epsilon)),
-                                    delta / 3,
-                                    Z);
+  stat_print_memoization_stats(env, prop);
 
-  /* phase 2 */
-  N = ceil(2 * upsilon2 * epsilon / mu_hat_Z);
-  alt = 0;
-  cnt = 0;
+  return retval;
+}
 
-  while (cnt < N) {
-    boolean z, z_prime;
+/*!
+  \brief Runs the sequential probability ratio test on a fresh sampler of Z
+
+  Tests H0: P(Z) >= theta + width against H1: P(Z) <= theta - width.
+  The sampler is handled as in stat_check_approximate.
+*/
+static boolean stat_check_sprt(const NuSMVEnv_ptr env,
+                               const Prop_ptr prop,
+                               const double theta,
+                               const double width,
+                               const double alpha,
+                               const double beta,
+                               const int workers,
+                               const StatRandomVariable Z,
+                               const char* env_stat_prob_gen)
+{
+  const ErrorMgr_ptr errmgr =
+    ERROR_MGR(NuSMVEnv_get_value(env, ENV_ERROR_MANAGER));
+  StatSampler_ptr sampler;
+  boolean retval = false;
+  boolean failed = false;
 
-    cnt++;
-    z = Z(env, prop_problem);
+  /* the indifference region must be a non empty subset of [0, 1] */
+  nusmv_assert(0 < width);
+  nusmv_assert(0 <= theta - width && theta + width <= 1);
 
-    cnt++;
-    z_prime = Z(env, prop_problem);
+  sampler = StatSampler_create(env, prop, Z, workers);
 
-    alt += z != z_prime;
+  CATCH(errmgr) {
+    retval = Stat_sprt(env, sampler, prop, env_stat_prob_gen,
+                       theta + width, theta - width, alpha, beta);
+  }
+  FAIL(errmgr) {
+    failed = true;
   }
 
-  /* phase 3 */
+  StatSampler_destroy(sampler);
 
-  rho_hat_Z = max(alt/ N, epsilon * pow(mu_hat_Z, 2));
-  N = upsilon2 * rho_hat_Z / pow(mu_hat_Z, 2);
-  successes = 0;
+  if (failed) ErrorMgr_nusmv_exit(errmgr, 1);
 
-  for (i= 0; i < N; i++) {
-    successes += Z(env, prop_problem);
+  stat_print_memoization_stats(env, prop);
+
+  return retval;
+}
+
+/*!
+  \brief Wald's sequential probability ratio test
+
+  Tests H0: p >= p0 against H1: p <= p1, with p1 < p0. Samples are
+  drawn until the log-likelihood ratio of H1 over H0 leaves the
+  interval (log(beta / (1 - alpha)), log((1 - beta) / alpha)). The
+  probability of accepting H1 when H0 holds is at most alpha, and
+  the probability of accepting H0 when H1 holds is at most beta.
+  Returns true iff H0 is accepted.
+*/
+static boolean Stat_sprt(const NuSMVEnv_ptr env,
+                         const StatSampler_ptr sampler,
+                         const Prop_ptr prop,
+                         const char* env_stat_prob_gen,
+                         const double p0,
+                         const double p1,
+                         const double alpha,
+                         const double beta)
+{
+  StatEstimation_ptr test =
+    StatEstimation_create_test(p0, p1, alpha, beta);
+  boolean res;
+
+  stat_sample(env, sampler, prop, env_stat_prob_gen, test);
+
+  res = (1.0 == StatEstimation_get_result(test));
+  StatEstimation_destroy(test);
+
+  return res;
+}
+
+/*!
+  \brief Feeds estimation with the samples of sampler until it is done
+
+  If a checkpoint file is set, the run is resumed from it when it
+  exists, and its progress is saved there while sampling. The
+  memoized executions saved with it are the ones of the problem
+  generator env_stat_prob_gen. The checkpoint is removed once the
+  estimation is done.
+*/
+static void stat_sample(const NuSMVEnv_ptr env,
+                        const StatSampler_ptr sampler,
+                        const Prop_ptr prop,
+                        const char* env_stat_prob_gen,
+                        StatEstimation_ptr estimation)
+{
+  const ErrorMgr_ptr errmgr =
+    ERROR_MGR(NuSMVEnv_get_value(env, ENV_ERROR_MANAGER));
+  StatProblemsGenerator_ptr prob_gen =
+    STAT_PROBLEMS_GENERATOR(NuSMVEnv_get_value(env, env_stat_prob_gen));
+  StatCheckpoint_ptr checkpoint = STAT_CHECKPOINT(NULL);
+  boolean failed = false;
+
+  if (NuSMVEnv_has_value(env, ENV_STAT_CHECKPOINT)) {
+    if (1 < StatSampler_get_workers_num(sampler)) {
+      ErrorMgr_rpterr(errmgr, "Checkpoints require a single worker\n");
+    }
+
+    /* the memoized executions are restored in the prepared property */
+    if (prop != StatProblemsGenerator_get_prop(prob_gen)) {
+      StatProblemsGenerator_prepare_property(prob_gen, prop);
+    }
+
+    checkpoint =
+      StatCheckpoint_create(env,
+                            (char*)NuSMVEnv_get_value(env,
+                                                      ENV_STAT_CHECKPOINT),
+                            &prop, &estimation, &prob_gen, 1);
+  }
+
+  CATCH(errmgr) {
+    if (STAT_CHECKPOINT(NULL) != checkpoint) {
+      (void)StatCheckpoint_resume(checkpoint);
+    }
+
+    while (! StatEstimation_is_done(estimation)) {
+      StatEstimation_add_sample(estimation, StatSampler_get_sample(sampler));
+
+      if (STAT_CHECKPOINT(NULL) != checkpoint) {
+        StatCheckpoint_update(checkpoint);
+      }
+    }
+  }
+  FAIL(errmgr) {
+    failed = true;
   }
 
-  mu_hat_Z = successes * 1.0 / N;
+  if (STAT_CHECKPOINT(NULL) != checkpoint) {
+    if (! failed) StatCheckpoint_remove(checkpoint);
+    StatCheckpoint_destroy(checkpoint);
+  }
 
-  return mu_hat_Z;
+  if (failed) ErrorMgr_nusmv_exit(errmgr, 1);
 }
 
-static double Stat_stopping_rule_alg(const NuSMVEnv_ptr env,
-                                     const Prop_ptr prob_prop,
-                                     const double epsilon,
-                                     const double delta,
-                                     const RandomVariable Z)
+/*!
+  \brief Feeds all the estimations with the same executions
+
+  Each execution is drawn once by the problem generator of the
+  package, and it is verified against the properties whose
+  estimation is not done yet. A property is not verified anymore as
+  soon as its estimation is done. Each property is verified by its
+  own problem generator, configured as the one of the package, so
+  that every property keeps its own memoized results. Samples are
+  drawn serially. The run is checkpointed as in stat_sample.
+*/
+static void stat_check_shared(const NuSMVEnv_ptr env,
+                              const Prop_ptr* props,
+                              const int props_num,
+                              StatEstimation_ptr* estimations)
 {
-  double upsilon, upsilon1;
-  double mu_hat_Z;
-  int cnt, successes;
+  const ErrorMgr_ptr errmgr =
+    ERROR_MGR(NuSMVEnv_get_value(env, ENV_ERROR_MANAGER));
+  const OptsHandler_ptr opts =
+    OPTS_HANDLER(NuSMVEnv_get_value(env, ENV_OPTS_HANDLER));
+  const StatProblemsGenerator_ptr prob_gen =
+    STAT_PROBLEMS_GENERATOR(NuSMVEnv_get_value(env, ENV_STAT_PROB_GEN));
+  StatProblemsGenerator_ptr* checkers =
+    ALLOC(StatProblemsGenerator_ptr, props_num);
+  const StatProfiler_ptr profiler = Stat_get_profiler(env);
+  StatCheckpoint_ptr checkpoint = STAT_CHECKPOINT(NULL);
+  int pending = 0;
+  long executions = 0;
+  boolean failed = false;
+  int i;
+
+  for (i = 0; i < props_num; i++) {
+    checkers[i] = StatProblemsGenerator_create(env);
+    StatProblemsGenerator_set_verification_method(checkers[i],
+        StatProblemsGenerator_get_verification_method(prob_gen));
+    StatProblemsGenerator_set_memoization(checkers[i],
+        StatProblemsGenerator_get_memoization(prob_gen));
+    StatProblemsGenerator_prepare_property(checkers[i], props[i]);
+  }
+
+  if (NuSMVEnv_has_value(env, ENV_STAT_CHECKPOINT)) {
+    checkpoint =
+      StatCheckpoint_create(env,
+                            (char*)NuSMVEnv_get_value(env,
+                                                      ENV_STAT_CHECKPOINT),
+                            props, estimations, checkers, props_num);
+  }
+
+  CATCH(errmgr) {
+    if (STAT_CHECKPOINT(NULL) != checkpoint) {
+      (void)StatCheckpoint_resume(checkpoint);
+    }
+
+    for (i = 0; i < props_num; i++) {
+      if (! StatEstimation_is_done(estimations[i])) pending++;
+    }
+
+    while (0 < pending) {
+      StatTrace_ptr execution = StatProblemsGenerator_simulate(prob_gen);
+
+      executions++;
+      if (STAT_PROFILER(NULL) != profiler) StatProfiler_add_sample(profiler);
 
-  upsilon = 4 * (M_E - 2) * log(2 / delta) / pow(epsilon, 2);
-  upsilon1 = 1 + (1 + epsilon) * upsilon;
+      for (i = 0; i < props_num; i++) {
+        StatVericationResult res;
 
-  cnt = 0;
-  successes = 0;
+        if (StatEstimation_is_done(estimations[i])) continue;
+
+        res = StatProblemsGenerator_verify_execution(checkers[i], execution);
+        if (STAT_OK != res && STAT_NOT_OK != res) {
+          StatTrace_destroy(execution);
+          ErrorMgr_nusmv_exit(errmgr, 1);
+        }
+
+        if (StatEstimation_add_sample(estimations[i], STAT_OK == res)) {
+          pending--;
+
+          if (opt_verbose_level_gt(opts, 0)) {
+            const Logger_ptr logger =
+              LOGGER(NuSMVEnv_get_value(env, ENV_LOGGER));
+
+            Logger_log(logger, "Property %d done after %ld executions, "
+                       "%d properties pending\n",
+                       Prop_get_index(props[i]), executions, pending);
+          }
+        }
+      }
+
+      StatTrace_destroy(execution);
+
+      if (STAT_CHECKPOINT(NULL) != checkpoint) {
+        StatCheckpoint_update(checkpoint);
+      }
+    }
+  }
+  FAIL(errmgr) {
+    failed = true;
+  }
 
-  /* TODO[AB]: Handle case where cnt >>> successes (!!!) */
-  while(successes < upsilon1) {
-    cnt++;
+  if (STAT_CHECKPOINT(NULL) != checkpoint) {
+    if (! failed) StatCheckpoint_remove(checkpoint);
+    StatCheckpoint_destroy(checkpoint);
+  }
 
-    successes = successes + Z(env, prob_prop);
+  for (i = 0; i < props_num; i++) {
+    StatProblemsGenerator_destroy(checkers[i]);
   }
+  FREE(checkers);
+
+  if (failed) ErrorMgr_nusmv_exit(errmgr, 1);
+}
+
+/*!
+  \brief Logs how many executions were not verified again
+
+  Only the problem generator of the current process is considered:
+  the executions verified by the workers are not counted.
+*/
+static void stat_print_memoization_stats(const NuSMVEnv_ptr env,
+                                         const Prop_ptr prop)
+{
+  const OptsHandler_ptr opts =
+    OPTS_HANDLER(NuSMVEnv_get_value(env, ENV_OPTS_HANDLER));
+  const char* generators[] = { ENV_STAT_PROB_GEN, ENV_STAT_PROB_GEN_BMC };
+  size_t i;
+
+  if (! opt_verbose_level_gt(opts, 0)) return;
+
+  for (i = 0; i < sizeof(generators) / sizeof(generators[0]); i++) {
+    const StatProblemsGenerator_ptr prob_gen =
+      STAT_PROBLEMS_GENERATOR(NuSMVEnv_get_value(env, generators[i]));
+    long lookups;
 
-  mu_hat_Z = successes * 1.0 / cnt;
+    if (prop != StatProblemsGenerator_get_prop(prob_gen)) continue;
 
-  return mu_hat_Z;
+    lookups = StatProblemsGenerator_get_lookups_num(prob_gen);
+
+    if (0 < lookups) {
+      const Logger_ptr logger = LOGGER(NuSMVEnv_get_value(env, ENV_LOGGER));
+      const long hits = StatProblemsGenerator_get_hits_num(prob_gen);
+
+      Logger_log(logger, "Memoized executions: %ld hits out of %ld "
+                 "executions (%.2f%%)\n",
+                 hits, lookups, (100.0 * hits) / lookups);
+    }
+  }
 }
 
 static boolean verify_single_simulation_ltl(const NuSMVEnv_ptr env,
@@ -47,6 +47,20 @@ E
 /* Constant declarations                                                     */
 /*---------------------------------------------------------------------------*/
 
+/*!
+  \brief Minimum number of seconds between two checkpoints
+
+  \sa Stat_set_checkpoint
+*/
+#define STAT_CHECKPOINT_PERIOD 60
+
+/*!
+  \brief Seconds between two throughput reports while profiling
+
+  \sa Stat_enable_profiling
+*/
+#define STAT_PROFILER_REPORT_PERIOD 10
+
 /*---------------------------------------------------------------------------*/
 /* Macro declarations                                                        */
 /*---------------------------------------------------------------------------*/
@@ -60,24 +74,234 @@ typedef enum StatVericationResult_TAG {
   STAT_NOT_OK,
   STAT_INTERNAL_ERROR
 } StatVericationResult;
+
+/*!
+  \brief Algorithms used to estimate the probability of a property
+
+  \sa Stat_check_ltlspec
+*/
+typedef enum StatEstimator_TAG {
+  STAT_ESTIMATOR_INVALID = 0,
+  STAT_ESTIMATOR_DKLR,
+  STAT_ESTIMATOR_OKAMOTO,
+  STAT_ESTIMATOR_BAYES
+} StatEstimator;
+
+/*!
+  \brief Rare event estimation engines
+
+  \sa Stat_check_ltlspec_rare
+*/
+typedef enum StatRareMethod_TAG {
+  STAT_RARE_INVALID = 0,
+  STAT_RARE_SPLITTING,
+  STAT_RARE_IMPORTANCE
+} StatRareMethod;
 /*--------------------------------------------------------------------------*/
 /* Function prototypes                                                      */
 /*--------------------------------------------------------------------------*/
 
-#warning TODO[AB]: Add description
+/*!
+  \brief Statistical verification of an LTL property
+
+  Approximates the probability that a random execution satisfies
+  prop with the given estimator. error_level is relative for
+  STAT_ESTIMATOR_DKLR, absolute otherwise. Samples are drawn by the
+  given number of workers: when workers is greater than one the
+  sampling is performed in parallel by forked processes.
+*/
 int Stat_check_ltlspec(const NuSMVEnv_ptr env,
                        const Prop_ptr prop,
+                       const StatEstimator estimator,
                        const double error_level,
                        const double confidence_level,
+                       const int workers,
                        double *res);
 
+/*!
+  \brief Statistical verification of an LTL property using BMC
+
+  \sa Stat_check_ltlspec
+*/
 int Stat_check_ltlspec_bmc(const NuSMVEnv_ptr env,
                            const Prop_ptr prop,
+                           const StatEstimator estimator,
                            const double error_level,
                            const double confidence_level,
+                           const int workers,
                            double *res);
 
+/*!
+  \brief Statistical hypothesis testing of an LTL property
+
+  Decides whether the probability that a random execution satisfies
+  prop is at least theta, using Wald's sequential probability ratio
+  test with the indifference region (theta - width, theta + width).
+  res is set to true if the probability is accepted to be at least
+  theta + width, and to false if it is accepted to be at most
+  theta - width. alpha and beta bound the probabilities of the two
+  wrong answers respectively. Samples are drawn as in
+  Stat_check_ltlspec.
+*/
+int Stat_test_ltlspec(const NuSMVEnv_ptr env,
+                      const Prop_ptr prop,
+                      const double theta,
+                      const double width,
+                      const double alpha,
+                      const double beta,
+                      const int workers,
+                      boolean *res);
+
+/*!
+  \brief Statistical verification of several LTL properties on the
+  same executions
+
+  Like Stat_check_ltlspec on each of the props_num properties in
+  props, whose results are stored in res. Every random execution is
+  drawn once and verified against all the properties that still need
+  samples, and a property stops being verified as soon as its
+  estimation is done. Samples are drawn serially.
+*/
+int Stat_check_ltlspecs(const NuSMVEnv_ptr env,
+                        const Prop_ptr* props,
+                        const int props_num,
+                        const StatEstimator estimator,
+                        const double error_level,
+                        const double confidence_level,
+                        double* res);
+
+/*!
+  \brief Statistical hypothesis testing of several LTL properties on
+  the same executions
+
+  Like Stat_test_ltlspec on each of the props_num properties in
+  props, sharing the executions as Stat_check_ltlspecs does.
+*/
+int Stat_test_ltlspecs(const NuSMVEnv_ptr env,
+                       const Prop_ptr* props,
+                       const int props_num,
+                       const double theta,
+                       const double width,
+                       const double alpha,
+                       const double beta,
+                       boolean* res);
+
+/*!
+  \brief Rare event estimation of an LTL property
+
+  prop must be F p, with p a simple expression, and the model must
+  not have fairness constraints. The probability is estimated with
+  importance splitting or importance sampling, over nested level sets
+  leading to p. level_exprs is a list of simple expressions, the
+  i-th one holding in the states of level at least i + 1. If it is
+  Nil the level sets are derived from the backward reachability
+  layers of p. effort is the number of executions of a splitting
+  stage, or of a cross entropy pilot for importance sampling.
+
+  The estimation is repeated until the confidence interval given by
+  the central limit theorem, holding with probability
+  1 - confidence_level, has a half width of at most error_level
+  times the estimate. The half
+  width is stored in half_width. Samples are drawn serially.
+*/
+int Stat_check_ltlspec_rare(const NuSMVEnv_ptr env,
+                            const Prop_ptr prop,
+                            const StatRareMethod method,
+                            node_ptr level_exprs,
+                            const int effort,
+                            const double error_level,
+                            const double confidence_level,
+                            double* res,
+                            double* half_width);
+
+/*!
+  \brief Converts a string into a rare event method
+
+  Returns STAT_RARE_INVALID if name is neither "splitting" nor
+  "importance"
+*/
+StatRareMethod Stat_rare_method_from_string(const char* name);
+
+/*!
+  \brief Converts a string into an estimator
+
+  Returns STAT_ESTIMATOR_INVALID if name is not the name of an
+  estimator
+
+  \sa Stat_estimator_to_string
+*/
+StatEstimator Stat_estimator_from_string(const char* name);
+
+/*!
+  \brief Returns the name of the given estimator
+
+  \sa Stat_estimator_from_string
+*/
+const char* Stat_estimator_to_string(const StatEstimator estimator);
+
 void Stat_Pkg_init(NuSMVEnv_ptr env);
 
 void Stat_Pkg_quit(NuSMVEnv_ptr env);
+
+/*!
+  \brief Restarts the random generator of the package from seed
+
+  All the executions are drawn from this generator: two runs with the
+  same seed, model, options and number of workers draw the same
+  executions. Stat_Pkg_init seeds it from the time and the process id.
+  Must be called after Stat_Pkg_init.
+*/
+void Stat_set_seed(NuSMVEnv_ptr env, const unsigned long long seed);
+
+/*!
+  \brief Makes the sampled executions follow the given input
+  probabilities
+
+  probs is an ADD over the input variables, whose leaves are numeric
+  constants. At each step the input is drawn among the ones enabled
+  in the current state with probability proportional to probs, and
+  the successor is drawn uniformly among the ones reached through
+  it. This gives the executions of a DTMC when, as for the Compass
+  prob files, probs assigns a probability to the labels of the
+  transitions. States without enabled inputs of positive probability
+  are left uniformly. probs is duplicated, and released by
+  Stat_Pkg_quit. Must be called after Stat_Pkg_init and before
+  sampling.
+*/
+void Stat_set_input_probabilities(NuSMVEnv_ptr env, add_ptr probs);
+
+/*!
+  \brief Sets the file the statistical runs are checkpointed to
+
+  If fname exists, the next run is resumed from it, and an error is
+  raised if it was written by a run of different properties or
+  parameters. While sampling, the progress of the run is saved to
+  fname, which is removed once the run is over. Checkpoints require a
+  single worker. fname is copied, and released by Stat_Pkg_quit. Must
+  be called after Stat_Pkg_init.
+*/
+void Stat_set_checkpoint(NuSMVEnv_ptr env, const char* fname);
+
+/*!
+  \brief Enables the profiling of the statistical runs
+
+  From now on, the time spent in each stage of the statistical runs
+  is measured, together with the throughput, the length of the
+  executions, the memoization hit rate and the growth of the node and
+  BDD managers. When verbose the throughput is logged periodically.
+  The profiler is released by Stat_Pkg_quit. Must be called after
+  Stat_Pkg_init.
+
+  \sa Stat_print_profile
+*/
+void Stat_enable_profiling(NuSMVEnv_ptr env);
+
+/*!
+  \brief Prints a JSON summary of the profiled runs to out
+
+  Nothing is printed if profiling is not enabled.
+
+  \sa Stat_enable_profiling
+*/
+void Stat_print_profile(NuSMVEnv_ptr env, FILE* out);
 #endif /* __NUSMV_CORE_STAT_STAT_H__ */
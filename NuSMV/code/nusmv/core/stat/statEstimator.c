@@ -0,0 +1,692 @@
+/* ---------------------------------------------------------------------------
+
+
+  This file is part of the ``stat'' package of NuSMV version 2.
+  Copyright (C) 2012 by FBK-irst.
+
+  NuSMV version 2 is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  NuSMV version 2 is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA.
+
+  For more information on NuSMV see <http://nusmv.fbk.eu>
+  or email to <nusmv-users@fbk.eu>.
+  Please report bugs to <nusmv-users@fbk.eu>.
+
+  To contact the NuSMV development board, email to <nusmv@fbk.eu>.
+
+-----------------------------------------------------------------------------*/
+
+/*!
+  \author Alberto Bombardelli
+  \brief Estimators of the probability of a Bernoulli random variable
+
+  All the estimators share the StatEstimatorFun signature: they
+  consume samples from a StatSampler until the estimate is within
+  epsilon of the real probability with confidence 1 - delta. They
+  differ in the meaning of epsilon and in the number of samples:
+
+  - DKLR: the approximation algorithm of Dagum, Karp, Luby and Ross.
+    epsilon is a relative error, and the number of samples grows as
+    1 / mu.
+  - Okamoto: the Chernoff-Hoeffding bound. epsilon is an absolute
+    error, and the number of samples is fixed and known upfront.
+  - Bayes: Bayesian interval estimation with a uniform prior. epsilon
+    is an absolute error, and sampling stops as soon as the posterior
+    probability of the interval of width 2 epsilon around the
+    estimate is at least 1 - delta.
+
+  The algorithms are implemented by StatEstimation, which is fed one
+  sample at a time and tells when it has seen enough of them. This
+  allows to feed several estimations with the samples of the same
+  executions, see Stat_check_ltlspecs. StatEstimation also implements
+  Wald's sequential probability ratio test.
+
+*/
+
+#include "nusmv/core/stat/statInt.h"
+#include "nusmv/core/utils/error.h" /* for error_unreachable_code */
+
+#include <math.h>
+
+/*---------------------------------------------------------------------------*/
+/* Structure declarations                                                    */
+/*---------------------------------------------------------------------------*/
+
+/*!
+  \brief Phases of the estimations
+
+  Okamoto, Bayes and the test have a single phase. The phases of
+  DKLR are its stopping rule algorithm, the estimation of the
+  variance and the final estimation.
+*/
+typedef enum StatEstimationPhase_TAG {
+  STAT_ESTIMATION_SAMPLING,
+  STAT_ESTIMATION_DKLR_VARIANCE,
+  STAT_ESTIMATION_DKLR_FINAL,
+  STAT_ESTIMATION_DONE
+} StatEstimationPhase;
+
+typedef struct StatEstimation_TAG
+{
+  /* STAT_ESTIMATOR_INVALID for the probability ratio test */
+  StatEstimator estimator;
+  StatEstimationPhase phase;
+
+  double epsilon;
+  double delta;
+
+  /* samples and successes of the current phase */
+  long n;
+  long successes;
+
+  /* DKLR: samples needed by the current phase, estimate of the
+     first phase, pairs of different samples and first sample of the
+     current pair (-1 if none) */
+  double target;
+  double upsilon2;
+  double mu_hat;
+  long alt;
+  int first;
+
+  /* Okamoto: number of samples */
+  long N;
+
+  /* test: log-likelihood ratio, its bounds and its increments */
+  double llr;
+  double accept_h0;
+  double accept_h1;
+  double llr_success;
+  double llr_failure;
+
+  /* the estimate, or 1 if H0 was accepted by the test */
+  double result;
+} StatEstimation;
+
+/*---------------------------------------------------------------------------*/
+/* Type declarations                                                         */
+/*---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*/
+/* Variable declarations                                                     */
+/*---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*/
+/* Macro declarations                                                        */
+/*---------------------------------------------------------------------------*/
+
+/*!
+  \brief Parameters of the uniform prior Beta(1, 1)
+
+*/
+#define STAT_ESTIMATOR_BAYES_PRIOR_A 1.0
+#define STAT_ESTIMATOR_BAYES_PRIOR_B 1.0
+
+/*!
+  \brief Bounds for the evaluation of the incomplete beta function
+
+*/
+#define STAT_ESTIMATOR_BETACF_MAX_ITER 100000
+#define STAT_ESTIMATOR_BETACF_EPS 3.0e-14
+#define STAT_ESTIMATOR_BETACF_FPMIN 1.0e-300
+
+/*---------------------------------------------------------------------------*/
+/* Static function prototypes                                                */
+/*---------------------------------------------------------------------------*/
+
+static double stat_estimator_run(const StatSampler_ptr sampler,
+                                 const StatEstimator estimator,
+                                 const double epsilon,
+                                 const double delta);
+
+static void stat_estimation_add_dklr(StatEstimation_ptr self,
+                                     const boolean z);
+
+static void stat_estimation_add_bayes(StatEstimation_ptr self,
+                                      const boolean z);
+
+static void stat_estimation_dklr_variance(StatEstimation_ptr self);
+
+static void stat_estimation_dklr_final(StatEstimation_ptr self);
+
+static double stat_estimator_beta_cdf(const double a, const double b,
+                                      const double x);
+
+static double stat_estimator_betacf(const double a, const double b,
+                                    const double x);
+
+/*---------------------------------------------------------------------------*/
+/* Definition of exported functions                                          */
+/*---------------------------------------------------------------------------*/
+
+StatEstimatorFun StatEstimator_get_fun(const StatEstimator estimator)
+{
+  switch (estimator) {
+  case STAT_ESTIMATOR_DKLR: return StatEstimator_dklr;
+  case STAT_ESTIMATOR_OKAMOTO: return StatEstimator_okamoto;
+  case STAT_ESTIMATOR_BAYES: return StatEstimator_bayes;
+
+  default:
+    error_unreachable_code();
+  }
+
+  return (StatEstimatorFun)NULL;
+}
+
+double StatEstimator_dklr(const StatSampler_ptr sampler,
+                          const double epsilon,
+                          const double delta)
+{
+  return stat_estimator_run(sampler, STAT_ESTIMATOR_DKLR, epsilon, delta);
+}
+
+double StatEstimator_okamoto(const StatSampler_ptr sampler,
+                             const double epsilon,
+                             const double delta)
+{
+  return stat_estimator_run(sampler, STAT_ESTIMATOR_OKAMOTO, epsilon, delta);
+}
+
+double StatEstimator_bayes(const StatSampler_ptr sampler,
+                           const double epsilon,
+                           const double delta)
+{
+  return stat_estimator_run(sampler, STAT_ESTIMATOR_BAYES, epsilon, delta);
+}
+
+StatEstimation_ptr StatEstimation_create(const StatEstimator estimator,
+                                         const double epsilon,
+                                         const double delta)
+{
+  StatEstimation_ptr self = ALLOC(StatEstimation, 1);
+  STAT_ESTIMATION_CHECK_INSTANCE(self);
+
+  self->estimator = estimator;
+  self->phase = STAT_ESTIMATION_SAMPLING;
+  self->epsilon = epsilon;
+  self->delta = delta;
+  self->n = 0;
+  self->successes = 0;
+  self->result = 0.0;
+
+  switch (estimator) {
+  case STAT_ESTIMATOR_DKLR:
+    {
+      /* the first phase is the stopping rule algorithm, with error
+         min(0.5, sqrt(epsilon)) and confidence delta / 3 */
+      const double epsilon1 = min(0.5, sqrt(epsilon));
+      const double upsilon = 4 * (M_E - 2) * log(2 / delta) / pow(epsilon, 2);
+      const double upsilon1 =
+        4 * (M_E - 2) * log(2 / (delta / 3)) / pow(epsilon1, 2);
+
+      self->upsilon2 = 2 * (1 + sqrt(epsilon)) * (1 + 2*sqrt(epsilon)) *
+                       ((1 + log(1.5)) / log(2 / delta)) * upsilon;
+      self->target = 1 + (1 + epsilon1) * upsilon1;
+      self->mu_hat = 0.0;
+      self->alt = 0;
+      self->first = -1;
+    }
+    break;
+
+  case STAT_ESTIMATOR_OKAMOTO:
+    /* P(|mu_hat - mu| > epsilon) <= 2 exp(-2 N epsilon^2) <= delta */
+    self->N = (long)ceil(log(2 / delta) / (2 * pow(epsilon, 2)));
+    nusmv_assert(0 < self->N);
+    break;
+
+  case STAT_ESTIMATOR_BAYES:
+    break;
+
+  default:
+    error_unreachable_code();
+  }
+
+  return self;
+}
+
+StatEstimation_ptr StatEstimation_create_test(const double p0,
+                                              const double p1,
+                                              const double alpha,
+                                              const double beta)
+{
+  StatEstimation_ptr self = ALLOC(StatEstimation, 1);
+  STAT_ESTIMATION_CHECK_INSTANCE(self);
+
+  nusmv_assert(p1 < p0);
+
+  self->estimator = STAT_ESTIMATOR_INVALID;
+  self->phase = STAT_ESTIMATION_SAMPLING;
+  self->n = 0;
+  self->successes = 0;
+  self->result = 0.0;
+
+  self->accept_h1 = log((1 - beta) / alpha);
+  self->accept_h0 = log(beta / (1 - alpha));
+
+  /* with p1 = 0 (resp. p0 = 1) a single success (resp. failure) is
+     enough to reject H1 (resp. H0) */
+  self->llr_success = (0 < p1) ? log(p1 / p0) : -HUGE_VAL;
+  self->llr_failure = (p0 < 1) ? log((1 - p1) / (1 - p0)) : HUGE_VAL;
+  self->llr = 0.0;
+
+  return self;
+}
+
+void StatEstimation_destroy(StatEstimation_ptr self)
+{
+  STAT_ESTIMATION_CHECK_INSTANCE(self);
+
+  FREE(self);
+}
+
+boolean StatEstimation_add_sample(StatEstimation_ptr self, const boolean z)
+{
+  STAT_ESTIMATION_CHECK_INSTANCE(self);
+  nusmv_assert(STAT_ESTIMATION_DONE != self->phase);
+
+  switch (self->estimator) {
+  case STAT_ESTIMATOR_DKLR:
+    stat_estimation_add_dklr(self, z);
+    break;
+
+  case STAT_ESTIMATOR_OKAMOTO:
+    self->n++;
+    self->successes += z;
+
+    if (self->N <= self->n) {
+      self->result = self->successes * 1.0 / self->N;
+      self->phase = STAT_ESTIMATION_DONE;
+    }
+    break;
+
+  case STAT_ESTIMATOR_BAYES:
+    stat_estimation_add_bayes(self, z);
+    break;
+
+  case STAT_ESTIMATOR_INVALID:
+    self->n++;
+    self->llr += z ? self->llr_success : self->llr_failure;
+
+    if (! (self->accept_h0 < self->llr && self->llr < self->accept_h1)) {
+      self->result = (self->llr <= self->accept_h0) ? 1.0 : 0.0;
+      self->phase = STAT_ESTIMATION_DONE;
+    }
+    break;
+
+  default:
+    error_unreachable_code();
+  }
+
+  return STAT_ESTIMATION_DONE == self->phase;
+}
+
+boolean StatEstimation_is_done(const StatEstimation_ptr self)
+{
+  STAT_ESTIMATION_CHECK_INSTANCE(self);
+
+  return STAT_ESTIMATION_DONE == self->phase;
+}
+
+double StatEstimation_get_result(const StatEstimation_ptr self)
+{
+  STAT_ESTIMATION_CHECK_INSTANCE(self);
+  nusmv_assert(STAT_ESTIMATION_DONE == self->phase);
+
+  return self->result;
+}
+
+void StatEstimation_write(const StatEstimation_ptr self, FILE* out)
+{
+  STAT_ESTIMATION_CHECK_INSTANCE(self);
+
+  /* doubles are written in hexadecimal, so that they are read back
+     exactly */
+  fprintf(out, "%d %d %ld %ld %a", (int)self->estimator, (int)self->phase,
+          self->n, self->successes, self->result);
+
+  switch (self->estimator) {
+  case STAT_ESTIMATOR_DKLR:
+    fprintf(out, " %a %a %a %a %a %ld %d", self->epsilon, self->delta,
+            self->target, self->upsilon2, self->mu_hat, self->alt,
+            self->first);
+    break;
+
+  case STAT_ESTIMATOR_OKAMOTO:
+    fprintf(out, " %a %a %ld", self->epsilon, self->delta, self->N);
+    break;
+
+  case STAT_ESTIMATOR_BAYES:
+    fprintf(out, " %a %a", self->epsilon, self->delta);
+    break;
+
+  case STAT_ESTIMATOR_INVALID:
+    fprintf(out, " %a %a %a %a %a", self->accept_h0, self->accept_h1,
+            self->llr_success, self->llr_failure, self->llr);
+    break;
+
+  default:
+    error_unreachable_code();
+  }
+
+  fprintf(out, "\n");
+}
+
+boolean StatEstimation_read(StatEstimation_ptr self, FILE* in)
+{
+  StatEstimation read;
+  int estimator, phase;
+
+  STAT_ESTIMATION_CHECK_INSTANCE(self);
+
+  if (5 != fscanf(in, "%d %d %ld %ld %la", &estimator, &phase,
+                  &read.n, &read.successes, &read.result)) {
+    return false;
+  }
+
+  if ((int)self->estimator != estimator) return false;
+  if (STAT_ESTIMATION_SAMPLING > phase || STAT_ESTIMATION_DONE < phase) {
+    return false;
+  }
+
+  /* the parameters must be the ones self was created with */
+  switch (self->estimator) {
+  case STAT_ESTIMATOR_DKLR:
+    if (7 != fscanf(in, "%la %la %la %la %la %ld %d", &read.epsilon,
+                    &read.delta, &read.target, &read.upsilon2,
+                    &read.mu_hat, &read.alt, &read.first)) {
+      return false;
+    }
+    if (self->epsilon != read.epsilon || self->delta != read.delta) {
+      return false;
+    }
+    self->target = read.target;
+    self->upsilon2 = read.upsilon2;
+    self->mu_hat = read.mu_hat;
+    self->alt = read.alt;
+    self->first = read.first;
+    break;
+
+  case STAT_ESTIMATOR_OKAMOTO:
+    if (3 != fscanf(in, "%la %la %ld", &read.epsilon, &read.delta,
+                    &read.N)) {
+      return false;
+    }
+    if (self->epsilon != read.epsilon || self->delta != read.delta ||
+        self->N != read.N) {
+      return false;
+    }
+    break;
+
+  case STAT_ESTIMATOR_BAYES:
+    if (2 != fscanf(in, "%la %la", &read.epsilon, &read.delta)) {
+      return false;
+    }
+    if (self->epsilon != read.epsilon || self->delta != read.delta) {
+      return false;
+    }
+    break;
+
+  case STAT_ESTIMATOR_INVALID:
+    if (5 != fscanf(in, "%la %la %la %la %la", &read.accept_h0,
+                    &read.accept_h1, &read.llr_success, &read.llr_failure,
+                    &read.llr)) {
+      return false;
+    }
+    if (self->accept_h0 != read.accept_h0 ||
+        self->accept_h1 != read.accept_h1 ||
+        self->llr_success != read.llr_success ||
+        self->llr_failure != read.llr_failure) {
+      return false;
+    }
+    self->llr = read.llr;
+    break;
+
+  default:
+    error_unreachable_code();
+  }
+
+  self->phase = (StatEstimationPhase)phase;
+  self->n = read.n;
+  self->successes = read.successes;
+  self->result = read.result;
+
+  return true;
+}
+
+/*---------------------------------------------------------------------------*/
+/* Definition of static functions                                            */
+/*---------------------------------------------------------------------------*/
+
+/*!
+  \brief Feeds a new estimation with the samples of sampler until it
+  is done
+
+*/
+static double stat_estimator_run(const StatSampler_ptr sampler,
+                                 const StatEstimator estimator,
+                                 const double epsilon,
+                                 const double delta)
+{
+  StatEstimation_ptr estimation =
+    StatEstimation_create(estimator, epsilon, delta);
+  double res;
+
+  while (! StatEstimation_add_sample(estimation,
+                                     StatSampler_get_sample(sampler)));
+
+  res = StatEstimation_get_result(estimation);
+  StatEstimation_destroy(estimation);
+
+  return res;
+}
+
+/*!
+  \brief Feeds a DKLR estimation
+
+  Phase 1 is the stopping rule algorithm, which returns an estimate
+  of mu within relative error min(0.5, sqrt(epsilon)) with
+  probability at least 1 - delta / 3. Phase 2 estimates the variance
+  from pairs of samples, and phase 3 draws the number of samples it
+  requires.
+*/
+static void stat_estimation_add_dklr(StatEstimation_ptr self,
+                                     const boolean z)
+{
+  switch (self->phase) {
+  case STAT_ESTIMATION_SAMPLING:
+    /* TODO[AB]: Handle case where cnt >>> successes (!!!) */
+    self->n++;
+    self->successes += z;
+
+    if (self->successes >= self->target) {
+      self->mu_hat = self->successes * 1.0 / self->n;
+      stat_estimation_dklr_variance(self);
+    }
+    break;
+
+  case STAT_ESTIMATION_DKLR_VARIANCE:
+    self->n++;
+
+    if (-1 == self->first) self->first = z;
+    else {
+      self->alt += self->first != z;
+      self->first = -1;
+
+      if (self->n >= self->target) stat_estimation_dklr_final(self);
+    }
+    break;
+
+  case STAT_ESTIMATION_DKLR_FINAL:
+    self->n++;
+    self->successes += z;
+
+    if (self->n >= self->target) {
+      self->result = self->successes * 1.0 / (int)self->target;
+      self->phase = STAT_ESTIMATION_DONE;
+    }
+    break;
+
+  default:
+    error_unreachable_code();
+  }
+}
+
+/*!
+  \brief Starts phase 2 of DKLR
+
+*/
+static void stat_estimation_dklr_variance(StatEstimation_ptr self)
+{
+  const int N = ceil(2 * self->upsilon2 * self->epsilon / self->mu_hat);
+
+  self->phase = STAT_ESTIMATION_DKLR_VARIANCE;
+  self->target = N;
+  self->n = 0;
+  self->alt = 0;
+  self->first = -1;
+
+  if (self->n >= self->target) stat_estimation_dklr_final(self);
+}
+
+/*!
+  \brief Starts phase 3 of DKLR
+
+*/
+static void stat_estimation_dklr_final(StatEstimation_ptr self)
+{
+  const int N2 = (int)self->target;
+  const double rho_hat_Z =
+    max((int)self->alt / N2, self->epsilon * pow(self->mu_hat, 2));
+  const int N = self->upsilon2 * rho_hat_Z / pow(self->mu_hat, 2);
+
+  self->phase = STAT_ESTIMATION_DKLR_FINAL;
+  self->target = N;
+  self->n = 0;
+  self->successes = 0;
+
+  if (self->n >= self->target) {
+    self->result = self->successes * 1.0 / N;
+    self->phase = STAT_ESTIMATION_DONE;
+  }
+}
+
+/*!
+  \brief Feeds a Bayes estimation
+
+*/
+static void stat_estimation_add_bayes(StatEstimation_ptr self,
+                                      const boolean z)
+{
+  const double a = STAT_ESTIMATOR_BAYES_PRIOR_A;
+  const double b = STAT_ESTIMATOR_BAYES_PRIOR_B;
+  double mean, coverage;
+  double t0, t1;
+
+  self->n++;
+  self->successes += z;
+
+  /* the posterior is Beta(successes + a, n - successes + b) */
+  mean = (self->successes + a) / (self->n + a + b);
+
+  /* the interval is kept of width 2 epsilon within [0, 1] */
+  t0 = mean - self->epsilon;
+  t1 = mean + self->epsilon;
+  if (1 < t1) { t0 = max(0.0, 1 - 2 * self->epsilon); t1 = 1; }
+  if (0 > t0) { t0 = 0; t1 = min(1.0, 2 * self->epsilon); }
+
+  coverage =
+    stat_estimator_beta_cdf(self->successes + a,
+                            self->n - self->successes + b, t1) -
+    stat_estimator_beta_cdf(self->successes + a,
+                            self->n - self->successes + b, t0);
+
+  if (coverage >= 1 - self->delta) {
+    self->result = mean;
+    self->phase = STAT_ESTIMATION_DONE;
+  }
+}
+
+/*!
+  \brief Cumulative distribution function of Beta(a, b) in x
+
+  This is the regularized incomplete beta function I_x(a, b)
+*/
+static double stat_estimator_beta_cdf(const double a, const double b,
+                                      const double x)
+{
+  double front;
+
+  if (0 >= x) return 0.0;
+  if (1 <= x) return 1.0;
+
+  front = exp(lgamma(a + b) - lgamma(a) - lgamma(b) +
+              a * log(x) + b * log(1 - x));
+
+  /* the continued fraction converges quickly for x < (a + 1) / (a + b + 2) */
+  if (x < (a + 1) / (a + b + 2)) {
+    return front * stat_estimator_betacf(a, b, x) / a;
+  }
+  else {
+    return 1.0 - front * stat_estimator_betacf(b, a, 1 - x) / b;
+  }
+}
+
+/*!
+  \brief Continued fraction of the incomplete beta function
+
+  Evaluated with the modified Lentz's method
+*/
+static double stat_estimator_betacf(const double a, const double b,
+                                    const double x)
+{
+  const double qab = a + b;
+  const double qap = a + 1;
+  const double qam = a - 1;
+  double c, d, h;
+  int m;
+
+  c = 1.0;
+  d = 1.0 - qab * x / qap;
+  if (fabs(d) < STAT_ESTIMATOR_BETACF_FPMIN) d = STAT_ESTIMATOR_BETACF_FPMIN;
+  d = 1.0 / d;
+  h = d;
+
+  for (m = 1; m <= STAT_ESTIMATOR_BETACF_MAX_ITER; m++) {
+    const int m2 = 2 * m;
+    double aa, del;
+
+    /* even step */
+    aa = m * (b - m) * x / ((qam + m2) * (a + m2));
+    d = 1.0 + aa * d;
+    if (fabs(d) < STAT_ESTIMATOR_BETACF_FPMIN) d = STAT_ESTIMATOR_BETACF_FPMIN;
+    c = 1.0 + aa / c;
+    if (fabs(c) < STAT_ESTIMATOR_BETACF_FPMIN) c = STAT_ESTIMATOR_BETACF_FPMIN;
+    d = 1.0 / d;
+    h *= d * c;
+
+    /* odd step */
+    aa = -(a + m) * (qab + m) * x / ((a + m2) * (qap + m2));
+    d = 1.0 + aa * d;
+    if (fabs(d) < STAT_ESTIMATOR_BETACF_FPMIN) d = STAT_ESTIMATOR_BETACF_FPMIN;
+    c = 1.0 + aa / c;
+    if (fabs(c) < STAT_ESTIMATOR_BETACF_FPMIN) c = STAT_ESTIMATOR_BETACF_FPMIN;
+    d = 1.0 / d;
+    del = d * c;
+    h *= del;
+
+    if (fabs(del - 1.0) < STAT_ESTIMATOR_BETACF_EPS) break;
+  }
+
+  return h;
+}
+
+/**AutomaticEnd***************************************************************/
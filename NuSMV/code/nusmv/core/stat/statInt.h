@@ -38,12 +38,46 @@
 #ifndef __NUSMV_CORE_STAT_STAT_INT_H__
 #define __NUSMV_CORE_STAT_STAT_INT_H__
 
+#include "nusmv/core/stat/stat.h"
 #include "nusmv/core/stat/StatTrace.h"
+#include "nusmv/core/stat/StatSampler.h"
+#include "nusmv/core/stat/StatProfiler.h"
 #include "nusmv/core/prop/Prop.h"
+#include "nusmv/core/utils/assoc.h"
 /*---------------------------------------------------------------------------*/
 /* Constant declarations                                                     */
 /*---------------------------------------------------------------------------*/
 
+/*---------------------------------------------------------------------------*/
+/* Type declarations                                                         */
+/*---------------------------------------------------------------------------*/
+
+/*!
+  \brief Estimator of the probability of a Bernoulli random variable
+
+  Returns an estimate of the probability of the samples drawn from
+  sampler, within error epsilon with probability at least 1 - delta
+*/
+typedef double (*StatEstimatorFun)(const StatSampler_ptr sampler,
+                                   const double epsilon,
+                                   const double delta);
+
+/*!
+  \struct StatEstimation
+  \brief An estimation in progress, fed one sample at a time
+
+*/
+typedef struct StatEstimation_TAG*  StatEstimation_ptr;
+
+/*---------------------------------------------------------------------------*/
+/* Macro declarations                                                        */
+/*---------------------------------------------------------------------------*/
+#define STAT_ESTIMATION(self) \
+         ((StatEstimation_ptr) self)
+
+#define STAT_ESTIMATION_CHECK_INSTANCE(self) \
+         (nusmv_assert(STAT_ESTIMATION(self) != STAT_ESTIMATION(NULL)))
+
 /*---------------------------------------------------------------------------*/
 /* Function prototypes                                                       */
 /*---------------------------------------------------------------------------*/
@@ -69,4 +103,99 @@ Prop_ptr StatSexpProblem_gen_single_state_problem(const NuSMVEnv_ptr env,
 Prop_ptr StatSexpProblem_gen_bmc_problem(const NuSMVEnv_ptr env,
                                          const StatTrace_ptr execution,
                                          const Prop_ptr prop);
+
+StatEstimatorFun StatEstimator_get_fun(const StatEstimator estimator);
+
+double StatEstimator_dklr(const StatSampler_ptr sampler,
+                          const double epsilon,
+                          const double delta);
+
+double StatEstimator_okamoto(const StatSampler_ptr sampler,
+                             const double epsilon,
+                             const double delta);
+
+double StatEstimator_bayes(const StatSampler_ptr sampler,
+                           const double epsilon,
+                           const double delta);
+
+/*!
+  \methodof StatEstimation
+  \brief Starts an estimation with the given estimator
+
+  The estimation consumes the same samples, and gives the same
+  result, as the corresponding StatEstimatorFun.
+*/
+StatEstimation_ptr StatEstimation_create(const StatEstimator estimator,
+                                         const double epsilon,
+                                         const double delta);
+
+/*!
+  \methodof StatEstimation
+  \brief Starts a sequential probability ratio test
+
+  Tests H0: p >= p0 against H1: p <= p1, with p1 < p0. The
+  probability of accepting H1 when H0 holds is at most alpha, and the
+  probability of accepting H0 when H1 holds is at most beta. The
+  result is 1 iff H0 is accepted, 0 otherwise.
+*/
+StatEstimation_ptr StatEstimation_create_test(const double p0,
+                                              const double p1,
+                                              const double alpha,
+                                              const double beta);
+
+void StatEstimation_destroy(StatEstimation_ptr self);
+
+/*!
+  \methodof StatEstimation
+  \brief Feeds the estimation with a new sample
+
+  Returns true iff no more samples are needed. It must not be called
+  after that.
+*/
+boolean StatEstimation_add_sample(StatEstimation_ptr self, const boolean z);
+
+boolean StatEstimation_is_done(const StatEstimation_ptr self);
+
+/*!
+  \methodof StatEstimation
+  \brief Returns the result of a finished estimation
+
+*/
+double StatEstimation_get_result(const StatEstimation_ptr self);
+
+/*!
+  \methodof StatEstimation
+  \brief Writes the progress of the estimation to out
+
+  \sa StatEstimation_read
+*/
+void StatEstimation_write(const StatEstimation_ptr self, FILE* out);
+
+/*!
+  \methodof StatEstimation
+  \brief Restores the progress written by StatEstimation_write
+
+  self must have been created with the same estimator and parameters
+  as the written estimation. Returns false, leaving self unchanged, if
+  this is not the case or if nothing valid can be read from in.
+*/
+boolean StatEstimation_read(StatEstimation_ptr self, FILE* in);
+
+/*!
+  \brief Returns the profiler of the statistical runs
+
+  Returns NULL if profiling is not enabled.
+
+  \sa Stat_enable_profiling
+*/
+StatProfiler_ptr Stat_get_profiler(const NuSMVEnv_ptr env);
+
+/*!
+  \brief Tells whether a cache of a statistical run must be emptied
+
+  Caches are checked between two executions, since the entries of
+  the current one may still be in use, and emptied when they hold at
+  least stat_cache_size entries.
+*/
+boolean Stat_is_cache_full(const NuSMVEnv_ptr env, const hash_ptr cache);
 #endif /* __NUSMV_CORE_STAT_STAT_INT_H__ */
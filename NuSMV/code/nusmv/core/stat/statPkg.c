@@ -20,6 +20,9 @@
 #include "nusmv/core/stat/StatProblemsGeneratorBmc.h"
 
 #include "nusmv/core/cinit/NuSMVEnv.h"
+#include "nusmv/core/utils/RandomGen.h"
+#include "nusmv/core/utils/Logger.h"
+#include "nusmv/core/opt/opt.h"
 
 /*---------------------------------------------------------------------------*/
 /* Constant declarations                                                     */
@@ -64,8 +67,11 @@ void Stat_Pkg_init(NuSMVEnv_ptr env)
   StatProblemsGenerator_ptr pg = StatProblemsGenerator_create(env);
   StatProblemsGeneratorBmc_ptr b_pg = StatProblemsGeneratorBmc_create(env);
 
+  RandomGen_ptr gen = RandomGen_create(RandomGen_get_default_seed());
+
   NuSMVEnv_set_value(env, ENV_STAT_PROB_GEN, (void*)pg);
   NuSMVEnv_set_value(env, ENV_STAT_PROB_GEN_BMC, (void*)b_pg);
+  NuSMVEnv_set_value(env, ENV_STAT_RANDOM_GEN, (void*)gen);
   /* TODO[AB]: Add also the BMC generator... */
 }
 
@@ -76,17 +82,113 @@ void Stat_Pkg_quit(NuSMVEnv_ptr env)
   StatProblemsGeneratorBmc_ptr b_pg =
     STAT_PROBLEMS_GENERATOR_BMC(NuSMVEnv_get_value(env, ENV_STAT_PROB_GEN_BMC));
 
+  RandomGen_ptr gen =
+    RANDOM_GEN(NuSMVEnv_get_value(env, ENV_STAT_RANDOM_GEN));
+
   StatProblemsGenerator_destroy(pg);
   StatProblemsGeneratorBmc_destroy(b_pg);
+  RandomGen_destroy(gen);
+
+  if (NuSMVEnv_has_value(env, ENV_STAT_INPUT_PROBS)) {
+    add_free(DD_MGR(NuSMVEnv_get_value(env, ENV_DD_MGR)),
+             (add_ptr)NuSMVEnv_remove_value(env, ENV_STAT_INPUT_PROBS));
+  }
+
+  if (NuSMVEnv_has_value(env, ENV_STAT_CHECKPOINT)) {
+    char* fname = (char*)NuSMVEnv_remove_value(env, ENV_STAT_CHECKPOINT);
+
+    FREE(fname);
+  }
+
+  if (NuSMVEnv_has_value(env, ENV_STAT_PROFILER)) {
+    StatProfiler_destroy(
+      STAT_PROFILER(NuSMVEnv_remove_value(env, ENV_STAT_PROFILER)));
+  }
 
   NuSMVEnv_remove_value(env, ENV_STAT_PROB_GEN);
   NuSMVEnv_remove_value(env, ENV_STAT_PROB_GEN_BMC);
+  NuSMVEnv_remove_value(env, ENV_STAT_RANDOM_GEN);
+}
+
+void Stat_set_seed(NuSMVEnv_ptr env, const unsigned long long seed)
+{
+  const OptsHandler_ptr opts =
+    OPTS_HANDLER(NuSMVEnv_get_value(env, ENV_OPTS_HANDLER));
+
+  RandomGen_set_seed(RANDOM_GEN(NuSMVEnv_get_value(env, ENV_STAT_RANDOM_GEN)),
+                     seed);
+
+  if (opt_verbose_level_gt(opts, 0)) {
+    const Logger_ptr logger = LOGGER(NuSMVEnv_get_value(env, ENV_LOGGER));
+
+    Logger_log(logger, "Statistical model checking: random seed %llu\n",
+               seed);
+  }
+}
+
+void Stat_set_input_probabilities(NuSMVEnv_ptr env, add_ptr probs)
+{
+  const DDMgr_ptr dd = DD_MGR(NuSMVEnv_get_value(env, ENV_DD_MGR));
+
+  if (NuSMVEnv_has_value(env, ENV_STAT_INPUT_PROBS)) {
+    add_free(dd, (add_ptr)NuSMVEnv_remove_value(env, ENV_STAT_INPUT_PROBS));
+  }
+
+  NuSMVEnv_set_value(env, ENV_STAT_INPUT_PROBS, (void*)add_dup(probs));
+}
+
+void Stat_set_checkpoint(NuSMVEnv_ptr env, const char* fname)
+{
+  if (NuSMVEnv_has_value(env, ENV_STAT_CHECKPOINT)) {
+    char* old = (char*)NuSMVEnv_remove_value(env, ENV_STAT_CHECKPOINT);
+
+    FREE(old);
+  }
+
+  NuSMVEnv_set_value(env, ENV_STAT_CHECKPOINT,
+                     (void*)util_strsav((char*)fname));
+}
+
+void Stat_enable_profiling(NuSMVEnv_ptr env)
+{
+  if (NuSMVEnv_has_value(env, ENV_STAT_PROFILER)) {
+    StatProfiler_destroy(
+      STAT_PROFILER(NuSMVEnv_remove_value(env, ENV_STAT_PROFILER)));
+  }
+
+  NuSMVEnv_set_value(env, ENV_STAT_PROFILER, (void*)StatProfiler_create(env));
+}
+
+void Stat_print_profile(NuSMVEnv_ptr env, FILE* out)
+{
+  const StatProfiler_ptr profiler = Stat_get_profiler(env);
+
+  if (STAT_PROFILER(NULL) != profiler) {
+    StatProfiler_print_json(profiler, out);
+  }
 }
 
 /*---------------------------------------------------------------------------*/
 /* Definition of internal functions                                          */
 /*---------------------------------------------------------------------------*/
 
+StatProfiler_ptr Stat_get_profiler(const NuSMVEnv_ptr env)
+{
+  if (!NuSMVEnv_has_value(env, ENV_STAT_PROFILER)) {
+    return STAT_PROFILER(NULL);
+  }
+
+  return STAT_PROFILER(NuSMVEnv_get_value(env, ENV_STAT_PROFILER));
+}
+
+boolean Stat_is_cache_full(const NuSMVEnv_ptr env, const hash_ptr cache)
+{
+  const OptsHandler_ptr opts =
+    OPTS_HANDLER(NuSMVEnv_get_value(env, ENV_OPTS_HANDLER));
+
+  return assoc_get_size(cache) >= get_stat_cache_size(opts);
+}
+
 
 /*---------------------------------------------------------------------------*/
 /* Definition of static functions                                            */
@@ -0,0 +1,864 @@
+/* ---------------------------------------------------------------------------
+
+
+  This file is part of the ``stat'' package of NuSMV version 2.
+  Copyright (C) 2012 by FBK-irst.
+
+  NuSMV version 2 is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  NuSMV version 2 is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA.
+
+  For more information on NuSMV see <http://nusmv.fbk.eu>
+  or email to <nusmv-users@fbk.eu>.
+  Please report bugs to <nusmv-users@fbk.eu>.
+
+  To contact the NuSMV development board, email to <nusmv@fbk.eu>.
+
+-----------------------------------------------------------------------------*/
+
+/*!
+  \author Alberto Bombardelli
+  \brief Rare event estimation of reachability properties
+
+  The probability of F p is estimated when it is too small for the
+  estimators of statEstimator.c, which need a number of samples
+  growing as its inverse. Both the engines rely on a sequence of
+  nested level sets, the last one being p, telling how close a state
+  is to p:
+
+  - Importance splitting (fixed effort): the executions are drawn in
+    stages, one per level. At each stage a fixed number of executions
+    is continued from the prefixes that reached the previous level,
+    until they reach the next one or loop back. The probability is
+    the product of the fractions of executions reaching each level.
+  - Importance sampling: the successors are drawn with probability
+    proportional to exp(theta * level), and every execution is
+    weighted by its likelihood ratio. theta is tuned with the cross
+    entropy method on pilot executions.
+
+  In both cases the whole estimation is repeated until the confidence
+  interval of the mean of the estimates, given by the central limit
+  theorem, is small enough with respect to the mean.
+
+  Level sets are either given by the user or derived from the
+  backward reachability layers of p.
+
+*/
+
+#include "nusmv/core/stat/statInt.h"
+#include "nusmv/core/stat/StatSimulator.h"
+#include "nusmv/core/stat/StatTrace.h"
+
+#include "nusmv/core/utils/ErrorMgr.h"
+#include "nusmv/core/utils/Logger.h"
+#include "nusmv/core/utils/RandomGen.h"
+#include "nusmv/core/utils/error.h"
+#include "nusmv/core/opt/opt.h"
+#include "nusmv/core/parser/symbols.h"
+#include "nusmv/core/compile/compile.h"
+#include "nusmv/core/enc/bdd/BddEnc.h"
+#include "nusmv/core/fsm/bdd/BddFsm.h"
+#include "nusmv/core/fsm/bdd/FairnessList.h"
+#include "nusmv/core/wff/lr/MasterLogicRecognizer.h"
+
+#include <math.h>
+
+/*---------------------------------------------------------------------------*/
+/* Constant declarations                                                     */
+/*---------------------------------------------------------------------------*/
+
+/* at most this many derived level sets are used */
+#define STAT_RARE_MAX_LEVELS 64
+
+/* bounds on the number of repetitions of the estimation, as multiples
+   of the minimum one */
+#define STAT_RARE_MIN_RUNS 10
+#define STAT_RARE_MAX_RUNS_FACTOR 1000
+
+/* cross entropy: fraction of elite executions, iterations, and
+   bound on the absolute value of theta */
+#define STAT_RARE_CE_RHO 0.1
+#define STAT_RARE_CE_ITERATIONS 20
+#define STAT_RARE_CE_MAX_THETA 20.0
+
+/*---------------------------------------------------------------------------*/
+/* Structure declarations                                                    */
+/*---------------------------------------------------------------------------*/
+
+/*!
+  \brief A rare event estimation in progress
+
+*/
+typedef struct StatRare_TAG {
+  NuSMVEnv_ptr env;
+  StatSimulator_ptr simulator;
+  RandomGen_ptr gen;
+
+  /* the target is reached at level levels_num */
+  int levels_num;
+
+  /* executions per stage (splitting) or per pilot (sampling) */
+  int effort;
+
+  /* tilting of the importance sampling */
+  double theta;
+} StatRare;
+
+/*!
+  \brief A step of a pilot execution of the cross entropy method
+
+*/
+typedef struct StatRareStep_TAG {
+  /* successors of the source at each level, owned by the simulator */
+  const double* counts;
+
+  /* level of the chosen successor */
+  int level;
+} StatRareStep;
+
+/*!
+  \brief A pilot execution of the cross entropy method
+
+*/
+typedef struct StatRarePath_TAG {
+  StatRareStep* steps;
+  int steps_num;
+  int steps_size;
+
+  /* highest level reached and likelihood ratio */
+  int max_level;
+  double ratio;
+} StatRarePath;
+
+/*---------------------------------------------------------------------------*/
+/* Type declarations                                                         */
+/*---------------------------------------------------------------------------*/
+
+typedef double (*StatRareRunFun)(StatRare* rare);
+
+/**AutomaticStart*************************************************************/
+
+/*---------------------------------------------------------------------------*/
+/* Static function prototypes                                                */
+/*---------------------------------------------------------------------------*/
+
+static Expr_ptr stat_rare_get_target(const NuSMVEnv_ptr env,
+                                     const Prop_ptr prop);
+
+static bdd_ptr* stat_rare_build_levels(const NuSMVEnv_ptr env,
+                                       bdd_ptr target,
+                                       node_ptr level_exprs,
+                                       int* levels_num);
+
+static bdd_ptr* stat_rare_derive_levels(const NuSMVEnv_ptr env,
+                                        bdd_ptr target,
+                                        int* levels_num);
+
+static double stat_rare_estimate(StatRare* rare, StatRareRunFun run,
+                                 const double epsilon, const double delta,
+                                 double* half_width);
+
+static double stat_rare_split(StatRare* rare);
+
+static boolean stat_rare_climb(StatRare* rare, StatTrace_ptr trace,
+                               const int level);
+
+static double stat_rare_sample(StatRare* rare);
+
+static double stat_rare_sample_path(StatRare* rare, StatRarePath* path);
+
+static void stat_rare_tune(StatRare* rare);
+
+static double stat_rare_ce_gradient(const StatRarePath* paths,
+                                    const int paths_num,
+                                    const int min_level,
+                                    const int levels_num,
+                                    const double theta);
+
+static double stat_rare_normal_quantile(const double p);
+
+/*---------------------------------------------------------------------------*/
+/* Definition of exported functions                                          */
+/*---------------------------------------------------------------------------*/
+
+int Stat_check_ltlspec_rare(const NuSMVEnv_ptr env,
+                            const Prop_ptr prop,
+                            const StatRareMethod method,
+                            node_ptr level_exprs,
+                            const int effort,
+                            const double error_level,
+                            const double confidence_level,
+                            double* res,
+                            double* half_width)
+{
+  const ErrorMgr_ptr errmgr =
+    ERROR_MGR(NuSMVEnv_get_value(env, ENV_ERROR_MANAGER));
+  const OptsHandler_ptr opts =
+    OPTS_HANDLER(NuSMVEnv_get_value(env, ENV_OPTS_HANDLER));
+  const BddFsm_ptr fsm = BDD_FSM(NuSMVEnv_get_value(env, ENV_BDD_FSM));
+  const BddEnc_ptr enc = BddFsm_get_bdd_encoding(fsm);
+  const DDMgr_ptr dd = BddEnc_get_dd_manager(enc);
+  StatRare rare;
+  Expr_ptr target_expr;
+  bdd_ptr target;
+  bdd_ptr* levels;
+  boolean failed = false;
+  int i;
+
+  nusmv_assert(0 < effort);
+
+  target_expr = stat_rare_get_target(env, prop);
+  if (Nil == target_expr) {
+    ErrorMgr_rpterr(errmgr, "Rare event estimation requires a property "
+                    "F p, with p a simple expression\n");
+  }
+
+  /* the estimate does not take fairness into account */
+  if (! FairnessList_is_empty(FAIRNESS_LIST(BddFsm_get_justice(fsm))) ||
+      ! FairnessList_is_empty(FAIRNESS_LIST(BddFsm_get_compassion(fsm)))) {
+    ErrorMgr_rpterr(errmgr, "Rare event estimation does not support "
+                    "fairness constraints\n");
+  }
+
+  if (STAT_RARE_IMPORTANCE == method &&
+      NuSMVEnv_has_value(env, ENV_STAT_INPUT_PROBS)) {
+    ErrorMgr_rpterr(errmgr, "Importance sampling can not be used with "
+                    "input probabilities\n");
+  }
+
+  target = BddEnc_expr_to_bdd(enc, target_expr, Nil);
+  levels = stat_rare_build_levels(env, target, level_exprs, &rare.levels_num);
+  bdd_free(dd, target);
+
+  if (opt_verbose_level_gt(opts, 0)) {
+    const Logger_ptr logger = LOGGER(NuSMVEnv_get_value(env, ENV_LOGGER));
+
+    Logger_log(logger, "Rare event estimation with %d levels\n",
+               rare.levels_num);
+  }
+
+  rare.env = env;
+  rare.simulator = StatSimulator_create(env);
+  rare.gen = RANDOM_GEN(NuSMVEnv_get_value(env, ENV_STAT_RANDOM_GEN));
+  rare.effort = effort;
+  rare.theta = 0.0;
+
+  StatSimulator_set_levels(rare.simulator, levels, rare.levels_num);
+
+  for (i = 0; i < rare.levels_num; i++) bdd_free(dd, levels[i]);
+  FREE(levels);
+
+  CATCH(errmgr) {
+    switch (method) {
+    case STAT_RARE_SPLITTING:
+      *res = stat_rare_estimate(&rare, stat_rare_split,
+                                error_level, confidence_level, half_width);
+      break;
+
+    case STAT_RARE_IMPORTANCE:
+      stat_rare_tune(&rare);
+      *res = stat_rare_estimate(&rare, stat_rare_sample,
+                                error_level, confidence_level, half_width);
+      break;
+
+    default:
+      error_unreachable_code_msg("Unknown rare event method %d\n", method);
+    }
+  }
+  FAIL(errmgr) {
+    failed = true;
+  }
+
+  StatSimulator_destroy(rare.simulator);
+
+  if (failed) ErrorMgr_nusmv_exit(errmgr, 1);
+
+  return 0;
+}
+
+StatRareMethod Stat_rare_method_from_string(const char* name)
+{
+  if (0 == strcmp(name, "splitting")) return STAT_RARE_SPLITTING;
+  if (0 == strcmp(name, "importance")) return STAT_RARE_IMPORTANCE;
+
+  return STAT_RARE_INVALID;
+}
+
+/*---------------------------------------------------------------------------*/
+/* Definition of internal functions                                          */
+/*---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*/
+/* Definition of static functions                                            */
+/*---------------------------------------------------------------------------*/
+
+/*!
+  \brief Returns p if prop is F p with p a simple expression
+
+  Returns Nil otherwise. p is flattened, with defines expanded.
+*/
+static Expr_ptr stat_rare_get_target(const NuSMVEnv_ptr env,
+                                     const Prop_ptr prop)
+{
+  const SymbTable_ptr st = SYMB_TABLE(NuSMVEnv_get_value(env, ENV_SYMB_TABLE));
+  const MasterLogicRecognizer_ptr mlr =
+    MASTER_LOGIC_RECOGNIZER(NuSMVEnv_get_value(env,
+                                               ENV_MASTER_LOGIC_RECOGNIZER));
+  Expr_ptr formula;
+
+  if (Prop_Ltl != Prop_get_type(prop)) return Nil;
+
+  formula = Compile_FlattenSexpExpandDefine(st, Prop_get_expr_core(prop), Nil);
+
+  if (OP_FUTURE != node_get_type(formula) ||
+      EXP_SIMPLE != MasterLogicRecognizer_recognize(mlr, car(formula), Nil)) {
+    return Nil;
+  }
+
+  return car(formula);
+}
+
+/*!
+  \brief Builds the nested level sets
+
+  level_exprs is a list of simple expressions, the i-th one
+  characterizing the states of level at least i + 1. Each level set
+  is joined with the next ones, so that the sets are nested, and the
+  last one is target. If level_exprs is Nil the level sets are
+  derived from target. The returned array and its bdds must be freed
+  by the caller.
+*/
+static bdd_ptr* stat_rare_build_levels(const NuSMVEnv_ptr env,
+                                       bdd_ptr target,
+                                       node_ptr level_exprs,
+                                       int* levels_num)
+{
+  const SymbTable_ptr st = SYMB_TABLE(NuSMVEnv_get_value(env, ENV_SYMB_TABLE));
+  const BddEnc_ptr enc = BDD_ENC(NuSMVEnv_get_value(env, ENV_BDD_ENCODER));
+  const DDMgr_ptr dd = BddEnc_get_dd_manager(enc);
+  bdd_ptr* res;
+  node_ptr iter;
+  int i;
+
+  if (Nil == level_exprs) {
+    return stat_rare_derive_levels(env, target, levels_num);
+  }
+
+  *levels_num = llength(level_exprs) + 1;
+  res = ALLOC(bdd_ptr, *levels_num);
+
+  for (i = 0, iter = level_exprs; Nil != iter; i++, iter = cdr(iter)) {
+    Expr_ptr expr = Compile_FlattenSexpExpandDefine(st, car(iter), Nil);
+
+    res[i] = BddEnc_expr_to_bdd(enc, expr, Nil);
+  }
+  res[*levels_num - 1] = bdd_dup(target);
+
+  for (i = *levels_num - 2; 0 <= i; i--) {
+    bdd_or_accumulate(dd, &res[i], res[i + 1]);
+  }
+
+  return res;
+}
+
+/*!
+  \brief Derives the level sets from the backward reachability layers
+  of target
+
+  The i-th layer is made of the states reaching target in at most i
+  steps. The layers are computed up to the fixpoint, and then at most
+  STAT_RARE_MAX_LEVELS of them, evenly spaced, are used as level
+  sets: the farther from target the lower the level.
+*/
+static bdd_ptr* stat_rare_derive_levels(const NuSMVEnv_ptr env,
+                                        bdd_ptr target,
+                                        int* levels_num)
+{
+  const BddFsm_ptr fsm = BDD_FSM(NuSMVEnv_get_value(env, ENV_BDD_FSM));
+  const BddEnc_ptr enc = BddFsm_get_bdd_encoding(fsm);
+  const DDMgr_ptr dd = BddEnc_get_dd_manager(enc);
+  bdd_ptr* layers;
+  bdd_ptr* res;
+  int layers_num, layers_size;
+  int stride, i;
+
+  layers_size = 16;
+  layers = ALLOC(bdd_ptr, layers_size);
+  layers[0] = BddEnc_apply_state_frozen_vars_mask_bdd(enc, target);
+  layers_num = 1;
+
+  while (true) {
+    bdd_ptr last = layers[layers_num - 1];
+    bdd_ptr pre = BddFsm_get_backward_image(fsm, last);
+    bdd_ptr next = BddEnc_apply_state_frozen_vars_mask_bdd(enc, pre);
+
+    bdd_or_accumulate(dd, &next, last);
+    bdd_free(dd, pre);
+
+    if (next == last) {
+      bdd_free(dd, next);
+      break;
+    }
+
+    if (layers_num == layers_size) {
+      layers_size *= 2;
+      layers = REALLOC(bdd_ptr, layers, layers_size);
+    }
+    layers[layers_num++] = next;
+  }
+
+  /* layers_num - 1 is the farthest layer */
+  stride = (layers_num + STAT_RARE_MAX_LEVELS - 1) / STAT_RARE_MAX_LEVELS;
+  *levels_num = (layers_num + stride - 1) / stride;
+  res = ALLOC(bdd_ptr, *levels_num);
+
+  for (i = 0; i < *levels_num; i++) {
+    /* the last level set is target */
+    res[i] = bdd_dup(layers[(*levels_num - 1 - i) * stride]);
+  }
+
+  for (i = 0; i < layers_num; i++) bdd_free(dd, layers[i]);
+  FREE(layers);
+
+  return res;
+}
+
+/*!
+  \brief Repeats run until its mean is known within relative error
+  epsilon with confidence 1 - delta
+
+  The confidence interval is the one of the central limit theorem,
+  and its half width is stored in half_width. At least
+  STAT_RARE_MIN_RUNS runs are performed, and at most
+  STAT_RARE_MAX_RUNS_FACTOR times as many: in that case the estimate
+  does not have the required precision, and a warning is issued.
+*/
+static double stat_rare_estimate(StatRare* rare, StatRareRunFun run,
+                                 const double epsilon, const double delta,
+                                 double* half_width)
+{
+  const OptsHandler_ptr opts =
+    OPTS_HANDLER(NuSMVEnv_get_value(rare->env, ENV_OPTS_HANDLER));
+  const double z = stat_rare_normal_quantile(1.0 - delta / 2.0);
+  const long max_runs = (long)STAT_RARE_MIN_RUNS * STAT_RARE_MAX_RUNS_FACTOR;
+  double sum = 0.0;
+  double sum_sq = 0.0;
+  double mean = 0.0;
+  long runs = 0;
+
+  *half_width = HUGE_VAL;
+
+  while (runs < max_runs) {
+    const double x = run(rare);
+    double variance;
+
+    runs++;
+    sum += x;
+    sum_sq += x * x;
+
+    if (runs < STAT_RARE_MIN_RUNS) continue;
+
+    mean = sum / runs;
+    variance = (sum_sq - runs * mean * mean) / (runs - 1);
+    *half_width = z * sqrt((0 < variance) ? variance / runs : 0.0);
+
+    if (0 < mean && *half_width <= epsilon * mean) break;
+  }
+
+  if (opt_verbose_level_gt(opts, 0)) {
+    const Logger_ptr logger =
+      LOGGER(NuSMVEnv_get_value(rare->env, ENV_LOGGER));
+
+    Logger_log(logger, "Rare event estimate %g +- %g after %ld runs\n",
+               mean, *half_width, runs);
+  }
+
+  if (max_runs <= runs) {
+    const ErrorMgr_ptr errmgr =
+      ERROR_MGR(NuSMVEnv_get_value(rare->env, ENV_ERROR_MANAGER));
+
+    ErrorMgr_warning_msg(errmgr, "rare event estimate did not reach the "
+                         "required precision after %ld runs\n", runs);
+  }
+
+  return mean;
+}
+
+/*!
+  \brief A run of fixed effort importance splitting
+
+  Returns the estimate of the probability of reaching the last level.
+*/
+static double stat_rare_split(StatRare* rare)
+{
+  const BddEnc_ptr enc =
+    BDD_ENC(NuSMVEnv_get_value(rare->env, ENV_BDD_ENCODER));
+  const DDMgr_ptr dd = BddEnc_get_dd_manager(enc);
+  StatTrace_ptr* traces = ALLOC(StatTrace_ptr, rare->effort);
+  bdd_ptr* states = ALLOC(bdd_ptr, rare->effort);
+  StatTrace_ptr* next_traces = ALLOC(StatTrace_ptr, rare->effort);
+  bdd_ptr* next_states = ALLOC(bdd_ptr, rare->effort);
+  double res = 1.0;
+  int entries = 0;
+  int level, i;
+
+  for (level = 1; level <= rare->levels_num && 0 < res; level++) {
+    int hits = 0;
+
+    for (i = 0; i < rare->effort; i++) {
+      StatTrace_ptr trace;
+
+      if (1 == level) {
+        Expr_ptr init = StatSimulator_pick_init(rare->simulator);
+
+        if (Nil == init) {
+          error_unreachable_code_msg("Error handling not yet implemented!!!\n");
+        }
+
+        trace = StatTrace_create();
+        StatTrace_add_state(trace, init, false);
+      }
+      else {
+        /* each execution continues a random prefix of the previous stage */
+        const int entry = (int)RandomGen_next_below(rare->gen, entries);
+
+        trace = StatTrace_copy(traces[entry]);
+        StatSimulator_restart(rare->simulator, states[entry]);
+      }
+
+      if (stat_rare_climb(rare, trace, level)) {
+        next_traces[hits] = trace;
+        next_states[hits] = StatSimulator_get_state(rare->simulator);
+        hits++;
+      }
+      else {
+        StatTrace_destroy(trace);
+      }
+    }
+
+    for (i = 0; i < entries; i++) {
+      StatTrace_destroy(traces[i]);
+      bdd_free(dd, states[i]);
+    }
+
+    /* the prefixes reaching this level start the next stage */
+    {
+      StatTrace_ptr* tmp_traces = traces;
+      bdd_ptr* tmp_states = states;
+
+      traces = next_traces; next_traces = tmp_traces;
+      states = next_states; next_states = tmp_states;
+      entries = hits;
+    }
+
+    res *= (double)hits / rare->effort;
+  }
+
+  for (i = 0; i < entries; i++) {
+    StatTrace_destroy(traces[i]);
+    bdd_free(dd, states[i]);
+  }
+
+  FREE(next_states);
+  FREE(next_traces);
+  FREE(states);
+  FREE(traces);
+
+  return res;
+}
+
+/*!
+  \brief Extends trace until it reaches the given level
+
+  Returns false if the execution loops back before.
+*/
+static boolean stat_rare_climb(StatRare* rare, StatTrace_ptr trace,
+                               const int level)
+{
+  while (StatSimulator_get_level(rare->simulator) < level) {
+    Expr_ptr state = StatSimulator_step(rare->simulator);
+
+    if (Nil == state) {
+      error_unreachable_code_msg("Error handling not yet implemented!!!\n");
+    }
+
+    StatTrace_add_state(trace, state, true);
+    if (StatTrace_is_generated(trace)) return false;
+  }
+
+  return true;
+}
+
+/*!
+  \brief A run of importance sampling
+
+  Returns the likelihood ratio of the execution if it reaches the
+  last level, 0 otherwise.
+*/
+static double stat_rare_sample(StatRare* rare)
+{
+  return stat_rare_sample_path(rare, (StatRarePath*)NULL);
+}
+
+/*!
+  \brief Draws an execution with the tilted simulation
+
+  Returns the likelihood ratio of the execution if it reaches the
+  last level, 0 otherwise. If path is not NULL the steps, the
+  highest level and the likelihood ratio are stored in it.
+*/
+static double stat_rare_sample_path(StatRare* rare, StatRarePath* path)
+{
+  StatTrace_ptr trace = StatTrace_create();
+  Expr_ptr state = StatSimulator_pick_init(rare->simulator);
+  double ratio = 1.0;
+  boolean hit = false;
+  int level;
+
+  if (Nil == state) {
+    error_unreachable_code_msg("Error handling not yet implemented!!!\n");
+  }
+
+  StatTrace_add_state(trace, state, false);
+  level = StatSimulator_get_level(rare->simulator);
+
+  if ((StatRarePath*)NULL != path) {
+    path->steps_num = 0;
+    path->max_level = level;
+  }
+
+  while (! hit && ! StatTrace_is_generated(trace)) {
+    const double* counts =
+      StatSimulator_get_successor_levels(rare->simulator);
+    double step_ratio;
+
+    if (rare->levels_num == level) {
+      hit = true;
+      break;
+    }
+
+    state = StatSimulator_step_tilted(rare->simulator, rare->theta,
+                                      &step_ratio);
+    if (Nil == state) {
+      error_unreachable_code_msg("Error handling not yet implemented!!!\n");
+    }
+
+    StatTrace_add_state(trace, state, true);
+    ratio *= step_ratio;
+    level = StatSimulator_get_level(rare->simulator);
+
+    if ((StatRarePath*)NULL != path) {
+      if (path->steps_num == path->steps_size) {
+        path->steps_size = (0 < path->steps_size) ? 2 * path->steps_size : 16;
+        path->steps = REALLOC(StatRareStep, path->steps, path->steps_size);
+      }
+
+      path->steps[path->steps_num].counts = counts;
+      path->steps[path->steps_num].level = level;
+      path->steps_num++;
+
+      if (path->max_level < level) path->max_level = level;
+    }
+  }
+
+  StatTrace_destroy(trace);
+
+  if ((StatRarePath*)NULL != path) path->ratio = ratio;
+
+  return hit ? ratio : 0.0;
+}
+
+/*!
+  \brief Tunes theta with the cross entropy method
+
+  At each iteration effort pilot executions are drawn with the
+  current theta, and the elite ones are those reaching the level
+  reached by a fraction STAT_RARE_CE_RHO of them. The new theta
+  maximizes the likelihood of the elite executions, weighted by
+  their likelihood ratio. The tuning stops when the elite executions
+  reach the last level.
+*/
+static void stat_rare_tune(StatRare* rare)
+{
+  const OptsHandler_ptr opts =
+    OPTS_HANDLER(NuSMVEnv_get_value(rare->env, ENV_OPTS_HANDLER));
+  StatRarePath* paths = ALLOC(StatRarePath, rare->effort);
+  int* max_levels = ALLOC(int, rare->effort);
+  int iteration, i;
+
+  for (i = 0; i < rare->effort; i++) {
+    paths[i].steps = (StatRareStep*)NULL;
+    paths[i].steps_num = 0;
+    paths[i].steps_size = 0;
+  }
+
+  for (iteration = 0; iteration < STAT_RARE_CE_ITERATIONS; iteration++) {
+    int elite_level;
+    double lo, hi;
+
+    for (i = 0; i < rare->effort; i++) {
+      stat_rare_sample_path(rare, &paths[i]);
+      max_levels[i] = paths[i].max_level;
+    }
+
+    /* the (1 - rho) quantile of the highest levels reached: counting
+       sort, levels are small integers */
+    {
+      int* num = ALLOC(int, rare->levels_num + 1);
+      int elite = (int)ceil(STAT_RARE_CE_RHO * rare->effort);
+      int seen = 0;
+
+      for (i = 0; i <= rare->levels_num; i++) num[i] = 0;
+      for (i = 0; i < rare->effort; i++) num[max_levels[i]]++;
+
+      for (elite_level = rare->levels_num; 0 < elite_level; elite_level--) {
+        seen += num[elite_level];
+        if (elite <= seen) break;
+      }
+      FREE(num);
+    }
+
+    /* the gradient of the likelihood decreases with theta */
+    lo = -STAT_RARE_CE_MAX_THETA;
+    hi = STAT_RARE_CE_MAX_THETA;
+    if (0 < stat_rare_ce_gradient(paths, rare->effort, elite_level,
+                                  rare->levels_num, hi)) {
+      rare->theta = hi;
+    }
+    else if (stat_rare_ce_gradient(paths, rare->effort, elite_level,
+                                   rare->levels_num, lo) < 0) {
+      rare->theta = lo;
+    }
+    else {
+      for (i = 0; i < 50; i++) {
+        const double mid = (lo + hi) / 2.0;
+
+        if (0 < stat_rare_ce_gradient(paths, rare->effort, elite_level,
+                                      rare->levels_num, mid)) {
+          lo = mid;
+        }
+        else hi = mid;
+      }
+      rare->theta = (lo + hi) / 2.0;
+    }
+
+    if (opt_verbose_level_gt(opts, 0)) {
+      const Logger_ptr logger =
+        LOGGER(NuSMVEnv_get_value(rare->env, ENV_LOGGER));
+
+      Logger_log(logger, "Cross entropy iteration %d: elite level %d, "
+                 "theta %g\n", iteration, elite_level, rare->theta);
+    }
+
+    if (rare->levels_num == elite_level) break;
+  }
+
+  for (i = 0; i < rare->effort; i++) {
+    if ((StatRareStep*)NULL != paths[i].steps) FREE(paths[i].steps);
+  }
+  FREE(max_levels);
+  FREE(paths);
+}
+
+/*!
+  \brief Derivative in theta of the weighted log likelihood of the
+  elite executions
+
+  The elite executions are the ones reaching min_level. Each step
+  contributes the difference between the level of the chosen
+  successor and its expected level under the tilting theta.
+*/
+static double stat_rare_ce_gradient(const StatRarePath* paths,
+                                    const int paths_num,
+                                    const int min_level,
+                                    const int levels_num,
+                                    const double theta)
+{
+  double res = 0.0;
+  int i, t, j;
+
+  for (i = 0; i < paths_num; i++) {
+    double path_res = 0.0;
+
+    if (paths[i].max_level < min_level) continue;
+
+    for (t = 0; t < paths[i].steps_num; t++) {
+      const double* counts = paths[i].steps[t].counts;
+      double shift = -HUGE_VAL;
+      double mass = 0.0;
+      double expected = 0.0;
+
+      for (j = 0; j <= levels_num; j++) {
+        if (0 < counts[j] && shift < theta * j) shift = theta * j;
+      }
+      for (j = 0; j <= levels_num; j++) {
+        if (0 < counts[j]) {
+          const double w = counts[j] * exp(theta * j - shift);
+
+          mass += w;
+          expected += j * w;
+        }
+      }
+
+      path_res += paths[i].steps[t].level - expected / mass;
+    }
+
+    res += paths[i].ratio * path_res;
+  }
+
+  return res;
+}
+
+/*!
+  \brief Quantile function of the standard normal distribution
+
+  Uses the rational approximation of Acklam, whose relative error is
+  below 1.15e-9.
+*/
+static double stat_rare_normal_quantile(const double p)
+{
+  static const double a[] = { -3.969683028665376e+01, 2.209460984245205e+02,
+                              -2.759285104469687e+02, 1.383577518672690e+02,
+                              -3.066479806614716e+01, 2.506628277459239e+00 };
+  static const double b[] = { -5.447609879822406e+01, 1.615858368580409e+02,
+                              -1.556989798598866e+02, 6.680131188771972e+01,
+                              -1.328068155288572e+01 };
+  static const double c[] = { -7.784894002430293e-03, -3.223964580411365e-01,
+                              -2.400758277161838e+00, -2.549732539343734e+00,
+                              4.374664141464968e+00, 2.938163982698783e+00 };
+  static const double d[] = { 7.784695709041462e-03, 3.224671290700398e-01,
+                              2.445134137142996e+00, 3.754408661907416e+00 };
+  const double p_low = 0.02425;
+  double q, r;
+
+  nusmv_assert(0 < p && p < 1);
+
+  if (p < p_low) {
+    q = sqrt(-2 * log(p));
+    return (((((c[0]*q + c[1])*q + c[2])*q + c[3])*q + c[4])*q + c[5]) /
+      ((((d[0]*q + d[1])*q + d[2])*q + d[3])*q + 1);
+  }
+
+  if (1 - p_low < p) {
+    q = sqrt(-2 * log(1 - p));
+    return -(((((c[0]*q + c[1])*q + c[2])*q + c[3])*q + c[4])*q + c[5]) /
+      ((((d[0]*q + d[1])*q + d[2])*q + d[3])*q + 1);
+  }
+
+  q = p - 0.5;
+  r = q * q;
+  return (((((a[0]*r + a[1])*r + a[2])*r + a[3])*r + a[4])*r + a[5])*q /
+    (((((b[0]*r + b[1])*r + b[2])*r + b[3])*r + b[4])*r + 1);
+}
+
+/**AutomaticEnd***************************************************************/
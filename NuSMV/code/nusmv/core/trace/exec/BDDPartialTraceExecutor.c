@@ -412,7 +412,8 @@ bdd_partial_trace_executor_generate(const BDDPartialTraceExecutor_ptr self,
   env = EnvObject_get_environment(ENV_OBJECT(self));
   nodemgr = NODE_MGR(NuSMVEnv_get_value(env, ENV_NODE_MGR));
 
-  target = BddEnc_pick_one_state_rand(self->enc, goal_states);
+  target = BddEnc_pick_one_state_rand(self->enc, goal_states,
+                                      (RandomGen_ptr)NULL);
   path = cons(nodemgr, (node_ptr) target, Nil);
 
   if (Nil != reachable) {
@@ -88,6 +88,12 @@ typedef struct BddTrans_TAG
   bdd_ptr (*trans_compute_k_image)(void* transition,
                                    bdd_ptr bdd, int k, TransImageKind kind);
 
+  /* the same as compute_image applied to the conjunction of cube and
+     bdd, where cube is a conjunction of literals (e.g. a concrete
+     state). Optional: when NULL, compute_image is used instead. */
+  bdd_ptr (*trans_compute_cube_image)(void* transition, bdd_ptr cube,
+                                      bdd_ptr bdd, TransImageKind kind);
+
   /* returns a BDD representing the whole
      transition relation. To be freed by invoker. */
   bdd_ptr (*trans_get_monolithic_bdd)(void* transition);
@@ -181,6 +187,13 @@ bdd_trans_debug_partitioned(const ClusterBasedTrans_ptr self,
 
 
 /* implementation of function for ClusterBasedTrans */
+static BddTrans_ptr
+bdd_trans_clusterlist_create(const NuSMVEnv_ptr env,
+                             ClusterBasedTrans_ptr trans,
+                             bdd_ptr state_vars_cube,
+                             bdd_ptr input_vars_cube,
+                             bdd_ptr next_state_vars_cube,
+                             const TransType trans_type);
 static void* bdd_trans_clusterlist_copy(void* transition);
 static void bdd_trans_clusterlist_destroy(void* transition);
 static bdd_ptr bdd_trans_clusterlist_compute_image(void* transition,
@@ -189,6 +202,10 @@ static bdd_ptr bdd_trans_clusterlist_compute_image(void* transition,
 static bdd_ptr bdd_trans_clusterlist_compute_k_image(void* transition,
                                                bdd_ptr bdd, int k,
                                                TransImageKind kind);
+static bdd_ptr bdd_trans_clusterlist_compute_cube_image(void* transition,
+                                                        bdd_ptr cube,
+                                                        bdd_ptr bdd,
+                                                        TransImageKind kind);
 static bdd_ptr bdd_trans_clusterlist_get_monolithic_bdd(void* transition);
 static ClusterList_ptr 
 bdd_trans_clusterlist_get_clusterlist(void* transition);
@@ -248,33 +265,38 @@ BddTrans_ptr BddTrans_create(DDMgr_ptr dd_manager,
 
   } /* switch on type */
 
-  ClusterList_build_schedule(trans->forward_trans,
-                             state_vars_cube, input_vars_cube);
-
-  ClusterList_build_schedule(trans->backward_trans,
-                             next_state_vars_cube, input_vars_cube);
-
 # ifdef TRANS_DEBUG_THRESHOLD  /* trans checking of partitioned trans */
   if (trans_type != TRANS_TYPE_MONOLITHIC) {
     bdd_trans_debug_partitioned(trans, clusters_bdd, errstream);
   }
 # endif
 
+  self = bdd_trans_clusterlist_create(env, trans,
+                                      state_vars_cube, input_vars_cube,
+                                      next_state_vars_cube, trans_type);
 
-  self = BddTrans_generic_create(env,
-                                 trans_type,
-                                 trans,
-                                 bdd_trans_clusterlist_copy,
-                                 bdd_trans_clusterlist_destroy,
-                                 bdd_trans_clusterlist_compute_image,
-                                 bdd_trans_clusterlist_compute_k_image,
-                                 bdd_trans_clusterlist_get_monolithic_bdd,
-                                 bdd_trans_clusterlist_synchronous_product,
-                                 bdd_trans_clusterlist_print_short_info,
-                                 bdd_trans_clusterlist_get_clusterlist);
   return self;
 }
 
+BddTrans_ptr BddTrans_create_partitioned(DDMgr_ptr dd_manager,
+                                         ClusterList_ptr forward,
+                                         ClusterList_ptr backward,
+                                         bdd_ptr state_vars_cube,
+                                         bdd_ptr input_vars_cube,
+                                         bdd_ptr next_state_vars_cube,
+                                         const TransType trans_type)
+{
+  const NuSMVEnv_ptr env = EnvObject_get_environment(ENV_OBJECT(dd_manager));
+  ClusterBasedTrans_ptr trans = ALLOC(ClusterBasedTrans, 1);
+
+  trans->forward_trans = forward;
+  trans->backward_trans = backward;
+
+  return bdd_trans_clusterlist_create(env, trans,
+                                      state_vars_cube, input_vars_cube,
+                                      next_state_vars_cube, trans_type);
+}
+
 BddTrans_ptr
 BddTrans_generic_create(const NuSMVEnv_ptr env,
                         const TransType trans_type,
@@ -331,6 +353,18 @@ ClusterList_ptr BddTrans_get_clusterlist(const BddTrans_ptr self)
   return self->trans_get_clusterlist(self->transition);
 }
 
+ClusterList_ptr BddTrans_get_backward_clusterlist(const BddTrans_ptr self)
+{
+  BDD_TRANS_CHECK_INSTANCE(self);
+
+  if (self->trans_get_clusterlist != bdd_trans_clusterlist_get_clusterlist) {
+    return CLUSTER_LIST(NULL);
+  }
+
+  return ClusterList_copy(
+           ((ClusterBasedTrans_ptr) self->transition)->backward_trans);
+}
+
 bdd_ptr BddTrans_get_forward_image_state(const BddTrans_ptr self, bdd_ptr s)
 {
   BDD_TRANS_CHECK_INSTANCE(self);
@@ -339,6 +373,31 @@ bdd_ptr BddTrans_get_forward_image_state(const BddTrans_ptr self, bdd_ptr s)
 
 }
 
+bdd_ptr BddTrans_get_forward_image_state_cube(const BddTrans_ptr self,
+                                             bdd_ptr cube, bdd_ptr s)
+{
+  DDMgr_ptr dd;
+  bdd_ptr res;
+  bdd_ptr tmp;
+
+  BDD_TRANS_CHECK_INSTANCE(self);
+
+  if (NULL != self->trans_compute_cube_image) {
+    return self->trans_compute_cube_image(self->transition, cube, s,
+                                          TRANS_IMAGE_FORWARD_STATE);
+  }
+
+  dd = DD_MGR(NuSMVEnv_get_value(EnvObject_get_environment(ENV_OBJECT(self)),
+                                 ENV_DD_MGR));
+
+  tmp = bdd_and(dd, cube, s);
+  res = self->trans_compute_image(self->transition, tmp,
+                                  TRANS_IMAGE_FORWARD_STATE);
+  bdd_free(dd, tmp);
+
+  return res;
+}
+
 bdd_ptr BddTrans_get_forward_image_state_input(const BddTrans_ptr self, bdd_ptr s)
 {
   BDD_TRANS_CHECK_INSTANCE(self);
@@ -435,6 +494,7 @@ static void bdd_trans_init(BddTrans_ptr self,
   self->trans_destroy = trans_destroy;
   self->trans_compute_image = trans_compute_image;
   self->trans_compute_k_image = trans_compute_k_image;
+  self->trans_compute_cube_image = NULL;
   self->trans_get_monolithic_bdd = trans_get_monolithic_bdd;
   self->trans_synchronous_product = trans_synchronous_product;
   self->trans_print_short_info = trans_print_short_info;
@@ -492,6 +552,7 @@ static Object_ptr bdd_trans_copy(const Object_ptr object)
   copy->trans_destroy = self->trans_destroy;
   copy->trans_compute_image = self->trans_compute_image;
   copy->trans_compute_k_image = self->trans_compute_k_image;
+  copy->trans_compute_cube_image = self->trans_compute_cube_image;
   copy->trans_get_monolithic_bdd = self->trans_get_monolithic_bdd;
   copy->trans_synchronous_product = self->trans_synchronous_product;
   copy->trans_print_short_info = self->trans_print_short_info;
@@ -559,6 +620,46 @@ bdd_trans_debug_partitioned(const ClusterBasedTrans_ptr self,
 
 ***************************************************************************/
 
+/*!
+  \brief Wraps the given partitioned cluster lists into a BddTrans
+
+  Builds the quantification schedules of both lists. The ownership
+  of trans is taken.
+*/
+static BddTrans_ptr
+bdd_trans_clusterlist_create(const NuSMVEnv_ptr env,
+                             ClusterBasedTrans_ptr trans,
+                             bdd_ptr state_vars_cube,
+                             bdd_ptr input_vars_cube,
+                             bdd_ptr next_state_vars_cube,
+                             const TransType trans_type)
+{
+  BddTrans_ptr self;
+
+  ClusterList_build_schedule(trans->forward_trans,
+                             state_vars_cube, input_vars_cube);
+
+  ClusterList_build_schedule(trans->backward_trans,
+                             next_state_vars_cube, input_vars_cube);
+
+  self = BddTrans_generic_create(env,
+                                 trans_type,
+                                 trans,
+                                 bdd_trans_clusterlist_copy,
+                                 bdd_trans_clusterlist_destroy,
+                                 bdd_trans_clusterlist_compute_image,
+                                 bdd_trans_clusterlist_compute_k_image,
+                                 bdd_trans_clusterlist_get_monolithic_bdd,
+                                 bdd_trans_clusterlist_synchronous_product,
+                                 bdd_trans_clusterlist_print_short_info,
+                                 bdd_trans_clusterlist_get_clusterlist);
+
+  /* single states are cofactored out of the clusters */
+  self->trans_compute_cube_image = bdd_trans_clusterlist_compute_cube_image;
+
+  return self;
+}
+
 /*!
   \brief Implementation of 'copy' parameter of
   BddTrans_generic_create having 'transition' of type ClusterBasedTrans_ptr
@@ -672,6 +773,25 @@ static bdd_ptr bdd_trans_clusterlist_compute_k_image(void* transition,
   } /* switch */
 }
 
+/*!
+  \brief Implementation of 'compute_cube_image' of transitions of
+  type ClusterBasedTrans_ptr
+
+  See struct BddTrans_TAG for specification of this function
+*/
+static bdd_ptr bdd_trans_clusterlist_compute_cube_image(void* transition,
+                                                        bdd_ptr cube,
+                                                        bdd_ptr bdd,
+                                                        TransImageKind kind)
+{
+  ClusterBasedTrans_ptr trans = (ClusterBasedTrans_ptr) transition;
+
+  /* only forward state images are computed by cofactoring */
+  nusmv_assert(TRANS_IMAGE_FORWARD_STATE == kind);
+
+  return ClusterList_get_image_state_cube(trans->forward_trans, cube, bdd);
+}
+
 /*!
   \brief Implementation of 'get_monolithic_bdd' parameter of
   BddTrans_generic_create having 'transition' of type ClusterBasedTrans_ptr
@@ -150,6 +150,29 @@ BddTrans_create(DDMgr_ptr dd_manager,
                 const TransType trans_type,
                 const ClusterOptions_ptr cl_options);
 
+/*!
+  \methodof BddTrans
+  \brief Builds the transition relation from already partitioned
+  cluster lists
+
+  forward and backward are the lists used for forward and backward
+  images, as returned by BddTrans_get_clusterlist and
+  BddTrans_get_backward_clusterlist on a BddTrans built with
+  BddTrans_create. No partitioning is performed, only the
+  quantification schedules are computed. The ownership of forward and
+  backward is taken.
+
+  \sa BddTrans_create
+*/
+BddTrans_ptr
+BddTrans_create_partitioned(DDMgr_ptr dd_manager,
+                            ClusterList_ptr forward,
+                            ClusterList_ptr backward,
+                            bdd_ptr state_vars_cube,
+                            bdd_ptr input_vars_cube,
+                            bdd_ptr next_state_vars_cube,
+                            const TransType trans_type);
+
 /*!
   \brief Builds the transition relation
 
@@ -218,6 +241,18 @@ BddTrans_get_monolithic_bdd(const BddTrans_ptr self);
 ClusterList_ptr
 BddTrans_get_clusterlist(const BddTrans_ptr self);
 
+/*!
+  \methodof BddTrans
+  \brief Returns a copy of the clusters used for backward images
+
+  Returns NULL if self was not built out of cluster lists. Invoker
+  has to free the returned clusterlist
+
+  \sa BddTrans_get_clusterlist
+*/
+ClusterList_ptr
+BddTrans_get_backward_clusterlist(const BddTrans_ptr self);
+
 /*!
   \methodof BddTrans
   \brief Computes the forward image by existentially quantifying
@@ -241,6 +276,24 @@ bdd_ptr
 BddTrans_get_forward_image_state_input(const BddTrans_ptr self,
                                        bdd_ptr s);
 
+/*!
+  \methodof BddTrans
+  \brief Computes the forward image of "cube" and "s" as
+  BddTrans_get_forward_image_state does.
+
+  "cube" must be a conjunction of literals, typically a single
+  concrete state. Transitions based on ClusterList cofactor each
+  cluster by "cube" instead of performing the full relational
+  product.
+
+  Returned bdd is referenced
+
+  \sa BddTrans_get_forward_image_state
+*/
+bdd_ptr
+BddTrans_get_forward_image_state_cube(const BddTrans_ptr self,
+                                      bdd_ptr cube, bdd_ptr s);
+
 /*!
   \methodof BddTrans
   \brief Computes the backward image by existentially quantifying
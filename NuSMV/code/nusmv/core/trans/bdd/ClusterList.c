@@ -208,6 +208,11 @@ static bdd_ptr
 cluster_list_get_k_image(const ClusterList_ptr self, bdd_ptr s, int k,
 bdd_ptr (*cluster_getter)(const Cluster_ptr cluster));
 
+static bdd_ptr
+cluster_list_get_cube_image(const ClusterList_ptr self,
+                            bdd_ptr cube, bdd_ptr s,
+                            bdd_ptr (*cluster_getter)(const Cluster_ptr cluster));
+
 
 static ClusterList_ptr
 cluster_list_iwls95_order(const ClusterList_ptr self,
@@ -534,6 +539,14 @@ ClusterList_get_image_state_input(const ClusterList_ptr self, bdd_ptr s)
   return cluster_list_get_image(self, s, &Cluster_get_quantification_state);
 }
 
+bdd_ptr ClusterList_get_image_state_cube(const ClusterList_ptr self,
+                                         bdd_ptr cube, bdd_ptr s)
+{
+  CLUSTER_LIST_CHECK_INSTANCE(self);
+  return cluster_list_get_cube_image(self, cube, s,
+                                     &Cluster_get_quantification_state_input);
+}
+
 bdd_ptr ClusterList_get_k_image_state(const ClusterList_ptr self, bdd_ptr s, int k)
 {
   CLUSTER_LIST_CHECK_INSTANCE(self);
@@ -936,6 +949,60 @@ cluster_list_get_image(const ClusterList_ptr self,
   return cur_prod;
 }
 
+/*!
+  \brief Use to compute the image of "cube" and "s"
+
+  "cube" is a conjunction of literals. Since cofactoring by a cube
+  distributes over conjunction, every cluster is cofactored by "cube"
+  and the (much smaller) results are conjoined and quantified along
+  the schedule, as in cluster_list_get_image. The variables of "cube"
+  are not in the support of the product: those which are never
+  quantified (e.g. frozen variables) are conjoined back at the end.
+*/
+
+static bdd_ptr
+cluster_list_get_cube_image(const ClusterList_ptr self,
+                            bdd_ptr cube, bdd_ptr s,
+                            bdd_ptr (*cluster_getter)(const Cluster_ptr cluster))
+{
+  ClusterListIterator_ptr iter;
+  bdd_ptr cur_prod;
+  bdd_ptr kept;
+
+  nusmv_assert(bdd_isnot_false(self->dd, cube));
+
+  cur_prod = bdd_cofactor(self->dd, s, cube);
+  kept = bdd_dup(cube);
+
+  iter = ClusterList_begin(self);
+  while ( ! ClusterListIterator_is_end(iter) &&
+          bdd_isnot_false(self->dd, cur_prod) ) {
+    Cluster_ptr cluster = ClusterList_get_cluster(self, iter);
+
+    bdd_ptr tmp = Cluster_get_trans(cluster);
+    bdd_ptr cof = bdd_cofactor(self->dd, tmp, cube);
+    bdd_ptr ex  = cluster_getter(cluster);
+    bdd_ptr new_p = bdd_and_abstract(self->dd, cur_prod, cof, ex);
+    bdd_ptr new_k = bdd_forsome(self->dd, kept, ex);
+
+    bdd_free(self->dd, cof);
+    bdd_free(self->dd, tmp);
+    bdd_free(self->dd, ex);
+
+    bdd_free(self->dd, cur_prod);
+    cur_prod = new_p;
+    bdd_free(self->dd, kept);
+    kept = new_k;
+
+    iter = ClusterListIterator_next(iter);
+  } /* iteration */
+
+  bdd_and_accumulate(self->dd, &cur_prod, kept);
+  bdd_free(self->dd, kept);
+
+  return cur_prod;
+}
+
 /*!
   \brief  Use to compute the k image from a given set of states
   "s".
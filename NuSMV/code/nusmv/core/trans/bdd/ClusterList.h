@@ -350,6 +350,25 @@ ClusterList_get_image_state(const ClusterList_ptr self, bdd_ptr s);
 bdd_ptr
 ClusterList_get_image_state_input(const ClusterList_ptr self, bdd_ptr s);
 
+/*!
+  \methodof ClusterList
+  \brief Computes the image of "cube" and "s" using the clusters of
+  the "self" while quantifying state vars only.
+
+  "cube" must be a conjunction of literals, typically a single
+  concrete state. Each cluster is cofactored by "cube" before being
+  conjoined, which is much cheaper than the relational product of
+  ClusterList_get_image_state, and gives the same result as
+  ClusterList_get_image_state applied to "cube" and "s".
+
+  Returned bdd is referenced
+
+  \sa ClusterList_get_image_state
+*/
+bdd_ptr
+ClusterList_get_image_state_cube(const ClusterList_ptr self,
+                                 bdd_ptr cube, bdd_ptr s);
+
 /*!
   \methodof ClusterList
   \brief  Computes the k image of the given bdd "s" using the
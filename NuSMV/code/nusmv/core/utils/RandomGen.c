@@ -0,0 +1,277 @@
+/* ---------------------------------------------------------------------------
+
+
+  This file is part of the ``utils'' package of NuSMV version 2.
+  Copyright (C) 2012 by FBK-irst.
+
+  NuSMV version 2 is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  NuSMV version 2 is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA.
+
+  For more information on NuSMV see <http://nusmv.fbk.eu>
+  or email to <nusmv-users@fbk.eu>.
+  Please report bugs to <nusmv-users@fbk.eu>.
+
+  To contact the NuSMV development board, email to <nusmv@fbk.eu>.
+
+-----------------------------------------------------------------------------*/
+
+/*!
+  \author Alberto Bombardelli
+  \brief Implementation of class 'RandomGen'
+
+  The state is initialized from the seed with splitmix64, as
+  suggested by the authors of xoshiro256**.
+
+*/
+
+#if HAVE_CONFIG_H
+# include "nusmv-config.h"
+#endif
+
+#include "nusmv/core/utils/RandomGen.h"
+
+#if NUSMV_HAVE_UNISTD_H
+# include <unistd.h>
+#endif
+
+#include <time.h>
+
+/*---------------------------------------------------------------------------*/
+/* Constant declarations                                                     */
+/*---------------------------------------------------------------------------*/
+
+/* words of state of xoshiro256** */
+#define RANDOM_GEN_STATE_SIZE 4
+
+/*---------------------------------------------------------------------------*/
+/* Structure declarations                                                    */
+/*---------------------------------------------------------------------------*/
+
+typedef struct RandomGen_TAG
+{
+  unsigned long long state[RANDOM_GEN_STATE_SIZE];
+} RandomGen;
+
+/*---------------------------------------------------------------------------*/
+/* Type declarations                                                         */
+/*---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*/
+/* Variable declarations                                                     */
+/*---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*/
+/* Macro declarations                                                        */
+/*---------------------------------------------------------------------------*/
+
+#define RANDOM_GEN_MASK 0xffffffffffffffffULL
+
+#define RANDOM_GEN_ROTL(x, k) \
+  ((((x) << (k)) | ((x) >> (64 - (k)))) & RANDOM_GEN_MASK)
+
+
+/**AutomaticStart*************************************************************/
+
+/*---------------------------------------------------------------------------*/
+/* Static function prototypes                                                */
+/*---------------------------------------------------------------------------*/
+
+static unsigned long long random_gen_splitmix(unsigned long long* x);
+
+/*---------------------------------------------------------------------------*/
+/* Definition of exported functions                                          */
+/*---------------------------------------------------------------------------*/
+
+RandomGen_ptr RandomGen_create(const unsigned long long seed)
+{
+  RandomGen_ptr self = ALLOC(RandomGen, 1);
+  RANDOM_GEN_CHECK_INSTANCE(self);
+
+  RandomGen_set_seed(self, seed);
+
+  return self;
+}
+
+void RandomGen_destroy(RandomGen_ptr self)
+{
+  RANDOM_GEN_CHECK_INSTANCE(self);
+
+  FREE(self);
+}
+
+void RandomGen_set_seed(RandomGen_ptr self, const unsigned long long seed)
+{
+  unsigned long long x = seed;
+  int i;
+
+  RANDOM_GEN_CHECK_INSTANCE(self);
+
+  /* splitmix64 never produces an all zero state */
+  for (i = 0; i < RANDOM_GEN_STATE_SIZE; i++) {
+    self->state[i] = random_gen_splitmix(&x);
+  }
+}
+
+void RandomGen_jump(RandomGen_ptr self)
+{
+  static const unsigned long long jump[RANDOM_GEN_STATE_SIZE] = {
+    0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL,
+    0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL
+  };
+  unsigned long long res[RANDOM_GEN_STATE_SIZE] = { 0, 0, 0, 0 };
+  int i, b, j;
+
+  RANDOM_GEN_CHECK_INSTANCE(self);
+
+  for (i = 0; i < RANDOM_GEN_STATE_SIZE; i++) {
+    for (b = 0; b < 64; b++) {
+      if (jump[i] & (1ULL << b)) {
+        for (j = 0; j < RANDOM_GEN_STATE_SIZE; j++) {
+          res[j] ^= self->state[j];
+        }
+      }
+      (void)RandomGen_next(self);
+    }
+  }
+
+  for (j = 0; j < RANDOM_GEN_STATE_SIZE; j++) {
+    self->state[j] = res[j];
+  }
+}
+
+unsigned long long RandomGen_next(RandomGen_ptr self)
+{
+  unsigned long long* s;
+  unsigned long long res, t;
+
+  RANDOM_GEN_CHECK_INSTANCE(self);
+
+  s = self->state;
+  res = (RANDOM_GEN_ROTL((s[1] * 5) & RANDOM_GEN_MASK, 7) * 9) &
+    RANDOM_GEN_MASK;
+  t = (s[1] << 17) & RANDOM_GEN_MASK;
+
+  s[2] ^= s[0];
+  s[3] ^= s[1];
+  s[1] ^= s[2];
+  s[0] ^= s[3];
+
+  s[2] ^= t;
+  s[3] = RANDOM_GEN_ROTL(s[3], 45);
+
+  return res;
+}
+
+boolean RandomGen_next_bit(RandomGen_ptr self)
+{
+  /* the highest bits are the best ones */
+  return 0 != (RandomGen_next(self) >> 63);
+}
+
+unsigned long RandomGen_next_below(RandomGen_ptr self,
+                                   const unsigned long bound)
+{
+  unsigned long long limit;
+  unsigned long long r;
+
+  nusmv_assert(0 < bound);
+
+  /* values beyond the largest multiple of bound are discarded, so
+     that all the results are equally likely */
+  limit = RANDOM_GEN_MASK - (RANDOM_GEN_MASK % bound + 1) % bound;
+
+  do {
+    r = RandomGen_next(self);
+  } while (r > limit);
+
+  return (unsigned long)(r % bound);
+}
+
+double RandomGen_next_double(RandomGen_ptr self)
+{
+  /* the 53 highest bits fill the mantissa */
+  return (double)(RandomGen_next(self) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+unsigned long long RandomGen_get_default_seed(void)
+{
+  unsigned long long seed = (unsigned long long)time(NULL);
+
+#if NUSMV_HAVE_GETPID
+  seed ^= ((unsigned long long)getpid()) << 32;
+#endif
+
+  return seed;
+}
+
+void RandomGen_write(const RandomGen_ptr self, FILE* out)
+{
+  int i;
+
+  RANDOM_GEN_CHECK_INSTANCE(self);
+
+  for (i = 0; i < RANDOM_GEN_STATE_SIZE; i++) {
+    fprintf(out, "%s%llx", (0 < i) ? " " : "", self->state[i]);
+  }
+  fprintf(out, "\n");
+}
+
+boolean RandomGen_read(RandomGen_ptr self, FILE* in)
+{
+  unsigned long long state[RANDOM_GEN_STATE_SIZE];
+  unsigned long long any = 0;
+  int i;
+
+  RANDOM_GEN_CHECK_INSTANCE(self);
+
+  for (i = 0; i < RANDOM_GEN_STATE_SIZE; i++) {
+    if (1 != fscanf(in, "%llx", &(state[i]))) return false;
+    any |= state[i];
+  }
+
+  /* the all zero state is a fixpoint of the generator */
+  if (0 == any) return false;
+
+  for (i = 0; i < RANDOM_GEN_STATE_SIZE; i++) self->state[i] = state[i];
+
+  return true;
+}
+
+/*---------------------------------------------------------------------------*/
+/* Definition of internal functions                                          */
+/*---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*/
+/* Definition of static functions                                            */
+/*---------------------------------------------------------------------------*/
+
+/*!
+  \brief One step of splitmix64
+
+  Advances x and returns the next output.
+*/
+static unsigned long long random_gen_splitmix(unsigned long long* x)
+{
+  unsigned long long z;
+
+  *x = (*x + 0x9e3779b97f4a7c15ULL) & RANDOM_GEN_MASK;
+
+  z = *x;
+  z = ((z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL) & RANDOM_GEN_MASK;
+  z = ((z ^ (z >> 27)) * 0x94d049bb133111ebULL) & RANDOM_GEN_MASK;
+
+  return z ^ (z >> 31);
+}
+
+/**AutomaticEnd***************************************************************/
@@ -0,0 +1,175 @@
+/* ---------------------------------------------------------------------------
+
+
+  This file is part of the ``utils'' package of NuSMV version 2.
+  Copyright (C) 2012 by FBK-irst.
+
+  NuSMV version 2 is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  NuSMV version 2 is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA.
+
+  For more information on NuSMV see <http://nusmv.fbk.eu>
+  or email to <nusmv-users@fbk.eu>.
+  Please report bugs to <nusmv-users@fbk.eu>.
+
+  To contact the NuSMV development board, email to <nusmv@fbk.eu>.
+
+-----------------------------------------------------------------------------*/
+
+/*!
+  \author Alberto Bombardelli
+  \brief Public interface of class 'RandomGen'
+
+  A RandomGen is a seeded pseudo random number generator
+  (xoshiro256**) whose state is explicit, so that a sequence of
+  random choices can be reproduced from its seed.
+
+  Independent streams are obtained with RandomGen_jump, which
+  advances the generator by 2^128 steps: after the same seed, the
+  generator jumped i times produces a sequence that does not overlap
+  with the ones of the generators jumped a different number of times.
+
+*/
+
+
+#ifndef __NUSMV_CORE_UTILS_RANDOM_GEN_H__
+#define __NUSMV_CORE_UTILS_RANDOM_GEN_H__
+
+#include "nusmv/core/utils/utils.h"
+
+/*!
+  \struct RandomGen
+  \brief Definition of the public accessor for class RandomGen
+
+*/
+typedef struct RandomGen_TAG* RandomGen_ptr;
+
+/*!
+  \brief To cast and check instances of class RandomGen
+
+  These macros must be used respectively to cast and to check
+  instances of class RandomGen
+*/
+#define RANDOM_GEN(self) \
+         ((RandomGen_ptr) self)
+
+/*!
+  \brief \todo Missing synopsis
+
+  \todo Missing description
+*/
+#define RANDOM_GEN_CHECK_INSTANCE(self) \
+         (nusmv_assert(RANDOM_GEN(self) != RANDOM_GEN(NULL)))
+
+
+/**AutomaticStart*************************************************************/
+
+/*---------------------------------------------------------------------------*/
+/* Function prototypes                                                       */
+/*---------------------------------------------------------------------------*/
+
+/* Constructors ***************************************************************/
+
+/*!
+  \methodof RandomGen
+  \brief The RandomGen class constructor
+
+  \sa RandomGen_destroy, RandomGen_set_seed
+*/
+RandomGen_ptr RandomGen_create(const unsigned long long seed);
+
+/* Destructors ****************************************************************/
+
+/*!
+  \methodof RandomGen
+  \brief The RandomGen class destructor
+
+  \sa RandomGen_create
+*/
+void RandomGen_destroy(RandomGen_ptr self);
+
+/*!
+  \methodof RandomGen
+  \brief Restarts the generator from the given seed
+
+  Any seed, 0 included, is valid.
+*/
+void RandomGen_set_seed(RandomGen_ptr self, const unsigned long long seed);
+
+/*!
+  \methodof RandomGen
+  \brief Advances the generator by 2^128 steps
+
+  Used to split the sequence in non overlapping streams.
+*/
+void RandomGen_jump(RandomGen_ptr self);
+
+/*!
+  \methodof RandomGen
+  \brief Returns the next 64 random bits
+
+*/
+unsigned long long RandomGen_next(RandomGen_ptr self);
+
+/*!
+  \methodof RandomGen
+  \brief Returns a random boolean
+
+*/
+boolean RandomGen_next_bit(RandomGen_ptr self);
+
+/*!
+  \methodof RandomGen
+  \brief Returns a number uniformly distributed in [0, bound)
+
+  bound must be positive.
+*/
+unsigned long RandomGen_next_below(RandomGen_ptr self,
+                                   const unsigned long bound);
+
+/*!
+  \methodof RandomGen
+  \brief Returns a number uniformly distributed in [0, 1)
+
+*/
+double RandomGen_next_double(RandomGen_ptr self);
+
+/*!
+  \brief Returns a seed that differs between runs and processes
+
+  The seed is built from the current time and the process id.
+*/
+unsigned long long RandomGen_get_default_seed(void);
+
+/*!
+  \methodof RandomGen
+  \brief Writes the state of the generator to out
+
+  The state is written as a single line of text.
+
+  \sa RandomGen_read
+*/
+void RandomGen_write(const RandomGen_ptr self, FILE* out);
+
+/*!
+  \methodof RandomGen
+  \brief Restores a state written by RandomGen_write
+
+  Returns false, leaving the generator unchanged, if no valid state
+  can be read from in.
+*/
+boolean RandomGen_read(RandomGen_ptr self, FILE* in);
+
+/**AutomaticEnd***************************************************************/
+
+#endif /* __NUSMV_CORE_UTILS_RANDOM_GEN_H__ */
@@ -162,6 +162,11 @@ bmc_cmd_gen_solve_invar_zigzag_selected_or_all_props(NuSMVEnv_ptr const env,
                                                      Prop_ptr const invarprop,
                                                      const int max_k);
 
+static inline int
+bmc_cmd_gen_solve_invar_ic3_selected_or_all_props(NuSMVEnv_ptr const env,
+                                                  Prop_ptr const invarprop,
+                                                  const int max_k);
+
 static inline int
 bmc_cmd_gen_solve_psl_selected_or_all_props(NuSMVEnv_ptr const env,
                                             const int prop_no,
@@ -1610,15 +1615,18 @@ int Bmc_CommandCheckInvarBmcInc(NuSMVEnv_ptr env, int argc, char** argv)
 
   if ((strcasecmp(algorithm_name, BMC_INC_INVAR_ALG_DUAL) != 0) &&
       (strcasecmp(algorithm_name, BMC_INC_INVAR_ALG_FALSIFICATION) != 0) &&
-      (strcasecmp(algorithm_name, BMC_INC_INVAR_ALG_ZIGZAG) != 0)) {
+      (strcasecmp(algorithm_name, BMC_INC_INVAR_ALG_ZIGZAG) != 0) &&
+      (strcasecmp(algorithm_name, BMC_INC_INVAR_ALG_IC3) != 0)) {
     StreamMgr_print_error(streams,
              "'%s' is an invalid algorithm name.\n"
              "Valid names are "
              "'" BMC_INC_INVAR_ALG_DUAL "'"
              ", "
              "'" BMC_INVAR_ALG_FALSIFICATION "'"
+             ", "
+             "'" BMC_INC_INVAR_ALG_ZIGZAG "'"
              " and "
-             "'" BMC_INC_INVAR_ALG_ZIGZAG "'.\n", algorithm_name);
+             "'" BMC_INC_INVAR_ALG_IC3 "'.\n", algorithm_name);
     FREE(algorithm_name);
     return 1;
   }
@@ -1660,6 +1668,9 @@ int Bmc_CommandCheckInvarBmcInc(NuSMVEnv_ptr env, int argc, char** argv)
   else if (!strcasecmp(algorithm_name, BMC_INC_INVAR_ALG_ZIGZAG)) {
     algorithm = ALG_ZIGZAG;
   }
+  else if (!strcasecmp(algorithm_name, BMC_INC_INVAR_ALG_IC3)) {
+    algorithm = ALG_IC3;
+  }
   else {
     ErrorMgr_internal_error(errmgr, "%s:%d:%s unexpected algorithm specified (%s)",
                    __FILE__, __LINE__, __func__, algorithm_name);
@@ -1700,6 +1711,11 @@ int Bmc_CommandCheckInvarBmcInc(NuSMVEnv_ptr env, int argc, char** argv)
                                                            max_k);
     break;
 
+  case ALG_IC3:
+    res =
+      bmc_cmd_gen_solve_invar_ic3_selected_or_all_props(env, invarprop, max_k);
+    break;
+
   default: error_unreachable_code();
   }
 
@@ -1754,6 +1770,7 @@ static int UsageBmcCheckInvarInc(const NuSMVEnv_ptr env)
   StreamMgr_print_error(streams,  "\n\t\tValid values are: "
           BMC_INC_INVAR_ALG_DUAL ", "
           BMC_INC_INVAR_ALG_ZIGZAG ", "
+          BMC_INC_INVAR_ALG_IC3 ", "
           BMC_INC_INVAR_ALG_FALSIFICATION
           "\n\t\tDefault value is taken from variable bmc_inc_invar_alg.\n");
 
@@ -3436,6 +3453,45 @@ bmc_cmd_gen_solve_invar_zigzag_selected_or_all_props(NuSMVEnv_ptr const env,
   return res;
 }
 
+/*!
+  \brief Call Bmc_GenSolveInvarIc3 on a selected property or
+  over all the properties
+
+  Call Bmc_GenSolveInvarIc3 on a selected property or
+  over all the properties
+*/
+static inline int
+bmc_cmd_gen_solve_invar_ic3_selected_or_all_props(NuSMVEnv_ptr const env,
+                                                  Prop_ptr const invarprop,
+                                                  const int max_k)
+{
+  int res = 0;
+
+  if (invarprop == PROP(NULL)) {
+    PropDb_ptr prop_db = PROP_DB(NuSMVEnv_get_value(env, ENV_PROP_DB));
+    lsList props;
+    lsGen  iterator;
+    Prop_ptr prop;
+
+    props = PropDb_prepare_prop_list(prop_db, Prop_Invar);
+
+    lsForEachItem(props, iterator, prop) {
+      res = Bmc_GenSolveInvarIc3(env, prop, max_k);
+
+      if (res != 0) {
+        break;
+      }
+    }
+
+    lsDestroy(props, NULL);
+  }
+  else {
+    res = Bmc_GenSolveInvarIc3(env, invarprop, max_k);
+  }
+
+  return res;
+}
+
 /*!
   \brief Call the sbmc check function over the selected psl
   property or over all the psl properties
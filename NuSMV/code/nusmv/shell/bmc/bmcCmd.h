@@ -802,7 +802,8 @@ Bmc_CommandCheckLtlSpecBmcInc(NuSMVEnv_ptr env, int argc, char** argv);
     <dt> <tt>-a <i>algorithm</i></tt>
        <dd> Use to specify incremental invariant checking algorithm. Currently
             this can be one of the following values: dual, zigzag,
-            falsification.
+            ic3, falsification. With ic3 the maximal depth bounds the
+            number of frames.
     <dt> <tt>-s <i>strategy</i></tt>
        <dd> Use to specify closure strategy (this currenly applies to dual
        algorithm only). This can be one of the following values: backward,
@@ -78,7 +78,8 @@ void Ltl_Init(NuSMVEnv_ptr env)
 /*!
   \command{check_ltlspec} Performs LTL model checking
 
-  \command_args{[-h] [-m | -o output-file] [-n number | -p "ltl-expr [IN context]" | -P \"name\"] }
+  \command_args{[-h] [-m | -o output-file] [-j workers]
+  [-n number | -p "ltl-expr [IN context]" | -P \"name\"] }
 
    Performs model checking of LTL formulas. LTL
   model checking is reduced to CTL model checking as described in the
@@ -110,6 +111,11 @@ void Ltl_Init(NuSMVEnv_ptr env)
     <dt> <tt>-P name</tt>
        <dd> Checks the LTL property named <tt>name</tt> in the property
             database.
+    <dt> <tt>-j workers</tt>
+       <dd> When all the LTLSPEC formulas are checked, verifies them with
+            <tt>workers</tt> forked processes, each one with its own
+            DD manager. Formulas with a larger cone of influence are
+            handed out first, and results are printed as they arrive.
   </dl>
 
 */
@@ -126,6 +132,7 @@ int CommandCheckLtlSpec(NuSMVEnv_ptr env, int argc, char** argv)
   char* formula_name = NIL(char);
   int status = 0;
   int useMore = 0;
+  int workers = 1;
   char* dbgFileName = NIL(char);
   FILE* outstream = StreamMgr_get_output_stream(streams);
   FILE* old_outstream = outstream;
@@ -134,7 +141,7 @@ int CommandCheckLtlSpec(NuSMVEnv_ptr env, int argc, char** argv)
   OptsHandler_ptr opts = OPTS_HANDLER(NuSMVEnv_get_value(env, ENV_OPTS_HANDLER));
 
   util_getopt_reset();
-  while ((c = util_getopt(argc,argv,"hmo:n:p:P:")) != EOF) {
+  while ((c = util_getopt(argc,argv,"hmo:n:p:P:j:")) != EOF) {
 
     switch (c) {
     case 'h': return UsageCheckLtlSpec(env);
@@ -185,6 +192,14 @@ int CommandCheckLtlSpec(NuSMVEnv_ptr env, int argc, char** argv)
       useMore = 1;
       break;
 
+    case 'j':
+      workers = atoi(util_optarg);
+      if (0 >= workers) {
+        StreamMgr_print_error(streams, "The number of workers must be > 0\n");
+        return 1;
+      }
+      break;
+
     default:  return UsageCheckLtlSpec(env);
     }
   }
@@ -247,7 +262,7 @@ int CommandCheckLtlSpec(NuSMVEnv_ptr env, int argc, char** argv)
   }
   else {
     CATCH(errmgr) {
-      PropDb_verify_all_type_wrapper(prop_db, Prop_Ltl);
+      PropDb_verify_all_type_parallel(prop_db, Prop_Ltl, workers);
     }
     FAIL(errmgr) {
       status = 1;
@@ -285,7 +300,7 @@ check_ltlspec_exit:
 static int UsageCheckLtlSpec(const NuSMVEnv_ptr env)
 {
   StreamMgr_ptr streams = STREAM_MGR(NuSMVEnv_get_value(env, ENV_STREAM_MANAGER));
-  StreamMgr_print_error(streams,  "usage: check_ltlspec [-h] [-m | -o file] [-n number | -p \"ltl_expr\" | -P \"name\"]\n");
+  StreamMgr_print_error(streams,  "usage: check_ltlspec [-h] [-m | -o file] [-j workers] [-n number | -p \"ltl_expr\" | -P \"name\"]\n");
   StreamMgr_print_error(streams,  "   -h \t\t\tPrints the command usage.\n");
   StreamMgr_print_error(streams,  "   -m \t\t\tPipes output through the program specified by\n");
   StreamMgr_print_error(streams,  "      \t\t\tthe \"PAGER\" environment variable if any,\n");
@@ -294,5 +309,7 @@ static int UsageCheckLtlSpec(const NuSMVEnv_ptr env)
   StreamMgr_print_error(streams,  "   -n number\t\tChecks only the LTLSPEC with the given index number.\n");
   StreamMgr_print_error(streams,  "   -p \"ltl-expr\"\tChecks only the given LTL formula.\n");
   StreamMgr_print_error(streams,  "   -P \"name\"\t\tChecks only the LTLSPEC with the given name.\n");
+  StreamMgr_print_error(streams,  "   -j workers\t\tChecks all the LTLSPECs with the given number of\n");
+  StreamMgr_print_error(streams,  "      \t\t\tforked workers.\n");
   return(1);
 }
@@ -131,7 +131,8 @@ void Mc_End(NuSMVEnv_ptr env)
 /*!
   \command{check_ctlspec} Performs fair CTL model checking.
 
-  \command_args{[-h] [-m | -o output-file] [-n number | -p "ctl-expr [IN context]" | -P "name"]}
+  \command_args{[-h] [-m | -o output-file] [-j workers]
+  [-n number | -p "ctl-expr [IN context]" | -P "name"]}
 
   Performs fair CTL model checking.<p>
 
@@ -161,6 +162,11 @@ void Mc_End(NuSMVEnv_ptr env)
     <dt> <tt>-P name</tt>
        <dd> Checks the CTL property with name <tt>name</tt> in the property
             database.
+    <dt> <tt>-j workers</tt>
+       <dd> When all the SPEC formulas are checked, verifies them with
+            <tt>workers</tt> forked processes, each one with its own
+            DD manager. Formulas with a larger cone of influence are
+            handed out first, and results are printed as they arrive.
   </dl><p>
 
   If the <tt>ag_only_search</tt> environment variable has been set, and
@@ -183,6 +189,7 @@ int CommandCheckCtlSpec(NuSMVEnv_ptr env, int argc, char** argv)
   char* formula_name = NIL(char);
   int status = 0;
   int useMore = 0;
+  int workers = 1;
   char* dbgFileName = NIL(char);
   PropDb_ptr prop_db = PROP_DB(NuSMVEnv_get_value(env, ENV_PROP_DB));
   OptsHandler_ptr opts = OPTS_HANDLER(NuSMVEnv_get_value(env, ENV_OPTS_HANDLER));
@@ -190,9 +197,16 @@ int CommandCheckCtlSpec(NuSMVEnv_ptr env, int argc, char** argv)
     ERROR_MGR(NuSMVEnv_get_value(env, ENV_ERROR_MANAGER));
 
   util_getopt_reset();
-  while ((c = util_getopt(argc,argv,"hmo:n:p:P:")) != EOF) {
+  while ((c = util_getopt(argc,argv,"hmo:n:p:P:j:")) != EOF) {
     switch (c) {
     case 'h': return UsageCheckCtlSpec(env);
+    case 'j':
+      workers = atoi(util_optarg);
+      if (0 >= workers) {
+        StreamMgr_print_error(streams, "The number of workers must be > 0\n");
+        return 1;
+      }
+      break;
     case 'n':
       {
         if (formula != NIL(char)) return UsageCheckCtlSpec(env);
@@ -286,7 +300,10 @@ int CommandCheckCtlSpec(NuSMVEnv_ptr env, int argc, char** argv)
   }
   else {
     CATCH(errmgr) {
-      if (opt_use_coi_size_sorting(opts)) {
+      if (1 < workers) {
+        PropDb_verify_all_type_parallel(prop_db, Prop_Ctl, workers);
+      }
+      else if (opt_use_coi_size_sorting(opts)) {
         FlatHierarchy_ptr hierarchy =
           FLAT_HIERARCHY(NuSMVEnv_get_value(env, ENV_FLAT_HIERARCHY));
         PropDb_ordered_verify_all_type(prop_db, hierarchy, Prop_Ctl);
@@ -329,7 +346,7 @@ check_ctlspec_exit:
 static int UsageCheckCtlSpec(const NuSMVEnv_ptr env)
 {
   StreamMgr_ptr streams = STREAM_MGR(NuSMVEnv_get_value(env, ENV_STREAM_MANAGER));
-  StreamMgr_print_error(streams,  "usage: check_ctlspec [-h] [-m | -o file] [-n number | -p \"ctl-expr\" | -P \"name\"]\n");
+  StreamMgr_print_error(streams,  "usage: check_ctlspec [-h] [-m | -o file] [-j workers] [-n number | -p \"ctl-expr\" | -P \"name\"]\n");
   StreamMgr_print_error(streams,  "   -h \t\t\tPrints the command usage.\n");
   StreamMgr_print_error(streams,  "   -m \t\t\tPipes output through the program specified\n");
   StreamMgr_print_error(streams,  "      \t\t\tby the \"PAGER\" environment variable if defined,\n");
@@ -338,6 +355,8 @@ static int UsageCheckCtlSpec(const NuSMVEnv_ptr env)
   StreamMgr_print_error(streams,  "   -n number\t\tChecks only the SPEC with the given index number.\n");
   StreamMgr_print_error(streams,  "   -p \"ctl-expr\"\tChecks only the given CTL formula.\n");
   StreamMgr_print_error(streams,  "   -P \"name\"\t\tChecks only the SPEC with the given name\n");
+  StreamMgr_print_error(streams,  "   -j workers\t\tChecks all the SPECs with the given number of\n");
+  StreamMgr_print_error(streams,  "      \t\t\tforked workers.\n");
   return 1;
 }
 
@@ -345,7 +364,7 @@ static int UsageCheckCtlSpec(const NuSMVEnv_ptr env)
   \command{check_invar} Performs model checking of invariants
 
   \command_args{[-h] [-m | -o output-file] [-s "strategy"]
-  [-e "heuristic"] [-t number] [-k number] [-j "heuristic"]
+  [-e "heuristic"] [-t number] [-k number] [-j "heuristic"] [-J workers]
   [-n number | -p "invar-expr [IN context]" | -P "name"]}
 
   Performs invariant checking on the given
@@ -397,6 +416,11 @@ static int UsageCheckCtlSpec(const NuSMVEnv_ptr env)
     <dt> <tt>-P name</tt>
        <dd> Checks the INVARSPEC with name <tt>name</tt> in the property
             database.
+    <dt> <tt>-J workers</tt>
+       <dd> When all the INVARSPEC formulas are checked, verifies them
+            with <tt>workers</tt> forked processes, each one with its own
+            DD manager. Invariants with a larger cone of influence are
+            handed out first, and results are printed as they arrive.
   </dl>
 */
 
@@ -434,9 +458,16 @@ int CommandCheckInvar(NuSMVEnv_ptr env, int argc, char** argv)
   used_t = false;
 
   util_getopt_reset();
-  while ((c = util_getopt(argc,argv,"hbt:k:j:e:s:mo:n:p:P:")) != EOF) {
+  while ((c = util_getopt(argc,argv,"hbt:k:j:J:e:s:mo:n:p:P:")) != EOF) {
     switch (c) {
     case 'h': return(UsageCheckInvar(env));
+    case 'J':
+      options.workers = atoi(util_optarg);
+      if (0 >= options.workers) {
+        StreamMgr_print_error(streams, "The number of workers must be > 0\n");
+        return 1;
+      }
+      break;
     case 'n':
       {
         if (formula != NIL(char)) return(UsageCheckInvar(env));
@@ -686,9 +717,9 @@ static int UsageCheckInvar(const NuSMVEnv_ptr env)
 {
   StreamMgr_ptr streams = STREAM_MGR(NuSMVEnv_get_value(env, ENV_STREAM_MANAGER));
 #if NUSMV_HAVE_SAT_SOLVER
-  StreamMgr_print_error(streams,  "usage: check_invar [-h] [-m| -o file] [-s strategy] [-e heuristic] [-t number] [-k number] [-j heuristic] [-n number | -p \"invar-expr\" | -P \"name\"]\n");
+  StreamMgr_print_error(streams,  "usage: check_invar [-h] [-m| -o file] [-s strategy] [-e heuristic] [-t number] [-k number] [-j heuristic] [-J workers] [-n number | -p \"invar-expr\" | -P \"name\"]\n");
 #else
-  StreamMgr_print_error(streams,  "usage: check_invar [-h] [-m| -o file] [-s strategy] [-e heuristic] [-n number | -p \"invar-expr\" | -P \"name\"]\n");
+  StreamMgr_print_error(streams,  "usage: check_invar [-h] [-m| -o file] [-s strategy] [-e heuristic] [-J workers] [-n number | -p \"invar-expr\" | -P \"name\"]\n");
 #endif
   StreamMgr_print_error(streams,  "   -h \t\t\tPrints the command usage.\n");
 #if NUSMV_HAVE_SAT_SOLVER
@@ -709,6 +740,8 @@ static int UsageCheckInvar(const NuSMVEnv_ptr env)
   StreamMgr_print_error(streams,  "   -n number\t\tchecks only the INVARSPEC with the given index number.\n");
   StreamMgr_print_error(streams,  "   -p \"invar-expr\"\tchecks only the given invariant formula.\n");
   StreamMgr_print_error(streams,  "   -P \"name\"\t\tchecks only the INVARSPEC with the given name.\n");
+  StreamMgr_print_error(streams,  "   -J workers\t\tchecks all the INVARSPECs with the given number of\n");
+  StreamMgr_print_error(streams,  "      \t\t\tforked workers.\n");
   return 1;
 }
 
@@ -34,6 +34,10 @@
 
 */
 
+#if HAVE_CONFIG_H
+# include "nusmv-config.h"
+#endif
+
 #include "nusmv/shell/cmd/cmd.h"
 #include "nusmv/shell/stat/statCmd.h"
 
@@ -50,6 +54,15 @@
 #include "nusmv/core/compile/compile.h"
 
 #include "nusmv/core/stat/stat.h"
+#include "nusmv/core/stat/StatProblemsGenerator.h"
+#include "nusmv/core/stat/StatProblemsGeneratorBmc.h"
+#include "nusmv/core/utils/RandomGen.h"
+
+#if NUSMV_HAVE_COMPASS
+#include "nusmv/addons_core/compass/compass.h"
+#endif
+
+#include <ctype.h>
 /* Prototypes of command functions */
 int Stat_CommandCheckLtlspec(NuSMVEnv_ptr env, int argc, char** argv);
 int Stat_CommandCheckLtlspecBmc(NuSMVEnv_ptr env, int argc, char** argv);
@@ -64,17 +77,70 @@ extern cmp_struct_ptr cmps;
 /*---------------------------------------------------------------------------*/
 #define STAT_CMD_DEFAULT_EPSILON 0.9
 #define STAT_CMD_DEFAULT_DELTA 0.9
+#define STAT_CMD_DEFAULT_WORKERS 1
+#define STAT_CMD_DEFAULT_WIDTH 0.01
+#define STAT_CMD_DEFAULT_ALPHA 0.05
+#define STAT_CMD_DEFAULT_BETA 0.05
+#define STAT_CMD_DEFAULT_EFFORT 100
+#define STAT_CMD_DEFAULT_ESTIMATOR STAT_ESTIMATOR_DKLR
 /*---------------------------------------------------------------------------*/
 /* Static function prototypes                                                */
 /*---------------------------------------------------------------------------*/
 static int UsageStatCheckLtlspec(const NuSMVEnv_ptr env);
 
+static int UsageStatCheckLtlspecBmc(const NuSMVEnv_ptr env);
+
+static inline void print_common_usage(const StreamMgr_ptr streams);
+
 static inline void print_result(const StreamMgr_ptr streams,
                                 const OptsHandler_ptr opts,
                                 const Prop_ptr prop,
                                 const double delta,
                                 const double epsilon,
                                 const double result);
+
+static inline void print_rare_result(const StreamMgr_ptr streams,
+                                     const OptsHandler_ptr opts,
+                                     const Prop_ptr prop,
+                                     const double delta,
+                                     const double epsilon,
+                                     const double result,
+                                     const double half_width);
+
+static inline void print_test_result(const StreamMgr_ptr streams,
+                                     const OptsHandler_ptr opts,
+                                     const Prop_ptr prop,
+                                     const double theta,
+                                     const double alpha,
+                                     const double beta,
+                                     const boolean result);
+
+static int check_ltlspec_stat_prop(const NuSMVEnv_ptr env,
+                                   const Prop_ptr prop,
+                                   const StatEstimator estimator,
+                                   const double epsilon,
+                                   const double delta,
+                                   const int workers,
+                                   const double theta,
+                                   const double width,
+                                   const double alpha,
+                                   const double beta,
+                                   const StatRareMethod rare,
+                                   node_ptr levels,
+                                   const int effort);
+
+static int check_ltlspecs_stat(const NuSMVEnv_ptr env,
+                               const StatEstimator estimator,
+                               const double epsilon,
+                               const double delta,
+                               const double theta,
+                               const double width,
+                               const double alpha,
+                               const double beta);
+
+static boolean parse_seed(const char* str, unsigned long long* seed);
+
+static int print_profile(const NuSMVEnv_ptr env, const char* fname);
 /*---------------------------------------------------------------------------*/
 /* Definition of exported functions                                          */
 /*---------------------------------------------------------------------------*/
@@ -105,6 +171,12 @@ int Stat_CommandCheckLtlspecBmc(NuSMVEnv_ptr env, int argc, char** argv)
   int prop_no = -1;
   double delta;
   double epsilon;
+  int workers = STAT_CMD_DEFAULT_WORKERS;
+  boolean incremental = false;
+  boolean memoize = true;
+  boolean bit_simulation = false;
+  unsigned long long seed = RandomGen_get_default_seed();
+  char* profile_fname = NIL(char);
   char* formula = NIL(char);
   char* formula_name = NIL(char);
   int status = 0;
@@ -119,17 +191,17 @@ int Stat_CommandCheckLtlspecBmc(NuSMVEnv_ptr env, int argc, char** argv)
   delta = STAT_CMD_DEFAULT_DELTA;
 
   util_getopt_reset();
-  while ((c = util_getopt(argc,argv,"hmo:n:p:P:d:e:k:")) != EOF) {
+  while ((c = util_getopt(argc,argv,"hmo:n:p:P:d:e:k:j:iMbs:T:")) != EOF) {
 
     switch (c) {
-    case 'h': return UsageStatCheckLtlspec(env);
+    case 'h': return UsageStatCheckLtlspecBmc(env);
 
     case 'd':
       delta = atof(util_optarg);
 
       if (0 >= delta || 1 <= delta) {
         StreamMgr_print_error(streams, "Delta value must be > 0 and < 1");
-        return 1;
+        status = 1; goto stat_check_ltlspec_bmc_free;
       }
       break;
     case 'k':
@@ -149,24 +221,49 @@ int Stat_CommandCheckLtlspecBmc(NuSMVEnv_ptr env, int argc, char** argv)
       epsilon = atof(util_optarg);
       if (0 >= epsilon || 1 <= epsilon) {
         StreamMgr_print_error(streams, "Epsilon value must be > 0 and < 1");
-        return 1;
+        status = 1; goto stat_check_ltlspec_bmc_free;
+      }
+      break;
+    case 'j':
+      workers = atoi(util_optarg);
+      if (0 >= workers) {
+        StreamMgr_print_error(streams, "The number of workers must be > 0");
+        status = 1; goto stat_check_ltlspec_bmc_free;
+      }
+      break;
+    case 'i':
+      incremental = true;
+      break;
+    case 'M':
+      memoize = false;
+      break;
+    case 'b':
+      bit_simulation = true;
+      break;
+    case 's':
+      if (! parse_seed(util_optarg, &seed)) {
+        StreamMgr_print_error(streams, "The seed must be a non negative integer");
+        status = 1; goto stat_check_ltlspec_bmc_free;
       }
       break;
+    case 'T':
+      if (profile_fname != NIL(char)) FREE(profile_fname);
+      profile_fname = util_strsav(util_optarg);
+      break;
     case 'n':
-      if (formula != NIL(char)) return UsageStatCheckLtlspec(env);
-      if (prop_no != -1) return UsageStatCheckLtlspec(env);
-      if (formula_name != NIL(char)) return UsageStatCheckLtlspec(env);
+      if (formula != NIL(char)) return UsageStatCheckLtlspecBmc(env);
+      if (prop_no != -1) return UsageStatCheckLtlspecBmc(env);
+      if (formula_name != NIL(char)) return UsageStatCheckLtlspecBmc(env);
 
       prop_no = PropDb_get_prop_index_from_string(prop_db, util_optarg);
-      if (-1 == prop_no)
-        return 1;
+      if (-1 == prop_no) { status = 1; goto stat_check_ltlspec_bmc_free; }
 
       break;
 
     case 'P':
-        if (formula != NIL(char)) return UsageStatCheckLtlspec(env);
-        if (prop_no != -1) return UsageStatCheckLtlspec(env);
-        if (formula_name != NIL(char)) return UsageStatCheckLtlspec(env);
+        if (formula != NIL(char)) return UsageStatCheckLtlspecBmc(env);
+        if (prop_no != -1) return UsageStatCheckLtlspecBmc(env);
+        if (formula_name != NIL(char)) return UsageStatCheckLtlspecBmc(env);
 
         formula_name = util_strsav(util_optarg);
         prop_no = PropDb_prop_parse_name(prop_db, formula_name);
@@ -174,45 +271,45 @@ int Stat_CommandCheckLtlspecBmc(NuSMVEnv_ptr env, int argc, char** argv)
         if (prop_no == -1) {
           StreamMgr_print_error(streams,  "No property named \"%s\"\n", formula_name);
           FREE(formula_name);
-          return 1;
+          status = 1; goto stat_check_ltlspec_bmc_free;
         }
         FREE(formula_name);
         break;
 
     case 'p':
-      if (prop_no != -1) return UsageStatCheckLtlspec(env);
-      if (formula != NIL(char)) return UsageStatCheckLtlspec(env);
-      if (formula_name != NIL(char)) return UsageStatCheckLtlspec(env);
+      if (prop_no != -1) return UsageStatCheckLtlspecBmc(env);
+      if (formula != NIL(char)) return UsageStatCheckLtlspecBmc(env);
+      if (formula_name != NIL(char)) return UsageStatCheckLtlspecBmc(env);
 
       formula = util_strsav(util_optarg);
       break;
 
     case 'o':
-      if (useMore == 1) return UsageStatCheckLtlspec(env);
+      if (useMore == 1) return UsageStatCheckLtlspecBmc(env);
       dbgFileName = util_strsav(util_optarg);
       StreamMgr_print_output(streams,  "Output to file: %s\n", dbgFileName);
       break;
 
     case 'm':
-      if (dbgFileName != NIL(char)) return UsageStatCheckLtlspec(env);
+      if (dbgFileName != NIL(char)) return UsageStatCheckLtlspecBmc(env);
       useMore = 1;
       break;
 
-    default:  return UsageStatCheckLtlspec(env);
+    default:  return UsageStatCheckLtlspecBmc(env);
     }
   }
-  if (argc != util_optind) return UsageStatCheckLtlspec(env);
+  if (argc != util_optind) return UsageStatCheckLtlspecBmc(env);
 
   if (cmp_struct_get_read_model(cmps) == 0) {
     StreamMgr_print_error(streams,
             "A model must be read before. Use the \"read_model\" command.\n");
-    return 1;
+    status = 1; goto stat_check_ltlspec_bmc_free;
   }
 
   if (cmp_struct_get_encode_variables(cmps) == 0) {
     StreamMgr_print_error(streams,
             "The variables must be built before. Use the \"encode_variables\" command.\n");
-    return 1;
+    status = 1; goto stat_check_ltlspec_bmc_free;
   }
 
   if ( (!cmp_struct_get_build_model(cmps))
@@ -221,7 +318,7 @@ int Stat_CommandCheckLtlspecBmc(NuSMVEnv_ptr env, int argc, char** argv)
             TransType_to_string(get_partition_method(opts)));
     StreamMgr_print_error(streams,  "Use \t \"build_model -f -m %s\"\nto build the transition relation.\n",
             TransType_to_string(get_partition_method(opts)));
-    return 1;
+    status = 1; goto stat_check_ltlspec_bmc_free;
   }
 
   if (useMore || (char*)NULL != dbgFileName) {
@@ -233,6 +330,25 @@ int Stat_CommandCheckLtlspecBmc(NuSMVEnv_ptr env, int argc, char** argv)
 
 
   Stat_Pkg_init(env);
+  Stat_set_seed(env, seed);
+
+  if (profile_fname != NIL(char)) {
+    Stat_enable_profiling(env);
+  }
+
+  if (incremental) {
+    StatProblemsGenerator_set_verification_method(
+        STAT_PROBLEMS_GENERATOR(NuSMVEnv_get_value(env, ENV_STAT_PROB_GEN_BMC)),
+        STAT_BMC_VERIFICATION_INCREMENTAL);
+  }
+
+  StatProblemsGenerator_set_memoization(
+      STAT_PROBLEMS_GENERATOR(NuSMVEnv_get_value(env, ENV_STAT_PROB_GEN_BMC)),
+      memoize);
+
+  StatProblemsGeneratorBmc_set_bit_simulation(
+      STAT_PROBLEMS_GENERATOR_BMC(NuSMVEnv_get_value(env, ENV_STAT_PROB_GEN_BMC)),
+      bit_simulation);
 
   if (formula != NIL(char)) {
     prop_no = PropDb_prop_parse_and_add(prop_db, st, formula, Prop_Ltl, Nil);
@@ -242,7 +358,8 @@ int Stat_CommandCheckLtlspecBmc(NuSMVEnv_ptr env, int argc, char** argv)
     CATCH(errmgr) {
       double result;
       Prop_ptr p = PropDb_get_prop_at_index(prop_db, prop_no);
-      status = Stat_check_ltlspec_bmc(env, p, epsilon, delta, &result);
+      status = Stat_check_ltlspec_bmc(env, p, STAT_ESTIMATOR_DKLR,
+                                      epsilon, delta, workers, &result);
 
       print_result(streams, opts, p, delta, epsilon, result);
     }
@@ -260,7 +377,8 @@ int Stat_CommandCheckLtlspecBmc(NuSMVEnv_ptr env, int argc, char** argv)
         double result;
         Prop_ptr p = PropDb_get_prop_at_index(prop_db, prop_no);
 
-        status = Stat_check_ltlspec_bmc(env, p, epsilon, delta, &result);
+        status = Stat_check_ltlspec_bmc(env, p, STAT_ESTIMATOR_DKLR,
+                                      epsilon, delta, workers, &result);
 
         print_result(streams, opts, p, delta, epsilon, result);
       }
@@ -279,7 +397,8 @@ int Stat_CommandCheckLtlspecBmc(NuSMVEnv_ptr env, int argc, char** argv)
 
         status = 0;
         if (Prop_get_type(p) == Prop_Ltl) {
-          status = Stat_check_ltlspec_bmc(env, p, delta, epsilon, &result);
+          status = Stat_check_ltlspec_bmc(env, p, STAT_ESTIMATOR_DKLR,
+                                          epsilon, delta, workers, &result);
 
           if (1 == status) { goto stat_check_ltlspec_bmc_exit; }
 
@@ -292,6 +411,10 @@ int Stat_CommandCheckLtlspecBmc(NuSMVEnv_ptr env, int argc, char** argv)
     }
   }
 
+  if (profile_fname != NIL(char)) {
+    if (0 != print_profile(env, profile_fname)) status = 1;
+  }
+
   Stat_Pkg_quit(env);
 
 stat_check_ltlspec_bmc_exit:
@@ -314,6 +437,10 @@ stat_check_ltlspec_bmc_exit:
     outstream = (FILE*)NULL;
   }
 
+  /* invalid options are rejected before the package is initialized */
+stat_check_ltlspec_bmc_free:
+  if (profile_fname != NIL(char)) FREE(profile_fname);
+
   return status;
 }
 
@@ -327,6 +454,24 @@ int Stat_CommandCheckLtlspec(NuSMVEnv_ptr env, int argc, char** argv)
   int prop_no = -1;
   double delta;
   double epsilon;
+  int workers = STAT_CMD_DEFAULT_WORKERS;
+  boolean lasso = false;
+  boolean memoize = true;
+  boolean monitoring = false;
+  unsigned long long seed = RandomGen_get_default_seed();
+  double theta = -1.0;
+  double width = STAT_CMD_DEFAULT_WIDTH;
+  double alpha = STAT_CMD_DEFAULT_ALPHA;
+  double beta = STAT_CMD_DEFAULT_BETA;
+  StatEstimator estimator = STAT_CMD_DEFAULT_ESTIMATOR;
+  StatRareMethod rare = STAT_RARE_INVALID;
+  int effort = STAT_CMD_DEFAULT_EFFORT;
+  char** level_strs = (char**)NULL;
+  int levels_num = 0;
+  node_ptr levels = Nil;
+  char* checkpoint_fname = NIL(char);
+  char* profile_fname = NIL(char);
+  char* prob_fname = NIL(char);
   char* formula = NIL(char);
   char* formula_name = NIL(char);
   int status = 0;
@@ -334,6 +479,8 @@ int Stat_CommandCheckLtlspec(NuSMVEnv_ptr env, int argc, char** argv)
   char* dbgFileName = NIL(char);
   FILE* outstream = StreamMgr_get_output_stream(streams);
   FILE* old_outstream = outstream;
+  const NodeMgr_ptr nodemgr =
+    NODE_MGR(NuSMVEnv_get_value(env, ENV_NODE_MGR));
   SymbTable_ptr st = SYMB_TABLE(NuSMVEnv_get_value(env, ENV_SYMB_TABLE));
   PropDb_ptr prop_db = PROP_DB(NuSMVEnv_get_value(env, ENV_PROP_DB));
   OptsHandler_ptr opts = OPTS_HANDLER(NuSMVEnv_get_value(env, ENV_OPTS_HANDLER));
@@ -342,7 +489,7 @@ int Stat_CommandCheckLtlspec(NuSMVEnv_ptr env, int argc, char** argv)
   delta = STAT_CMD_DEFAULT_DELTA;
 
   util_getopt_reset();
-  while ((c = util_getopt(argc,argv,"hmo:n:p:P:d:e:")) != EOF) {
+  while ((c = util_getopt(argc,argv,"hmo:n:p:P:d:e:D:E:j:lMOr:s:t:w:a:b:R:L:N:T:")) != EOF) {
 
     switch (c) {
     case 'h': return UsageStatCheckLtlspec(env);
@@ -352,14 +499,108 @@ int Stat_CommandCheckLtlspec(NuSMVEnv_ptr env, int argc, char** argv)
 
       if (0 >= delta || 1 <= delta) {
         StreamMgr_print_error(streams, "Delta value must be > 0 and < 1");
-        return 1;
+        status = 1; goto stat_check_ltlspec_free;
       }
       break;
     case 'e':
       epsilon = atof(util_optarg);
       if (0 >= epsilon || 1 <= epsilon) {
         StreamMgr_print_error(streams, "Epsilon value must be > 0 and < 1");
-        return 1;
+        status = 1; goto stat_check_ltlspec_free;
+      }
+      break;
+    case 'D':
+#if NUSMV_HAVE_COMPASS
+      if (prob_fname != NIL(char)) FREE(prob_fname);
+      prob_fname = util_strsav(util_optarg);
+#else
+      StreamMgr_print_error(streams, "Option -D requires the Compass addon\n");
+      status = 1; goto stat_check_ltlspec_free;
+#endif
+      break;
+    case 'E':
+      estimator = Stat_estimator_from_string(util_optarg);
+      if (STAT_ESTIMATOR_INVALID == estimator) {
+        StreamMgr_print_error(streams, "Unknown estimator \"%s\"\n",
+                              util_optarg);
+        status = 1; goto stat_check_ltlspec_free;
+      }
+      break;
+    case 'j':
+      workers = atoi(util_optarg);
+      if (0 >= workers) {
+        StreamMgr_print_error(streams, "The number of workers must be > 0");
+        status = 1; goto stat_check_ltlspec_free;
+      }
+      break;
+    case 'l':
+      lasso = true;
+      break;
+    case 'M':
+      memoize = false;
+      break;
+    case 'O':
+      monitoring = true;
+      break;
+    case 'r':
+      if (checkpoint_fname != NIL(char)) FREE(checkpoint_fname);
+      checkpoint_fname = util_strsav(util_optarg);
+      break;
+    case 'T':
+      if (profile_fname != NIL(char)) FREE(profile_fname);
+      profile_fname = util_strsav(util_optarg);
+      break;
+    case 's':
+      if (! parse_seed(util_optarg, &seed)) {
+        StreamMgr_print_error(streams, "The seed must be a non negative integer");
+        status = 1; goto stat_check_ltlspec_free;
+      }
+      break;
+    case 't':
+      theta = atof(util_optarg);
+      if (0 >= theta || 1 <= theta) {
+        StreamMgr_print_error(streams, "Theta value must be > 0 and < 1");
+        status = 1; goto stat_check_ltlspec_free;
+      }
+      break;
+    case 'w':
+      width = atof(util_optarg);
+      if (0 >= width || 1 <= width) {
+        StreamMgr_print_error(streams, "Width value must be > 0 and < 1");
+        status = 1; goto stat_check_ltlspec_free;
+      }
+      break;
+    case 'a':
+      alpha = atof(util_optarg);
+      if (0 >= alpha || 1 <= alpha) {
+        StreamMgr_print_error(streams, "Alpha value must be > 0 and < 1");
+        status = 1; goto stat_check_ltlspec_free;
+      }
+      break;
+    case 'b':
+      beta = atof(util_optarg);
+      if (0 >= beta || 1 <= beta) {
+        StreamMgr_print_error(streams, "Beta value must be > 0 and < 1");
+        status = 1; goto stat_check_ltlspec_free;
+      }
+      break;
+    case 'R':
+      rare = Stat_rare_method_from_string(util_optarg);
+      if (STAT_RARE_INVALID == rare) {
+        StreamMgr_print_error(streams, "Unknown rare event method \"%s\"\n",
+                              util_optarg);
+        status = 1; goto stat_check_ltlspec_free;
+      }
+      break;
+    case 'L':
+      level_strs = REALLOC(char*, level_strs, levels_num + 1);
+      level_strs[levels_num++] = util_strsav(util_optarg);
+      break;
+    case 'N':
+      effort = atoi(util_optarg);
+      if (0 >= effort) {
+        StreamMgr_print_error(streams, "The effort must be > 0");
+        status = 1; goto stat_check_ltlspec_free;
       }
       break;
     case 'n':
@@ -368,8 +609,7 @@ int Stat_CommandCheckLtlspec(NuSMVEnv_ptr env, int argc, char** argv)
       if (formula_name != NIL(char)) return UsageStatCheckLtlspec(env);
 
       prop_no = PropDb_get_prop_index_from_string(prop_db, util_optarg);
-      if (-1 == prop_no)
-        return 1;
+      if (-1 == prop_no) { status = 1; goto stat_check_ltlspec_free; }
 
       break;
 
@@ -384,7 +624,7 @@ int Stat_CommandCheckLtlspec(NuSMVEnv_ptr env, int argc, char** argv)
         if (prop_no == -1) {
           StreamMgr_print_error(streams,  "No property named \"%s\"\n", formula_name);
           FREE(formula_name);
-          return 1;
+          status = 1; goto stat_check_ltlspec_free;
         }
         FREE(formula_name);
         break;
@@ -413,16 +653,40 @@ int Stat_CommandCheckLtlspec(NuSMVEnv_ptr env, int argc, char** argv)
   }
   if (argc != util_optind) return UsageStatCheckLtlspec(env);
 
+  if (STAT_RARE_INVALID != rare && 0 < theta) {
+    StreamMgr_print_error(streams, "Options -R and -t cannot be used together\n");
+    status = 1; goto stat_check_ltlspec_free;
+  }
+
+  if (checkpoint_fname != NIL(char) &&
+      (1 != workers || STAT_RARE_INVALID != rare)) {
+    StreamMgr_print_error(streams, "Option -r cannot be used with -j or -R\n");
+    status = 1; goto stat_check_ltlspec_free;
+  }
+
+  if (0 < theta) {
+    if (0 > theta - width || 1 < theta + width) {
+      StreamMgr_print_error(streams, "The indifference region (theta - width, "
+                            "theta + width) must be within [0, 1]\n");
+      status = 1; goto stat_check_ltlspec_free;
+    }
+
+    if (1 <= alpha + beta) {
+      StreamMgr_print_error(streams, "Alpha + beta must be < 1\n");
+      status = 1; goto stat_check_ltlspec_free;
+    }
+  }
+
   if (cmp_struct_get_read_model(cmps) == 0) {
     StreamMgr_print_error(streams,
             "A model must be read before. Use the \"read_model\" command.\n");
-    return 1;
+    status = 1; goto stat_check_ltlspec_free;
   }
 
   if (cmp_struct_get_encode_variables(cmps) == 0) {
     StreamMgr_print_error(streams,
             "The variables must be built before. Use the \"encode_variables\" command.\n");
-    return 1;
+    status = 1; goto stat_check_ltlspec_free;
   }
 
   if ( (!cmp_struct_get_build_model(cmps))
@@ -431,7 +695,7 @@ int Stat_CommandCheckLtlspec(NuSMVEnv_ptr env, int argc, char** argv)
             TransType_to_string(get_partition_method(opts)));
     StreamMgr_print_error(streams,  "Use \t \"build_model -f -m %s\"\nto build the transition relation.\n",
             TransType_to_string(get_partition_method(opts)));
-    return 1;
+    status = 1; goto stat_check_ltlspec_free;
   }
 
   if (useMore || (char*)NULL != dbgFileName) {
@@ -442,6 +706,78 @@ int Stat_CommandCheckLtlspec(NuSMVEnv_ptr env, int argc, char** argv)
   }
 
   Stat_Pkg_init(env);
+  Stat_set_seed(env, seed);
+
+  if (lasso) {
+    StatProblemsGenerator_set_verification_method(
+        STAT_PROBLEMS_GENERATOR(NuSMVEnv_get_value(env, ENV_STAT_PROB_GEN)),
+        STAT_LASSO_VERIFICATION);
+  }
+
+  StatProblemsGenerator_set_memoization(
+      STAT_PROBLEMS_GENERATOR(NuSMVEnv_get_value(env, ENV_STAT_PROB_GEN)),
+      memoize);
+
+  StatProblemsGenerator_set_monitoring(
+      STAT_PROBLEMS_GENERATOR(NuSMVEnv_get_value(env, ENV_STAT_PROB_GEN)),
+      monitoring);
+
+  if (checkpoint_fname != NIL(char)) {
+    Stat_set_checkpoint(env, checkpoint_fname);
+  }
+
+  if (profile_fname != NIL(char)) {
+    Stat_enable_profiling(env);
+  }
+
+#if NUSMV_HAVE_COMPASS
+  if (prob_fname != NIL(char)) {
+    FILE* prob_file = fopen(prob_fname, "r");
+
+    if (prob_file == (FILE*)NULL) {
+      StreamMgr_print_error(streams,
+                            "Unable to open probability list file \"%s\".\n",
+                            prob_fname);
+      status = 1; goto stat_check_ltlspec_exit;
+    }
+
+    CATCH(errmgr) {
+      BddFsm_ptr fsm = BDD_FSM(NuSMVEnv_get_value(env, ENV_BDD_FSM));
+      add_ptr probs = Compass_read_prob_add(env, fsm, prob_file);
+
+      if ((add_ptr)NULL != probs) {
+        Stat_set_input_probabilities(env, probs);
+        add_free(BddEnc_get_dd_manager(BddFsm_get_bdd_encoding(fsm)), probs);
+      }
+      else {
+        StreamMgr_print_error(streams, "Warning: no probabilities in \"%s\", "
+                              "successors are chosen uniformly\n",
+                              prob_fname);
+      }
+    }
+    FAIL(errmgr) {
+      status = 1;
+    }
+
+    fclose(prob_file);
+    if (1 == status) goto stat_check_ltlspec_exit;
+  }
+#endif
+
+  if (STAT_RARE_INVALID != rare) {
+    int i;
+
+    for (i = 0; i < levels_num; i++) {
+      Expr_ptr level =
+        Compile_compile_simpwff_from_string(env, st, level_strs[i]);
+
+      if (EXPR(NULL) == level) { status = 1; goto stat_check_ltlspec_exit; }
+
+      levels = cons(nodemgr, NODE_PTR(level), levels);
+    }
+
+    levels = reverse(levels);
+  }
 
   if (formula != NIL(char)) {
     prop_no = PropDb_prop_parse_and_add(prop_db, st,
@@ -450,11 +786,10 @@ int Stat_CommandCheckLtlspec(NuSMVEnv_ptr env, int argc, char** argv)
     if (prop_no == -1) { status = 1; goto stat_check_ltlspec_exit; }
 
     CATCH(errmgr) {
-      double result;
       Prop_ptr p = PropDb_get_prop_at_index(prop_db, prop_no);
-      status = Stat_check_ltlspec(env, p, epsilon, delta, &result);
-
-      print_result(streams, opts, p, delta, epsilon, result);
+      status = check_ltlspec_stat_prop(env, p, estimator, epsilon, delta, workers,
+                                       theta, width, alpha, beta,
+                                       rare, levels, effort);
     }
     FAIL(errmgr) {
       status = 1;
@@ -467,33 +802,40 @@ int Stat_CommandCheckLtlspec(NuSMVEnv_ptr env, int argc, char** argv)
     }
     else {
       CATCH(errmgr) {
-        double result;
         Prop_ptr p = PropDb_get_prop_at_index(prop_db, prop_no);
 
-        status = Stat_check_ltlspec(env, p, epsilon, delta, &result);
-
-        print_result(streams, opts, p, delta, epsilon, result);
+        status = check_ltlspec_stat_prop(env, p, estimator, epsilon, delta, workers,
+                                         theta, width, alpha, beta,
+                                         rare, levels, effort);
       }
       FAIL(errmgr) {
         status = 1;
       }
     }
   }
+  else if (1 == workers && STAT_RARE_INVALID == rare) {
+    CATCH(errmgr) {
+      status = check_ltlspecs_stat(env, estimator, epsilon, delta,
+                                   theta, width, alpha, beta);
+    }
+    FAIL(errmgr) {
+      status = 1;
+    }
+  }
   else {
     CATCH(errmgr) {
       int i;
 
       for (i = 0; i < PropDb_get_size(prop_db); i++) {
-        double result;
         Prop_ptr p = PropDb_get_prop_at_index(prop_db, i);
 
         status = 0;
         if (Prop_get_type(p) == Prop_Ltl) {
-          status = Stat_check_ltlspec(env, p, delta, epsilon, &result);
+          status = check_ltlspec_stat_prop(env, p, estimator, epsilon, delta, workers,
+                                           theta, width, alpha, beta,
+                                           rare, levels, effort);
 
           if (1 == status) { goto stat_check_ltlspec_exit; }
-
-          print_result(streams, opts, p, delta, epsilon, result);
         }
       }
     }
@@ -522,15 +864,145 @@ stat_check_ltlspec_exit:
     outstream = (FILE*)NULL;
   }
 
+  if (profile_fname != NIL(char)) {
+    if (0 != print_profile(env, profile_fname)) status = 1;
+  }
+
+  free_list(nodemgr, levels);
+
   Stat_Pkg_quit(env);
 
+  /* invalid options are rejected before the package is initialized */
+stat_check_ltlspec_free:
+  if (prob_fname != NIL(char)) FREE(prob_fname);
+  if (checkpoint_fname != NIL(char)) FREE(checkpoint_fname);
+  if (profile_fname != NIL(char)) FREE(profile_fname);
+
+  if ((char**)NULL != level_strs) {
+    int i;
+
+    for (i = 0; i < levels_num; i++) FREE(level_strs[i]);
+    FREE(level_strs);
+  }
+
   return status;
 }
 
 
 static int UsageStatCheckLtlspec(const NuSMVEnv_ptr env)
 {
-  return 1;
+  StreamMgr_ptr streams = STREAM_MGR(NuSMVEnv_get_value(env, ENV_STREAM_MANAGER));
+  StreamMgr_print_error(streams,  "usage: check_ltlspec_stat [-h] [-m | -o file] [-n number | -p \"ltl_expr\" | -P \"name\"]\n"
+                        "                         [-e epsilon] [-d delta] [-E estimator] [-j workers] [-l] [-M] [-O]\n"
+                        "                         [-s seed] [-T profile-file] [-D prob-file] [-r checkpoint-file]\n"
+                        "                         [-t theta [-w width] [-a alpha] [-b beta]]\n"
+                        "                         [-R method [-L level]... [-N effort]]\n");
+  print_common_usage(streams);
+  StreamMgr_print_error(streams,  "   -D prob-file\tDraws the executions as in a Markov chain: at\n"
+                        "      \t\t\teach step the input is chosen according to the\n"
+                        "      \t\t\tprobabilities of its label in prob-file (in the\n"
+                        "      \t\t\tformat of compass_gen_sigref -i), and then the\n"
+                        "      \t\t\tsuccessor uniformly.\n");
+  StreamMgr_print_error(streams,  "   -E estimator\tAlgorithm used to approximate the probability:\n"
+                        "      \t\t\t\"dklr\" (relative error, default), \"okamoto\"\n"
+                        "      \t\t\t(absolute error, fixed number of samples) or\n"
+                        "      \t\t\t\"bayes\" (absolute error, Bayesian estimation).\n");
+  StreamMgr_print_error(streams,  "   -l \t\t\tEvaluates the property directly on the sampled\n"
+                        "      \t\t\texecutions instead of model checking them. Falls\n"
+                        "      \t\t\tback to model checking for properties with past\n"
+                        "      \t\t\toperators or next() expressions.\n");
+  StreamMgr_print_error(streams,  "   -O \t\t\tMonitors the property while each execution is\n"
+                        "      \t\t\tdrawn, and stops drawing it as soon as its\n"
+                        "      \t\t\tverdict is known. Ignored for properties with\n"
+                        "      \t\t\tpast operators and for models with fairness\n"
+                        "      \t\t\tconstraints.\n");
+  StreamMgr_print_error(streams,  "   -r checkpoint-file\tSaves the progress of the run to\n"
+                        "      \t\t\tcheckpoint-file every %d seconds, and resumes\n"
+                        "      \t\t\tthe run from it if it exists. The file is\n"
+                        "      \t\t\tremoved once the run is over. Requires a single\n"
+                        "      \t\t\tworker.\n",
+                        STAT_CHECKPOINT_PERIOD);
+  StreamMgr_print_error(streams,  "   When no property is given and a single worker is used, each\n"
+                        "   execution is drawn once and checked against all the LTL\n"
+                        "   properties that still need samples.\n");
+  StreamMgr_print_error(streams,  "   -t theta\t\tTests whether the probability of the property is\n"
+                        "      \t\t\tat least theta with the sequential probability\n"
+                        "      \t\t\tratio test, instead of approximating it.\n");
+  StreamMgr_print_error(streams,  "   -w width\t\tHalf width of the indifference region around\n"
+                        "      \t\t\ttheta (default %g).\n",
+                        STAT_CMD_DEFAULT_WIDTH);
+  StreamMgr_print_error(streams,  "   -a alpha\t\tBound on the probability of answering false when\n"
+                        "      \t\t\tthe probability is >= theta + width (default %g).\n",
+                        STAT_CMD_DEFAULT_ALPHA);
+  StreamMgr_print_error(streams,  "   -b beta\t\tBound on the probability of answering true when\n"
+                        "      \t\t\tthe probability is <= theta - width (default %g).\n",
+                        STAT_CMD_DEFAULT_BETA);
+  StreamMgr_print_error(streams,  "   -R method\t\tEstimates the probability of a rare property of\n"
+                        "      \t\t\tthe form F p, with p a simple expression, by\n"
+                        "      \t\t\t\"splitting\" (importance splitting) or\n"
+                        "      \t\t\t\"importance\" (importance sampling). The model\n"
+                        "      \t\t\tmust not have fairness constraints, and the\n"
+                        "      \t\t\texecutions are drawn by a single worker.\n");
+  StreamMgr_print_error(streams,  "   -L level\t\tSimple expression holding in the states close to\n"
+                        "      \t\t\tp. Repeat it to give nested levels, from the\n"
+                        "      \t\t\tfarthest from p to the closest. By default the\n"
+                        "      \t\t\tlevels are the backward reachability layers of p.\n");
+  StreamMgr_print_error(streams,  "   -N effort\t\tExecutions per splitting stage or per cross\n"
+                        "      \t\t\tentropy iteration (default %d).\n",
+                        STAT_CMD_DEFAULT_EFFORT);
+  return(1);
+}
+
+static int UsageStatCheckLtlspecBmc(const NuSMVEnv_ptr env)
+{
+  StreamMgr_ptr streams = STREAM_MGR(NuSMVEnv_get_value(env, ENV_STREAM_MANAGER));
+  StreamMgr_print_error(streams,  "usage: check_ltlspec_stat_bmc [-h] [-m | -o file] [-n number | -p \"ltl_expr\" | -P \"name\"]\n"
+                        "                             [-e epsilon] [-d delta] [-j workers] [-k length] [-i] [-M]\n"
+                        "                             [-b] [-s seed] [-T profile-file]\n");
+  print_common_usage(streams);
+  StreamMgr_print_error(streams,  "   -k length\t\tLength of the sampled executions.\n");
+  StreamMgr_print_error(streams,  "   -i \t\t\tLoads the bounded problem into an incremental SAT\n"
+                        "      \t\t\tsolver once, and checks each sampled execution\n"
+                        "      \t\t\tunder assumptions.\n");
+  StreamMgr_print_error(streams,  "   -b \t\t\tDraws the executions 64 at a time, evaluating the\n"
+                        "      \t\t\tboolean model bitwise. Undetermined bits are\n"
+                        "      \t\t\tchosen uniformly at random.\n");
+  return(1);
+}
+
+static inline void print_common_usage(const StreamMgr_ptr streams)
+{
+  StreamMgr_print_error(streams,  "   -h \t\t\tPrints the command usage.\n");
+  StreamMgr_print_error(streams,  "   -m \t\t\tPipes output through the program specified by\n");
+  StreamMgr_print_error(streams,  "      \t\t\tthe \"PAGER\" environment variable if any,\n");
+  StreamMgr_print_error(streams,  "      \t\t\telse through the UNIX command \"more\".\n");
+  StreamMgr_print_error(streams,  "   -o file\t\tWrites the output to \"file\".\n");
+  StreamMgr_print_error(streams,  "   -n number\t\tChecks only the LTLSPEC with the given index number.\n");
+  StreamMgr_print_error(streams,  "   -p \"ltl-expr\"\tChecks only the given LTL formula.\n");
+  StreamMgr_print_error(streams,  "   -P \"name\"\t\tChecks only the LTLSPEC with the given name.\n");
+  StreamMgr_print_error(streams,  "   -e epsilon\t\tRelative error of the approximation (default %g).\n",
+                        STAT_CMD_DEFAULT_EPSILON);
+  StreamMgr_print_error(streams,  "   -d delta\t\tThe result is within the error with probability\n"
+                        "      \t\t\tat least 1 - delta (default %g).\n",
+                        STAT_CMD_DEFAULT_DELTA);
+  StreamMgr_print_error(streams,  "   -j workers\t\tDraws the samples with the given number of parallel\n"
+                        "      \t\t\tworker processes (default %d).\n",
+                        STAT_CMD_DEFAULT_WORKERS);
+  StreamMgr_print_error(streams,  "   -M \t\t\tDoes not remember the verified executions: each\n"
+                        "      \t\t\texecution is verified even if it was sampled\n"
+                        "      \t\t\tbefore. Otherwise up to stat_cache_size of them\n"
+                        "      \t\t\tare remembered.\n");
+  StreamMgr_print_error(streams,  "   -s seed\t\tSeeds the random generator, so that the run can be\n"
+                        "      \t\t\treproduced with the same number of workers. By\n"
+                        "      \t\t\tdefault the seed depends on the time.\n");
+  StreamMgr_print_error(streams,  "   -T profile-file\tProfiles the run and writes a JSON summary of\n"
+                        "      \t\t\tit to profile-file: time and calls of each stage,\n"
+                        "      \t\t\tsamples per second, length of the executions,\n"
+                        "      \t\t\tmemoization hit rate and memory growth per\n"
+                        "      \t\t\tsample. When verbose, the throughput is also\n"
+                        "      \t\t\tlogged every %d seconds. With several workers\n"
+                        "      \t\t\tonly the samples are measured.\n",
+                        STAT_PROFILER_REPORT_PERIOD);
 }
 
 static inline void print_result(const StreamMgr_ptr streams,
@@ -547,3 +1019,199 @@ static inline void print_result(const StreamMgr_ptr streams,
   StreamMgr_print_output(streams, "\nwith parameters delta = %f and epsilon = %f is %f\n",
                                   delta, epsilon, result);
 }
+
+static inline void print_rare_result(const StreamMgr_ptr streams,
+                                     const OptsHandler_ptr opts,
+                                     const Prop_ptr prop,
+                                     const double delta,
+                                     const double epsilon,
+                                     const double result,
+                                     const double half_width)
+{
+  StreamMgr_print_output(streams, "Rare event estimation of : ");
+  Prop_print(prop,StreamMgr_get_output_ostream(streams),
+             get_prop_print_method(opts));
+  StreamMgr_print_output(streams, "\nwith parameters delta = %f and epsilon = %f is %g "
+                                  "(confidence interval half width %g)\n",
+                                  delta, epsilon, result, half_width);
+}
+
+static inline void print_test_result(const StreamMgr_ptr streams,
+                                     const OptsHandler_ptr opts,
+                                     const Prop_ptr prop,
+                                     const double theta,
+                                     const double alpha,
+                                     const double beta,
+                                     const boolean result)
+{
+  StreamMgr_print_output(streams, "Statistical test of : ");
+  Prop_print(prop,StreamMgr_get_output_ostream(streams),
+             get_prop_print_method(opts));
+  StreamMgr_print_output(streams, "\nwith parameters alpha = %f and beta = %f: "
+                                  "probability %s %f\n",
+                                  alpha, beta, result ? ">=" : "<", theta);
+}
+
+/*!
+  \brief Checks prop and prints the result
+
+  The probability of prop is estimated with the rare event method
+  rare if given, tested against theta if theta is positive, and
+  approximated otherwise.
+*/
+static int check_ltlspec_stat_prop(const NuSMVEnv_ptr env,
+                                   const Prop_ptr prop,
+                                   const StatEstimator estimator,
+                                   const double epsilon,
+                                   const double delta,
+                                   const int workers,
+                                   const double theta,
+                                   const double width,
+                                   const double alpha,
+                                   const double beta,
+                                   const StatRareMethod rare,
+                                   node_ptr levels,
+                                   const int effort)
+{
+  const StreamMgr_ptr streams =
+    STREAM_MGR(NuSMVEnv_get_value(env, ENV_STREAM_MANAGER));
+  const OptsHandler_ptr opts =
+    OPTS_HANDLER(NuSMVEnv_get_value(env, ENV_OPTS_HANDLER));
+  int status;
+
+  if (STAT_RARE_INVALID != rare) {
+    double result;
+    double half_width;
+
+    status = Stat_check_ltlspec_rare(env, prop, rare, levels, effort,
+                                     epsilon, delta, &result, &half_width);
+
+    if (0 == status) {
+      print_rare_result(streams, opts, prop, delta, epsilon, result,
+                        half_width);
+    }
+  }
+  else if (0 < theta) {
+    boolean result;
+
+    status = Stat_test_ltlspec(env, prop, theta, width, alpha, beta,
+                               workers, &result);
+
+    if (0 == status) {
+      print_test_result(streams, opts, prop, theta, alpha, beta, result);
+    }
+  }
+  else {
+    double result;
+
+    status = Stat_check_ltlspec(env, prop, estimator, epsilon, delta,
+                                workers, &result);
+
+    if (0 == status) {
+      print_result(streams, opts, prop, delta, epsilon, result);
+    }
+  }
+
+  return status;
+}
+
+/*!
+  \brief Checks all the LTL properties of the database on shared
+  executions and prints the results
+
+  As check_ltlspec_stat_prop, but every execution is drawn once and
+  verified against all the properties still being estimated.
+*/
+static int check_ltlspecs_stat(const NuSMVEnv_ptr env,
+                               const StatEstimator estimator,
+                               const double epsilon,
+                               const double delta,
+                               const double theta,
+                               const double width,
+                               const double alpha,
+                               const double beta)
+{
+  const StreamMgr_ptr streams =
+    STREAM_MGR(NuSMVEnv_get_value(env, ENV_STREAM_MANAGER));
+  const OptsHandler_ptr opts =
+    OPTS_HANDLER(NuSMVEnv_get_value(env, ENV_OPTS_HANDLER));
+  const PropDb_ptr prop_db =
+    PROP_DB(NuSMVEnv_get_value(env, ENV_PROP_DB));
+  Prop_ptr* props = ALLOC(Prop_ptr, PropDb_get_size(prop_db));
+  int props_num = 0;
+  int status = 0;
+  int i;
+
+  for (i = 0; i < PropDb_get_size(prop_db); i++) {
+    Prop_ptr p = PropDb_get_prop_at_index(prop_db, i);
+
+    if (Prop_get_type(p) == Prop_Ltl) props[props_num++] = p;
+  }
+
+  if (0 < props_num && 0 < theta) {
+    boolean* results = ALLOC(boolean, props_num);
+
+    status = Stat_test_ltlspecs(env, props, props_num, theta, width,
+                                alpha, beta, results);
+
+    for (i = 0; 0 == status && i < props_num; i++) {
+      print_test_result(streams, opts, props[i], theta, alpha, beta,
+                        results[i]);
+    }
+    FREE(results);
+  }
+  else if (0 < props_num) {
+    double* results = ALLOC(double, props_num);
+
+    status = Stat_check_ltlspecs(env, props, props_num, estimator,
+                                 epsilon, delta, results);
+
+    for (i = 0; 0 == status && i < props_num; i++) {
+      print_result(streams, opts, props[i], delta, epsilon, results[i]);
+    }
+    FREE(results);
+  }
+
+  FREE(props);
+
+  return status;
+}
+
+/*!
+  \brief Parses a non negative decimal seed
+
+  Returns false if str is not a non negative integer.
+*/
+static boolean parse_seed(const char* str, unsigned long long* seed)
+{
+  char* end;
+
+  if (! isdigit((unsigned char)str[0])) return false;
+
+  *seed = strtoull(str, &end, 10);
+
+  return '\0' == *end;
+}
+
+/*!
+  \brief Writes the profile of the statistical runs to fname
+
+  Returns 1 if fname cannot be written, 0 otherwise.
+*/
+static int print_profile(const NuSMVEnv_ptr env, const char* fname)
+{
+  const StreamMgr_ptr streams =
+    STREAM_MGR(NuSMVEnv_get_value(env, ENV_STREAM_MANAGER));
+  FILE* out = fopen(fname, "w");
+
+  if ((FILE*)NULL == out) {
+    StreamMgr_print_error(streams, "Unable to write the profile to \"%s\".\n",
+                          fname);
+    return 1;
+  }
+
+  Stat_print_profile(env, out);
+  fclose(out);
+
+  return 0;
+}
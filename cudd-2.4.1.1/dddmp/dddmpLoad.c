@@ -921,9 +921,20 @@ DddmpCuddDdArrayLoad (
             if (strcmp(buf, "0") == 0) {
               pnodes[i] = Cudd_ReadFalse (ddMgr);       
             } else {
+/* NuSMV: added begin */
+#if 0
+/* NuSMV: added end */
               addConstant = atof(buf);
               pnodes[i] = Cudd_addConst (ddMgr,
                 (CUDD_VALUE_TYPE) addConstant);
+/* NuSMV: added begin */
+#endif
+              /* ADD leaves are node pointers in NuSMV, numeric
+                 constants cannot be restored */
+              (void) addConstant;
+              Dddmp_CheckAndGotoLabel (1,
+                "ADD Constants Not Supported.", failure);
+/* NuSMV: added end */
             }
           }
 